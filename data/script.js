@@ -16,6 +16,14 @@ const elements = {
   progressBar: document.getElementById("uploadProgress"),
   progressText: document.getElementById("progressText"),
   uploadBtn: document.getElementById("uploadBtn"),
+  telemetryFps: document.getElementById("telemetryFps"),
+  telemetryEffects: document.getElementById("telemetryEffects"),
+  telemetryHeap: document.getElementById("telemetryHeap"),
+  telemetryPsram: document.getElementById("telemetryPsram"),
+  telemetryRssi: document.getElementById("telemetryRssi"),
+  telemetryUnderruns: document.getElementById("telemetryUnderruns"),
+  telemetryMotion: document.getElementById("telemetryMotion"),
+  telemetryStatus: document.getElementById("telemetryStatus"),
 };
 
 // State
@@ -23,6 +31,18 @@ const state = {
   isPasswordVisible: false,
 };
 
+// Background scan and connect jobs are polled at this interval
+const POLL_INTERVAL_MS = 1000;
+const SCAN_MAX_POLLS = 20;
+
+// Binary telemetry samples, laid out as telemetry_sample_t (little-endian)
+const TELEMETRY_VERSION = 1;
+const TELEMETRY_HEADER_SIZE = 28;
+const TELEMETRY_RECONNECT_MS = 5000;
+const EFFECT_NAMES = ["Scanlines", "Dithering", "Glitch", "Tint", "Chromatic", "Dot matrix", "Pixelate"];
+const MOTION_EVENTS = ["Shaking", "Tapped", "Double tapped", "Sleep", "Deep sleep", "Upside down",
+  "Tilted left", "Tilted right", "Half tilted left", "Half tilted right", "Sudden acceleration"];
+
 // UI Helper Functions
 const ui = {
   showStatus(el, message, type) {
@@ -165,8 +185,13 @@ const network = {
       "WARNING"
     );
     try {
-      const response = await fetchWithTimeout("/scan", {}, 60000);
-      if (!response.ok) {
+      // The device scans in the background and answers 202 until it is done
+      let response = await fetchWithTimeout("/scan?refresh=1", {}, 60000);
+      for (let polls = 0; response.status === 202 && polls < SCAN_MAX_POLLS; polls++) {
+        await sleep(POLL_INTERVAL_MS);
+        response = await fetchWithTimeout("/scan", {}, 60000);
+      }
+      if (!response.ok || response.status === 202) {
         throw new Error(`Network scan failed with status: ${response.status}`);
       }
 
@@ -235,7 +260,7 @@ const network = {
           throw new Error(`HTTP error! status: ${response.status}`);
         }
   
-        const data = await response.json();
+        const data = await network.waitForConnectJob(await response.json());
         ui.showStatus(
           elements.statusNotification,
           data.message,
@@ -258,6 +283,20 @@ const network = {
       return { success: false, message: "Connection failed" };
     }
   },
+  // Poll a connect job started by /connect until it connects or fails
+  async waitForConnectJob(data) {
+    while (data.state === "pending") {
+      ui.showStatus(elements.statusNotification, data.message, "WARNING");
+      await sleep(POLL_INTERVAL_MS);
+      const response = await fetchWithTimeout(`/connect/status?job=${data.job}`, {}, 60000);
+      if (!response.ok) {
+        throw new Error(`Connect status check failed with status: ${response.status}`);
+      }
+      data = await response.json();
+    }
+    return data;
+  },
+
   async disconnect() {
     ui.hideStatus(elements.statusNotification);
     try {
@@ -312,18 +351,75 @@ const network = {
       return { success: false, message: "Connection timed out." };
     }
   },
+};
 
-  async pollUpdateStatus() {
-    try {
-      const response = await fetchWithTimeout("/update/status", {}, 60000);
-      if (!response.ok) {
-        throw new Error(`HTTP error! status: ${response.status}`);
+// Live telemetry pushed over the /telemetry WebSocket
+const telemetry = {
+  underruns: 0,
+
+  connect() {
+    const socket = new WebSocket(`ws://${window.location.host}/telemetry`);
+    socket.binaryType = "arraybuffer";
+    socket.onopen = () => ui.hideStatus(elements.telemetryStatus);
+    socket.onmessage = (event) => {
+      const samples = telemetry.parse(event.data);
+      samples.forEach((sample) => (telemetry.underruns += sample.audioUnderruns));
+      if (samples.length > 0) {
+        telemetry.render(samples[samples.length - 1]);
       }
-      const data = await response.json();
-      return data;
-    } catch (error) {
-      console.error("Failed to get update status:", error);
-      return null;
+    };
+    socket.onclose = () => {
+      ui.showStatus(elements.telemetryStatus, "Telemetry disconnected, retrying.", "WARNING");
+      setTimeout(() => telemetry.connect(), TELEMETRY_RECONNECT_MS);
+    };
+  },
+
+  // A frame holds one or more consecutive samples
+  parse(buffer) {
+    const view = new DataView(buffer);
+    const samples = [];
+    let offset = 0;
+    while (offset + TELEMETRY_HEADER_SIZE <= view.byteLength) {
+      const effectCount = view.getUint8(offset + 1);
+      const size = TELEMETRY_HEADER_SIZE + effectCount * 2;
+      if (view.getUint8(offset) !== TELEMETRY_VERSION || offset + size > view.byteLength) {
+        break;
+      }
+      const effectLoad = [];
+      for (let i = 0; i < effectCount; i++) {
+        effectLoad.push(view.getUint16(offset + TELEMETRY_HEADER_SIZE + i * 2, true) / 100);
+      }
+      samples.push({
+        uptime: view.getUint32(offset + 4, true),
+        fps: view.getUint16(offset + 8, true) / 100,
+        motionEvents: view.getUint16(offset + 10, true),
+        heapFree: view.getUint32(offset + 12, true),
+        heapMinFree: view.getUint32(offset + 16, true),
+        psramFree: view.getUint32(offset + 20, true),
+        audioUnderruns: view.getUint16(offset + 24, true),
+        rssi: view.getInt8(offset + 26),
+        effectLoad,
+      });
+      offset += size;
+    }
+    return samples;
+  },
+
+  render(sample) {
+    const kb = (bytes) => `${Math.round(bytes / 1024)} KB`;
+    const effects = sample.effectLoad
+      .map((load, i) => (load > 0 ? `${EFFECT_NAMES[i] || `Effect ${i}`} ${load.toFixed(1)}%` : null))
+      .filter(Boolean);
+    const motion = MOTION_EVENTS.filter((name, i) => sample.motionEvents & (1 << i));
+
+    elements.telemetryFps.textContent = `${sample.fps.toFixed(1)} fps`;
+    elements.telemetryEffects.textContent = effects.length ? effects.join(", ") : "None";
+    elements.telemetryHeap.textContent = `${kb(sample.heapFree)} (min ${kb(sample.heapMinFree)})`;
+    elements.telemetryPsram.textContent = kb(sample.psramFree);
+    elements.telemetryRssi.textContent = sample.rssi ? `${sample.rssi} dBm` : "Not connected";
+    elements.telemetryUnderruns.textContent = telemetry.underruns;
+    if (motion.length) {
+      elements.telemetryMotion.textContent = motion.join(", ");
     }
   },
 };
@@ -348,6 +444,8 @@ async function connectionWithRetry(operation, maxRetries = 3) {
   }
 }
 
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
 const fetchWithTimeout = (url, options, timeout = 30000) => {
   return Promise.race([
     fetch(url, options),
@@ -359,8 +457,9 @@ const fetchWithTimeout = (url, options, timeout = 30000) => {
 
 function validateFirmwareFile(file) {
   // Check file type
-  if (!file.name.endsWith('.bin')) {
-    return { valid: false, message: "Invalid firmware file format. Expected .bin file." };
+  const name = file.name.endsWith('.gz') ? file.name.slice(0, -3) : file.name;
+  if (!name.endsWith('.bin') && !name.endsWith('.patch')) {
+    return { valid: false, message: "Invalid firmware file format. Expected .bin or .patch file (optionally .gz)." };
   }
   
   // Check file size (adjust max size as needed)
@@ -398,37 +497,16 @@ function handleFirmwareUpdate(e) {
   const handleError = (message) => {
     ui.resetProgress();
     ui.showStatus(elements.updateStatusNotification, message, "ERROR");
-    if (statusInterval) {
-      clearInterval(statusInterval);
-    }
   };
 
-  // Start polling when upload begins
-  let statusInterval = null;
+  // The device answers the upload request itself once the update has been
+  // applied, so progress comes from the browser rather than /update/status
   xhr.upload.onloadstart = () => {
-    statusInterval = setInterval(async () => {
-      const status = await network.pollUpdateStatus();
-      if (status) {
-        ui.updateProgress(status.progress);
-        ui.showStatus(
-          elements.updateStatusNotification,
-          status.message,
-          status.state === "ERROR"
-            ? "ERROR"
-            : status.state === "SUCCESS"
-            ? "SUCCESS"
-            : "WARNING"
-        );
-
-        // Clear interval if we're done or there's an error
-        if (status.completed || status.state === "ERROR") {
-          clearInterval(statusInterval);
-          if (status.state === "SUCCESS") {
-            setTimeout(() => window.location.reload(), 2000);
-          }
-        }
-      }
-    }, 1000); // Poll every second
+    ui.showStatus(
+      elements.updateStatusNotification,
+      "Your update is being uploaded to your device, please wait.",
+      "WARNING"
+    );
   };
 
   xhr.upload.onprogress = (e) => {
@@ -438,11 +516,15 @@ function handleFirmwareUpdate(e) {
     }
   };
 
+  xhr.upload.onload = () => {
+    ui.showStatus(
+      elements.updateStatusNotification,
+      "Upload complete, applying the update.",
+      "WARNING"
+    );
+  };
+
   xhr.onload = () => {
-    // Clear polling interval when upload is complete
-    if (statusInterval) {
-      clearInterval(statusInterval);
-    }
     try {
       const response = JSON.parse(xhr.responseText);
 
@@ -468,9 +550,6 @@ function handleFirmwareUpdate(e) {
   };
 
   xhr.onerror = () => {
-    if (statusInterval) {
-      clearInterval(statusInterval);
-    }
     handleError(
       "Network timed out, make sure you are connected to your Wi-Fi network."
     );
@@ -510,6 +589,7 @@ window.addEventListener('error', (event) => {
 async function init() {
   elements.hideIcon.style.display = "none";
   initializeEventListeners();
+  telemetry.connect();
   // First, check our current connection status
   const status = await network.checkConnectionStatus();
 
@@ -62,6 +62,14 @@ void clearInterrupts();
  */
 void enterDeepSleep();
 
+/**
+ * @brief Light-sleeps the ESP with the ADXL345 and a timer as wake-up sources
+ * Wake-up sources the caller enabled (e.g. the menu button) also end it.
+ * @param durationMs Longest time to sleep
+ * @return true if motion woke the device
+ */
+bool enterLightSleep(uint32_t durationMs);
+
 /**
  * @brief Calculates the combined magnitude of acceleration across all axes
  * @param accelX X-axis acceleration in m/s²
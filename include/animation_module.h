@@ -50,6 +50,15 @@ struct AnimationSequence {
   const unsigned long IDLE_DELAY = 20000;
 };
 
+/**
+ * @brief Where the emote sequence was, kept across deep sleep
+ */
+struct AnimationPosition {
+  SequenceState sequenceState;
+  bool isIdleMode;
+  bool asleep; // Sleeping animation was showing; the wake plays the wake-up emote
+};
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -76,4 +85,16 @@ void playEmotes(void);
  */
 void playBootAnimation(void);
 
+/**
+ * @brief Capture the position of the emote sequence
+ * @param position Receives the position
+ */
+void getAnimationPosition(AnimationPosition *position);
+
+/**
+ * @brief Continue the emote sequence from a captured position
+ * @param position Position from getAnimationPosition()
+ */
+void restoreAnimationPosition(const AnimationPosition *position);
+
 #endif /* ANIMATION_MODULE_H */
\ No newline at end of file
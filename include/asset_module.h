@@ -0,0 +1,97 @@
+/**
+ * @file asset_module.h
+ * @brief File-level LittleFS asset sync over HTTP and serial
+ *
+ * The host describes the asset tree as a manifest of "size,sha256,path"
+ * entries; the device answers with the entries that differ from its copy and
+ * only those files are transferred. Each file is written to a temporary
+ * sibling, hash-verified, then renamed over the original so a failed or
+ * interrupted transfer never leaves a partially written asset in place.
+ */
+
+#ifndef ASSET_MODULE_H
+#define ASSET_MODULE_H
+
+#include "common.h"
+#include "flash_module.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *ASSET_LOG = "::ASSET_MODULE::";
+
+#define ASSET_PATH_MAX 64
+#define ASSET_HASH_SIZE 32
+#define ASSET_TEMP_SUFFIX ".part"
+#define ASSET_READ_BUFFER_SIZE 1024
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+// One manifest entry: "size,sha256 hex,path"
+typedef struct {
+  size_t size;
+  uint8_t hash[ASSET_HASH_SIZE];
+  char path[ASSET_PATH_MAX + 1];
+} asset_entry_t;
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Parse a manifest entry
+ * @param text Entry text ("size,sha256,path"), not necessarily terminated
+ * @param length Length of the entry text
+ * @param entry Receives the parsed entry
+ * @return true if the entry is well formed and the path is allowed
+ */
+bool assetSync_parseEntry(const char *text, size_t length, asset_entry_t *entry);
+
+/**
+ * @brief Check whether the device copy of an asset matches a manifest entry
+ * @param entry Manifest entry
+ * @return true if the file exists with the same size and SHA-256
+ */
+bool assetSync_isCurrent(const asset_entry_t *entry);
+
+/**
+ * @brief Start receiving an asset into its temporary file
+ * @param entry Manifest entry of the file being sent
+ * @return true if the temporary file is open
+ */
+bool assetSync_begin(const asset_entry_t *entry);
+
+/**
+ * @brief Append the next chunk of file data
+ * @param data File bytes
+ * @param length Number of bytes
+ * @return false if the write failed or exceeds the announced size
+ */
+bool assetSync_write(const uint8_t *data, size_t length);
+
+/**
+ * @brief Verify the received file and rename it into place
+ * @return true if the asset was replaced
+ */
+bool assetSync_end();
+
+/**
+ * @brief Abandon the current transfer and remove its temporary file
+ */
+void assetSync_abort();
+
+/**
+ * @brief Get a description of the last asset sync error
+ * @return Error message
+ */
+const char *assetSync_errorString();
+
+/**
+ * @brief Register the /assets/diff and /assets/upload endpoints
+ */
+void setupAssetEndpoints();
+
+#endif /* ASSET_MODULE_H */
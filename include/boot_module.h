@@ -0,0 +1,141 @@
+/**
+ * @file boot_module.h
+ * @brief Boot timeline recorder and dependency-ordered initialization
+ *
+ * Initializers are described as stages, each naming the stages it depends
+ * on. Independent stages run concurrently on their own tasks; a stage starts
+ * as soon as its dependencies have finished instead of after a fixed delay.
+ * Every stage, and any section timed with boot_beginStage(), is recorded on
+ * a timeline that is printed over serial once the device is interactive.
+ *
+ * A small resume record in RTC memory survives software resets and deep
+ * sleep, so a warm boot with quick boot enabled can skip the cosmetic
+ * startup sequence and pick up where the device left off. A wake from deep
+ * sleep always does, whatever the quick boot preference. Before deep sleep
+ * the record also captures the effect chain and animation position, and
+ * the preferences keep their own RTC copy, so the wake needs neither NVS nor
+ * a filesystem check to restore them.
+ */
+
+#ifndef BOOT_MODULE_H
+#define BOOT_MODULE_H
+
+#include "common.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *BOOT_LOG = "::BOOT_MODULE::";
+
+#define BOOT_MAX_STAGES 24 // One event group bit per stage
+#define BOOT_TIMELINE_MAX 32
+#define BOOT_STAGE_STACK 4096 // Default for parallel stages that do not set their own
+#define BOOT_STAGE_PRIORITY 1
+#define BOOT_STAGE_TIMEOUT_MS 10000
+
+#define BOOT_STAGE_BIT(stage) (1UL << (stage))
+
+#define BOOT_RESUME_MAGIC 0x42393052 // "B90R"
+#define BOOT_RESUME_VERSION 2
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef bool (*boot_init_fn_t)(void);
+
+/**
+ * @brief One initializer in a boot stage table
+ * Dependencies may only name earlier entries of the same table.
+ */
+typedef struct {
+  const char *name;
+  boot_init_fn_t init;
+  uint32_t dependsOn; // BOOT_STAGE_BIT() of each stage that must finish first
+  bool parallel;      // Run on its own task; otherwise on the caller's, in table order
+  bool required;      // Failure fails the boot and skips the stages that depend on it
+  uint32_t stackSize; // Task stack in bytes for a parallel stage; 0 for BOOT_STAGE_STACK
+} boot_stage_t;
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Run a stage table, each stage once its dependencies have finished
+ * @param stages Stage table; must outlive the call
+ * @param count Number of stages, at most BOOT_MAX_STAGES
+ * @return false if a required stage failed, was skipped or timed out
+ */
+bool boot_runStages(const boot_stage_t *stages, size_t count);
+
+/**
+ * @brief Start timing a section of the boot
+ * @param name Label, kept by pointer
+ * @return Timeline entry to pass to boot_endStage(), or -1 if the timeline is full
+ */
+int boot_beginStage(const char *name);
+
+/**
+ * @brief Finish timing a section started with boot_beginStage()
+ * @param entry Timeline entry
+ * @param ok Whether the section succeeded
+ */
+void boot_endStage(int entry, bool ok);
+
+/**
+ * @brief Record a point in time on the timeline
+ * @param name Label, kept by pointer
+ */
+void boot_mark(const char *name);
+
+/**
+ * @brief Print the timeline over serial
+ * Parallel stages also show the least stack their task had left, for sizing
+ * boot_stage_t.stackSize.
+ */
+void boot_printTimeline();
+
+/**
+ * @brief Check whether this boot follows a software reset or deep-sleep wake
+ */
+bool boot_isWarmStart();
+
+/**
+ * @brief Check whether the cosmetic startup sequence should be skipped
+ * @return true on a warm start with quick boot enabled and a valid resume record
+ */
+bool boot_isQuickBoot();
+
+/**
+ * @brief Remember the running system state for the next warm boot
+ * @param state SystemState value
+ */
+void boot_saveResumeState(uint8_t state);
+
+/**
+ * @brief Get the system state that was running before a warm boot
+ * @param state Receives the SystemState value
+ * @return false after a cold boot or if the resume record is invalid
+ */
+bool boot_loadResumeState(uint8_t *state);
+
+/**
+ * @brief Capture the runtime state into RTC memory - call right before deep sleep
+ */
+void boot_prepareForSleep();
+
+/**
+ * @brief Check whether this boot is a wake from a deep sleep prepared with boot_prepareForSleep()
+ */
+bool boot_isSleepWake();
+
+/**
+ * @brief Restore the effect chain and animation position captured before deep sleep
+ * Call once the effects and animation modules are initialized.
+ * @return false if this boot is not such a wake
+ */
+bool boot_restoreAfterSleep();
+
+#endif /* BOOT_MODULE_H */
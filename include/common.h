@@ -95,6 +95,15 @@ bool checkHardwareSupport();
  */
 String formatBytes(size_t bytes);
 
+/**
+ * @brief Convert bytes to human-readable format into a caller buffer
+ * @param bytes Number of bytes to convert
+ * @param buffer Destination buffer
+ * @param bufferSize Size of the destination buffer
+ * @return Pointer to buffer
+ */
+const char *formatBytes(size_t bytes, char *buffer, size_t bufferSize);
+
 //==============================================================================
 // COLOR UTILITY FUNCTIONS
 //==============================================================================
@@ -0,0 +1,102 @@
+/**
+ * @file delta_module.h
+ * @brief Streaming application of binary delta patches against the running firmware
+ *
+ * A patch rebuilds the new firmware image from the running partition plus a
+ * compact list of COPY/ADD/INSERT operations, writing the result into the
+ * inactive OTA partition through Update. Patches are produced on the host by
+ * tools/make_delta.py and are fed in arbitrary-sized chunks as they arrive
+ * over HTTP or serial.
+ */
+
+#ifndef DELTA_MODULE_H
+#define DELTA_MODULE_H
+
+#include "common.h"
+#include <Update.h>
+#include <esp_ota_ops.h>
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *DELTA_LOG = "::DELTA_MODULE::";
+
+#define DELTA_MAGIC "B90P"
+#define DELTA_VERSION 1
+#define DELTA_HASH_SIZE 32
+#define DELTA_WORK_BUFFER_SIZE 1024
+
+// Operation types
+#define DELTA_OP_END 0x00
+#define DELTA_OP_COPY 0x01   // new = old[offset, offset + length)
+#define DELTA_OP_ADD 0x02    // new = old[offset + i] + patch[i] (mod 256)
+#define DELTA_OP_INSERT 0x03 // new = patch[0, length)
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+// Patch header (little-endian, followed by a stream of delta_op_t records)
+typedef struct __attribute__((packed)) {
+  char magic[4];
+  uint8_t version;
+  uint8_t reserved[3];
+  uint32_t oldSize;
+  uint32_t newSize;
+  uint8_t oldHash[DELTA_HASH_SIZE]; // SHA-256 of the running image
+  uint8_t newHash[DELTA_HASH_SIZE]; // SHA-256 of the rebuilt image
+} delta_header_t;
+
+// Operation record; ADD and INSERT are followed by `length` payload bytes
+typedef struct __attribute__((packed)) {
+  uint8_t type;
+  uint32_t offset;
+  uint32_t length;
+} delta_op_t;
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Start a delta update session
+ * @return true if a running partition is available to patch against
+ *
+ * Update.begin is deferred until the patch header (and the new image size)
+ * has been received and the running image hash has been verified.
+ */
+bool deltaUpdate_begin();
+
+/**
+ * @brief Feed the next chunk of patch data
+ * @param data Patch bytes
+ * @param length Number of bytes
+ * @return false if the patch is invalid or a flash write failed
+ */
+bool deltaUpdate_write(const uint8_t *data, size_t length);
+
+/**
+ * @brief Verify the rebuilt image and finalize the update
+ * @return true if the new image is complete, hash-verified and bootable
+ */
+bool deltaUpdate_end();
+
+/**
+ * @brief Abort the delta session and any Update in progress
+ */
+void deltaUpdate_abort();
+
+/**
+ * @brief Check if a delta session is in progress
+ * @return true between deltaUpdate_begin and end/abort
+ */
+bool deltaUpdate_isActive();
+
+/**
+ * @brief Get a description of the last delta error
+ * @return Error message
+ */
+const char *deltaUpdate_errorString();
+
+#endif /* DELTA_MODULE_H */
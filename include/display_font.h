@@ -0,0 +1,74 @@
+/**
+ * @file display_font.h
+ * @brief Pre-rasterized glyph atlas for the built-in 5x7 display font
+ *
+ * Provides text rendering that composes whole lines of the classic GFX font
+ * into a RAM buffer and pushes them to the OLED in a single burst, using
+ * RGB565 glyph atlases cached per foreground/background color pair.
+ */
+
+#ifndef DISPLAY_FONT_H
+#define DISPLAY_FONT_H
+
+#include "common.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *FONT_LOG = "::DISPLAY_FONT::";
+
+#define FONT_CHAR_WIDTH 6
+#define FONT_CHAR_HEIGHT 8
+#define FONT_FIRST_CHAR 0x20
+#define FONT_LAST_CHAR 0x7E
+#define FONT_GLYPH_COUNT (FONT_LAST_CHAR - FONT_FIRST_CHAR + 1)
+#define FONT_VARIANT_SLOTS 4
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Get the rendered width of a string in pixels
+ * @param text Null-terminated string
+ * @return Width in pixels (matches GFX getTextBounds at text size 1)
+ */
+int16_t displayFont_textWidth(const char *text);
+
+/**
+ * @brief Get how many characters fit in a given width
+ * @param maxWidth Available width in pixels
+ * @return Number of characters that fit
+ */
+int16_t displayFont_charsForWidth(int16_t maxWidth);
+
+/**
+ * @brief Draw a line of text as a single pixel burst
+ * @param x X-coordinate of the top-left corner
+ * @param y Y-coordinate of the top-left corner
+ * @param text Null-terminated string (clipped at the right edge)
+ * @param fg Foreground (glyph) color
+ * @param bg Background color filling each character cell
+ * @param minWidth Pad the line with background up to this width (0 for none)
+ * @return Width in pixels actually pushed to the display
+ */
+int16_t displayFont_drawText(int16_t x, int16_t y, const char *text, uint16_t fg, uint16_t bg, int16_t minWidth = 0);
+
+/**
+ * @brief Compose a line of text into an off-screen RGB565 buffer
+ * @param buffer Destination framebuffer (row-major)
+ * @param bufferWidth Framebuffer width in pixels
+ * @param bufferHeight Framebuffer height in pixels
+ * @param x X-coordinate of the top-left corner
+ * @param y Y-coordinate of the top-left corner
+ * @param text Null-terminated string (clipped at the right edge)
+ * @param fg Foreground (glyph) color
+ * @param bg Background color filling each character cell
+ * @param minWidth Pad the line with background up to this width (0 for none)
+ * @return Width in pixels written to the buffer
+ */
+int16_t displayFont_composeText(uint16_t *buffer, int16_t bufferWidth, int16_t bufferHeight, int16_t x, int16_t y,
+                                const char *text, uint16_t fg, uint16_t bg, int16_t minWidth = 0);
+
+#endif /* DISPLAY_FONT_H */
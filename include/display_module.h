@@ -99,6 +99,25 @@ void endWrite();
  */
 void writePixels(uint16_t *pixels, uint32_t len);
 
+/**
+ * @brief Push full-width rows of pixel data to the display
+ * @param rows Pointer to h rows of DISPLAY_WIDTH RGB565 pixels
+ * @param y Display row the first pixel row lands on
+ * @param h Number of rows to push
+ *
+ * Rows are mapped through the current hardware start line, so callers always
+ * address visible display rows regardless of hardware scrolling.
+ */
+void flushPixelRows(const uint16_t *rows, int16_t y, int16_t h);
+
+/**
+ * @brief Push full framebuffer rows to the display in one transaction
+ * @param framebuffer Pointer to a DISPLAY_WIDTH x DISPLAY_HEIGHT RGB565 framebuffer
+ * @param y First row to push
+ * @param h Number of rows to push
+ */
+void flushFramebufferRows(const uint16_t *framebuffer, int16_t y, int16_t h);
+
 /**
  * @brief Initialize the OLED display (optimized for fast boot)
  * @return true if initialization was successful, false otherwise
@@ -127,6 +146,18 @@ void displayStaticImage(const uint16_t *imageData, uint16_t imageWidth, uint16_t
  */
 void setDisplayBrightness(uint8_t contrastLevel);
 
+/**
+ * @brief Set the SSD1351 display start line (hardware vertical scroll)
+ * @param line GDDRAM row shown at the top of the panel (wraps at DISPLAY_HEIGHT)
+ */
+void setDisplayStartLine(uint8_t line);
+
+/**
+ * @brief Get the current SSD1351 display start line
+ * @return GDDRAM row shown at the top of the panel
+ */
+uint8_t getDisplayStartLine();
+
 /**
  * @brief Clear the display by filling it with black
  */
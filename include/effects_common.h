@@ -117,6 +117,7 @@ typedef struct {
   uint32_t totalPixels;
   uint32_t effectsApplied;
   uint32_t processingTime;
+  uint32_t effectTime[EFFECT_COUNT]; // Microseconds spent in each effect
   float fps;
 } effect_performance_t;
 
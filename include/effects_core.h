@@ -9,6 +9,67 @@
 #include "effects_common.h"
 #include "preferences_module.h"
 
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+#define EFFECT_PRESET_VERSION 1
+#define EFFECT_PRESET_SLOTS PREFERENCES_PRESET_SLOTS // Named presets in the bank
+#define EFFECT_PRESET_NAME_LEN 12 // Including the terminator
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Serialized effect chain - enable states and all seven parameter sets
+ * Stored as-is in the preferences blob; modes and counts are narrowed to bytes.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t version;              // EFFECT_PRESET_VERSION
+    uint8_t enabled;              // Bit per effect_type_t
+
+    uint16_t tintColor;
+    float tintIntensity;
+    float tintThreshold;
+    uint8_t tintSelective;
+
+    uint8_t chromaticMode;
+    float chromaticIntensity;
+    float chromaticDegrees;
+    float chromaticRedShift;
+    float chromaticBlueShift;
+
+    uint8_t scanlineMode;
+    float scanlineIntensity;
+    float scanlineSpeed;
+
+    uint8_t ditherMode;
+    uint8_t ditherQuantization;
+    float ditherIntensity;
+
+    uint8_t glitchMode;
+    float glitchProbability;
+
+    uint8_t dotMatrixMode;
+    uint8_t dotSize;
+    uint8_t dotQuantization;
+    float dotMatrixIntensity;
+
+    uint8_t pixelateMode;
+    uint8_t blockSize;
+    float pixelateIntensity;
+} effect_preset_t;
+
+/**
+ * @brief One slot of the preset bank - a name and the chain it selects
+ * Slots stored before names existed hold a bare effect_preset_t.
+ */
+typedef struct __attribute__((packed)) {
+    char name[EFFECT_PRESET_NAME_LEN];
+    effect_preset_t effects;
+} effect_bank_entry_t;
+
 //==============================================================================
 // CORE EFFECTS MANAGEMENT
 //==============================================================================
@@ -82,17 +143,68 @@ bool effectsCore_getEffectParams(effect_type_t type, void* params);
  */
 bool effectsCore_applyDefaultParams(effect_type_t type);
 
+//==============================================================================
+// EFFECT PRESETS
+//==============================================================================
+
+/**
+ * @brief Capture the current effect chain
+ * @param preset Receives the enable states and every parameter set
+ */
+void effectsCore_capturePreset(effect_preset_t* preset);
+
+/**
+ * @brief Restore an effect chain captured with effectsCore_capturePreset()
+ * @param preset Preset to apply
+ * @return false if the preset is from an unknown version
+ */
+bool effectsCore_applyPreset(const effect_preset_t* preset);
+
+/**
+ * @brief Store the current effect chain in a bank slot and make it active
+ * @param slot Slot index, below EFFECT_PRESET_SLOTS
+ * @param name Printable name, stored upper-cased; NULL keeps the slot's name
+ * @return false if the slot or name is invalid or could not be persisted
+ */
+bool effectsCore_storePreset(uint8_t slot, const char* name = NULL);
+
+/**
+ * @brief Switch to a stored preset
+ * The preset's chain is compiled when stored, so switching is a pointer swap
+ * taking effect on the next scanline, with no flash access.
+ * @param slot Slot index, below EFFECT_PRESET_SLOTS
+ * @return false if the slot is invalid or empty
+ */
+bool effectsCore_selectPreset(uint8_t slot);
+
+/**
+ * @brief Check whether a bank slot holds a preset
+ */
+bool effectsCore_isPresetStored(uint8_t slot);
+
+/**
+ * @brief Get the name of a stored preset
+ * @return The name, or NULL if the slot is invalid or empty
+ */
+const char* effectsCore_getPresetName(uint8_t slot);
+
+/**
+ * @brief Get the slot of the active preset
+ * @return Slot index, or -1 once the chain has been edited since selection
+ */
+int effectsCore_getActivePreset(void);
+
 //==============================================================================
 // PREFERENCES INTEGRATION
 //==============================================================================
 
 /**
- * @brief Save all effect states to preferences
+ * @brief Save the effect chain to preferences
  */
 void effectsCore_saveToPreferences(void);
 
 /**
- * @brief Load all effect states from preferences
+ * @brief Load the effect chain from preferences
  */
 void effectsCore_loadFromPreferences(void);
 
@@ -113,4 +225,19 @@ void effectsCore_clearPreferences(void);
  */
 void effectsCore_applyToScanline(uint16_t* pixels, int width, int row);
 
+//==============================================================================
+// PERFORMANCE MONITORING
+//==============================================================================
+
+/**
+ * @brief Copy the effect processing counters
+ * @param stats Receives the counters accumulated since the last reset
+ */
+void effectsCore_getPerformance(effect_performance_t* stats);
+
+/**
+ * @brief Clear the effect processing counters
+ */
+void effectsCore_resetPerformance(void);
+
 #endif /* EFFECTS_CORE_H */
@@ -25,7 +25,25 @@ class MotionState;
 
 static const char* ESPNOW_LOG = "::ESPNOW_MODULE::";
 
-#define APP_SIGNATURE 0xCAFE2025
+#define ESPNOW_PROTOCOL_ID 0xB          // High nibble of every frame's version byte
+#define ESPNOW_PROTOCOL_VERSION 1
+#define ESPNOW_VERSION_BYTE ((ESPNOW_PROTOCOL_ID << 4) | ESPNOW_PROTOCOL_VERSION)
+
+#define ESPNOW_CHANNEL 1
+
+#define ESPNOW_MAX_PEERS 4              // Devices in one conversation besides this one
+#define ESPNOW_MAX_EVENTS 8             // Events batched into one frame
+#define ESPNOW_QUEUE_LENGTH 16          // Radio callbacks waiting for the main loop
+#define ESPNOW_ACK_TIMEOUT_MS 200
+#define ESPNOW_MAX_RETRIES 3
+
+#define ESPNOW_LISTEN_WINDOW_MS 300             // Radio stays up this long after each discovery beacon
+#define ESPNOW_DISCOVERY_JITTER_PERCENT 25      // Random spread of every discovery interval
+#define ESPNOW_MIN_LIGHT_SLEEP_MS 500           // Shorter idle gaps are not worth stopping the radio
+
+#define FRAME_FLAG_ACK_REQUEST (1 << 0) // Receiver answers with an ACK of the same sequence
+#define FRAME_FLAG_RETRY (1 << 1)       // Retransmission of an unacknowledged frame
+#define FRAME_FLAG_REPLY (1 << 2)       // DISCOVERY answering a newcomer; not answered back
 
 //==============================================================================
 // TYPE DEFINITIONS
@@ -36,12 +54,6 @@ enum class ESPNowState {
     OFF
 };
 
-enum class DeviceRole {
-    UNKNOWN,
-    INITIATOR,
-    RESPONDER
-};
-
 enum class ComState {
     NONE,
     WAITING,
@@ -53,7 +65,7 @@ enum class ComStatus {
     PAIRED
 };
 
-enum class ConversationType {
+enum class ConversationType : uint8_t {
     HELLO,
     QUESTION_01,
     QUESTION_02,
@@ -72,17 +84,49 @@ struct ConversationConfig {
     const char* gifPath;
 };
 
-struct Message {
-    uint32_t signature;
+enum class FrameType : uint8_t {
+    DISCOVERY,
+    EVENTS,
+    ACK
+};
+
+/**
+ * @brief Header of every ESP-NOW frame
+ * The sender's MAC comes with the ESP-NOW packet, so it is not repeated here.
+ */
+struct __attribute__((packed)) FrameHeader {
+    uint8_t version;    // ESPNOW_VERSION_BYTE
+    FrameType type;
+    uint8_t flags;      // FRAME_FLAG_*
+    uint8_t seq;        // EVENTS: per sender and receiver; DISCOVERY: per sender; an ACK echoes it
+};
+
+/**
+ * @brief ESP-NOW frame; only the header and the used payload bytes are sent
+ */
+struct __attribute__((packed)) Frame {
+    FrameHeader header;
+    uint8_t payload[ESPNOW_MAX_EVENTS]; // EVENTS: one ConversationType per byte
+};
+
+/**
+ * @brief Link statistics for one peer
+ */
+struct PeerLinkStats {
     uint8_t mac[6];
-    char text[32];
-    ConversationType type;
+    uint32_t framesSent;        // EVENTS frames, not counting retries
+    uint32_t framesAcked;
+    uint32_t retries;
+    uint32_t framesLost;        // Gave up after ESPNOW_MAX_RETRIES
+    uint32_t rttMs;             // Smoothed ACK round trip of first attempts
+    unsigned long lastHeard;    // millis() of the last frame from the peer
 };
 
 struct ComsInterval {
     static const unsigned long STATUS_INTERVAL = 6000;
     static const unsigned long MESSAGE_INTERVAL = 4000;
-    static const unsigned long DISCOVERY_INTERVAL = 1000;
+    static const unsigned long DISCOVERY_INTERVAL = 1000;       // First discovery backoff step
+    static const unsigned long DISCOVERY_MAX_INTERVAL = 32000;
     static const unsigned long TOGGLE_DEBOUNCE = 5000;
 };
 
@@ -104,10 +148,24 @@ bool startDiscovery();
 
 /**
  * @brief Check if device is paired with another device
- * @return true if paired and ESP-NOW is active
+ * @return true if at least one peer is paired and ESP-NOW is active
  */
 bool isPaired();
 
+/**
+ * @brief Get the number of paired peers
+ * @return Peers in the conversation, at most ESPNOW_MAX_PEERS
+ */
+size_t getPeerCount();
+
+/**
+ * @brief Copy the link statistics of the paired peers
+ * @param stats Receives one entry per peer
+ * @param maxPeers Capacity of stats
+ * @return Number of entries copied
+ */
+size_t getPeerLinkStats(PeerLinkStats* stats, size_t maxPeers);
+
 /**
  * @brief Restart ESP-NOW communication
  * @return true if restart successful
@@ -116,6 +174,9 @@ bool restartCommunication();
 
 /**
  * @brief Shut down ESP-NOW communication
+ *
+ * Leaves the conversation animation to the main loop, which may be drawing
+ * it; call resetAnimationPath() from there once the shutdown has finished.
  */
 void shutdownCommunication();
 
@@ -125,7 +186,17 @@ void shutdownCommunication();
 void handleCommunication();
 
 /**
- * @brief Force disconnect from current peer
+ * @brief Light-sleep between discovery listen windows while the device is idle
+ *
+ * Only while unpaired and the motion module reports sleep. The radio is
+ * stopped until the next beacon is due; motion wakes the device early and
+ * restarts discovery at its shortest interval. Call from the main loop in
+ * ESP_MODE once the frame has been drawn.
+ */
+void handleDiscoveryPowerSave();
+
+/**
+ * @brief Force disconnect from all peers
  */
 void forceDisconnect();
 
@@ -140,6 +211,13 @@ void resetAnimationPath();
  */
 const char* getCurrentAnimationPath();
 
+/**
+ * @brief Mark the conversation animation as played
+ * Call once the PROCESSING animation has been shown; the next received
+ * event is only taken off the queue after this.
+ */
+void finishConversationAnimation();
+
 /**
  * @brief Get current ESP-NOW state
  * @return Current ESP-NOW state (ON/OFF)
@@ -74,4 +74,11 @@ bool loadGIF(const char *filename);
  */
 int playGIFFrame(bool bSync, int *delayMilliseconds);
 
+/**
+ * @brief Get the number of frames drawn since boot
+ * @return Frame counter (wraps); the difference between two reads is the
+ *         number of frames drawn in between
+ */
+uint32_t getGIFFrameCount();
+
 #endif /* GIF_MODULE_H */
\ No newline at end of file
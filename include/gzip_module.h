@@ -0,0 +1,96 @@
+/**
+ * @file gzip_module.h
+ * @brief Streaming gzip decompression for compressed update images
+ *
+ * Compressed images (.gz) are inflated as they arrive over HTTP or serial
+ * and handed to an output callback in window-sized pieces, so the full
+ * uncompressed image never has to be held in memory. Inflation uses the
+ * ROM miniz inflater with a single 32 KB circular window; the gzip CRC32
+ * and length trailer are checked before the update may be finalized.
+ */
+
+#ifndef GZIP_MODULE_H
+#define GZIP_MODULE_H
+
+#include "common.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *GZIP_LOG = "::GZIP_MODULE::";
+
+#define GZIP_MAGIC_0 0x1F
+#define GZIP_MAGIC_1 0x8B
+#define GZIP_METHOD_DEFLATE 8
+#define GZIP_HEADER_SIZE 10
+#define GZIP_TRAILER_SIZE 8
+
+// Header flag bits (RFC 1952)
+#define GZIP_FLAG_HCRC 0x02
+#define GZIP_FLAG_EXTRA 0x04
+#define GZIP_FLAG_NAME 0x08
+#define GZIP_FLAG_COMMENT 0x10
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Receives decompressed data
+ * @param data Decompressed bytes (valid only for the duration of the call)
+ * @param length Number of bytes
+ * @return false to stop decompression
+ */
+typedef bool (*gzip_output_t)(const uint8_t *data, size_t length);
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Start a decompression session
+ * @param output Callback receiving the decompressed stream
+ * @return true if the inflater and window buffer were allocated
+ */
+bool gzipStream_begin(gzip_output_t output);
+
+/**
+ * @brief Feed the next chunk of compressed data
+ * @param data Compressed bytes
+ * @param length Number of bytes
+ * @return false if the data is corrupt or the output callback failed
+ */
+bool gzipStream_write(const uint8_t *data, size_t length);
+
+/**
+ * @brief Check the gzip trailer and release the session buffers
+ * @return true if the stream ended cleanly with a matching CRC32 and size
+ */
+bool gzipStream_end();
+
+/**
+ * @brief Abort the session and release its buffers
+ */
+void gzipStream_abort();
+
+/**
+ * @brief Check if a decompression session is in progress
+ * @return true between gzipStream_begin and end/abort
+ */
+bool gzipStream_isActive();
+
+/**
+ * @brief Get the number of decompressed bytes produced so far
+ * @return Decompressed size
+ */
+size_t gzipStream_outputSize();
+
+/**
+ * @brief Get a description of the last decompression error
+ * @return Error message, or NULL if the session failed because the output
+ *         callback rejected data (the receiver holds the real error)
+ */
+const char *gzipStream_errorString();
+
+#endif /* GZIP_MODULE_H */
@@ -0,0 +1,213 @@
+/**
+ * @file http_module.h
+ * @brief Event-driven HTTP server on top of esp_http_server
+ *
+ * Handlers run in the server's own task instead of being pumped from the
+ * main loop, so web latency no longer depends on how long a GIF frame or a
+ * sound takes. Several sockets stay open at once; files are sent in chunks
+ * straight from LittleFS and uploads are streamed to the caller without
+ * buffering the request body. WebSocket endpoints let other tasks push
+ * frames to every connected client.
+ */
+
+#ifndef HTTP_MODULE_H
+#define HTTP_MODULE_H
+
+#include "common.h"
+#include "flash_module.h"
+#include <esp_http_server.h>
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *HTTP_LOG = "::HTTP_MODULE::";
+
+#define HTTP_MAX_ROUTES 24
+#define HTTP_MAX_OPEN_SOCKETS 7
+#define HTTP_SERVER_STACK 8192
+#define HTTP_RECV_TIMEOUT_S 10
+#define HTTP_RECV_RETRIES 3
+#define HTTP_CHUNK_SIZE 4096   // File send and upload receive buffer
+#define HTTP_BOUNDARY_MAX 72   // RFC 2046 limit on multipart boundaries
+#define HTTP_HEADER_MAX 128
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef esp_err_t (*http_handler_t)(httpd_req_t *req);
+
+/**
+ * @brief Called once when the file part of an upload starts
+ * @param req Request being received (query arguments, content length)
+ * @param filename File name from the multipart headers, or the "filename"
+ *                 query argument for a raw body
+ * @return false to reject the upload
+ */
+typedef bool (*http_upload_begin_t)(httpd_req_t *req, const char *filename);
+
+/**
+ * @brief Called with each run of file bytes, in order
+ * @return false to stop receiving
+ */
+typedef bool (*http_upload_write_t)(const uint8_t *data, size_t length);
+
+/**
+ * @brief Called with each line of a text body, without the line ending
+ * @return false to stop receiving
+ */
+typedef bool (*http_line_t)(const char *line, size_t length, void *context);
+
+//==============================================================================
+// SERVER MANAGEMENT API
+//==============================================================================
+
+/**
+ * @brief Register a route; takes effect immediately if the server is running
+ * @param uri Exact request path (must stay valid, e.g. a string literal)
+ * @param method HTTP method
+ * @param handler Request handler
+ * @param context Passed to the handler as req->user_ctx
+ * @return false if the route table is full
+ */
+bool httpServer_on(const char *uri, httpd_method_t method, http_handler_t handler, void *context = NULL);
+
+/**
+ * @brief Start the server task and register all routes
+ * @param port TCP port
+ * @return true if the server is running
+ */
+bool httpServer_start(uint16_t port);
+
+/**
+ * @brief Stop the server task and clear the route table
+ * Must not be called from a handler
+ */
+void httpServer_stop();
+
+/**
+ * @brief Check whether the server is running
+ */
+bool httpServer_isRunning();
+
+//==============================================================================
+// RESPONSE API
+//==============================================================================
+
+/**
+ * @brief Send a complete response
+ * @param req Request
+ * @param status HTTP status code
+ * @param contentType MIME type, or NULL for an empty body
+ * @param body Response body
+ * @param length Body length
+ */
+esp_err_t httpServer_send(httpd_req_t *req, int status, const char *contentType, const char *body, size_t length);
+
+/**
+ * @brief Send a JSON response
+ */
+esp_err_t httpServer_sendJson(httpd_req_t *req, int status, const String &json);
+
+/**
+ * @brief Send a plain text response
+ */
+esp_err_t httpServer_sendText(httpd_req_t *req, int status, const char *text);
+
+/**
+ * @brief Stream a file as a chunked response
+ * Adds Content-Encoding: gzip for ".gz" files
+ * @param req Request
+ * @param file Open file, read from its current position
+ * @param contentType MIME type of the uncompressed content
+ */
+esp_err_t httpServer_sendFile(httpd_req_t *req, File &file, const char *contentType);
+
+//==============================================================================
+// REQUEST API
+//==============================================================================
+
+/**
+ * @brief Read a request header
+ * @return false if the header is missing or does not fit
+ */
+bool httpServer_header(httpd_req_t *req, const char *name, char *value, size_t size);
+
+/**
+ * @brief Read and URL-decode a query string argument
+ * @return false if the argument is missing or does not fit
+ */
+bool httpServer_queryArg(httpd_req_t *req, const char *name, char *value, size_t size);
+
+/**
+ * @brief Read and URL-decode an argument from a form-encoded body
+ * @param form Body read with httpServer_readBody()
+ * @return false if the argument is missing or does not fit
+ */
+bool httpServer_formArg(const char *form, const char *name, char *value, size_t size);
+
+/**
+ * @brief Read a small request body into a terminated buffer
+ * @return Body length, or -1 if it does not fit or the connection failed
+ */
+int httpServer_readBody(httpd_req_t *req, char *buffer, size_t size);
+
+/**
+ * @brief Receive a text body line by line
+ * @return ESP_OK, ESP_ERR_TIMEOUT if the connection failed,
+ *         ESP_ERR_INVALID_SIZE for a line over HTTP_CHUNK_SIZE, or ESP_FAIL
+ *         if the callback stopped
+ */
+esp_err_t httpServer_receiveLines(httpd_req_t *req, http_line_t onLine, void *context);
+
+/**
+ * @brief Receive an upload, multipart/form-data or raw body
+ * Only the first file part of a multipart body is delivered.
+ * @return ESP_OK once the whole file was delivered, ESP_ERR_TIMEOUT if the
+ *         connection failed, ESP_ERR_INVALID_ARG for a malformed body or one
+ *         without a file, or ESP_FAIL if a callback rejected the upload
+ */
+esp_err_t httpServer_receiveUpload(httpd_req_t *req, http_upload_begin_t begin, http_upload_write_t write);
+
+//==============================================================================
+// WEBSOCKET API
+//==============================================================================
+
+/**
+ * @brief Register a WebSocket endpoint
+ * The handler runs once after the handshake (req->method == HTTP_GET) and
+ * then for each data frame, which it must read with httpServer_receiveFrame().
+ * Needs CONFIG_HTTPD_WS_SUPPORT in the ESP-IDF configuration.
+ * @return false if WebSockets are unavailable or the route table is full
+ */
+bool httpServer_onWebSocket(const char *uri, http_handler_t handler, void *context = NULL);
+
+/**
+ * @brief Read the data frame a WebSocket handler was called for
+ * @param req Request passed to the handler
+ * @param buffer Receives the payload
+ * @param size Buffer size
+ * @return Payload length, or -1 if it does not fit or the read failed
+ */
+int httpServer_receiveFrame(httpd_req_t *req, uint8_t *buffer, size_t size);
+
+/**
+ * @brief Send a binary frame to the client of a WebSocket handler
+ */
+esp_err_t httpServer_sendFrame(httpd_req_t *req, const uint8_t *data, size_t length);
+
+/**
+ * @brief Send a binary frame to every WebSocket client
+ * Safe to call from any task: the payload is copied and sent from the
+ * server task.
+ * @return false if the server is not running or no memory is available
+ */
+bool httpServer_broadcast(const uint8_t *data, size_t length);
+
+/**
+ * @brief Count the connected WebSocket clients
+ */
+size_t httpServer_webSocketClients();
+
+#endif /* HTTP_MODULE_H */
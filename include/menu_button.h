@@ -34,4 +34,16 @@ bool menuButton_checkLongPress(unsigned long longPressTime = MENU_LONG_PRESS_TIM
  */
 void menuButton_reset();
 
+/**
+ * @brief Let a press of the button end the next light sleep
+ * Call menuButton_disableWakeup() once the device is awake again.
+ */
+void menuButton_enableWakeup();
+
+/**
+ * @brief Restore the button interrupt after a light sleep
+ * A press that woke the device is picked up as the start of a click.
+ */
+void menuButton_disableWakeup();
+
 #endif /* MENU_BUTTON_H */
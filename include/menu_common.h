@@ -32,6 +32,11 @@
 #define MENU_ITEM_X_OFFSET 3
 #define MENU_PADDING 6
 
+// Smooth scrolling (hardware start line) - set to 0 to jump by whole items
+#define MENU_SMOOTH_SCROLL 1
+#define MENU_SCROLL_STEP_PX 2
+#define MENU_SCROLL_FRAME_MS 16
+
 // Menu labels
 #define MENU_LABEL_MAIN "SETTINGS"
 #define MENU_LABEL_THEMES "THEMES"
@@ -74,10 +79,12 @@
 #define MENU_LABEL_PIXELATE "PIXELATE"
 #define MENU_LABEL_SCANLINES "SCANLINES"
 #define MENU_LABEL_GLITCH "GLITCH"
+#define MENU_LABEL_PRESETS "PRESETS"
 
 // Settings menu labels
 #define MENU_LABEL_AUDIO "AUDIO"
 #define MENU_LABEL_HAPTIC "HAPTIC"
+#define MENU_LABEL_QUICK_BOOT "QUICK BOOT"
 #define MENU_LABEL_CLEAR_EFFECTS "CLEAR EFFECTS"
 
 // Toggle action labels
@@ -8,6 +8,12 @@
 
 #include "menu_common.h"
 
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *MENU_DISPLAY_LOG = "::MENU_DISPLAY::";
+
 //==============================================================================
 // PUBLIC API
 //==============================================================================
@@ -48,4 +54,10 @@ void menuDisplay_drawItem(int index, const MenuItem* item, bool selected);
  */
 void menuDisplay_forceRedraw();
 
+/**
+ * @brief Restore the hardware scroll position for direct drawing
+ * Call before actions that may draw to the display outside the menu
+ */
+void menuDisplay_resetScroll();
+
 #endif /* MENU_DISPLAY_H */
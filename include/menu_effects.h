@@ -30,6 +30,25 @@ int menuEffects_getItemCount();
  */
 void menuEffects_getContext(MenuContext* context);
 
+/**
+ * @brief Get the preset submenu items
+ * @return Pointer to preset menu array
+ */
+MenuItem* menuPresets_getItems();
+
+/**
+ * @brief Get the preset submenu context, listing the stored presets by name
+ * @param context Pointer to context to populate
+ */
+void menuPresets_getContext(MenuContext* context);
+
+/**
+ * @brief Find the preset slot a menu item selects
+ * @param item Menu item to check
+ * @return Slot index, or -1 if the item is not a preset action
+ */
+int menuPresets_getSlot(const MenuItem* item);
+
 /**
  * @brief Initialize effects module
  */
@@ -75,6 +75,7 @@ bool detectInactivity(uint8_t samples);
 
 /**
  * @brief Handle entry into deep sleep mode
+ * Deferred until a state transition in flight has finished
  */
 void handleDeepSleep(void);
 
@@ -97,6 +98,13 @@ bool checkMotionState(MotionStateType state);
  */
 void resetMotionState();
 
+/**
+ * @brief Collect the motion states raised since the previous call
+ * Safe to call from another task; each event is reported once
+ * @return Bit mask indexed by MotionStateType
+ */
+uint32_t takeMotionEvents();
+
 /**
  * @brief Monitor and update haptics power state based on device activity
  * @param samples Number of samples to analyze for activity detection
@@ -8,7 +8,7 @@
 
 #include "common.h"
 #include "flash_module.h"
-#include <WebServer.h>
+#include "http_module.h"
 #include <Update.h>
 #include <esp_ota_ops.h>
 
@@ -22,9 +22,20 @@
 
 #define FIRMWARE_BIN "byte90.bin"
 #define FILESYSTEM_BIN "byte90animations.bin"
+#define FIRMWARE_PATCH "byte90.patch" // Delta against the running firmware (tools/make_delta.py)
 
 static const char* OTA_LOG = "::OTA_MODULE::";
 
+// Upload pipeline: HTTP handler -> ring buffer -> flash writer task
+#define OTA_RING_BUFFER_SIZE (64 * 1024)
+#define OTA_WRITE_CHUNK_SIZE 4096
+#define OTA_WRITER_STACK 4096
+#define OTA_WRITER_PRIORITY 2
+#define OTA_WRITER_CORE 0
+#define OTA_SEND_TIMEOUT_MS 5000
+#define OTA_DRAIN_TIMEOUT_MS 10000
+#define OTA_RESTART_DELAY_MS 1000 // Lets the success response reach the browser
+
 //==============================================================================
 // TYPE DEFINITIONS
 //==============================================================================
@@ -42,7 +53,6 @@ enum class OTAState {
 // EXTERNAL VARIABLES
 //==============================================================================
 
-extern WebServer webServer;
 extern OTAState otaState;
 extern String otaMessage;
 
@@ -62,8 +72,15 @@ bool initOTA();
 void setupOTAEndpoints();
 
 /**
- * @brief Handle the file upload process for OTA updates
+ * @brief Receive an uploaded update (POST /update) and reply with the result
+ * @param req Update request
+ */
+esp_err_t handleFileUpload(httpd_req_t *req);
+
+/**
+ * @brief Restart the device once a successful update has been reported
+ * Call regularly from the main loop while in Update Mode
  */
-void handleFileUpload();
+void handleOTA();
 
 #endif /* OTA_MODULE_H */
\ No newline at end of file
@@ -4,6 +4,11 @@
  *
  * Provides functionality for persistent storage and retrieval of system preferences,
  * user settings, WiFi credentials, and configuration data using ESP32 NVS (Non-Volatile Storage).
+ *
+ * Settings are held in RAM and committed as one NVS blob: setters only mark
+ * the settings dirty, handlePreferences() writes them once they settle, and
+ * flushPreferences() must run before a restart, and savePreferencesForSleep()
+ * before deep sleep so the wake can restore the settings without NVS.
  */
 
 #ifndef PREFERENCES_MODULE_H
@@ -11,6 +16,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 //==============================================================================
 // CONSTANTS & DEFINITIONS
@@ -22,6 +28,15 @@ static const char *PREFERENCES_LOG = "::PREFERENCES_MODULE::";
 #define WIFI_SSID_MAX_LEN 32
 #define WIFI_PASSWORD_MAX_LEN 64
 
+// Commit once settings have been unchanged this long...
+#define PREFERENCES_COMMIT_DELAY_MS 2000
+// ...but never hold a change back longer than this
+#define PREFERENCES_COMMIT_MAX_DELAY_MS 10000
+
+// Room reserved for the serialized effect chain
+#define PREFERENCES_EFFECT_PRESET_MAX 96
+#define PREFERENCES_PRESET_SLOTS 8
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -31,6 +46,23 @@ static const char *PREFERENCES_LOG = "::PREFERENCES_MODULE::";
  */
 void initPreferencesManager();
 
+/**
+ * @brief Commits pending changes once they have settled - call from the main loop
+ */
+void handlePreferences();
+
+/**
+ * @brief Commits pending changes immediately
+ * @return true if nothing is left uncommitted
+ */
+bool flushPreferences();
+
+/**
+ * @brief Commits pending changes and keeps the settings in RTC memory
+ * Call right before deep sleep; the wake restores them without reading NVS.
+ */
+void savePreferencesForSleep();
+
 /**
  * @brief Saves WiFi credentials to persistent storage
  * @param ssid WiFi network SSID
@@ -65,6 +97,19 @@ bool getWiFiModeEnabled();
  */
 bool setWiFiModeEnabled(bool enabled);
 
+/**
+ * @brief Gets whether warm boots skip the startup sequence
+ * @return true if quick boot is enabled, false otherwise
+ */
+bool getQuickBootEnabled();
+
+/**
+ * @brief Sets whether warm boots skip the startup sequence
+ * @param enabled true to enable quick boot, false to disable
+ * @return true if state saved successfully, false otherwise
+ */
+bool setQuickBootEnabled(bool enabled);
+
 /**
  * @brief Saves the startup mode to persistent storage
  * @param mode Startup mode value to save
@@ -269,6 +314,40 @@ float getTintIntensity();
  */
 bool setTintIntensity(float intensity);
 
+/**
+ * @brief Stores the serialized effect chain
+ * @param preset Preset bytes, opaque to this module
+ * @param length Preset length, at most PREFERENCES_EFFECT_PRESET_MAX
+ * @return true if the preset will be persisted, false otherwise
+ */
+bool saveEffectPreset(const void* preset, size_t length);
+
+/**
+ * @brief Copies the stored effect chain
+ * @param preset Buffer to receive the preset bytes
+ * @param size Buffer size
+ * @return Preset length, or 0 if none is stored or it does not fit
+ */
+size_t loadEffectPreset(void* preset, size_t size);
+
+/**
+ * @brief Stores a preset in the bank
+ * @param slot Bank slot (0 to PREFERENCES_PRESET_SLOTS - 1)
+ * @param preset Preset bytes, opaque to this module
+ * @param length Preset length, at most PREFERENCES_EFFECT_PRESET_MAX
+ * @return true if the preset will be persisted, false otherwise
+ */
+bool saveEffectPresetSlot(uint8_t slot, const void* preset, size_t length);
+
+/**
+ * @brief Copies a preset from the bank
+ * @param slot Bank slot (0 to PREFERENCES_PRESET_SLOTS - 1)
+ * @param preset Buffer to receive the preset bytes
+ * @param size Buffer size
+ * @return Preset length, or 0 if the slot is empty or does not fit
+ */
+size_t loadEffectPresetSlot(uint8_t slot, void* preset, size_t size);
+
 /**
  * @brief Gets the current clock enabled state
  * @return true if clock is enabled, false otherwise
@@ -18,6 +18,9 @@ static const char* SERIAL_LOG = "::SERIAL_MODULE::";
 
 #define SERIAL_BAUD_RATE 921600
 #define SERIAL_COMMAND_BUFFER_SIZE 4096
+#define SERIAL_RX_BUFFER_SIZE 16384
+#define SERIAL_JSON_BUFFER_SIZE 128
+#define SERIAL_COMMAND_BUCKETS 32
 
 #define CMD_GET_INFO "GET_INFO"
 #define CMD_GET_STATUS "GET_STATUS"
@@ -25,10 +28,15 @@ static const char* SERIAL_LOG = "::SERIAL_MODULE::";
 #define CMD_SEND_CHUNK "SEND_CHUNK"
 #define CMD_FINISH_UPDATE "FINISH_UPDATE"
 #define CMD_ABORT_UPDATE "ABORT_UPDATE"
+#define CMD_START_BINARY_UPDATE "START_BINARY_UPDATE"
+#define CMD_START_ASSET "START_ASSET"
+#define CMD_ASSET_CHECK "ASSET_CHECK"
 #define CMD_RESTART "RESTART"
 #define CMD_GET_LOGS "GET_LOGS"
 #define CMD_GET_PREFERENCES "GET_PREFERENCES"
 #define CMD_RESET_PREFERENCES "RESET_PREFERENCES"
+#define CMD_SELECT_PRESET "SELECT_PRESET"
+#define CMD_STORE_PRESET "STORE_PRESET"
 
 // WiFi Configuration Commands
 #define CMD_WIFI_SCAN "WIFI_SCAN"
@@ -38,9 +46,35 @@ static const char* SERIAL_LOG = "::SERIAL_MODULE::";
 #define CMD_WIFI_GET_SAVED "WIFI_GET_SAVED"
 #define CMD_WIFI_FORGET "WIFI_FORGET"
 
+// Utility Commands
+#define CMD_VERBOSE "VERBOSE"
+
 #define RESP_OK "OK:"
 #define RESP_ERROR "ERROR:"
 #define RESP_PROGRESS "PROGRESS:"
+#define RESP_NOTIFY "NOTIFY:"
+#define RESP_ACK "ACK:"
+#define RESP_NAK "NAK:"
+
+// Binary framed update protocol (entered with START_BINARY_UPDATE:size,type[,gzip])
+// Frame: [magic][type][seq u16 LE][length u16 LE][payload][crc32 u32 LE]
+// CRC32 (IEEE) covers type through the end of the payload
+#define SERIAL_FRAME_MAGIC 0xB9
+#define SERIAL_FRAME_HEADER_SIZE 6
+#define SERIAL_FRAME_CRC_SIZE 4
+#define SERIAL_FRAME_MAX_PAYLOAD 2048
+#define SERIAL_FRAME_WINDOW 4
+#define SERIAL_FRAME_POOL_SIZE (SERIAL_FRAME_WINDOW + 2)
+#define SERIAL_FRAME_GAP_TIMEOUT_MS 250
+#define SERIAL_FRAME_IDLE_TIMEOUT_MS 10000
+#define SERIAL_FRAME_DRAIN_TIMEOUT_MS 5000
+#define SERIAL_FRAME_READ_BUDGET 8192
+#define SERIAL_FRAME_WRITER_STACK 4096
+#define SERIAL_FRAME_WRITER_PRIORITY 2
+
+#define SERIAL_FRAME_DATA 0x01
+#define SERIAL_FRAME_END 0x02
+#define SERIAL_FRAME_ABORT 0x03
 
 //==============================================================================
 // TYPE DEFINITIONS
@@ -54,16 +88,18 @@ enum class SerialUpdateState {
   ERROR
 };
 
+// Points into the fixed command line buffer; valid until the next line
 struct SerialCommand {
-  String command;
-  String data;
+  const char *command;
+  const char *data;
+  size_t dataLength;
 };
 
 struct UpdateProgress {
   size_t totalSize;
   size_t receivedSize;
   int percentage;
-  String message;
+  const char *message;
 };
 
 //==============================================================================
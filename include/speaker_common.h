@@ -18,6 +18,11 @@
 #define I2S_SAMPLE_RATE 44100
 #define I2S_BITS_PER_SAMPLE I2S_BITS_PER_SAMPLE_24BIT
 #define I2S_CHANNEL_FORMAT I2S_CHANNEL_FMT_ONLY_LEFT
+#define I2S_DMA_BUF_COUNT 2
+#define I2S_DMA_BUF_LEN 64
+
+// Audio queued in the beep DMA buffers; a longer gap between writes plays silence
+#define I2S_DMA_BUFFER_US ((I2S_DMA_BUF_COUNT * I2S_DMA_BUF_LEN * 1000000UL) / I2S_SAMPLE_RATE)
 
 // I2S Pin Configuration (shared between speaker_module and speaker_mp3)
 #define I2S_BCK_IO A3
@@ -34,6 +39,7 @@
 // MP3 Configuration (from speaker_mp3)
 #define MP3_DEFAULT_VOLUME 1
 #define SOUNDS_FOLDER "/sounds/"
+#define MP3_SERVICE_GAP_MS 100 // Decoder starved if mp3Loop() is this late
 
 //==============================================================================
 // TYPE DEFINITIONS
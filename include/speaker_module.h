@@ -65,6 +65,14 @@ void playBeep(uint16_t frequency, uint16_t duration, uint8_t volume);
 
 // MP3 functions moved to speaker_mp3.h
 
+/**
+ * @brief Get the number of audio underruns since boot
+ * Counts beep writes that came after the DMA buffers ran dry and MP3
+ * decoder service gaps over MP3_SERVICE_GAP_MS
+ * @return Underrun counter (wraps)
+ */
+uint32_t getAudioUnderrunCount(void);
+
 /**
  * @brief Audio loop function for core speaker operations
  */
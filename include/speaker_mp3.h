@@ -104,6 +104,13 @@ String getCurrentMP3File();
  */
 void mp3Loop();
 
+/**
+ * @brief Get the number of times playback went unserviced for longer
+ * than MP3_SERVICE_GAP_MS
+ * @return Counter since boot (wraps)
+ */
+uint32_t getMP3UnderrunCount();
+
 //==============================================================================
 // UTILITY FUNCTIONS
 //==============================================================================
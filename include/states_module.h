@@ -17,6 +17,11 @@
 
 static const char *STATES_LOG = "::STATES_MODULE::";
 
+#define STATES_WORKER_STACK 4096
+#define STATES_WORKER_PRIORITY 1
+#define STATES_WORKER_CORE 0          // Radio core; the animation keeps core 1
+#define STATES_TRANSITION_HISTORY 8   // Transition timings kept for diagnostics
+
 /**
  * @brief System state enumeration defining all possible device operating modes
  */
@@ -28,6 +33,16 @@ enum SystemState {
     CLOCK_MODE      ///< Temporary time synchronization mode
 };
 
+/**
+ * @brief Timing of one completed state transition
+ */
+typedef struct {
+    SystemState from;
+    SystemState to;
+    uint32_t radioUs;   ///< Exit and enter actions on the transition worker
+    uint32_t totalUs;   ///< Request to completion, including the display update
+} state_transition_record_t;
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -44,19 +59,30 @@ void initSystemStateManager();
 void updateSystemStateMachine();
 
 /**
- * @brief Transitions the system to a new state
+ * @brief Starts a transition to a new state
  * @param newState The target state to transition to
+ * @return true if the transition passed its guards and was started
+ *
+ * The radio work of leaving the old state and entering the new one runs on
+ * a worker task; updateSystemStateMachine() finishes the transition on the
+ * main loop. Only one transition can be in flight at a time.
+ */
+bool transitionToState(SystemState newState);
+
+/**
+ * @brief Checks whether a transition is still in flight
+ * @return true from transitionToState() until the main loop has finished it
  */
-void transitionToState(SystemState newState);
+bool isStateTransitioning();
 
 /**
- * @brief Handles cleanup and exit logic for a specific state
+ * @brief Runs the exit actions of a state on the calling task
  * @param state The state to exit from
  */
 void exitState(SystemState state);
 
 /**
- * @brief Handles initialization and entry logic for a specific state
+ * @brief Runs the enter actions of a state on the calling task
  * @param state The state to enter
  */
 void enterState(SystemState state);
@@ -64,9 +90,20 @@ void enterState(SystemState state);
 /**
  * @brief Gets the current system state
  * @return Current SystemState value
+ *
+ * While a transition is in flight this is the old state until its exit
+ * actions have run, then the new one; see isStateTransitioning().
  */
 SystemState getCurrentState();
 
+/**
+ * @brief Copies the most recent transition timings
+ * @param records Receives the records, newest first
+ * @param maxRecords Capacity of records
+ * @return Number of records copied
+ */
+size_t getStateTransitionHistory(state_transition_record_t* records, size_t maxRecords);
+
 /**
  * @brief Gets the startup state that should be used on system boot
  * @return Startup SystemState value
@@ -0,0 +1,81 @@
+/**
+ * @file telemetry_module.h
+ * @brief Live device telemetry pushed to the web dashboard
+ *
+ * A low-priority task samples frame rate, effect cost, memory, motion events,
+ * audio underruns and WiFi signal once per interval into a ring buffer and
+ * broadcasts each sample to every client of the /telemetry WebSocket. A new
+ * client first receives the samples already in the ring.
+ */
+
+#ifndef TELEMETRY_MODULE_H
+#define TELEMETRY_MODULE_H
+
+#include "common.h"
+#include "effects_common.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+static const char *TELEMETRY_LOG = "::TELEMETRY_MODULE::";
+
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_INTERVAL_MS 1000
+#define TELEMETRY_HISTORY 60 // Samples kept for new subscribers
+#define TELEMETRY_STACK 3072
+#define TELEMETRY_PRIORITY 1 // Just above idle
+#define TELEMETRY_CORE 0
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief One telemetry sample, sent as-is (little-endian) in binary frames
+ * A frame carries one or more consecutive samples.
+ */
+typedef struct __attribute__((packed)) {
+  uint8_t version;          // TELEMETRY_VERSION
+  uint8_t effectCount;      // Entries in effectLoad (EFFECT_COUNT)
+  uint16_t sequence;        // Increments per sample
+  uint32_t uptime;          // Milliseconds since boot
+  uint16_t fps;             // Frames per second x100
+  uint16_t motionEvents;    // Bit per MotionStateType raised in the interval
+  uint32_t heapFree;        // Internal RAM free
+  uint32_t heapMinFree;     // Internal RAM low-water mark
+  uint32_t psramFree;
+  uint16_t audioUnderruns;  // Underruns in the interval
+  int8_t rssi;              // Station RSSI in dBm, 0 when not connected
+  uint8_t reserved;
+  uint16_t effectLoad[EFFECT_COUNT]; // Time in each effect, 0.01% of the interval
+} telemetry_sample_t;
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Start the sampler task
+ * @return true if the task is running
+ */
+bool telemetry_start();
+
+/**
+ * @brief Stop the sampler task; the ring keeps its samples
+ */
+void telemetry_stop();
+
+/**
+ * @brief Copy the most recent sample
+ * @param sample Receives the sample
+ * @return false if nothing has been sampled yet
+ */
+bool telemetry_latest(telemetry_sample_t *sample);
+
+/**
+ * @brief Register the /telemetry WebSocket endpoint
+ */
+void setupTelemetryEndpoints();
+
+#endif /* TELEMETRY_MODULE_H */
@@ -7,7 +7,7 @@
 #define WIFI_ENDPOINTS_H
 
 #include "common.h"
-#include <WebServer.h>
+#include "http_module.h"
 #include <WiFi.h>
 #include "wifi_common.h"
 
@@ -22,8 +22,9 @@
 bool initWiFiEndpoints();
 
 /**
- * @brief Handle web server client requests
- * Should be called regularly in main loop when web server is active
+ * @brief Service background web work (connect jobs, post-update restart)
+ * Should be called regularly in main loop when web server is active;
+ * requests themselves are handled by the HTTP server task
  */
 void handleWebServer();
 
@@ -32,15 +33,39 @@ void handleWebServer();
  */
 void stopWiFiEndpoints();
 
+/**
+ * @brief Start the read-only web server and the telemetry sampler for WiFi mode
+ * @return true if the web server is running
+ */
+bool initStationEndpoints();
+
+/**
+ * @brief Stop the telemetry sampler and the web server started for WiFi mode
+ */
+void stopStationEndpoints();
+
+/**
+ * @brief Forget the cached ETags of the web UI files
+ * Call after replacing any of them on LittleFS
+ */
+void invalidateStaticAssetCache();
+
 //==============================================================================
 // ENDPOINT SETUP FUNCTIONS
 //==============================================================================
 
 /**
- * @brief Set up the root endpoint for the configuration portal
+ * @brief Set up the root endpoint and the web UI files (/styles.css, /script.js)
+ * Serves pre-compressed ".gz" variants with ETag and Cache-Control headers
  */
 void setupRootEndpoint();
 
+/**
+ * @brief Set up the read-only endpoints for WiFi mode
+ * Web UI files, /status and /telemetry; nothing that changes the device
+ */
+void setupStationEndpoints();
+
 /**
  * @brief Set up the restart endpoint (/restart)
  */
@@ -53,7 +78,8 @@ void setupWebEndpoints();
 
 /**
  * @brief Set up the network scan endpoint (/scan)
- * Returns JSON with available networks and their signal strengths
+ * Returns JSON with available networks and their signal strengths; answers
+ * 202 while a background scan is still running
  */
 void setupScanEndpoint();
 
@@ -64,8 +90,9 @@ void setupScanEndpoint();
 void setupConnectionStatusEndpoint();
 
 /**
- * @brief Set up the connect endpoint (/connect)
- * Handles POST requests to connect to a specific network
+ * @brief Set up the connect endpoints (/connect, /connect/status)
+ * POST /connect starts a background connect job and returns its id;
+ * GET /connect/status?job=<id> reports its progress
  */
 void setupConnectEndpoint();
 
@@ -98,6 +125,8 @@ String createJsonResponse(bool success, const String& ssid, int rssi, const Stri
 
 /**
  * @brief Scan for available WiFi networks and return formatted JSON
+ * Blocks only when no recent scan results are cached; a background scan
+ * already running is waited for instead of starting another
  * @return JSON string with scan results including SSID, RSSI, and signal strength
  */
 String scanWiFiNetworks();
@@ -108,14 +137,4 @@ String scanWiFiNetworks();
  */
 String getWiFiStatusJson();
 
-//==============================================================================
-// WEB SERVER INTEGRATION
-//==============================================================================
-
-/**
- * @brief Get the web server instance for endpoint integration
- * @return Reference to the web server instance
- */
-WebServer& getWiFiWebServer();
-
 #endif /* WIFI_ENDPOINTS_H */
@@ -11,6 +11,7 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include "preferences_module.h"
 
 //==============================================================================
 // CONSTANTS & DEFINITIONS
@@ -18,6 +19,32 @@
 
 static const char *WIFI_LOG = "::WIFI_MODULE::";
 
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Progress of a connect job started from the configuration portal
+ */
+typedef enum {
+  WIFI_JOB_NONE,
+  WIFI_JOB_PENDING,
+  WIFI_JOB_CONNECTED,
+  WIFI_JOB_FAILED
+} wifi_job_state_t;
+
+/**
+ * @brief Snapshot of a connect job
+ */
+typedef struct {
+  uint32_t id;
+  wifi_job_state_t state;
+  char ssid[WIFI_SSID_MAX_LEN];
+  uint8_t attempt;       // Current attempt, 1-based
+  uint8_t reason;        // Last disconnect reason, 0 if none
+  unsigned long elapsed; // Milliseconds since the job started
+} wifi_connect_job_t;
+
 //==============================================================================
 // GLOBAL VARIABLES
 //==============================================================================
@@ -80,6 +107,51 @@ bool connectToWiFiFromPreferences();
  */
 void disconnectFromWiFi();
 
+/**
+ * @brief Disconnect from the current network on the main loop
+ * Safe to call from other tasks (e.g. a web handler); handleWebServer()
+ * performs the disconnect.
+ * @param timeoutMs How long to wait for the main loop
+ * @return false if the main loop did not get to it in time
+ */
+bool requestWiFiDisconnect(uint32_t timeoutMs);
+
+/**
+ * @brief Start connecting to a network in the background
+ * Safe to call from other tasks: this only records the job, and
+ * handleWebServer() starts the attempt, retries it and saves the
+ * credentials once connected. Supersedes any earlier job.
+ * @param ssid WiFi network SSID
+ * @param password WiFi network password
+ * @return Job id, or 0 if the credentials are invalid
+ */
+uint32_t startWiFiConnectJob(const char* ssid, const char* password);
+
+/**
+ * @brief Get the progress of a connect job
+ * @param id Job id returned by startWiFiConnectJob()
+ * @param job Receives the job snapshot
+ * @return false if the id is unknown or was superseded by a newer job
+ */
+bool getWiFiConnectJob(uint32_t id, wifi_connect_job_t* job);
+
+/**
+ * @brief Converts a connect job state to a string
+ * @param state Job state
+ * @return "pending", "connected", "failed" or "none"
+ */
+const char* getWiFiJobStateString(wifi_job_state_t state);
+
+/**
+ * @brief Starts the web interface and telemetry on the station interface
+ */
+void startStationWebServer();
+
+/**
+ * @brief Stops the web interface started by startStationWebServer()
+ */
+void stopStationWebServer();
+
 /**
  * @brief Starts WiFi Access Point mode
  */
@@ -7,6 +7,7 @@
  */
 
 #include "adxl_module.h"
+#include "boot_module.h"
 #include "i2c_module.h"
 #include "common.h"
 #include <stdarg.h>
@@ -282,11 +283,33 @@ void enterDeepSleep() {
 
   adxlDebug("Entering deep sleep mode...");
   clearInterrupts();
+  boot_prepareForSleep();
   delay(100);
   adxlDebug("Starting ESP32 deep sleep");
   esp_deep_sleep_start();
 }
 
+/**
+ * @brief Light-sleeps the ESP with the ADXL345 and a timer as wake-up sources
+ * Wake-up sources the caller enabled (e.g. the menu button) also end it.
+ * @param durationMs Longest time to sleep
+ * @return true if motion woke the device
+ */
+bool enterLightSleep(uint32_t durationMs) {
+  if (!ADXL345Enabled) {
+    adxlDebug("Skipping light sleep - ADXL345 not enabled");
+    return false;
+  }
+
+  // The ext0 wake-up set up for deep sleep also ends a light sleep
+  clearInterrupts();
+  esp_sleep_enable_timer_wakeup((uint64_t)durationMs * 1000);
+  esp_light_sleep_start();
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+
+  return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT0;
+}
+
 /**
  * @brief Initializes and configures the ADXL345 accelerometer
  * @return true if initialization successful, false otherwise
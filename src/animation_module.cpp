@@ -424,8 +424,8 @@ void playEmotes() {
         int soundDelay = getCurrentConversationSoundDelay(convType);
         sfxPlay(soundType, soundDelay);
         playGIF(getCurrentAnimationPath());
-
       }
+      finishConversationAnimation();
       break;
     case ComState::WAITING:
       playGIF(COMS_IDLE_EMOTE);
@@ -449,4 +449,25 @@ void playBootAnimation() {
     pulseVibration(100, 1200);
   }
   playGIF(STARTUP_EMOTE);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Capture the position of the emote sequence
+ * @param position Receives the position
+ */
+void getAnimationPosition(AnimationPosition *position) {
+  position->sequenceState = animSequence.currentState;
+  position->isIdleMode = animSequence.isIdleMode;
+  position->asleep = wasAsleep;
+}
+
+/**
+ * @brief Continue the emote sequence from a captured position
+ * @param position Position from getAnimationPosition()
+ */
+void restoreAnimationPosition(const AnimationPosition *position) {
+  animSequence.currentState = position->sequenceState;
+  animSequence.isIdleMode = position->isIdleMode;
+  animSequence.stateStartTime = millis();
+  wasAsleep = position->asleep;
+}
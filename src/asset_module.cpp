@@ -0,0 +1,453 @@
+/**
+ * @file asset_module.cpp
+ * @brief Implementation of file-level LittleFS asset sync
+ *
+ * This module handles:
+ * - Parsing and validating manifest entries
+ * - Comparing manifest entries against the files on LittleFS
+ * - Receiving files into temporary siblings and renaming them into place
+ * - The HTTP diff and upload endpoints
+ */
+
+#include "asset_module.h"
+#include "http_module.h"
+#include "wifi_endpoints.h"
+#include <mbedtls/sha256.h>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef struct {
+  bool active;
+  asset_entry_t entry;
+  char tempPath[ASSET_PATH_MAX + sizeof(ASSET_TEMP_SUFFIX)];
+  File file;
+  size_t written;
+  mbedtls_sha256_context sha;
+  const char *error;
+} asset_transfer_t;
+
+// Progress of a streamed POST /assets/diff
+typedef struct {
+  size_t checked;
+  size_t changedCount;
+  String changed;
+} asset_diff_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static asset_transfer_t transfer = {};
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Record an error for assetSync_errorString
+ * @param message Error description
+ * @return Always false
+ */
+static bool failAsset(const char *message) {
+  ESP_LOGE(ASSET_LOG, "%s", message);
+  transfer.error = message;
+  return false;
+}
+
+/**
+ * @brief Check that a path is safe to write and to embed in JSON
+ * @param path Absolute LittleFS path
+ * @return true if the path is allowed
+ */
+static bool isValidAssetPath(const char *path) {
+  size_t length = strlen(path);
+  if (length < 2 || path[0] != '/' || path[length - 1] == '/') {
+    return false;
+  }
+  if (strstr(path, "..") || strstr(path, "//")) {
+    return false;
+  }
+  if (length > strlen(ASSET_TEMP_SUFFIX) &&
+      strcmp(path + length - strlen(ASSET_TEMP_SUFFIX), ASSET_TEMP_SUFFIX) == 0) {
+    return false;
+  }
+  for (const char *c = path; *c; c++) {
+    if (*c < 0x20 || *c == '"' || *c == '\\' || *c == ',') {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Decode a hex SHA-256 digest
+ * @param text Hex characters
+ * @param length Number of characters
+ * @param hash Receives ASSET_HASH_SIZE bytes
+ * @return true if the digest is exactly 64 hex digits
+ */
+static bool parseHash(const char *text, size_t length, uint8_t *hash) {
+  if (length != ASSET_HASH_SIZE * 2) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    char c = tolower(text[i]);
+    uint8_t nibble;
+    if (c >= '0' && c <= '9') {
+      nibble = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      nibble = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    hash[i / 2] = (i & 1) ? (hash[i / 2] | nibble) : (nibble << 4);
+  }
+  return true;
+}
+
+/**
+ * @brief Hash a file on LittleFS
+ * @param path File path
+ * @param hash Receives ASSET_HASH_SIZE bytes
+ * @return true if the file could be read
+ *
+ * Runs on the HTTP server task (/assets/diff) and the main loop (serial
+ * ASSET_CHECK), so the read buffer lives on the caller's stack.
+ */
+static bool hashFile(const char *path, uint8_t *hash) {
+  File file = LittleFS.open(path, "r");
+  if (!file || file.isDirectory()) {
+    return false;
+  }
+
+  uint8_t readBuffer[ASSET_READ_BUFFER_SIZE];
+  mbedtls_sha256_context sha;
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+  size_t length;
+  while ((length = file.read(readBuffer, sizeof(readBuffer))) > 0) {
+    mbedtls_sha256_update(&sha, readBuffer, length);
+  }
+  mbedtls_sha256_finish(&sha, hash);
+  mbedtls_sha256_free(&sha);
+  file.close();
+  return true;
+}
+
+/**
+ * @brief Create the parent directories of a path
+ * @param path File path
+ * @return true if every parent directory exists
+ */
+static bool ensureParentDirectories(const char *path) {
+  char directory[ASSET_PATH_MAX + 1];
+  for (const char *slash = strchr(path + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+    size_t length = slash - path;
+    memcpy(directory, path, length);
+    directory[length] = '\0';
+    if (!LittleFS.exists(directory) && !LittleFS.mkdir(directory)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Close and delete the temporary file of the current transfer
+ */
+static void discardTempFile() {
+  if (transfer.file) {
+    transfer.file.close();
+  }
+  if (transfer.tempPath[0] && LittleFS.exists(transfer.tempPath)) {
+    LittleFS.remove(transfer.tempPath);
+  }
+}
+
+//==============================================================================
+// HTTP ENDPOINT HANDLERS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Send a small JSON status response
+ * @param req Request
+ * @param code HTTP status code
+ * @param success Whether the operation succeeded
+ * @param message Status message (no characters that need escaping)
+ */
+static esp_err_t sendAssetResponse(httpd_req_t *req, int code, bool success, const char *message) {
+  String response;
+  response.reserve(48 + strlen(message));
+  response += "{\"success\":";
+  response += success ? "true" : "false";
+  response += ",\"message\":\"";
+  response += message;
+  response += "\"}";
+  return httpServer_sendJson(req, code, response);
+}
+
+/**
+ * @brief Check one manifest line of POST /assets/diff
+ * @param line Entry text, without the line ending
+ * @param length Length of the entry
+ * @param context asset_diff_t of the request
+ * @return false if the entry is malformed
+ */
+static bool diffManifestLine(const char *line, size_t length, void *context) {
+  asset_diff_t *diff = (asset_diff_t *)context;
+  if (length == 0) {
+    return true;
+  }
+
+  asset_entry_t entry;
+  if (!assetSync_parseEntry(line, length, &entry)) {
+    return false;
+  }
+  diff->checked++;
+  if (!assetSync_isCurrent(&entry)) {
+    diff->changed += diff->changedCount++ ? ",\"" : "\"";
+    diff->changed += entry.path;
+    diff->changed += "\"";
+  }
+  return true;
+}
+
+/**
+ * @brief Handle POST /assets/diff - reply with the manifest entries that differ
+ *
+ * The request body is the manifest, one "size,sha256,path" entry per line.
+ * It is checked as it arrives rather than buffered whole.
+ */
+static esp_err_t handleAssetDiff(httpd_req_t *req) {
+  asset_diff_t diff = {};
+  diff.changed.reserve(256);
+  diff.changed += "[";
+
+  esp_err_t result = httpServer_receiveLines(req, diffManifestLine, &diff);
+  if (result == ESP_ERR_TIMEOUT) {
+    return sendAssetResponse(req, 400, false, "Manifest was not received");
+  }
+  if (result != ESP_OK) {
+    return sendAssetResponse(req, 400, false, "Invalid manifest entry");
+  }
+  diff.changed += "]";
+
+  char counts[48];
+  snprintf(counts, sizeof(counts), ",\"checked\":%u,\"changed_count\":%u",
+           (unsigned)diff.checked, (unsigned)diff.changedCount);
+
+  String response;
+  response.reserve(diff.changed.length() + 64);
+  response += "{\"success\":true";
+  response += counts;
+  response += ",\"changed\":";
+  response += diff.changed;
+  response += "}";
+  return httpServer_sendJson(req, 200, response);
+}
+
+/**
+ * @brief Open the temporary file for POST /assets/upload?entry=size,sha256,path
+ * @param req Upload request
+ * @param filename Uploaded file name (the entry decides the path)
+ * @return true if the file should be received
+ */
+static bool beginAssetUpload(httpd_req_t *req, const char *filename) {
+  char spec[ASSET_PATH_MAX + ASSET_HASH_SIZE * 2 + 24];
+  asset_entry_t entry;
+  if (!httpServer_queryArg(req, "entry", spec, sizeof(spec)) ||
+      !assetSync_parseEntry(spec, strlen(spec), &entry)) {
+    assetSync_abort();
+    return failAsset("Invalid asset entry");
+  }
+  return assetSync_begin(&entry);
+}
+
+/**
+ * @brief Append received bytes to the temporary file
+ * @return false once the transfer has failed
+ */
+static bool writeAssetUpload(const uint8_t *data, size_t length) {
+  if (!assetSync_write(data, length)) {
+    assetSync_abort();
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Handle POST /assets/upload - receive one asset and reply with the result
+ */
+static esp_err_t handleAssetUpload(httpd_req_t *req) {
+  transfer.error = NULL;
+  esp_err_t result = httpServer_receiveUpload(req, beginAssetUpload, writeAssetUpload);
+
+  if (result == ESP_OK) {
+    assetSync_end();
+  } else if (transfer.active) {
+    assetSync_abort();
+    failAsset(result == ESP_ERR_TIMEOUT ? "Upload aborted" : "Malformed upload");
+  } else if (!transfer.error) {
+    failAsset("No file in upload");
+  }
+
+  if (transfer.error) {
+    return sendAssetResponse(req, 500, false, transfer.error);
+  }
+  return sendAssetResponse(req, 200, true, "Asset saved");
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+bool assetSync_parseEntry(const char *text, size_t length, asset_entry_t *entry) {
+  const char *end = text + length;
+  const char *comma = (const char *)memchr(text, ',', length);
+  if (!comma || comma == text) {
+    return false;
+  }
+
+  char *sizeEnd;
+  unsigned long size = strtoul(text, &sizeEnd, 10);
+  if (sizeEnd != comma) {
+    return false;
+  }
+
+  const char *hash = comma + 1;
+  comma = (const char *)memchr(hash, ',', end - hash);
+  if (!comma || !parseHash(hash, comma - hash, entry->hash)) {
+    return false;
+  }
+
+  const char *path = comma + 1;
+  size_t pathLength = end - path;
+  if (pathLength == 0 || pathLength > ASSET_PATH_MAX) {
+    return false;
+  }
+  memcpy(entry->path, path, pathLength);
+  entry->path[pathLength] = '\0';
+  entry->size = size;
+
+  return isValidAssetPath(entry->path);
+}
+
+bool assetSync_isCurrent(const asset_entry_t *entry) {
+  File file = LittleFS.open(entry->path, "r");
+  if (!file || file.isDirectory()) {
+    return false;
+  }
+  size_t size = file.size();
+  file.close();
+
+  // Size is free to check; only hash files that could still match
+  uint8_t hash[ASSET_HASH_SIZE];
+  return size == entry->size && hashFile(entry->path, hash) &&
+         memcmp(hash, entry->hash, ASSET_HASH_SIZE) == 0;
+}
+
+bool assetSync_begin(const asset_entry_t *entry) {
+  assetSync_abort();
+  transfer.error = NULL;
+
+  if (!getFSStatus()) {
+    return failAsset("Filesystem not mounted");
+  }
+
+  // The old copy stays until the rename, so both must fit at once
+  if (entry->size > LittleFS.totalBytes() - LittleFS.usedBytes()) {
+    return failAsset("Not enough space for asset");
+  }
+
+  transfer.entry = *entry;
+  snprintf(transfer.tempPath, sizeof(transfer.tempPath), "%s" ASSET_TEMP_SUFFIX, entry->path);
+
+  if (!ensureParentDirectories(entry->path)) {
+    transfer.tempPath[0] = '\0';
+    return failAsset("Failed to create asset directory");
+  }
+
+  transfer.file = LittleFS.open(transfer.tempPath, "w");
+  if (!transfer.file) {
+    transfer.tempPath[0] = '\0';
+    return failAsset("Failed to create temporary file");
+  }
+
+  mbedtls_sha256_init(&transfer.sha);
+  mbedtls_sha256_starts(&transfer.sha, 0);
+  transfer.written = 0;
+  transfer.active = true;
+  ESP_LOGI(ASSET_LOG, "Receiving %s (%u bytes)", entry->path, (unsigned)entry->size);
+  return true;
+}
+
+bool assetSync_write(const uint8_t *data, size_t length) {
+  if (!transfer.active) {
+    return failAsset("No asset transfer in progress");
+  }
+  if (length > transfer.entry.size - transfer.written) {
+    return failAsset("Asset data exceeds announced size");
+  }
+  if (transfer.file.write(data, length) != length) {
+    return failAsset("Asset write failed");
+  }
+
+  mbedtls_sha256_update(&transfer.sha, data, length);
+  transfer.written += length;
+  return true;
+}
+
+bool assetSync_end() {
+  if (!transfer.active) {
+    return failAsset("No asset transfer in progress");
+  }
+
+  uint8_t hash[ASSET_HASH_SIZE];
+  mbedtls_sha256_finish(&transfer.sha, hash);
+  transfer.file.close();
+
+  bool valid = false;
+  if (transfer.written != transfer.entry.size) {
+    failAsset("Asset size mismatch");
+  } else if (memcmp(hash, transfer.entry.hash, ASSET_HASH_SIZE) != 0) {
+    failAsset("Asset hash mismatch");
+  } else if (!LittleFS.rename(transfer.tempPath, transfer.entry.path)) {
+    // LittleFS renames over an existing file atomically; fall back to
+    // remove + rename if the VFS layer refuses
+    if (!LittleFS.remove(transfer.entry.path) || !LittleFS.rename(transfer.tempPath, transfer.entry.path)) {
+      failAsset("Failed to move asset into place");
+    } else {
+      valid = true;
+    }
+  } else {
+    valid = true;
+  }
+
+  if (valid) {
+    ESP_LOGI(ASSET_LOG, "Updated %s", transfer.entry.path);
+    transfer.tempPath[0] = '\0';
+    invalidateStaticAssetCache();
+  }
+  assetSync_abort();
+  return valid;
+}
+
+void assetSync_abort() {
+  if (transfer.active) {
+    mbedtls_sha256_free(&transfer.sha);
+    transfer.active = false;
+  }
+  discardTempFile();
+  transfer.tempPath[0] = '\0';
+}
+
+const char *assetSync_errorString() {
+  return transfer.error ? transfer.error : "No error";
+}
+
+void setupAssetEndpoints() {
+  httpServer_on("/assets/diff", HTTP_POST, handleAssetDiff);
+  httpServer_on("/assets/upload", HTTP_POST, handleAssetUpload);
+}
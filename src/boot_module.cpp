@@ -0,0 +1,340 @@
+/**
+ * @file boot_module.cpp
+ * @brief Implementation of the boot timeline and stage runner
+ *
+ * This module handles:
+ * - Recording timed sections and marks on the boot timeline
+ * - Running stage tables with dependency ordering across tasks
+ * - Printing the timeline over serial
+ * - The resume record kept in RTC memory for quick boots and deep-sleep wakes
+ */
+
+#include "boot_module.h"
+#include "animation_module.h"
+#include "effects_core.h"
+#include "preferences_module.h"
+#include "states_module.h"
+#include <esp_rom_crc.h>
+#include <esp_sleep.h>
+#include <freertos/event_groups.h>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef enum {
+  BOOT_ENTRY_RUNNING,
+  BOOT_ENTRY_OK,
+  BOOT_ENTRY_FAILED,
+  BOOT_ENTRY_SKIPPED,
+  BOOT_ENTRY_MARK
+} boot_entry_state_t;
+
+typedef struct {
+  const char *name;
+  uint32_t start; // Microseconds since power-on
+  uint32_t end;
+  uint8_t core;
+  boot_entry_state_t state;
+  uint32_t stackFree; // Stack high-water mark of a parallel stage's task; 0 otherwise
+} boot_entry_t;
+
+/**
+ * @brief State carried across warm boots
+ * RTC_NOINIT memory holds garbage after power-on, hence the magic and CRC.
+ */
+typedef struct {
+  uint32_t magic;
+  uint8_t version;
+  uint8_t state;  // SystemState running when last saved
+  uint8_t flags;  // BOOT_RESUME_SLEEP once the fields below are captured
+  int8_t preset;  // Active effect preset slot, or -1
+  effect_preset_t effects;
+  AnimationPosition animation;
+  uint32_t crc; // CRC32 of the fields above
+} boot_resume_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static boot_entry_t timeline[BOOT_TIMELINE_MAX];
+static size_t timelineCount = 0;
+static portMUX_TYPE timelineLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Stage table being run; stage tasks get their index as the task parameter
+static const boot_stage_t *runningStages = NULL;
+static StaticEventGroup_t stageEventsBuffer;
+static EventGroupHandle_t stageEvents = NULL; // Bit set when a stage finishes
+static volatile uint32_t failedStages = 0;    // Required stages that did not succeed
+
+#define BOOT_RESUME_SLEEP (1 << 0)
+
+// Record written by this run, and the one left by the previous run
+static RTC_NOINIT_ATTR boot_resume_t resume;
+static boot_resume_t previous;
+static bool previousChecked = false;
+static bool previousValid = false;
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Append a timeline entry
+ * @return Entry index, or -1 if the timeline is full
+ */
+static int addEntry(const char *name, boot_entry_state_t state) {
+  uint32_t now = esp_timer_get_time();
+  int entry = -1;
+
+  portENTER_CRITICAL(&timelineLock);
+  if (timelineCount < BOOT_TIMELINE_MAX) {
+    entry = timelineCount++;
+    timeline[entry] = {name, now, now, (uint8_t)xPortGetCoreID(), state, 0};
+  }
+  portEXIT_CRITICAL(&timelineLock);
+  return entry;
+}
+
+static const char *getEntryStateString(boot_entry_state_t state) {
+  switch (state) {
+  case BOOT_ENTRY_RUNNING:
+    return "running";
+  case BOOT_ENTRY_OK:
+    return "ok";
+  case BOOT_ENTRY_FAILED:
+    return "failed";
+  case BOOT_ENTRY_SKIPPED:
+    return "skipped";
+  default:
+    return "";
+  }
+}
+
+/**
+ * @brief Run one stage once its dependencies have finished
+ * @param index Stage index in runningStages
+ * @return Timeline entry of the stage, or -1 if it was skipped or the timeline is full
+ */
+static int runStage(uint8_t index) {
+  const boot_stage_t &stage = runningStages[index];
+  bool ok = false;
+  int entry = -1;
+
+  EventBits_t finished = stage.dependsOn
+                             ? xEventGroupWaitBits(stageEvents, stage.dependsOn, pdFALSE, pdTRUE,
+                                                   pdMS_TO_TICKS(BOOT_STAGE_TIMEOUT_MS))
+                             : 0;
+
+  if ((finished & stage.dependsOn) != stage.dependsOn) {
+    ESP_LOGE(BOOT_LOG, "%s: timed out waiting for dependencies", stage.name);
+    addEntry(stage.name, BOOT_ENTRY_SKIPPED);
+  } else if (failedStages & stage.dependsOn) {
+    ESP_LOGW(BOOT_LOG, "%s: skipped, a dependency failed", stage.name);
+    addEntry(stage.name, BOOT_ENTRY_SKIPPED);
+  } else {
+    entry = boot_beginStage(stage.name);
+    ok = stage.init();
+    boot_endStage(entry, ok);
+
+    if (!ok && stage.required) {
+      ESP_LOGE(BOOT_LOG, "%s initialization failed", stage.name);
+    } else if (!ok) {
+      ESP_LOGW(BOOT_LOG, "%s initialization skipped (not supported)", stage.name);
+    }
+  }
+
+  if (!ok && stage.required) {
+    portENTER_CRITICAL(&timelineLock);
+    failedStages |= BOOT_STAGE_BIT(index);
+    portEXIT_CRITICAL(&timelineLock);
+  }
+  xEventGroupSetBits(stageEvents, BOOT_STAGE_BIT(index));
+  return entry;
+}
+
+/**
+ * @brief Task running one parallel stage
+ * @param parameter Stage index
+ * Records how close the stage came to its stack size.
+ */
+static void stageTaskFunction(void *parameter) {
+  int entry = runStage((uint8_t)(uintptr_t)parameter);
+
+  if (entry >= 0) {
+    UBaseType_t stackFree = uxTaskGetStackHighWaterMark(NULL);
+    portENTER_CRITICAL(&timelineLock);
+    timeline[entry].stackFree = stackFree;
+    portEXIT_CRITICAL(&timelineLock);
+  }
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief CRC of the resume record, excluding the CRC itself
+ */
+static uint32_t resumeCrc(const boot_resume_t *record) {
+  return esp_rom_crc32_le(0, (const uint8_t *)record, offsetof(boot_resume_t, crc));
+}
+
+/**
+ * @brief Take the previous run's resume record before this run overwrites it
+ * @return true if it is valid; it is only meaningful after a warm start
+ */
+static bool loadPreviousResume() {
+  if (!previousChecked) {
+    previousChecked = true;
+    previous = resume;
+    previousValid = boot_isWarmStart() && previous.magic == BOOT_RESUME_MAGIC &&
+                    previous.version == BOOT_RESUME_VERSION && previous.crc == resumeCrc(&previous);
+  }
+  return previousValid;
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+bool boot_runStages(const boot_stage_t *stages, size_t count) {
+  if (!stages || count == 0 || count > BOOT_MAX_STAGES) {
+    ESP_LOGE(BOOT_LOG, "Invalid stage table");
+    return false;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    if (stages[i].dependsOn & ~(BOOT_STAGE_BIT(i) - 1)) {
+      ESP_LOGE(BOOT_LOG, "%s depends on a later stage", stages[i].name);
+      return false;
+    }
+  }
+
+  if (!stageEvents) {
+    stageEvents = xEventGroupCreateStatic(&stageEventsBuffer);
+  }
+  xEventGroupClearBits(stageEvents, BOOT_STAGE_BIT(BOOT_MAX_STAGES) - 1);
+  failedStages = 0;
+  runningStages = stages;
+
+  // Start every parallel stage; each waits for its own dependencies
+  for (size_t i = 0; i < count; i++) {
+    if (!stages[i].parallel) {
+      continue;
+    }
+    uint32_t stackSize = stages[i].stackSize ? stages[i].stackSize : BOOT_STAGE_STACK;
+    if (xTaskCreatePinnedToCore(stageTaskFunction, stages[i].name, stackSize, (void *)(uintptr_t)i,
+                                BOOT_STAGE_PRIORITY, NULL, tskNO_AFFINITY) != pdPASS) {
+      ESP_LOGW(BOOT_LOG, "No task for %s, running it inline", stages[i].name);
+      runStage(i);
+    }
+  }
+
+  // Dependencies only point backwards, so running in table order cannot deadlock
+  for (size_t i = 0; i < count; i++) {
+    if (!stages[i].parallel) {
+      runStage(i);
+    }
+  }
+
+  uint32_t all = BOOT_STAGE_BIT(count) - 1;
+  EventBits_t finished = xEventGroupWaitBits(stageEvents, all, pdFALSE, pdTRUE, pdMS_TO_TICKS(BOOT_STAGE_TIMEOUT_MS));
+  if ((finished & all) != all) {
+    ESP_LOGE(BOOT_LOG, "Boot stages did not finish in time");
+    return false;
+  }
+
+  return failedStages == 0;
+}
+
+int boot_beginStage(const char *name) { return addEntry(name, BOOT_ENTRY_RUNNING); }
+
+void boot_endStage(int entry, bool ok) {
+  if (entry < 0) {
+    return;
+  }
+
+  uint32_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&timelineLock);
+  timeline[entry].end = now;
+  timeline[entry].state = ok ? BOOT_ENTRY_OK : BOOT_ENTRY_FAILED;
+  portEXIT_CRITICAL(&timelineLock);
+}
+
+void boot_mark(const char *name) { addEntry(name, BOOT_ENTRY_MARK); }
+
+void boot_printTimeline() {
+  boot_entry_t entries[BOOT_TIMELINE_MAX];
+
+  portENTER_CRITICAL(&timelineLock);
+  size_t count = timelineCount;
+  memcpy(entries, timeline, count * sizeof(boot_entry_t));
+  portEXIT_CRITICAL(&timelineLock);
+
+  ESP_LOGI(BOOT_LOG, "Boot timeline (ms since power-on), reset reason %d, wake cause %d%s:", esp_reset_reason(),
+           esp_sleep_get_wakeup_cause(), boot_isQuickBoot() ? ", quick boot" : "");
+  for (size_t i = 0; i < count; i++) {
+    const boot_entry_t &entry = entries[i];
+    if (entry.state == BOOT_ENTRY_MARK) {
+      ESP_LOGI(BOOT_LOG, "  %7.1f            -- %s", entry.start / 1000.0f, entry.name);
+    } else if (entry.stackFree) {
+      ESP_LOGI(BOOT_LOG, "  %7.1f +%7.1f  core %u  %-16s %-8s stack %u free", entry.start / 1000.0f,
+               (entry.end - entry.start) / 1000.0f, entry.core, entry.name, getEntryStateString(entry.state),
+               (unsigned)entry.stackFree);
+    } else {
+      ESP_LOGI(BOOT_LOG, "  %7.1f +%7.1f  core %u  %-16s %s", entry.start / 1000.0f,
+               (entry.end - entry.start) / 1000.0f, entry.core, entry.name, getEntryStateString(entry.state));
+    }
+  }
+}
+
+bool boot_isWarmStart() {
+  esp_reset_reason_t reason = esp_reset_reason();
+  return reason == ESP_RST_SW || reason == ESP_RST_DEEPSLEEP;
+}
+
+bool boot_isQuickBoot() { return getQuickBootEnabled() && loadPreviousResume(); }
+
+void boot_saveResumeState(uint8_t state) {
+  loadPreviousResume();
+  resume.magic = BOOT_RESUME_MAGIC;
+  resume.version = BOOT_RESUME_VERSION;
+  resume.state = state;
+  resume.flags = 0; // Only the sleep that follows captures the rest
+  resume.crc = resumeCrc(&resume);
+}
+
+bool boot_loadResumeState(uint8_t *state) {
+  if (!loadPreviousResume()) {
+    return false;
+  }
+  *state = previous.state;
+  return true;
+}
+
+void boot_prepareForSleep() {
+  boot_saveResumeState((uint8_t)getCurrentState());
+  effectsCore_capturePreset(&resume.effects);
+  resume.preset = effectsCore_getActivePreset();
+  getAnimationPosition(&resume.animation);
+  resume.flags |= BOOT_RESUME_SLEEP;
+  resume.crc = resumeCrc(&resume);
+
+  savePreferencesForSleep();
+}
+
+bool boot_isSleepWake() {
+  return esp_reset_reason() == ESP_RST_DEEPSLEEP && loadPreviousResume() && (previous.flags & BOOT_RESUME_SLEEP);
+}
+
+bool boot_restoreAfterSleep() {
+  if (!boot_isSleepWake()) {
+    return false;
+  }
+
+  // A preset slot is already compiled; otherwise rebuild the chain
+  if (previous.preset < 0 || !effectsCore_selectPreset(previous.preset)) {
+    effectsCore_applyPreset(&previous.effects);
+  }
+  restoreAnimationPosition(&previous.animation);
+  return true;
+}
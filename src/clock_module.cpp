@@ -28,11 +28,42 @@ static uint8_t lastDisplayedHour = 255;
 static bool clockDisplayInitialized = false;
 
 // Flicker-free display tracking
-static char lastTimeStr[32] = "";
 static char lastAmpmStr[4] = "";
 static char lastDateStr[32] = "";
 static char lastDayStr[16] = "";
 
+// Digit glyph cache - time digits are pre-rasterized into fixed RGB565 cells
+// tinted for the current theme, so a tick only blits the cells that changed
+#define CLOCK_TIME_SLOTS 4
+#define CLOCK_GLYPH_COUNT 10
+#define CLOCK_GLYPH_BLANK 10
+#define CLOCK_GLYPH_UNSET -1
+
+static const uint8_t CLOCK_TIME_SCALE = 3;
+static const int16_t CLOCK_TIME_BASELINE_Y = 74;
+static const int16_t CLOCK_GLYPH_SPACING = 1; // Font pixels between cells, if they fit
+static const int16_t CLOCK_TIME_OFFSET_X = -6; // Centering nudge of the original text layout
+
+typedef struct {
+    uint16_t *digits;     // CLOCK_GLYPH_COUNT cells of cellWidth x cellHeight
+    uint16_t *colon;      // colonWidth x cellHeight
+    uint16_t color;       // Color the cells were rasterized with
+    int16_t cellWidth;
+    int16_t colonWidth;
+    int16_t cellHeight;
+    int16_t digitInkLeft; // Leftmost digit ink offset from cursor (scaled)
+    int16_t colonInkLeft; // Colon ink offset from cursor (scaled)
+    int16_t inkTop;       // Topmost ink offset from baseline (scaled)
+    int16_t top;
+    int16_t slotX[CLOCK_TIME_SLOTS];
+    int16_t colonX;
+    bool valid;
+} clock_glyph_cache_t;
+
+static clock_glyph_cache_t glyphCache = {nullptr, nullptr, 0, 0, 0, 0, 0, 0, 0, 0, {0}, 0, false};
+static int8_t lastDigits[CLOCK_TIME_SLOTS] = {CLOCK_GLYPH_UNSET, CLOCK_GLYPH_UNSET,
+                                              CLOCK_GLYPH_UNSET, CLOCK_GLYPH_UNSET};
+
 // String constants
 static const char *daysOfWeek[] = {
     "Sunday", "Monday", "Tuesday", "Wednesday", 
@@ -72,6 +103,200 @@ static bool dateTimeToStruct(const DateTime &dt, rtc_time_t *timeStruct) {
     return true;
 }
 
+/**
+ * @brief Derive fixed cell geometry for the time row from the clock font
+ *
+ * Cells are sized to the union of all digit ink boxes so every digit occupies
+ * the same slot, which keeps the layout stable and lets digits be replaced
+ * in place without clearing neighbours.
+ */
+static void computeGlyphLayout(void) {
+    const GFXfont *font = &FreeSansBold9pt7b;
+    int16_t minX = INT16_MAX, maxX = INT16_MIN;
+    int16_t minY = INT16_MAX, maxY = INT16_MIN;
+
+    for (char c = '0'; c <= '9'; c++) {
+        const GFXglyph *g = &font->glyph[c - font->first];
+        minX = min(minX, (int16_t)g->xOffset);
+        maxX = max(maxX, (int16_t)(g->xOffset + g->width));
+        minY = min(minY, (int16_t)g->yOffset);
+        maxY = max(maxY, (int16_t)(g->yOffset + g->height));
+    }
+
+    const GFXglyph *colon = &font->glyph[':' - font->first];
+    minY = min(minY, (int16_t)colon->yOffset);
+    maxY = max(maxY, (int16_t)(colon->yOffset + colon->height));
+
+    glyphCache.cellWidth = (maxX - minX) * CLOCK_TIME_SCALE;
+    glyphCache.colonWidth = colon->width * CLOCK_TIME_SCALE;
+    glyphCache.cellHeight = (maxY - minY) * CLOCK_TIME_SCALE;
+    glyphCache.digitInkLeft = minX * CLOCK_TIME_SCALE;
+    glyphCache.colonInkLeft = colon->xOffset * CLOCK_TIME_SCALE;
+    glyphCache.inkTop = minY * CLOCK_TIME_SCALE;
+    glyphCache.top = CLOCK_TIME_BASELINE_Y + glyphCache.inkTop;
+
+    // Layout: [H][H][:][M][M] centered horizontally. The ink union is wider
+    // than any single digit, so at larger scales the spacing shrinks (down to
+    // none) to keep the row on the panel; blitGlyphCell() clips any overhang.
+    int16_t inkWidth = (glyphCache.cellWidth * CLOCK_TIME_SLOTS) + glyphCache.colonWidth;
+    int16_t gap = constrain((DISPLAY_WIDTH - inkWidth) / CLOCK_TIME_SLOTS, 0, CLOCK_GLYPH_SPACING * CLOCK_TIME_SCALE);
+    int16_t totalWidth = inkWidth + (gap * CLOCK_TIME_SLOTS);
+    int16_t x = (DISPLAY_WIDTH - totalWidth) / 2 + CLOCK_TIME_OFFSET_X;
+    x = constrain(x, 0, max(0, DISPLAY_WIDTH - totalWidth));
+
+    glyphCache.slotX[0] = x;
+    glyphCache.slotX[1] = glyphCache.slotX[0] + glyphCache.cellWidth + gap;
+    glyphCache.colonX = glyphCache.slotX[1] + glyphCache.cellWidth + gap;
+    glyphCache.slotX[2] = glyphCache.colonX + glyphCache.colonWidth + gap;
+    glyphCache.slotX[3] = glyphCache.slotX[2] + glyphCache.cellWidth + gap;
+}
+
+/**
+ * @brief Rasterize a single character into an RGB565 cell
+ * @param c Character to rasterize
+ * @param inkLeft Ink offset from cursor so the glyph lands at column 0
+ * @param width Cell width in pixels
+ * @param color Glyph color
+ * @param dest Destination cell buffer (width x cellHeight pixels)
+ * @return true if rasterization succeeded
+ */
+static bool rasterizeGlyph(char c, int16_t inkLeft, int16_t width, uint16_t color, uint16_t *dest) {
+    GFXcanvas16 canvas(width, glyphCache.cellHeight);
+    if (!canvas.getBuffer()) {
+        return false;
+    }
+
+    canvas.fillScreen(COLOR_BLACK);
+    canvas.setFont(&FreeSansBold9pt7b);
+    canvas.setTextSize(CLOCK_TIME_SCALE);
+    canvas.setTextWrap(false);
+    canvas.setTextColor(color);
+    canvas.setCursor(-inkLeft, -glyphCache.inkTop);
+    canvas.write(c);
+
+    memcpy(dest, canvas.getBuffer(), (size_t)width * glyphCache.cellHeight * sizeof(uint16_t));
+    return true;
+}
+
+/**
+ * @brief Build (or rebuild) the digit glyph cache for a color
+ * @param color Glyph color to rasterize with
+ * @return true if the cache is ready
+ */
+static bool buildGlyphCache(uint16_t color) {
+    if (!glyphCache.digits) {
+        computeGlyphLayout();
+
+        size_t digitsSize = (size_t)glyphCache.cellWidth * glyphCache.cellHeight * CLOCK_GLYPH_COUNT * sizeof(uint16_t);
+        size_t colonSize = (size_t)glyphCache.colonWidth * glyphCache.cellHeight * sizeof(uint16_t);
+
+        glyphCache.digits = (uint16_t *)heap_caps_malloc(digitsSize, MALLOC_CAP_SPIRAM);
+        glyphCache.colon = (uint16_t *)heap_caps_malloc(colonSize, MALLOC_CAP_SPIRAM);
+        if (!glyphCache.digits || !glyphCache.colon) {
+            ESP_LOGE(CLOCK_LOG, "Failed to allocate clock glyph cache (%zu bytes)", digitsSize + colonSize);
+            heap_caps_free(glyphCache.digits);
+            heap_caps_free(glyphCache.colon);
+            glyphCache.digits = nullptr;
+            glyphCache.colon = nullptr;
+            glyphCache.valid = false;
+            return false;
+        }
+    }
+
+    size_t cellPixels = (size_t)glyphCache.cellWidth * glyphCache.cellHeight;
+    bool success = true;
+    for (int d = 0; d < CLOCK_GLYPH_COUNT; d++) {
+        success &= rasterizeGlyph('0' + d, glyphCache.digitInkLeft, glyphCache.cellWidth, color,
+                                  glyphCache.digits + (d * cellPixels));
+    }
+    success &= rasterizeGlyph(':', glyphCache.colonInkLeft, glyphCache.colonWidth, color, glyphCache.colon);
+
+    glyphCache.valid = success;
+    glyphCache.color = color;
+    if (!success) {
+        ESP_LOGE(CLOCK_LOG, "Failed to rasterize clock glyphs");
+    }
+    return success;
+}
+
+/**
+ * @brief Push a cached cell to the display in a single SPI transaction
+ * @param x Left edge of the cell
+ * @param pixels Cell pixel data
+ * @param width Cell width in pixels
+ *
+ * The address window bypasses GFX clipping, so columns past the right edge
+ * of the panel are dropped here instead of wrapping onto the next row.
+ */
+static void blitGlyphCell(int16_t x, const uint16_t *pixels, int16_t width) {
+    int16_t visibleWidth = min(width, (int16_t)(DISPLAY_WIDTH - x));
+    if (x < 0 || visibleWidth <= 0) {
+        return;
+    }
+
+    startWrite();
+    setAddrWindow(x, glyphCache.top, visibleWidth, glyphCache.cellHeight);
+    if (visibleWidth == width) {
+        writePixels((uint16_t *)pixels, (uint32_t)width * glyphCache.cellHeight);
+    } else {
+        for (int16_t row = 0; row < glyphCache.cellHeight; row++) {
+            writePixels((uint16_t *)pixels + ((size_t)row * width), visibleWidth);
+        }
+    }
+    endWrite();
+}
+
+/**
+ * @brief Draw the HH:MM digits, blitting only the cells that changed
+ * @param hour Hour in 12-hour format (1-12)
+ * @param minute Minute (0-59)
+ * @param color Digit color
+ */
+static void drawTimeDigits(uint8_t hour, uint8_t minute, uint16_t color) {
+    bool forceAll = (lastDigits[0] == CLOCK_GLYPH_UNSET);
+
+    if (!glyphCache.valid || glyphCache.color != color) {
+        if (!buildGlyphCache(color)) {
+            return;
+        }
+        forceAll = true;
+    }
+
+    int8_t digits[CLOCK_TIME_SLOTS] = {
+        (int8_t)(hour >= 10 ? hour / 10 : CLOCK_GLYPH_BLANK),
+        (int8_t)(hour % 10),
+        (int8_t)(minute / 10),
+        (int8_t)(minute % 10)
+    };
+
+    if (forceAll) {
+        blitGlyphCell(glyphCache.colonX, glyphCache.colon, glyphCache.colonWidth);
+    }
+
+    size_t cellPixels = (size_t)glyphCache.cellWidth * glyphCache.cellHeight;
+    for (int i = 0; i < CLOCK_TIME_SLOTS; i++) {
+        if (!forceAll && digits[i] == lastDigits[i]) {
+            continue;
+        }
+
+        if (digits[i] == CLOCK_GLYPH_BLANK) {
+            oled.fillRect(glyphCache.slotX[i], glyphCache.top, glyphCache.cellWidth, glyphCache.cellHeight, COLOR_BLACK);
+        } else {
+            blitGlyphCell(glyphCache.slotX[i], glyphCache.digits + (digits[i] * cellPixels), glyphCache.cellWidth);
+        }
+        lastDigits[i] = digits[i];
+    }
+}
+
+/**
+ * @brief Forget which digits are on screen so the next draw repaints all cells
+ */
+static void resetTimeDigits(void) {
+    for (int i = 0; i < CLOCK_TIME_SLOTS; i++) {
+        lastDigits[i] = CLOCK_GLYPH_UNSET;
+    }
+}
+
 /**
  * @brief Update RTC status based on current conditions
  * @return Updated rtc_state_t value
@@ -409,9 +634,6 @@ void drawDigitalClock(void) {
     }
     
     // Format current strings
-    char timeStr[32];
-    snprintf(timeStr, sizeof(timeStr), "%2d:%02d", displayHour, currentTime.minute);
-    
     char ampmStr[4];
     snprintf(ampmStr, sizeof(ampmStr), "%s", isPM ? "PM" : "AM");
     
@@ -450,7 +672,7 @@ void drawDigitalClock(void) {
         clearDisplay();
         clockDisplayInitialized = true;
         // Force update of all elements by clearing the "last" strings
-        strcpy(lastTimeStr, "");
+        resetTimeDigits();
         strcpy(lastAmpmStr, "");
         strcpy(lastDateStr, "");
         strcpy(lastDayStr, "");
@@ -459,33 +681,8 @@ void drawDigitalClock(void) {
     int16_t x1, y1;
     uint16_t w, h;
 
-    // Update time only if it changed
-    if (strcmp(timeStr, lastTimeStr) != 0) {
-        // Clear the old time area first (use larger area to ensure complete clearing)
-        oled.setFont(&FreeSansBold9pt7b);
-        oled.setTextSize(3);
-        
-        // Calculate bounds for old time string if it exists
-        if (strlen(lastTimeStr) > 0) {
-            oled.getTextBounds(lastTimeStr, 0, 0, &x1, &y1, &w, &h);
-            int oldTimeX = (DISPLAY_WIDTH - w) / 2 - 6;
-            int timeY = 74;
-            // Clear with extra margin to ensure complete erasure
-            oled.fillRect(oldTimeX - 5, timeY + y1 - 3, w + 15, h + 6, COLOR_BLACK);
-        }
-        
-        // Draw new time
-        oled.setTextWrap(false);
-        oled.setTextColor(primaryColor);
-        oled.getTextBounds(timeStr, 0, 0, &x1, &y1, &w, &h);
-        int timeX = (DISPLAY_WIDTH - w) / 2 - 6;
-        int timeY = 74;
-        
-        oled.setCursor(timeX, timeY);
-        oled.print(timeStr);
-        
-        strcpy(lastTimeStr, timeStr);
-    }
+    // Update time digits - only changed cells are pushed to the panel
+    drawTimeDigits(displayHour, currentTime.minute, primaryColor);
 
     // Update AM/PM only if it changed
     if (strcmp(ampmStr, lastAmpmStr) != 0) {
@@ -570,7 +767,7 @@ void resetClockDisplayState(void) {
     clockDisplayInitialized = false;
     lastDisplayedMinute = 255;
     lastDisplayedHour = 255;
-    strcpy(lastTimeStr, "");
+    resetTimeDigits();
     strcpy(lastAmpmStr, "");
     strcpy(lastDateStr, "");
     strcpy(lastDayStr, "");
@@ -113,18 +113,28 @@ bool checkHardwareSupport() {
  * @return String representation with appropriate unit
  */
 String formatBytes(size_t bytes) {
+  char buffer[16];
+  return String(formatBytes(bytes, buffer, sizeof(buffer)));
+}
+
+/**
+ * @brief Convert bytes to human-readable format into a caller buffer
+ * @param bytes Number of bytes to convert
+ * @param buffer Destination buffer
+ * @param bufferSize Size of the destination buffer
+ * @return Pointer to buffer
+ */
+const char *formatBytes(size_t bytes, char *buffer, size_t bufferSize) {
   if (bytes >= 1024 * 1024 * 1024) {
-    float gb = (float)bytes / (1024 * 1024 * 1024);
-    return String(gb, 1) + "GB";
+    snprintf(buffer, bufferSize, "%.1fGB", (float)bytes / (1024 * 1024 * 1024));
   } else if (bytes >= 1024 * 1024) {
-    float mb = (float)bytes / (1024 * 1024);
-    return String(mb, 1) + "MB";
+    snprintf(buffer, bufferSize, "%.1fMB", (float)bytes / (1024 * 1024));
   } else if (bytes >= 1024) {
-    float kb = (float)bytes / 1024;
-    return String(kb, 1) + "KB";
+    snprintf(buffer, bufferSize, "%.1fKB", (float)bytes / 1024);
   } else {
-    return String(bytes) + "B";
+    snprintf(buffer, bufferSize, "%uB", (unsigned)bytes);
   }
+  return buffer;
 }
 
 //==============================================================================
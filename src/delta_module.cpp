@@ -0,0 +1,355 @@
+/**
+ * @file delta_module.cpp
+ * @brief Implementation of streaming delta patch application
+ *
+ * This module handles:
+ * - Incremental parsing of the patch header and operation stream
+ * - Verifying the running image against the hash the patch was built for
+ * - Rebuilding the new image from running-partition reads and patch data
+ * - Hashing the rebuilt image before it is marked bootable
+ */
+
+#include "delta_module.h"
+#include <mbedtls/sha256.h>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef enum {
+  DELTA_STATE_IDLE,
+  DELTA_STATE_HEADER,
+  DELTA_STATE_OP,
+  DELTA_STATE_DATA,
+  DELTA_STATE_DONE,
+  DELTA_STATE_ERROR
+} delta_state_t;
+
+typedef struct {
+  delta_state_t state;
+  delta_header_t header;
+  delta_op_t op;
+  size_t filled;    // Bytes collected for the current header/op record
+  size_t opDone;    // Bytes of the current op already produced
+  size_t written;   // Bytes of the new image written so far
+  const esp_partition_t *source;
+  mbedtls_sha256_context sha;
+  bool hashing;     // sha holds a live context for the new image
+  const char *error;
+} delta_session_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static delta_session_t delta = {};
+static uint8_t workBuffer[DELTA_WORK_BUFFER_SIZE];
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Put the session into the error state
+ * @param message Error description
+ * @return Always false
+ */
+static bool failDelta(const char *message) {
+  ESP_LOGE(DELTA_LOG, "%s", message);
+  delta.error = message;
+  delta.state = DELTA_STATE_ERROR;
+  return false;
+}
+
+/**
+ * @brief Append bytes to the new image
+ * @param data Bytes to write
+ * @param length Number of bytes
+ * @return true if written to flash
+ */
+static bool emitBytes(const uint8_t *data, size_t length) {
+  mbedtls_sha256_update(&delta.sha, data, length);
+  if (Update.write((uint8_t *)data, length) != length) {
+    return failDelta("Flash write failed");
+  }
+  delta.written += length;
+  return true;
+}
+
+/**
+ * @brief Read a range of the running image
+ * @param offset Offset into the running partition
+ * @param buffer Destination buffer
+ * @param length Number of bytes
+ * @return true if the read succeeded
+ */
+static bool readSource(size_t offset, uint8_t *buffer, size_t length) {
+  if (esp_partition_read(delta.source, offset, buffer, length) != ESP_OK) {
+    return failDelta("Failed to read running partition");
+  }
+  return true;
+}
+
+/**
+ * @brief Check that the running image is the one the patch was built against
+ * @return true if the SHA-256 of the running image matches the header
+ */
+static bool verifySource() {
+  mbedtls_sha256_context sha;
+  uint8_t hash[DELTA_HASH_SIZE];
+
+  mbedtls_sha256_init(&sha);
+  mbedtls_sha256_starts(&sha, 0);
+  for (size_t offset = 0; offset < delta.header.oldSize; offset += DELTA_WORK_BUFFER_SIZE) {
+    size_t length = min((size_t)DELTA_WORK_BUFFER_SIZE, delta.header.oldSize - offset);
+    if (!readSource(offset, workBuffer, length)) {
+      mbedtls_sha256_free(&sha);
+      return false;
+    }
+    mbedtls_sha256_update(&sha, workBuffer, length);
+  }
+  mbedtls_sha256_finish(&sha, hash);
+  mbedtls_sha256_free(&sha);
+
+  if (memcmp(hash, delta.header.oldHash, DELTA_HASH_SIZE) != 0) {
+    return failDelta("Patch does not match the running firmware");
+  }
+  return true;
+}
+
+/**
+ * @brief Validate the completed header and open the target partition
+ * @return true if the patch can be applied
+ */
+static bool processHeader() {
+  const delta_header_t *header = &delta.header;
+
+  if (memcmp(header->magic, DELTA_MAGIC, sizeof(header->magic)) != 0) {
+    return failDelta("Not a BYTE-90 delta patch");
+  }
+  if (header->version != DELTA_VERSION) {
+    return failDelta("Unsupported delta patch version");
+  }
+  if (header->oldSize == 0 || header->oldSize > delta.source->size) {
+    return failDelta("Patch source size exceeds running partition");
+  }
+  if (!verifySource()) {
+    return false;
+  }
+
+  if (!Update.begin(header->newSize, U_FLASH)) {
+    return failDelta(Update.errorString());
+  }
+
+  mbedtls_sha256_init(&delta.sha);
+  mbedtls_sha256_starts(&delta.sha, 0);
+  delta.hashing = true;
+  ESP_LOGI(DELTA_LOG, "Applying delta: %u -> %u bytes", (unsigned)header->oldSize, (unsigned)header->newSize);
+  return true;
+}
+
+/**
+ * @brief Validate a completed op record and run it if it needs no payload
+ * @return true if the op is valid
+ */
+static bool processOp() {
+  const delta_op_t *op = &delta.op;
+
+  if (op->type == DELTA_OP_END) {
+    delta.state = DELTA_STATE_DONE;
+    return true;
+  }
+
+  if (op->length > delta.header.newSize - delta.written) {
+    return failDelta("Patch writes past the end of the new image");
+  }
+
+  switch (op->type) {
+  case DELTA_OP_COPY:
+  case DELTA_OP_ADD:
+    if (op->offset > delta.header.oldSize || op->length > delta.header.oldSize - op->offset) {
+      return failDelta("Patch reads past the end of the running image");
+    }
+    break;
+  case DELTA_OP_INSERT:
+    break;
+  default:
+    return failDelta("Unknown delta operation");
+  }
+
+  delta.opDone = 0;
+
+  if (op->type == DELTA_OP_COPY) {
+    while (delta.opDone < op->length) {
+      size_t length = min((size_t)DELTA_WORK_BUFFER_SIZE, (size_t)op->length - delta.opDone);
+      if (!readSource(op->offset + delta.opDone, workBuffer, length) || !emitBytes(workBuffer, length)) {
+        return false;
+      }
+      delta.opDone += length;
+    }
+    return true;
+  }
+
+  if (op->length > 0) {
+    delta.state = DELTA_STATE_DATA;
+  }
+  return true;
+}
+
+/**
+ * @brief Consume payload bytes for the current ADD/INSERT op
+ * @param data Patch bytes
+ * @param length Number of bytes available
+ * @return Number of bytes consumed, or 0 on error
+ */
+static size_t processOpData(const uint8_t *data, size_t length) {
+  const delta_op_t *op = &delta.op;
+  size_t count = min(min(length, (size_t)op->length - delta.opDone), (size_t)DELTA_WORK_BUFFER_SIZE);
+
+  if (op->type == DELTA_OP_INSERT) {
+    if (!emitBytes(data, count)) {
+      return 0;
+    }
+  } else {
+    if (!readSource(op->offset + delta.opDone, workBuffer, count)) {
+      return 0;
+    }
+    for (size_t i = 0; i < count; i++) {
+      workBuffer[i] += data[i];
+    }
+    if (!emitBytes(workBuffer, count)) {
+      return 0;
+    }
+  }
+
+  delta.opDone += count;
+  if (delta.opDone == op->length) {
+    delta.state = DELTA_STATE_OP;
+  }
+  return count;
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+bool deltaUpdate_begin() {
+  deltaUpdate_abort();
+
+  delta.source = esp_ota_get_running_partition();
+  if (!delta.source) {
+    failDelta("Failed to get running partition");
+    return false;
+  }
+
+  delta.state = DELTA_STATE_HEADER;
+  delta.filled = 0;
+  delta.written = 0;
+  delta.error = NULL;
+  return true;
+}
+
+bool deltaUpdate_write(const uint8_t *data, size_t length) {
+  while (length > 0) {
+    size_t count = 0;
+
+    switch (delta.state) {
+    case DELTA_STATE_HEADER:
+      count = min(length, sizeof(delta.header) - delta.filled);
+      memcpy((uint8_t *)&delta.header + delta.filled, data, count);
+      delta.filled += count;
+      if (delta.filled == sizeof(delta.header)) {
+        delta.filled = 0;
+        delta.state = DELTA_STATE_OP;
+        if (!processHeader()) {
+          return false;
+        }
+      }
+      break;
+
+    case DELTA_STATE_OP:
+      count = min(length, sizeof(delta.op) - delta.filled);
+      memcpy((uint8_t *)&delta.op + delta.filled, data, count);
+      delta.filled += count;
+      if (delta.filled == sizeof(delta.op)) {
+        delta.filled = 0;
+        if (!processOp()) {
+          return false;
+        }
+      }
+      break;
+
+    case DELTA_STATE_DATA:
+      count = processOpData(data, length);
+      if (count == 0) {
+        return false;
+      }
+      break;
+
+    case DELTA_STATE_DONE:
+      return failDelta("Unexpected data after end of patch");
+
+    default:
+      if (!delta.error) {
+        delta.error = "No delta update in progress";
+      }
+      return false;
+    }
+
+    data += count;
+    length -= count;
+  }
+
+  return true;
+}
+
+bool deltaUpdate_end() {
+  if (delta.state != DELTA_STATE_DONE) {
+    if (delta.state != DELTA_STATE_ERROR) {
+      failDelta("Patch is incomplete");
+    }
+    deltaUpdate_abort();
+    return false;
+  }
+
+  uint8_t hash[DELTA_HASH_SIZE];
+  mbedtls_sha256_finish(&delta.sha, hash);
+  mbedtls_sha256_free(&delta.sha);
+  delta.hashing = false;
+
+  if (delta.written != delta.header.newSize) {
+    failDelta("Rebuilt image size mismatch");
+  } else if (memcmp(hash, delta.header.newHash, DELTA_HASH_SIZE) != 0) {
+    failDelta("Rebuilt image hash mismatch");
+  } else if (!Update.end(true)) {
+    failDelta(Update.errorString());
+  } else {
+    delta.state = DELTA_STATE_IDLE;
+    return true;
+  }
+
+  Update.abort();
+  delta.state = DELTA_STATE_ERROR;
+  return false;
+}
+
+void deltaUpdate_abort() {
+  if (delta.hashing) {
+    mbedtls_sha256_free(&delta.sha);
+    delta.hashing = false;
+  }
+  if (Update.isRunning()) {
+    Update.abort();
+  }
+  if (delta.state != DELTA_STATE_ERROR) {
+    delta.state = DELTA_STATE_IDLE;
+  }
+}
+
+bool deltaUpdate_isActive() {
+  return delta.state != DELTA_STATE_IDLE && delta.state != DELTA_STATE_ERROR;
+}
+
+const char *deltaUpdate_errorString() {
+  return delta.error ? delta.error : "No error";
+}
@@ -0,0 +1,310 @@
+/**
+ * @file display_font.cpp
+ * @brief Implementation of the pre-rasterized 5x7 font glyph atlas
+ *
+ * Rendering text through Adafruit GFX draws the classic font pixel by pixel,
+ * with a separate SPI transaction for each pixel run. This module rasterizes
+ * the printable ASCII range once into 1-bit column masks, expands them into
+ * RGB565 atlases for each foreground/background pair in use, and composes
+ * whole text lines into a RAM buffer that is pushed with one writePixels burst.
+ *
+ * This module handles:
+ * - One-time glyph mask extraction from the GFX built-in font
+ * - Per color pair RGB565 atlas generation (theme changes select new pairs)
+ * - Least-recently-used eviction of color atlases
+ * - Line composition and single-window display writes
+ * - Composition into off-screen framebuffers for deferred flushing
+ * - Fixed-pitch text measurement without getTextBounds
+ */
+
+#include "display_font.h"
+#include "display_module.h"
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef struct {
+  uint16_t *pixels;   // FONT_GLYPH_COUNT glyphs, each 6x8 row-major
+  uint16_t fg;
+  uint16_t bg;
+  uint32_t lastUsed;
+  bool valid;
+} font_variant_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+// Column masks (bit N = row N) for each printable glyph
+static uint8_t glyphMasks[FONT_GLYPH_COUNT][FONT_CHAR_WIDTH];
+static bool glyphMasksReady = false;
+
+static font_variant_t fontVariants[FONT_VARIANT_SLOTS] = {};
+static uint32_t variantUseCounter = 0;
+
+// Composition buffer for one full-width text line
+static uint16_t lineBuffer[DISPLAY_WIDTH * FONT_CHAR_HEIGHT];
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Extract glyph masks from the GFX built-in font
+ * @return true if masks are available
+ */
+static bool buildGlyphMasks() {
+  if (glyphMasksReady) {
+    return true;
+  }
+
+  GFXcanvas1 canvas(FONT_GLYPH_COUNT * FONT_CHAR_WIDTH, FONT_CHAR_HEIGHT);
+  if (!canvas.getBuffer()) {
+    ESP_LOGE(FONT_LOG, "Failed to allocate glyph mask canvas");
+    return false;
+  }
+
+  canvas.fillScreen(0);
+  canvas.setFont();
+  canvas.setTextSize(1);
+  canvas.setTextWrap(false);
+  for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+    canvas.drawChar(i * FONT_CHAR_WIDTH, 0, FONT_FIRST_CHAR + i, 1, 0, 1);
+  }
+
+  for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+    for (int col = 0; col < FONT_CHAR_WIDTH; col++) {
+      uint8_t mask = 0;
+      for (int row = 0; row < FONT_CHAR_HEIGHT; row++) {
+        if (canvas.getPixel(i * FONT_CHAR_WIDTH + col, row)) {
+          mask |= (1 << row);
+        }
+      }
+      glyphMasks[i][col] = mask;
+    }
+  }
+
+  glyphMasksReady = true;
+  return true;
+}
+
+/**
+ * @brief Expand glyph masks into an RGB565 atlas for a color pair
+ * @param variant Variant slot to fill
+ * @param fg Foreground color
+ * @param bg Background color
+ * @return true if the atlas was generated
+ */
+static bool rasterizeVariant(font_variant_t *variant, uint16_t fg, uint16_t bg) {
+  if (!variant->pixels) {
+    size_t atlasSize = FONT_GLYPH_COUNT * FONT_CHAR_WIDTH * FONT_CHAR_HEIGHT * sizeof(uint16_t);
+    variant->pixels = (uint16_t *)heap_caps_malloc(atlasSize, MALLOC_CAP_SPIRAM);
+    if (!variant->pixels) {
+      ESP_LOGE(FONT_LOG, "Failed to allocate %zu byte glyph atlas", atlasSize);
+      return false;
+    }
+  }
+
+  for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+    uint16_t *glyph = variant->pixels + (i * FONT_CHAR_WIDTH * FONT_CHAR_HEIGHT);
+    for (int row = 0; row < FONT_CHAR_HEIGHT; row++) {
+      for (int col = 0; col < FONT_CHAR_WIDTH; col++) {
+        glyph[row * FONT_CHAR_WIDTH + col] = (glyphMasks[i][col] & (1 << row)) ? fg : bg;
+      }
+    }
+  }
+
+  variant->fg = fg;
+  variant->bg = bg;
+  variant->valid = true;
+  return true;
+}
+
+/**
+ * @brief Find (or generate) the atlas for a color pair
+ * @param fg Foreground color
+ * @param bg Background color
+ * @return Atlas variant, or NULL if unavailable
+ */
+static font_variant_t *getVariant(uint16_t fg, uint16_t bg) {
+  if (!buildGlyphMasks()) {
+    return NULL;
+  }
+
+  font_variant_t *victim = &fontVariants[0];
+  for (int i = 0; i < FONT_VARIANT_SLOTS; i++) {
+    font_variant_t *variant = &fontVariants[i];
+    if (variant->valid && variant->fg == fg && variant->bg == bg) {
+      variant->lastUsed = ++variantUseCounter;
+      return variant;
+    }
+    if (!variant->valid) {
+      if (victim->valid) {
+        victim = variant;
+      }
+    } else if (victim->valid && variant->lastUsed < victim->lastUsed) {
+      victim = variant;
+    }
+  }
+
+  if (!rasterizeVariant(victim, fg, bg)) {
+    victim->valid = false;
+    return NULL;
+  }
+
+  ESP_LOGD(FONT_LOG, "Generated glyph atlas fg=0x%04X bg=0x%04X", fg, bg);
+  victim->lastUsed = ++variantUseCounter;
+  return victim;
+}
+
+/**
+ * @brief Map a character to its atlas index
+ * @param c Character to look up
+ * @return Atlas index (unsupported characters render as '?')
+ */
+static inline int glyphIndex(char c) {
+  uint8_t code = (uint8_t)c;
+  if (code < FONT_FIRST_CHAR || code > FONT_LAST_CHAR) {
+    code = '?';
+  }
+  return code - FONT_FIRST_CHAR;
+}
+
+/**
+ * @brief Work out how much of a line fits from x to the right edge
+ * @param x Left edge of the line
+ * @param surfaceWidth Width of the destination surface
+ * @param text Text to draw
+ * @param minWidth Minimum padded width
+ * @param charCount Pointer to store the number of characters that fit
+ * @return Line width in pixels (0 if nothing fits)
+ */
+static int16_t measureLine(int16_t x, int16_t surfaceWidth, const char *text, int16_t minWidth, int16_t *charCount) {
+  int16_t maxWidth = surfaceWidth - x;
+  *charCount = min((int16_t)strlen(text), displayFont_charsForWidth(maxWidth));
+  return min(max((int16_t)(*charCount * FONT_CHAR_WIDTH), minWidth), maxWidth);
+}
+
+/**
+ * @brief Copy glyph rows from an atlas into a destination surface
+ * @param dest Top-left pixel of the line in the destination
+ * @param stride Destination row stride in pixels
+ * @param variant Atlas to copy from
+ * @param text Text to compose
+ * @param charCount Number of characters to compose
+ * @param width Line width in pixels (padding is filled with bg)
+ * @param bg Background color for padding
+ */
+static void composeLine(uint16_t *dest, int16_t stride, const font_variant_t *variant, const char *text,
+                        int16_t charCount, int16_t width, uint16_t bg) {
+  for (int row = 0; row < FONT_CHAR_HEIGHT; row++) {
+    uint16_t *rowDest = dest + (row * stride);
+    for (int i = 0; i < charCount; i++) {
+      const uint16_t *src = variant->pixels + (glyphIndex(text[i]) * FONT_CHAR_WIDTH * FONT_CHAR_HEIGHT) +
+                            (row * FONT_CHAR_WIDTH);
+      memcpy(rowDest + (i * FONT_CHAR_WIDTH), src, FONT_CHAR_WIDTH * sizeof(uint16_t));
+    }
+    for (int col = charCount * FONT_CHAR_WIDTH; col < width; col++) {
+      rowDest[col] = bg;
+    }
+  }
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Get the rendered width of a string in pixels
+ * @param text Null-terminated string
+ * @return Width in pixels (matches GFX getTextBounds at text size 1)
+ */
+int16_t displayFont_textWidth(const char *text) {
+  if (!text) {
+    return 0;
+  }
+  return (int16_t)(strlen(text) * FONT_CHAR_WIDTH);
+}
+
+/**
+ * @brief Get how many characters fit in a given width
+ * @param maxWidth Available width in pixels
+ * @return Number of characters that fit
+ */
+int16_t displayFont_charsForWidth(int16_t maxWidth) {
+  if (maxWidth <= 0) {
+    return 0;
+  }
+  return maxWidth / FONT_CHAR_WIDTH;
+}
+
+/**
+ * @brief Draw a line of text as a single pixel burst
+ * @param x X-coordinate of the top-left corner
+ * @param y Y-coordinate of the top-left corner
+ * @param text Null-terminated string (clipped at the right edge)
+ * @param fg Foreground (glyph) color
+ * @param bg Background color filling each character cell
+ * @param minWidth Pad the line with background up to this width (0 for none)
+ * @return Width in pixels actually pushed to the display
+ */
+int16_t displayFont_drawText(int16_t x, int16_t y, const char *text, uint16_t fg, uint16_t bg, int16_t minWidth) {
+  if (!text || x < 0 || y < 0 || x >= DISPLAY_WIDTH || y + FONT_CHAR_HEIGHT > DISPLAY_HEIGHT) {
+    return 0;
+  }
+
+  font_variant_t *variant = getVariant(fg, bg);
+  if (!variant) {
+    return 0;
+  }
+
+  int16_t charCount = 0;
+  int16_t width = measureLine(x, DISPLAY_WIDTH, text, minWidth, &charCount);
+  if (width <= 0) {
+    return 0;
+  }
+
+  composeLine(lineBuffer, width, variant, text, charCount, width, bg);
+
+  startWrite();
+  setAddrWindow(x, y, width, FONT_CHAR_HEIGHT);
+  writePixels(lineBuffer, (uint32_t)width * FONT_CHAR_HEIGHT);
+  endWrite();
+
+  return width;
+}
+
+/**
+ * @brief Compose a line of text into an off-screen RGB565 buffer
+ * @param buffer Destination framebuffer (row-major)
+ * @param bufferWidth Framebuffer width in pixels
+ * @param bufferHeight Framebuffer height in pixels
+ * @param x X-coordinate of the top-left corner
+ * @param y Y-coordinate of the top-left corner
+ * @param text Null-terminated string (clipped at the right edge)
+ * @param fg Foreground (glyph) color
+ * @param bg Background color filling each character cell
+ * @param minWidth Pad the line with background up to this width (0 for none)
+ * @return Width in pixels written to the buffer
+ */
+int16_t displayFont_composeText(uint16_t *buffer, int16_t bufferWidth, int16_t bufferHeight, int16_t x, int16_t y,
+                                const char *text, uint16_t fg, uint16_t bg, int16_t minWidth) {
+  if (!buffer || !text || x < 0 || y < 0 || x >= bufferWidth || y + FONT_CHAR_HEIGHT > bufferHeight) {
+    return 0;
+  }
+
+  font_variant_t *variant = getVariant(fg, bg);
+  if (!variant) {
+    return 0;
+  }
+
+  int16_t charCount = 0;
+  int16_t width = measureLine(x, bufferWidth, text, minWidth, &charCount);
+  if (width <= 0) {
+    return 0;
+  }
+
+  composeLine(buffer + (y * bufferWidth) + x, bufferWidth, variant, text, charCount, width, bg);
+  return width;
+}
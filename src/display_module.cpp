@@ -7,6 +7,7 @@
  */
 
 #include "display_module.h"
+#include "display_font.h"
 #include "common.h"
 #include "emotes_module.h"
 #include "soundsfx_module.h"
@@ -31,6 +32,9 @@ Adafruit_SSD1351 oled = Adafruit_SSD1351(DISPLAY_WIDTH, DISPLAY_HEIGHT, &SPI,
 static int16_t dos_x = 0;
 static int16_t dos_y = 0;
 
+// Hardware vertical scroll position (GDDRAM row shown at the top)
+static uint8_t displayStartLine = 0;
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -81,6 +85,56 @@ void writePixels(uint16_t *pixels, uint32_t len) {
   oled.writePixels(pixels, len);
 }
 
+/**
+ * @brief Push full-width rows of pixel data to the display
+ * @param rows Pointer to h rows of DISPLAY_WIDTH RGB565 pixels
+ * @param y Display row the first pixel row lands on
+ * @param h Number of rows to push
+ */
+void flushPixelRows(const uint16_t *rows, int16_t y, int16_t h) {
+  if (!rows || y < 0 || h <= 0 || y + h > DISPLAY_HEIGHT) {
+    return;
+  }
+
+  // Map display rows to GDDRAM rows, splitting where the RAM wraps
+  int16_t physicalY = (y + displayStartLine) % DISPLAY_HEIGHT;
+  int16_t firstRows = min(h, (int16_t)(DISPLAY_HEIGHT - physicalY));
+
+  // Full-width rows are contiguous, so each span is a single burst
+  oled.startWrite();
+  oled.setAddrWindow(0, physicalY, DISPLAY_WIDTH, firstRows);
+  oled.writePixels((uint16_t *)rows, (uint32_t)DISPLAY_WIDTH * firstRows);
+  if (h > firstRows) {
+    oled.setAddrWindow(0, 0, DISPLAY_WIDTH, h - firstRows);
+    oled.writePixels((uint16_t *)(rows + (firstRows * DISPLAY_WIDTH)), (uint32_t)DISPLAY_WIDTH * (h - firstRows));
+  }
+  oled.endWrite();
+}
+
+/**
+ * @brief Push full framebuffer rows to the display in one transaction
+ * @param framebuffer Pointer to a DISPLAY_WIDTH x DISPLAY_HEIGHT RGB565 framebuffer
+ * @param y First row to push
+ * @param h Number of rows to push
+ */
+void flushFramebufferRows(const uint16_t *framebuffer, int16_t y, int16_t h) {
+  if (!framebuffer) {
+    return;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (y + h > DISPLAY_HEIGHT) {
+    h = DISPLAY_HEIGHT - y;
+  }
+  if (h <= 0) {
+    return;
+  }
+
+  flushPixelRows(framebuffer + (y * DISPLAY_WIDTH), y, h);
+}
+
 /**
  * @brief Initialize the OLED display
  * @return true if initialization was successful, false otherwise
@@ -113,10 +167,32 @@ void setDisplayBrightness(uint8_t contrastLevel) {
 }
 
 
+/**
+ * @brief Set the SSD1351 display start line (hardware vertical scroll)
+ * @param line GDDRAM row shown at the top of the panel (wraps at DISPLAY_HEIGHT)
+ */
+void setDisplayStartLine(uint8_t line) {
+  uint8_t data = line % DISPLAY_HEIGHT;
+  oled.sendCommand(SSD1351_CMD_STARTLINE, &data, 1);
+  displayStartLine = data;
+}
+
+/**
+ * @brief Get the current SSD1351 display start line
+ * @return GDDRAM row shown at the top of the panel
+ */
+uint8_t getDisplayStartLine() {
+  return displayStartLine;
+}
+
 /**
  * @brief Clear the display by filling it with black
  */
 void clearDisplay() { 
+  // Undo any hardware scroll so direct GFX drawing maps 1:1 to the panel
+  if (displayStartLine != 0) {
+    setDisplayStartLine(0);
+  }
   oled.fillScreen(COLOR_BLACK); 
 }
 
@@ -133,31 +209,44 @@ void displayStaticImage(const uint16_t *imageData, uint16_t imageWidth, uint16_t
   if (x < 0) x = 0;
   if (y < 0) y = 0;
 
+  // Clip to the panel; rows keep the source stride
+  int16_t drawWidth = min((int16_t)imageWidth, (int16_t)(DISPLAY_WIDTH - x));
+  int16_t drawHeight = min((int16_t)imageHeight, (int16_t)(DISPLAY_HEIGHT - y));
+
+  // One address window and one transaction for the whole image
+  oled.startWrite();
+  oled.setAddrWindow(x, y, drawWidth, drawHeight);
+
   if (applyTint && effectsCore_isEffectEnabled(EFFECT_TINT)) {
     // Get current tint parameters using the new effects system
     tint_params_t tintParams = effectsTints_getDefaultTintParams();
     effectsCore_getEffectParams(EFFECT_TINT, &tintParams);
     
-    // Create a buffer for one scanline
-    uint16_t lineBuffer[128];
+    // Ping-pong scanline buffers: row N+1 is tinted while row N is sent
+    // (non-blocking when the SPI driver supports DMA, otherwise sequential)
+    static uint16_t lineBuffers[2][DISPLAY_WIDTH];
     
-    // Process the image line by line with tint effects
-    for (int row = 0; row < imageHeight; row++) {
-      // Copy original scanline to buffer
-      for (int col = 0; col < imageWidth; col++) {
-        lineBuffer[col] = imageData[row * imageWidth + col];
-      }
+    for (int row = 0; row < drawHeight; row++) {
+      uint16_t *lineBuffer = lineBuffers[row & 1];
+      memcpy(lineBuffer, imageData + (row * imageWidth), drawWidth * sizeof(uint16_t));
+      effectsTints_applyTintToScanline(lineBuffer, drawWidth, row, &tintParams);
       
-      // Apply tint effect to this scanline using new system
-      effectsTints_applyTintToScanline(lineBuffer, imageWidth, row, &tintParams);
-      
-      // Draw the processed scanline
-      oled.drawRGBBitmap(x, y + row, lineBuffer, imageWidth, 1);
+      // Wait for the transfer that last used the other buffer before queuing
+      oled.dmaWait();
+      oled.writePixels(lineBuffer, drawWidth, false);
     }
+    oled.dmaWait();
+  } else if (drawWidth == imageWidth) {
+    // No tint - stream the image straight from flash in a single burst
+    oled.writePixels((uint16_t *)imageData, (uint32_t)drawWidth * drawHeight);
   } else {
-    // No tint effect - display normally
-    oled.drawRGBBitmap(x, y, imageData, imageWidth, imageHeight);
+    // No tint but clipped horizontally - stream visible part of each row
+    for (int row = 0; row < drawHeight; row++) {
+      oled.writePixels((uint16_t *)(imageData + (row * imageWidth)), drawWidth);
+    }
   }
+
+  oled.endWrite();
 }
 
 /**
@@ -169,9 +258,6 @@ void displayStaticImage(const uint16_t *imageData, uint16_t imageWidth, uint16_t
  * @param isTerminal Whether the text is being typed in a terminal context
  */
 void dosTypeSynced(const char *text, int delay_ms, uint16_t color, bool audioAvailable, bool isTerminal) {
-  oled.setTextColor(color);
-  oled.setCursor(dos_x, dos_y);
-
   bool useSound = audioAvailable && strlen(text) > 3;
 
   while (*text) {
@@ -183,7 +269,8 @@ void dosTypeSynced(const char *text, int delay_ms, uint16_t color, bool audioAva
       }
     }
 
-    oled.print(*text);
+    char glyph[2] = {*text, '\0'};
+    displayFont_drawText(dos_x, dos_y, glyph, color, TINT_BLACK);
     text++;
     dos_x += 6;
 
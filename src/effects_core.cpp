@@ -6,12 +6,18 @@
  * including effect registry, lifecycle management, parameter handling, and scanline processing
  * for the modular effects system.
  *
+ * The enable/parameter API edits a working chain. Every edit compiles it into
+ * a spare copy and publishes that with a single pointer store, and selecting
+ * a preset publishes the preset's own precompiled chain the same way, so the
+ * render path never sees a half-applied change.
+ *
  * This module handles:
  * - Effect registry initialization and management
  * - Effect enable/disable/toggle operations with debouncing
  * - Effect parameter management and validation
  * - Performance monitoring and statistics tracking
- * - Preferences integration for persistent effect states
+ * - Effect presets capturing the whole chain, persisted through preferences
+ * - A bank of precompiled presets switched without copying or flash access
  * - Scanline processing pipeline with ordered effect application
  * - Effect lifecycle management and cleanup
  * - Integration with all effect modules (tints, retro, matrix)
@@ -26,6 +32,29 @@
 #include "effects_matrix.h"
 #include "preferences_module.h"
 #include <Arduino.h>
+#include <atomic>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief A complete effect configuration plus its compiled step list
+ * The render path only ever reads a published chain; parameters are held by
+ * value so editing one chain never changes another.
+ */
+typedef struct {
+    bool enabled[EFFECT_COUNT];
+    tint_params_t tint;
+    chromatic_params_t chromatic;
+    scanline_params_t scanline;
+    dither_params_t dither;
+    glitch_params_t glitch;
+    dot_matrix_params_t dotMatrix;
+    pixelate_params_t pixelate;
+    effect_type_t steps[EFFECT_COUNT]; // Enabled effects in application order
+    uint8_t stepCount;
+} effect_chain_t;
 
 //==============================================================================
 // GLOBAL VARIABLES
@@ -35,26 +64,228 @@
 static effect_registry_t effectRegistry[EFFECT_COUNT];
 static bool effectRegistryInitialized = false;
 
-// Effect states
-static bool effectsEnabled[EFFECT_COUNT] = {false};
-static void* effectParams[EFFECT_COUNT] = {NULL};
+// Order effects are applied in (matching original implementation)
+static const effect_type_t EFFECT_ORDER[EFFECT_COUNT] = {
+    EFFECT_TINT,       // Affects all pixels
+    EFFECT_DITHERING,
+    EFFECT_CHROMATIC,
+    EFFECT_DOT_MATRIX,
+    EFFECT_PIXELATE,
+    EFFECT_SCANLINES,
+    EFFECT_GLITCH,     // Should be last
+};
+
+// Chain edited by the enable/parameter API
+static effect_chain_t working;
 static unsigned long lastToggleTime[EFFECT_COUNT] = {0};
 
-// Parameter storage for each effect type - initialized from getter functions
-static tint_params_t tintParams;
-static chromatic_params_t chromaticParams;
-static scanline_params_t scanlineParams;
-static dither_params_t ditherParams;
-static glitch_params_t glitchParams;
-static dot_matrix_params_t dotMatrixParams;
-static pixelate_params_t pixelateParams;
+// Published chains. activeChain points at one of the live copies of the
+// working chain, or directly at a preset slot. All edits come from the main
+// loop, which also renders, so a chain is never rewritten mid-scanline.
+static effect_chain_t liveChains[2];
+static effect_chain_t presetChains[EFFECT_PRESET_SLOTS];
+static bool presetStored[EFFECT_PRESET_SLOTS] = {false};
+static char presetNames[EFFECT_PRESET_SLOTS][EFFECT_PRESET_NAME_LEN];
+static std::atomic<const effect_chain_t*> activeChain(&liveChains[0]);
+static int activePreset = -1;
+
+static_assert(EFFECT_COUNT <= 8, "effect_preset_t.enabled holds one bit per effect");
+static_assert(sizeof(effect_bank_entry_t) <= PREFERENCES_EFFECT_PRESET_MAX, "Effect preset outgrew its preferences slot");
+static_assert(EFFECT_PRESET_SLOTS <= PREFERENCES_PRESET_SLOTS, "Preset bank larger than its preferences storage");
 
 // Performance monitoring
 static effect_performance_t performanceStats = {0};
 static bool performanceMonitoringEnabled = false;
 static unsigned long lastPerformanceReset = 0;
 
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Build a chain's step list from its enable states
+ */
+static void compileChain(effect_chain_t* chain) {
+    chain->stepCount = 0;
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        effect_type_t type = EFFECT_ORDER[i];
+        if (chain->enabled[type] && effectRegistry[type].apply) {
+            chain->steps[chain->stepCount++] = type;
+        }
+    }
+}
+
+/**
+ * @brief Compile the working chain into a spare copy and make it active
+ */
+static void publishChain(void) {
+    const effect_chain_t* active = activeChain.load(std::memory_order_relaxed);
+    effect_chain_t* spare = (active == &liveChains[0]) ? &liveChains[1] : &liveChains[0];
+
+    *spare = working;
+    compileChain(spare);
+    activeChain.store(spare, std::memory_order_release);
+    activePreset = -1;
+}
+
+/**
+ * @brief Recompile stored presets after the registry changed
+ */
+static void recompilePresets(void) {
+    // Move off any preset slot before rewriting it
+    publishChain();
+    for (int i = 0; i < EFFECT_PRESET_SLOTS; i++) {
+        if (presetStored[i]) {
+            compileChain(&presetChains[i]);
+        }
+    }
+}
+
+/**
+ * @brief Serialize a chain's enable states and parameters
+ */
+static void chainToPreset(const effect_chain_t* chain, effect_preset_t* preset) {
+    memset(preset, 0, sizeof(*preset));
+    preset->version = EFFECT_PRESET_VERSION;
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        if (chain->enabled[i]) {
+            preset->enabled |= 1 << i;
+        }
+    }
+
+    preset->tintColor = chain->tint.tintColor;
+    preset->tintIntensity = chain->tint.intensity;
+    preset->tintThreshold = chain->tint.threshold;
+    preset->tintSelective = chain->tint.selectiveTint;
+
+    preset->chromaticMode = chain->chromatic.mode;
+    preset->chromaticIntensity = chain->chromatic.intensity;
+    preset->chromaticDegrees = chain->chromatic.degrees;
+    preset->chromaticRedShift = chain->chromatic.redShift;
+    preset->chromaticBlueShift = chain->chromatic.blueShift;
+
+    preset->scanlineMode = chain->scanline.mode;
+    preset->scanlineIntensity = chain->scanline.intensity;
+    preset->scanlineSpeed = chain->scanline.speed;
+
+    preset->ditherMode = chain->dither.mode;
+    preset->ditherQuantization = chain->dither.quantization;
+    preset->ditherIntensity = chain->dither.intensity;
+
+    preset->glitchMode = chain->glitch.mode;
+    preset->glitchProbability = chain->glitch.probability;
+
+    preset->dotMatrixMode = chain->dotMatrix.mode;
+    preset->dotSize = chain->dotMatrix.dotSize;
+    preset->dotQuantization = chain->dotMatrix.quantization;
+    preset->dotMatrixIntensity = chain->dotMatrix.intensity;
+
+    preset->pixelateMode = chain->pixelate.mode;
+    preset->blockSize = chain->pixelate.blockSize;
+    preset->pixelateIntensity = chain->pixelate.intensity;
+}
+
+/**
+ * @brief Restore a chain's enable states and parameters from a preset
+ * @return false if the preset is from an unknown version
+ */
+static bool presetToChain(const effect_preset_t* preset, effect_chain_t* chain) {
+    if (!preset || preset->version != EFFECT_PRESET_VERSION) {
+        return false;
+    }
+
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        chain->enabled[i] = (preset->enabled & (1 << i)) != 0;
+    }
+
+    chain->tint.tintColor = preset->tintColor;
+    chain->tint.intensity = preset->tintIntensity;
+    chain->tint.threshold = preset->tintThreshold;
+    chain->tint.selectiveTint = preset->tintSelective != 0;
+
+    chain->chromatic.mode = (ChromaticMode)preset->chromaticMode;
+    chain->chromatic.intensity = preset->chromaticIntensity;
+    chain->chromatic.degrees = preset->chromaticDegrees;
+    chain->chromatic.redShift = preset->chromaticRedShift;
+    chain->chromatic.blueShift = preset->chromaticBlueShift;
 
+    chain->scanline.mode = (ScanlineMode)preset->scanlineMode;
+    chain->scanline.intensity = preset->scanlineIntensity;
+    chain->scanline.speed = preset->scanlineSpeed;
+
+    chain->dither.mode = (DitherMode)preset->ditherMode;
+    chain->dither.quantization = preset->ditherQuantization;
+    chain->dither.intensity = preset->ditherIntensity;
+
+    chain->glitch.mode = (GlitchMode)preset->glitchMode;
+    chain->glitch.probability = preset->glitchProbability;
+
+    chain->dotMatrix.mode = (DotMatrixMode)preset->dotMatrixMode;
+    chain->dotMatrix.dotSize = preset->dotSize;
+    chain->dotMatrix.quantization = preset->dotQuantization;
+    chain->dotMatrix.intensity = preset->dotMatrixIntensity;
+
+    chain->pixelate.mode = (PixelateMode)preset->pixelateMode;
+    chain->pixelate.blockSize = preset->blockSize;
+    chain->pixelate.intensity = preset->pixelateIntensity;
+    return true;
+}
+
+/**
+ * @brief Give a slot the name it shows until one is stored with it
+ */
+static void setDefaultPresetName(uint8_t slot) {
+    snprintf(presetNames[slot], EFFECT_PRESET_NAME_LEN, "PRESET %u", slot + 1);
+}
+
+/**
+ * @brief Check a preset name and copy it upper-cased
+ * @return false if it is empty, too long or not printable ASCII
+ */
+static bool copyPresetName(char* dest, const char* name) {
+    size_t length = strlen(name);
+    if (length == 0 || length >= EFFECT_PRESET_NAME_LEN) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (name[i] < ' ' || name[i] > '~') {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i <= length; i++) {
+        dest[i] = toupper((unsigned char)name[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Load and compile the stored preset bank
+ * Slots stored before names existed get their default name.
+ */
+static void loadPresetBank(void) {
+    for (int i = 0; i < EFFECT_PRESET_SLOTS; i++) {
+        effect_bank_entry_t entry;
+        size_t length = loadEffectPresetSlot(i, &entry, sizeof(entry));
+        const effect_preset_t* preset = NULL;
+
+        setDefaultPresetName(i);
+        if (length == sizeof(entry)) {
+            entry.name[EFFECT_PRESET_NAME_LEN - 1] = '\0';
+            if (entry.name[0] != '\0') {
+                strlcpy(presetNames[i], entry.name, EFFECT_PRESET_NAME_LEN);
+            }
+            preset = &entry.effects;
+        } else if (length == sizeof(effect_preset_t)) {
+            preset = (const effect_preset_t*)&entry;
+        }
+
+        presetStored[i] = preset && presetToChain(preset, &presetChains[i]);
+        if (presetStored[i]) {
+            compileChain(&presetChains[i]);
+        }
+    }
+}
 
 //==============================================================================
 // CORE EFFECTS MANAGEMENT
@@ -72,7 +303,7 @@ void effectsCore_init(void) {
         effectRegistry[i].apply = NULL;
         effectRegistry[i].cleanup = NULL;
     }
-    
+
     // Register apply functions for each effect type
     effectRegistry[EFFECT_TINT].apply = (void (*)(uint16_t*, int, int, const void*))effectsTints_applyTintToScanline;
     effectRegistry[EFFECT_CHROMATIC].apply = (void (*)(uint16_t*, int, int, const void*))effectsTints_applyChromaticAberration;
@@ -81,21 +312,22 @@ void effectsCore_init(void) {
     effectRegistry[EFFECT_GLITCH].apply = (void (*)(uint16_t*, int, int, const void*))effectsRetro_applyCRTGlitches;
     effectRegistry[EFFECT_DOT_MATRIX].apply = (void (*)(uint16_t*, int, int, const void*))effectsMatrix_applyDotMatrixEffect;
     effectRegistry[EFFECT_PIXELATE].apply = (void (*)(uint16_t*, int, int, const void*))effectsMatrix_applyPixelateEffect;
-    
+
     effectRegistryInitialized = true;
-    
+
     // Initialize all parameter structs with default values
-    tintParams = effectsTints_getDefaultTintParams();
-    chromaticParams = effectsTints_getDefaultChromaticParams();
-    scanlineParams = effectsRetro_getDefaultScanlineParams();
-    ditherParams = effectsRetro_getDefaultDitherParams();
-    glitchParams = effectsRetro_getDefaultGlitchParams();
-    dotMatrixParams = effectsMatrix_getDefaultDotMatrixParams();
-    pixelateParams = effectsMatrix_getDefaultPixelateParams();
-    
+    working.tint = effectsTints_getDefaultTintParams();
+    working.chromatic = effectsTints_getDefaultChromaticParams();
+    working.scanline = effectsRetro_getDefaultScanlineParams();
+    working.dither = effectsRetro_getDefaultDitherParams();
+    working.glitch = effectsRetro_getDefaultGlitchParams();
+    working.dotMatrix = effectsMatrix_getDefaultDotMatrixParams();
+    working.pixelate = effectsMatrix_getDefaultPixelateParams();
+
     // Load effect states from preferences (may override some parameter values)
     effectsCore_loadFromPreferences();
-    
+    loadPresetBank();
+
     // Initialize performance monitoring
     performanceMonitoringEnabled = true;
     lastPerformanceReset = millis();
@@ -109,12 +341,13 @@ bool effectsCore_registerEffect(const effect_registry_t* effect) {
     if (!effect || !effectRegistryInitialized) {
         return false;
     }
-    
+
     if (effect->type < 0 || effect->type >= EFFECT_COUNT) {
         return false;
     }
-    
+
     effectRegistry[effect->type] = *effect;
+    recompilePresets();
     return true;
 }
 
@@ -122,15 +355,16 @@ bool effectsCore_unregisterEffect(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return false;
     }
-    
+
     // Disable effect first
     effectsCore_disableEffect(type);
-    
+
     // Clear registry entry
     effectRegistry[type].init = NULL;
     effectRegistry[type].apply = NULL;
     effectRegistry[type].cleanup = NULL;
-    
+
+    recompilePresets();
     return true;
 }
 
@@ -138,7 +372,7 @@ const effect_registry_t* effectsCore_getEffect(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return NULL;
     }
-    
+
     return &effectRegistry[type];
 }
 
@@ -156,43 +390,14 @@ bool effectsCore_enableEffect(effect_type_t type) {
         ESP_LOGE(EFFECTS_LOG, "Failed to enable effect %d: invalid type or not initialized", type);
         return false;
     }
-    
-    if (effectsEnabled[type]) {
+
+    if (working.enabled[type]) {
         ESP_LOGD(EFFECTS_LOG, "Effect %d (%s) already enabled", type, getEffectTypeName(type));
         return true; // Already enabled
     }
-    
-    // Ensure parameter pointer is set
-    if (!effectParams[type]) {
-        switch (type) {
-            case EFFECT_TINT:
-                effectParams[type] = &tintParams;
-                break;
-            case EFFECT_CHROMATIC:
-                effectParams[type] = &chromaticParams;
-                break;
-            case EFFECT_SCANLINES:
-                effectParams[type] = &scanlineParams;
-                break;
-            case EFFECT_DITHERING:
-                effectParams[type] = &ditherParams;
-                break;
-            case EFFECT_GLITCH:
-                effectParams[type] = &glitchParams;
-                break;
-            case EFFECT_DOT_MATRIX:
-                effectParams[type] = &dotMatrixParams;
-                break;
-            case EFFECT_PIXELATE:
-                effectParams[type] = &pixelateParams;
-                break;
-            default:
-                ESP_LOGE(EFFECTS_LOG, "Unknown effect type %d", type);
-                return false;
-        }
-    }
-    
-    effectsEnabled[type] = true;
+
+    working.enabled[type] = true;
+    publishChain();
     // Effect enabled silently
     return true;
 }
@@ -206,12 +411,13 @@ bool effectsCore_disableEffect(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return false;
     }
-    
-    if (!effectsEnabled[type]) {
+
+    if (!working.enabled[type]) {
         return true; // Already disabled
     }
-    
-    effectsEnabled[type] = false;
+
+    working.enabled[type] = false;
+    publishChain();
     return true;
 }
 
@@ -224,15 +430,15 @@ bool effectsCore_toggleEffect(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return false;
     }
-    
+
     unsigned long currentTime = millis();
     if (currentTime - lastToggleTime[type] < EFFECT_DEBOUNCE_TIME) {
-        return effectsEnabled[type]; // Debounce
+        return working.enabled[type]; // Debounce
     }
-    
+
     lastToggleTime[type] = currentTime;
-    
-    if (effectsEnabled[type]) {
+
+    if (working.enabled[type]) {
         effectsCore_disableEffect(type);
         return false;
     } else {
@@ -250,8 +456,8 @@ bool effectsCore_isEffectEnabled(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return false;
     }
-    
-    return effectsEnabled[type];
+
+    return working.enabled[type];
 }
 
 /**
@@ -278,42 +484,36 @@ bool effectsCore_setEffectParams(effect_type_t type, const void* params) {
         ESP_LOGE(EFFECTS_LOG, "Failed to set effect params for type %d: invalid params", type);
         return false;
     }
-    
+
     ESP_LOGI(EFFECTS_LOG, "Setting effect params for type %d (%s)", type, getEffectTypeName(type));
-    
+
     switch (type) {
         case EFFECT_TINT:
-            tintParams = *(const tint_params_t*)params;
-            effectParams[type] = &tintParams;
+            working.tint = *(const tint_params_t*)params;
             break;
         case EFFECT_CHROMATIC:
-            chromaticParams = *(const chromatic_params_t*)params;
-            effectParams[type] = &chromaticParams;
+            working.chromatic = *(const chromatic_params_t*)params;
             break;
         case EFFECT_SCANLINES:
-            scanlineParams = *(const scanline_params_t*)params;
-            effectParams[type] = &scanlineParams;
+            working.scanline = *(const scanline_params_t*)params;
             break;
         case EFFECT_DITHERING:
-            ditherParams = *(const dither_params_t*)params;
-            effectParams[type] = &ditherParams;
+            working.dither = *(const dither_params_t*)params;
             break;
         case EFFECT_GLITCH:
-            glitchParams = *(const glitch_params_t*)params;
-            effectParams[type] = &glitchParams;
+            working.glitch = *(const glitch_params_t*)params;
             break;
         case EFFECT_DOT_MATRIX:
-            dotMatrixParams = *(const dot_matrix_params_t*)params;
-            effectParams[type] = &dotMatrixParams;
+            working.dotMatrix = *(const dot_matrix_params_t*)params;
             break;
         case EFFECT_PIXELATE:
-            pixelateParams = *(const pixelate_params_t*)params;
-            effectParams[type] = &pixelateParams;
+            working.pixelate = *(const pixelate_params_t*)params;
             break;
         default:
             return false;
     }
-    
+
+    publishChain();
     return true;
 }
 
@@ -327,33 +527,33 @@ bool effectsCore_getEffectParams(effect_type_t type, void* params) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT || !params) {
         return false;
     }
-    
+
     switch (type) {
         case EFFECT_TINT:
-            *(tint_params_t*)params = tintParams;
+            *(tint_params_t*)params = working.tint;
             break;
         case EFFECT_CHROMATIC:
-            *(chromatic_params_t*)params = chromaticParams;
+            *(chromatic_params_t*)params = working.chromatic;
             break;
         case EFFECT_SCANLINES:
-            *(scanline_params_t*)params = scanlineParams;
+            *(scanline_params_t*)params = working.scanline;
             break;
         case EFFECT_DITHERING:
-            *(dither_params_t*)params = ditherParams;
+            *(dither_params_t*)params = working.dither;
             break;
         case EFFECT_GLITCH:
-            *(glitch_params_t*)params = glitchParams;
+            *(glitch_params_t*)params = working.glitch;
             break;
         case EFFECT_DOT_MATRIX:
-            *(dot_matrix_params_t*)params = dotMatrixParams;
+            *(dot_matrix_params_t*)params = working.dotMatrix;
             break;
         case EFFECT_PIXELATE:
-            *(pixelate_params_t*)params = pixelateParams;
+            *(pixelate_params_t*)params = working.pixelate;
             break;
         default:
             return false;
     }
-    
+
     return true;
 }
 
@@ -371,6 +571,7 @@ void effectsCore_resetPerformance(void) {
     performanceStats.totalPixels = 0;
     performanceStats.effectsApplied = 0;
     performanceStats.processingTime = 0;
+    memset(performanceStats.effectTime, 0, sizeof(performanceStats.effectTime));
     performanceStats.fps = 0.0f;
     lastPerformanceReset = millis();
 }
@@ -379,65 +580,158 @@ void effectsCore_setPerformanceMonitoring(bool enabled) {
     performanceMonitoringEnabled = enabled;
 }
 
+//==============================================================================
+// EFFECT PRESETS
+//==============================================================================
+
+void effectsCore_capturePreset(effect_preset_t* preset) {
+    if (preset) {
+        chainToPreset(&working, preset);
+    }
+}
+
+bool effectsCore_applyPreset(const effect_preset_t* preset) {
+    if (!presetToChain(preset, &working)) {
+        return false;
+    }
+
+    publishChain();
+    return true;
+}
+
+bool effectsCore_storePreset(uint8_t slot, const char* name) {
+    if (!effectRegistryInitialized || slot >= EFFECT_PRESET_SLOTS) {
+        return false;
+    }
+
+    effect_bank_entry_t entry;
+    if (name) {
+        if (!copyPresetName(entry.name, name)) {
+            ESP_LOGW(EFFECTS_LOG, "Invalid preset name - not storing slot %u", slot);
+            return false;
+        }
+    } else {
+        strlcpy(entry.name, presetNames[slot], EFFECT_PRESET_NAME_LEN);
+    }
+
+    // Never rewrite the chain the render path is following
+    if (activeChain.load(std::memory_order_relaxed) == &presetChains[slot]) {
+        publishChain();
+    }
+
+    presetChains[slot] = working;
+    compileChain(&presetChains[slot]);
+    presetStored[slot] = true;
+    strlcpy(presetNames[slot], entry.name, EFFECT_PRESET_NAME_LEN);
+    activePreset = slot;
+
+    chainToPreset(&working, &entry.effects);
+    return saveEffectPresetSlot(slot, &entry, sizeof(entry));
+}
+
+bool effectsCore_selectPreset(uint8_t slot) {
+    if (!effectRegistryInitialized || slot >= EFFECT_PRESET_SLOTS || !presetStored[slot]) {
+        return false;
+    }
+
+    activeChain.store(&presetChains[slot], std::memory_order_release);
+    working = presetChains[slot];
+    activePreset = slot;
+    return true;
+}
+
+bool effectsCore_isPresetStored(uint8_t slot) {
+    return slot < EFFECT_PRESET_SLOTS && presetStored[slot];
+}
+
+const char* effectsCore_getPresetName(uint8_t slot) {
+    return effectsCore_isPresetStored(slot) ? presetNames[slot] : NULL;
+}
+
+int effectsCore_getActivePreset(void) {
+    return activePreset;
+}
+
 //==============================================================================
 // PREFERENCES INTEGRATION
 //==============================================================================
 
 /**
- * @brief Save all effect states to preferences
+ * @brief Save the effect chain to preferences
+ *
+ * The whole chain goes into one preset; the enable flags and tint settings
+ * are mirrored for the code that reads them individually.
  */
 void effectsCore_saveToPreferences(void) {
-    // Save effect enabled states 
-    bool success = true;
-    
-    success &= setGlitchEnabled(effectsEnabled[EFFECT_GLITCH]);
-    success &= setScanlinesEnabled(effectsEnabled[EFFECT_SCANLINES]);
-    success &= setDitheringEnabled(effectsEnabled[EFFECT_DITHERING]);
-    success &= setChromaticEnabled(effectsEnabled[EFFECT_CHROMATIC]);
-    success &= setDotMatrixEnabled(effectsEnabled[EFFECT_DOT_MATRIX]);
-    success &= setPixelateEnabled(effectsEnabled[EFFECT_PIXELATE]);
-    success &= setTintEnabled(effectsEnabled[EFFECT_TINT]);
-    
+    effect_preset_t preset;
+    chainToPreset(&working, &preset);
+
+    bool success = saveEffectPreset(&preset, sizeof(preset));
+    success &= setGlitchEnabled(working.enabled[EFFECT_GLITCH]);
+    success &= setScanlinesEnabled(working.enabled[EFFECT_SCANLINES]);
+    success &= setDitheringEnabled(working.enabled[EFFECT_DITHERING]);
+    success &= setChromaticEnabled(working.enabled[EFFECT_CHROMATIC]);
+    success &= setDotMatrixEnabled(working.enabled[EFFECT_DOT_MATRIX]);
+    success &= setPixelateEnabled(working.enabled[EFFECT_PIXELATE]);
+    success &= setTintEnabled(working.enabled[EFFECT_TINT]);
+    success &= setTintColor(working.tint.tintColor);
+    success &= setTintIntensity(working.tint.intensity);
+
     if (!success) {
         ESP_LOGE(EFFECTS_LOG, "Failed to save some effect preferences");
     } else {
-        ESP_LOGI(EFFECTS_LOG, "All effect preferences saved successfully");
+        ESP_LOGI(EFFECTS_LOG, "Effect preferences updated");
     }
 }
 
 /**
- * @brief Load all effect states from preferences
+ * @brief Load the effect chain from preferences
+ *
+ * Restores the saved preset in one copy from the settings already in RAM.
+ * Before a preset has been saved, only the enable flags and tint settings
+ * exist, so the other parameters keep their defaults.
  */
 void effectsCore_loadFromPreferences(void) {
+    effect_preset_t preset;
+    if (loadEffectPreset(&preset, sizeof(preset)) == sizeof(preset) && effectsCore_applyPreset(&preset)) {
+        return;
+    }
+
     // Load effect enabled states
-    effectsEnabled[EFFECT_GLITCH] = getGlitchEnabled();
-    effectsEnabled[EFFECT_SCANLINES] = getScanlinesEnabled();
-    effectsEnabled[EFFECT_DITHERING] = getDitheringEnabled();
-    effectsEnabled[EFFECT_CHROMATIC] = getChromaticEnabled();
-    effectsEnabled[EFFECT_DOT_MATRIX] = getDotMatrixEnabled();
-    effectsEnabled[EFFECT_PIXELATE] = getPixelateEnabled();
-    
+    working.enabled[EFFECT_GLITCH] = getGlitchEnabled();
+    working.enabled[EFFECT_SCANLINES] = getScanlinesEnabled();
+    working.enabled[EFFECT_DITHERING] = getDitheringEnabled();
+    working.enabled[EFFECT_CHROMATIC] = getChromaticEnabled();
+    working.enabled[EFFECT_DOT_MATRIX] = getDotMatrixEnabled();
+    working.enabled[EFFECT_PIXELATE] = getPixelateEnabled();
+
     // Load tint effect state from preferences
-    effectsEnabled[EFFECT_TINT] = getTintEnabled();
-    
+    working.enabled[EFFECT_TINT] = getTintEnabled();
+
     // Load tint parameters from preferences
-    tintParams.tintColor = getTintColor();
-    tintParams.intensity = getTintIntensity();
-    
-    // Set parameter pointers
-    effectParams[EFFECT_TINT] = &tintParams;
-    effectParams[EFFECT_CHROMATIC] = &chromaticParams;
-    effectParams[EFFECT_SCANLINES] = &scanlineParams;
-    effectParams[EFFECT_DITHERING] = &ditherParams;
-    effectParams[EFFECT_GLITCH] = &glitchParams;
-    effectParams[EFFECT_DOT_MATRIX] = &dotMatrixParams;
-    effectParams[EFFECT_PIXELATE] = &pixelateParams;
+    working.tint.tintColor = getTintColor();
+    working.tint.intensity = getTintIntensity();
+
+    publishChain();
 }
 
 //==============================================================================
 // SCANLINE PROCESSING
 //==============================================================================
 
+/**
+ * @brief Charge the time since a mark to one effect
+ * @param type Effect that just ran
+ * @param since micros() when it started
+ * @return micros() now, the start of the next effect
+ */
+static inline unsigned long chargeEffectTime(effect_type_t type, unsigned long since) {
+    unsigned long now = micros();
+    performanceStats.effectTime[type] += now - since;
+    performanceStats.effectsApplied++;
+    return now;
+}
+
 /**
  * @brief Apply all enabled effects to a scanline
  * @param pixels Array of RGB565 pixels for current scanline
@@ -448,59 +742,48 @@ void effectsCore_applyToScanline(uint16_t* pixels, int width, int row) {
     if (!pixels || width <= 0 || !effectRegistryInitialized) {
         return;
     }
-    
+
+    // One load per scanline; a swap takes effect on the next one
+    const effect_chain_t* chain = activeChain.load(std::memory_order_acquire);
     unsigned long startTime = micros();
-    
-    // Apply effects in specific order matching original implementation
-    // 1. Tint effect first (affects all pixels)
-    if (effectsEnabled[EFFECT_TINT] && effectRegistry[EFFECT_TINT].apply && effectParams[EFFECT_TINT]) {
-        for (int i = 0; i < width; i++) {
-            uint16_t originalPixel = pixels[i];
-            pixels[i] = effectsTints_applyTint(originalPixel, (const tint_params_t*)effectParams[EFFECT_TINT], i, row);
-        }
-        performanceStats.effectsApplied++;
-    }
-    
-    // 2. Dithering (per-pixel effect)
-    if (effectsEnabled[EFFECT_DITHERING] && effectRegistry[EFFECT_DITHERING].apply && effectParams[EFFECT_DITHERING]) {
-        for (int i = 0; i < width; i++) {
-            pixels[i] = effectsRetro_applyBayerDithering(pixels[i], (const dither_params_t*)effectParams[EFFECT_DITHERING], i, row);
-        }
-        performanceStats.effectsApplied++;
-    }
-    
-    // 3. Chromatic aberration (scanline effect)
-    if (effectsEnabled[EFFECT_CHROMATIC] && effectRegistry[EFFECT_CHROMATIC].apply && effectParams[EFFECT_CHROMATIC]) {
-        effectsTints_applyChromaticAberration(pixels, width, row, (const chromatic_params_t*)effectParams[EFFECT_CHROMATIC]);
-        performanceStats.effectsApplied++;
-    }
-    
-    // 4. Dot matrix (per-pixel effect)
-    if (effectsEnabled[EFFECT_DOT_MATRIX] && effectRegistry[EFFECT_DOT_MATRIX].apply && effectParams[EFFECT_DOT_MATRIX]) {
-        effectsMatrix_applyDotMatrixEffect(pixels, width, row, (const dot_matrix_params_t*)effectParams[EFFECT_DOT_MATRIX]);
-        performanceStats.effectsApplied++;
-    }
-    
-    // 5. Pixelate (block effect)
-    if (effectsEnabled[EFFECT_PIXELATE] && effectRegistry[EFFECT_PIXELATE].apply && effectParams[EFFECT_PIXELATE]) {
-        effectsMatrix_applyPixelateEffect(pixels, width, row, (const pixelate_params_t*)effectParams[EFFECT_PIXELATE]);
-        performanceStats.effectsApplied++;
-    }
-    
-    // 6. Scanlines (per-pixel effect)
-    if (effectsEnabled[EFFECT_SCANLINES] && effectRegistry[EFFECT_SCANLINES].apply && effectParams[EFFECT_SCANLINES]) {
-        for (int i = 0; i < width; i++) {
-            pixels[i] = effectsRetro_applyScanline(pixels[i], (const scanline_params_t*)effectParams[EFFECT_SCANLINES], row);
+    unsigned long mark = startTime;
+
+    for (uint8_t step = 0; step < chain->stepCount; step++) {
+        effect_type_t type = chain->steps[step];
+        switch (type) {
+            case EFFECT_TINT:
+                for (int i = 0; i < width; i++) {
+                    pixels[i] = effectsTints_applyTint(pixels[i], &chain->tint, i, row);
+                }
+                break;
+            case EFFECT_DITHERING:
+                for (int i = 0; i < width; i++) {
+                    pixels[i] = effectsRetro_applyBayerDithering(pixels[i], &chain->dither, i, row);
+                }
+                break;
+            case EFFECT_CHROMATIC:
+                effectsTints_applyChromaticAberration(pixels, width, row, &chain->chromatic);
+                break;
+            case EFFECT_DOT_MATRIX:
+                effectsMatrix_applyDotMatrixEffect(pixels, width, row, &chain->dotMatrix);
+                break;
+            case EFFECT_PIXELATE:
+                effectsMatrix_applyPixelateEffect(pixels, width, row, &chain->pixelate);
+                break;
+            case EFFECT_SCANLINES:
+                for (int i = 0; i < width; i++) {
+                    pixels[i] = effectsRetro_applyScanline(pixels[i], &chain->scanline, row);
+                }
+                break;
+            case EFFECT_GLITCH:
+                effectsRetro_applyCRTGlitches(pixels, width, row, &chain->glitch);
+                break;
+            default:
+                break;
         }
-        performanceStats.effectsApplied++;
+        mark = chargeEffectTime(type, mark);
     }
-    
-    // 7. Glitch effects (scanline effect) - should be last
-    if (effectsEnabled[EFFECT_GLITCH] && effectRegistry[EFFECT_GLITCH].apply && effectParams[EFFECT_GLITCH]) {
-        effectsRetro_applyCRTGlitches(pixels, width, row, (const glitch_params_t*)effectParams[EFFECT_GLITCH]);
-        performanceStats.effectsApplied++;
-    }
-    
+
     performanceStats.totalPixels += width;
     performanceStats.processingTime += (micros() - startTime);
 }
@@ -511,7 +794,7 @@ void effectsCore_applyToScanline(uint16_t* pixels, int width, int row) {
 void effectsCore_clearPreferences(void) {
     // Disable all effects
     effectsCore_disableAllEffects();
-    
+
     // Reset to default parameters
     effectsCore_applyDefaultParams(EFFECT_TINT);
     effectsCore_applyDefaultParams(EFFECT_CHROMATIC);
@@ -520,7 +803,7 @@ void effectsCore_clearPreferences(void) {
     effectsCore_applyDefaultParams(EFFECT_GLITCH);
     effectsCore_applyDefaultParams(EFFECT_DOT_MATRIX);
     effectsCore_applyDefaultParams(EFFECT_PIXELATE);
-    
+
     // Save the cleared state
     effectsCore_saveToPreferences();
 }
@@ -534,39 +817,33 @@ bool effectsCore_applyDefaultParams(effect_type_t type) {
     if (!effectRegistryInitialized || type < 0 || type >= EFFECT_COUNT) {
         return false;
     }
-    
+
     switch (type) {
         case EFFECT_TINT:
-            tintParams = effectsTints_getDefaultTintParams();
-            effectParams[type] = &tintParams;
+            working.tint = effectsTints_getDefaultTintParams();
             break;
         case EFFECT_CHROMATIC:
-            chromaticParams = effectsTints_getDefaultChromaticParams();
-            effectParams[type] = &chromaticParams;
+            working.chromatic = effectsTints_getDefaultChromaticParams();
             break;
         case EFFECT_SCANLINES:
-            scanlineParams = effectsRetro_getDefaultScanlineParams();
-            effectParams[type] = &scanlineParams;
+            working.scanline = effectsRetro_getDefaultScanlineParams();
             break;
         case EFFECT_DITHERING:
-            ditherParams = effectsRetro_getDefaultDitherParams();
-            effectParams[type] = &ditherParams;
+            working.dither = effectsRetro_getDefaultDitherParams();
             break;
         case EFFECT_GLITCH:
-            glitchParams = effectsRetro_getDefaultGlitchParams();
-            effectParams[type] = &glitchParams;
+            working.glitch = effectsRetro_getDefaultGlitchParams();
             break;
         case EFFECT_DOT_MATRIX:
-            dotMatrixParams = effectsMatrix_getDefaultDotMatrixParams();
-            effectParams[type] = &dotMatrixParams;
+            working.dotMatrix = effectsMatrix_getDefaultDotMatrixParams();
             break;
         case EFFECT_PIXELATE:
-            pixelateParams = effectsMatrix_getDefaultPixelateParams();
-            effectParams[type] = &pixelateParams;
+            working.pixelate = effectsMatrix_getDefaultPixelateParams();
             break;
         default:
             return false;
     }
-    
+
+    publishChain();
     return true;
 }
@@ -24,6 +24,42 @@
 #include "effects_tints.h"
 #include <Arduino.h>
 
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+// Dot pattern for one grid cell, bit x of row y set for dot pixels. Built
+// on first use after the mode or size changes instead of per pixel.
+static uint8_t dotMaskRows[8];
+static int dotMaskSize = 0;
+static DotMatrixMode dotMaskMode = DOT_MATRIX_NONE;
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Look up a pixel in the dot pattern, rebuilding it if stale
+ * @param dotSize Clamped dot size (1-8), also the grid period
+ */
+static bool isDotPixelCached(int x, int y, int dotSize, DotMatrixMode mode) {
+  if (dotMaskSize != dotSize || dotMaskMode != mode) {
+    for (int row = 0; row < dotSize; row++) {
+      uint8_t bits = 0;
+      for (int col = 0; col < dotSize; col++) {
+        if (effectsMatrix_isDotPixel(col, row, dotSize, mode)) {
+          bits |= 1 << col;
+        }
+      }
+      dotMaskRows[row] = bits;
+    }
+    dotMaskSize = dotSize;
+    dotMaskMode = mode;
+  }
+
+  return (dotMaskRows[y % dotSize] >> (x % dotSize)) & 1;
+}
+
 //==============================================================================
 // MATRIX EFFECTS INITIALIZATION
 //==============================================================================
@@ -106,8 +142,7 @@ uint16_t effectsMatrix_applyDotMatrixToPixel(uint16_t pixel,
   b = effectsRetro_quantizeColorComponent(b, 31, clampedParams.quantization,
                                           0.5f);
 
-  if (!effectsMatrix_isDotPixel(x, y, clampedParams.dotSize,
-                                clampedParams.mode)) {
+  if (!isDotPixelCached(x, y, clampedParams.dotSize, clampedParams.mode)) {
     // This pixel should be darkened by the dot matrix
 
     // Use more stable brightness detection - check individual components
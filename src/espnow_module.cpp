@@ -7,8 +7,10 @@
  */
 
 #include "espnow_module.h"
+#include "adxl_module.h"
 #include "common.h"
 #include "emotes_module.h"
+#include "menu_button.h"
 #include "motion_module.h"
 #include "wifi_common.h"
 #include "wifi_module.h"
@@ -17,14 +19,64 @@
 #include "states_module.h"
 #include "soundsfx_communication.h"
 #include "soundsfx_module.h"
+#include <esp_wifi.h>
 #include <stdarg.h>
 
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef enum {
+  RADIO_EVENT_RECEIVED,
+  RADIO_EVENT_SENT
+} radio_event_kind_t;
+
+/**
+ * @brief Callback data handed from the WiFi task to the main loop
+ */
+typedef struct {
+  radio_event_kind_t kind;
+  uint8_t mac[6];
+  bool delivered;               // RADIO_EVENT_SENT
+  uint8_t length;               // RADIO_EVENT_RECEIVED
+  uint8_t data[sizeof(Frame)];  // RADIO_EVENT_RECEIVED
+} radio_event_t;
+
+/**
+ * @brief One conversation member and the frames exchanged with it
+ */
+typedef struct {
+  bool active;
+  uint8_t mac[6];
+
+  // Outgoing events, batched into the next frame to this peer
+  ConversationType pendingEvents[ESPNOW_MAX_EVENTS];
+  size_t pendingEventCount;
+
+  // Sequence of the next EVENTS frame to this peer
+  uint8_t nextSeq;
+
+  // Frame waiting for this peer's ACK
+  Frame inFlightFrame;
+  size_t inFlightLength;
+  bool inFlightActive;
+  int inFlightRetries;
+  unsigned long inFlightSentAt;       // Last transmission
+  unsigned long inFlightFirstSentAt;  // First transmission, for the round trip
+  int consecutiveFailures;
+
+  // Last sequence received from this peer, to drop retransmissions
+  uint8_t lastSeq;
+  bool lastSeqValid;
+
+  PeerLinkStats stats;
+} espnow_peer_t;
+
 //==============================================================================
 // GLOBAL VARIABLES
 //==============================================================================
 
 const int MAX_FAILURES = 4;
-const int MAX_BROADCAST_ATTEMPTS = 6;
 static const char *currentAnimationPath = nullptr;
 static ConversationType currentConversationType = ConversationType::HELLO;
 
@@ -63,17 +115,35 @@ static const ConversationSoundMapping CONVERSATION_SOUND_TYPES[] = {
   {ConversationType::SHOCK, "shock", 80}
 };
 
-uint8_t peerMac[6] = {0};
 bool espNowStateChanged = false;
 
+// Radio callbacks only push here; the main loop does the rest
+static QueueHandle_t radioEvents = NULL;
+static volatile uint32_t droppedRadioEvents = 0;
+
+// Conversation members besides this device
+static espnow_peer_t peers[ESPNOW_MAX_PEERS];
+static size_t peerCount = 0;
+static uint8_t ownMac[6] = {0};
+static uint8_t nextDiscoverySeq = 0; // DISCOVERY frames; EVENTS frames count per peer
+
+// Round-robin position; the member of rank turn % members speaks next
+static size_t conversationTurn = 0;
+
+// Events received from any peer, each shown once the one before it has played
+static ConversationType receivedEvents[ESPNOW_MAX_EVENTS];
+static size_t receivedEventHead = 0;
+static size_t receivedEventCount = 0;
+
+// Discovery beacons back off while nobody answers; each opens a listen window
+static unsigned long discoveryInterval = ComsInterval::DISCOVERY_INTERVAL;
+static unsigned long nextBeaconTime = 0;
+static unsigned long listenUntil = 0;
+
 ComStatus currentStatus = ComStatus::DISCOVERY;
 ComState currentComState = ComState::NONE;
-DeviceRole currentRole = DeviceRole::UNKNOWN;
 ESPNowState currentESPNowState = ESPNowState::OFF;
 
-int consecutiveFailures = 0;
-int broadcastAttempts = 0;
-unsigned long lastBroadcastTime = 0;
 unsigned long lastStatusTime = 0;
 unsigned long lastMessageTime = 0;
 unsigned long lastToggleTime = 0;
@@ -137,27 +207,25 @@ static void Send_data_cb(const uint8_t *mac, esp_now_send_status_t status);
 static void Receive_data_cb(const uint8_t *mac, const uint8_t *data, int len);
 
 /**
- * @brief Handle device pairing process
- * @param mac MAC address of device to pair with
+ * @brief Drop every peer and return to discovery mode
  */
-static void handlePairing(const uint8_t *mac);
+static void handleConnectionLost(void);
 
 /**
- * @brief Handle connection loss and reset communication
+ * @brief Drop every peer and the queued conversation, leaving the animation alone
  */
-static void handleConnectionLost(void);
+static void dropPeers(void);
 
 /**
- * @brief Send a data message to paired device
- * @param text Message text content
+ * @brief Queue an event for every peer and play it locally
  * @param type Conversation type for animation selection
- * @return true if message was sent successfully
+ * @return true if the event was queued
  */
-static bool sendDataMessage(const char *text, ConversationType type);
+static bool sendEvent(ConversationType type);
 
 /**
- * @brief Send a discovery broadcast message
- * @return true if message was sent successfully
+ * @brief Send a discovery beacon when one is due
+ * @return true if a beacon was sent
  */
 static bool sendDiscoveryMessage(void);
 
@@ -233,252 +301,522 @@ static bool setupPeer(const uint8_t *mac) {
 
 /**
  * @brief Callback function to receive data from ESP-NOW protocol
+ * Runs on the WiFi task, so it only copies the frame into the queue.
  */
 static void Receive_data_cb(const uint8_t *mac, const uint8_t *data, int len) {
-  // Log EVERY received message, regardless of validity
-  char macStr[18];
-  formatMacAddress(mac, macStr);
-  ESP_LOGI(ESPNOW_LOG, "📨 RAW RECEIVE: %d bytes from %s", len, macStr);
-  
-  if (len != sizeof(Message)) {
-    ESP_LOGE(ESPNOW_LOG, "Invalid message size: received %d bytes, expected %d",
-             len, sizeof(Message));
+  if (len < (int)sizeof(FrameHeader) || len > (int)sizeof(Frame)) {
+    droppedRadioEvents++;
     return;
   }
 
-  Message *msg = (Message *)data;
-  ESP_LOGI(ESPNOW_LOG, "📨 MSG: sig=0x%X, text='%s', type=%d from %s", 
-           msg->signature, msg->text, (int)msg->type, macStr);
-           
-  if (msg->signature != APP_SIGNATURE) {
-    ESP_LOGE(ESPNOW_LOG, "App signature mismatch: received 0x%X, expected 0x%X",
-             msg->signature, APP_SIGNATURE);
-    return;
+  radio_event_t event;
+  event.kind = RADIO_EVENT_RECEIVED;
+  memcpy(event.mac, mac, 6);
+  event.delivered = false;
+  event.length = len;
+  memcpy(event.data, data, len);
+  if (xQueueSend(radioEvents, &event, 0) != pdTRUE) {
+    droppedRadioEvents++;
   }
+}
 
-  if (currentStatus == ComStatus::DISCOVERY) {
-    ESP_LOGI(ESPNOW_LOG, "🔗 Processing pairing from %s", macStr);
-    handlePairing(mac);
-    
-    // Only process the message if pairing was successful
-    if (currentStatus != ComStatus::PAIRED) {
-      espnowDebug("Pairing failed - ignoring message");
-      return;
+/**
+ * @brief Callback function to send data from ESP-NOW protocol
+ * Runs on the WiFi task, so it only queues the delivery status.
+ */
+static void Send_data_cb(const uint8_t *mac, esp_now_send_status_t status) {
+  radio_event_t event;
+  event.kind = RADIO_EVENT_SENT;
+  memcpy(event.mac, mac, 6);
+  event.delivered = (status == ESP_NOW_SEND_SUCCESS);
+  event.length = 0;
+  if (xQueueSend(radioEvents, &event, 0) != pdTRUE) {
+    droppedRadioEvents++;
+  }
+}
+
+/**
+ * @brief Send a frame
+ * @param mac Destination, a registered peer or the broadcast address
+ * @param frame Frame to send; only the header and payloadLength bytes go out
+ * @param payloadLength Used payload bytes
+ * @return true if the frame was handed to the radio
+ */
+static bool sendFrame(const uint8_t *mac, const Frame *frame, size_t payloadLength) {
+  esp_err_t result = esp_now_send(mac, (const uint8_t *)frame, sizeof(FrameHeader) + payloadLength);
+  if (result != ESP_OK) {
+    ESP_LOGW(ESPNOW_LOG, "Failed to send frame: %s", esp_err_to_name(result));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Find a peer in the table
+ * @param mac MAC address of the peer
+ * @return Peer, or nullptr if the MAC is not paired
+ */
+static espnow_peer_t *findPeer(const uint8_t *mac) {
+  for (espnow_peer_t &peer : peers) {
+    if (peer.active && memcmp(peer.mac, mac, 6) == 0) {
+      return &peer;
     }
-    
-    // Log successful pairing with role assignment
-    espnowDebug("Pairing successful - Role: %s", 
-                currentRole == DeviceRole::INITIATOR ? "INITIATOR" : "RESPONDER");
   }
+  return nullptr;
+}
 
-  currentAnimationPath = getAnimationPath(msg->type);
-  currentConversationType = msg->type;
-  
-  if (msg->type == ConversationType::SHOCK ||
-    msg->type == ConversationType::ZONE) {
-      currentComState = ComState::PROCESSING;
-    } else if (currentAnimationPath != nullptr) {
-      currentComState = ComState::PROCESSING;
+/**
+ * @brief Restart discovery at its shortest interval
+ * Called whenever the group changes, since others are likely to be listening.
+ */
+static void resetDiscoveryBackoff() {
+  discoveryInterval = ComsInterval::DISCOVERY_INTERVAL;
+  // Jittered so members reacting to the same change do not beacon together
+  nextBeaconTime = millis() + random(ComsInterval::DISCOVERY_INTERVAL * ESPNOW_DISCOVERY_JITTER_PERCENT / 100 + 1);
+}
+
+/**
+ * @brief Spread an interval by up to ESPNOW_DISCOVERY_JITTER_PERCENT either way
+ */
+static unsigned long jitterInterval(unsigned long interval) {
+  unsigned long spread = interval * ESPNOW_DISCOVERY_JITTER_PERCENT / 100;
+  return interval - spread + random(2 * spread + 1);
+}
+
+/**
+ * @brief Time until the radio is next needed
+ * @return 0 while a listen window is open, a frame is in flight or radio events are waiting
+ */
+static unsigned long getRadioIdleTime() {
+  unsigned long currentTime = millis();
+
+  if ((long)(listenUntil - currentTime) > 0 || (radioEvents && uxQueueMessagesWaiting(radioEvents) > 0)) {
+    return 0;
+  }
+  for (const espnow_peer_t &peer : peers) {
+    if (peer.active && peer.inFlightActive) {
+      return 0;
     }
+  }
+  return (long)(nextBeaconTime - currentTime) > 0 ? nextBeaconTime - currentTime : 0;
+}
 
+/**
+ * @brief Position of a member in the conversation turn order
+ * @param mac MAC address of this device or of a peer
+ * @return 0 for the highest MAC in the group
+ *
+ * Every member orders the group the same way, so turns agree without
+ * negotiation; received events resynchronize the turn if they drift.
+ */
+static size_t getMemberRank(const uint8_t *mac) {
+  size_t rank = memcmp(ownMac, mac, 6) > 0 ? 1 : 0;
+  for (const espnow_peer_t &peer : peers) {
+    if (peer.active && memcmp(peer.mac, mac, 6) > 0) {
+      rank++;
+    }
+  }
+  return rank;
 }
 
 /**
- * @brief Callback function to send data from ESP-NOW protocol
+ * @brief Add a device to the peer table
+ * @param mac MAC address of the device
+ * @return New peer, or nullptr if the table is full or the radio refused it
  */
-static void Send_data_cb(const uint8_t *mac, esp_now_send_status_t status) {
+static espnow_peer_t *addPeer(const uint8_t *mac) {
   char macStr[18];
   formatMacAddress(mac, macStr);
-  if (status == ESP_NOW_SEND_SUCCESS) {
-    consecutiveFailures = 0;
-  } else {
-    ESP_LOGE(ESPNOW_LOG, "::Delivery failed to:: %s", macStr);
-    if (++consecutiveFailures >= MAX_FAILURES) {
-      handleConnectionLost();
+
+  espnow_peer_t *slot = nullptr;
+  for (espnow_peer_t &peer : peers) {
+    if (!peer.active) {
+      slot = &peer;
+      break;
     }
   }
+  if (!slot) {
+    espnowDebug("Peer table full - ignoring %s", macStr);
+    return nullptr;
+  }
+
+  if (!setupPeer(mac)) {
+    ESP_LOGE(ESPNOW_LOG, "Failed to add peer %s during pairing", macStr);
+    return nullptr;
+  }
+
+  *slot = {};
+  slot->active = true;
+  memcpy(slot->mac, mac, 6);
+  memcpy(slot->stats.mac, mac, 6);
+  slot->stats.lastHeard = millis();
+  peerCount++;
+  currentStatus = ComStatus::PAIRED;
+  resetDiscoveryBackoff();
+
+  // Reset conversation timing to prevent immediate message sending
+  lastMessageTime = millis();
+
+  espnowDebug("Paired with %s (%u/%d peers, rank %u)", macStr, (unsigned)peerCount, ESPNOW_MAX_PEERS,
+              (unsigned)getMemberRank(ownMac));
+  return slot;
 }
 
 /**
- * @brief Handle lost connection to paired device
+ * @brief Remove a peer that stopped acknowledging
+ * @param peer Peer to remove
  */
-static void handleConnectionLost() {
-  currentStatus = ComStatus::DISCOVERY;
-  currentRole = DeviceRole::UNKNOWN;
-  ESP_LOGW(ESPNOW_LOG, "Connection reset - returning to discovery mode");
+static void removePeer(espnow_peer_t *peer) {
+  char macStr[18];
+  formatMacAddress(peer->mac, macStr);
+  ESP_LOGW(ESPNOW_LOG, "Lost peer %s", macStr);
 
-  if (isPaired()) {
-    esp_now_del_peer(peerMac);
+  esp_now_del_peer(peer->mac);
+  peer->active = false;
+  peerCount--;
+  resetDiscoveryBackoff();
+
+  if (peerCount == 0) {
+    ESP_LOGW(ESPNOW_LOG, "Connection reset - returning to discovery mode");
+    currentStatus = ComStatus::DISCOVERY;
+    resetAnimationPath();
+    receivedEventCount = 0;
+    lastMessageTime = 0;
   }
+}
 
-  memset(peerMac, 0, 6);
+/**
+ * @brief Acknowledge a frame from a peer
+ * @param peer Sender of the frame
+ * @param seq Sequence of the frame being acknowledged
+ */
+static void sendAck(const espnow_peer_t *peer, uint8_t seq) {
+  Frame frame;
+  frame.header = {ESPNOW_VERSION_BYTE, FrameType::ACK, 0, seq};
+  sendFrame(peer->mac, &frame, 0);
+}
 
-  resetAnimationPath();
-  consecutiveFailures = 0;
-  broadcastAttempts = 0;
-  lastBroadcastTime = 0;
-  lastMessageTime = 0;
+/**
+ * @brief Send a peer's pending events as one frame, once its last one is acknowledged
+ * @param peer Destination peer
+ */
+static void flushEvents(espnow_peer_t *peer) {
+  if (!peer->active || peer->inFlightActive || peer->pendingEventCount == 0) {
+    return;
+  }
 
-  if (!startDiscovery()) {
-    ESP_LOGE(ESPNOW_LOG, "Failed to return to discovery mode");
+  peer->inFlightFrame.header = {ESPNOW_VERSION_BYTE, FrameType::EVENTS, FRAME_FLAG_ACK_REQUEST, peer->nextSeq++};
+  for (size_t i = 0; i < peer->pendingEventCount; i++) {
+    peer->inFlightFrame.payload[i] = (uint8_t)peer->pendingEvents[i];
+  }
+  peer->inFlightLength = peer->pendingEventCount;
+  peer->pendingEventCount = 0;
+
+  peer->inFlightActive = true;
+  peer->inFlightRetries = 0;
+  peer->inFlightSentAt = millis();
+  peer->inFlightFirstSentAt = peer->inFlightSentAt;
+  peer->stats.framesSent++;
+  sendFrame(peer->mac, &peer->inFlightFrame, peer->inFlightLength);
+}
+
+/**
+ * @brief Handle a peer's ACK of the frame in flight
+ * @param peer Sender of the ACK
+ * @param seq Acknowledged sequence
+ */
+static void handleAck(espnow_peer_t *peer, uint8_t seq) {
+  if (!peer->inFlightActive || seq != peer->inFlightFrame.header.seq) {
     return;
   }
+
+  // Only first attempts give an unambiguous round trip
+  if (peer->inFlightRetries == 0) {
+    uint32_t sample = millis() - peer->inFlightFirstSentAt;
+    peer->stats.rttMs = peer->stats.rttMs ? (peer->stats.rttMs * 7 + sample) / 8 : sample;
+  }
+  peer->stats.framesAcked++;
+  peer->inFlightActive = false;
+  peer->consecutiveFailures = 0;
+  flushEvents(peer);
 }
 
 /**
- * @brief Handle pairing with another device
- * @param mac MAC address of device to pair with
+ * @brief Retransmit a peer's frame once its ACK is overdue
+ * @param peer Peer to check
+ *
+ * A frame that runs out of retries counts as one delivery failure.
  */
-static void handlePairing(const uint8_t *mac) {
-  char macStr[18];
-  formatMacAddress(mac, macStr);
-  
-  // Check if we're already paired with this exact device
-  if (currentStatus == ComStatus::PAIRED && memcmp(peerMac, mac, 6) == 0) {
-    espnowDebug("Already paired with %s - ignoring duplicate pairing request", macStr);
-    return; // Don't send ACK messages during pairing
+static void checkAckTimeout(espnow_peer_t *peer) {
+  if (!peer->inFlightActive || millis() - peer->inFlightSentAt < ESPNOW_ACK_TIMEOUT_MS) {
+    return;
   }
-  
-  // If we're already paired with a different device, disconnect first
-  if (currentStatus == ComStatus::PAIRED) {
-    espnowDebug("Already paired with different device - disconnecting to pair with %s", macStr);
-    esp_now_del_peer(peerMac);
-    memset(peerMac, 0, 6);
-    currentStatus = ComStatus::DISCOVERY;
-    currentRole = DeviceRole::UNKNOWN;
+
+  if (peer->inFlightRetries < ESPNOW_MAX_RETRIES) {
+    peer->inFlightRetries++;
+    peer->inFlightSentAt = millis();
+    peer->inFlightFrame.header.flags |= FRAME_FLAG_RETRY;
+    peer->stats.retries++;
+    espnowDebug("Retrying frame %u (%d/%d)", peer->inFlightFrame.header.seq, peer->inFlightRetries,
+                ESPNOW_MAX_RETRIES);
+    sendFrame(peer->mac, &peer->inFlightFrame, peer->inFlightLength);
+    return;
   }
-  
-  espnowDebug("Starting pairing process with %s", macStr);
-  
-  // Store the new peer MAC
-  memcpy(peerMac, mac, 6);
-  
-  // Set up the peer for bidirectional communication
-  if (!setupPeer(mac)) {
-    ESP_LOGE(ESPNOW_LOG, "Failed to add peer %s during pairing", macStr);
-    memset(peerMac, 0, 6); // Clear failed peer
+
+  peer->inFlightActive = false;
+  peer->stats.framesLost++;
+  ESP_LOGW(ESPNOW_LOG, "Frame %u was not acknowledged", peer->inFlightFrame.header.seq);
+  if (++peer->consecutiveFailures >= MAX_FAILURES) {
+    removePeer(peer);
     return;
   }
-  
-  // Determine device role based on MAC comparison
-  uint8_t myMac[6];
-  WiFi.macAddress(myMac);
-  currentRole = (memcmp(myMac, mac, 6) > 0) ? DeviceRole::INITIATOR : DeviceRole::RESPONDER;
-  
-  // Set pairing status only after everything succeeds
-  currentStatus = ComStatus::PAIRED;
-  
-  // Reset conversation timing to prevent immediate message sending
-  lastMessageTime = millis();
-  
-  espnowDebug("Pairing completed with %s (Role: %s)", 
-              macStr, currentRole == DeviceRole::INITIATOR ? "INITIATOR" : "RESPONDER");
+  flushEvents(peer);
 }
 
 /**
- * @brief Send a discovery broadcast message
- * @return true if message was sent successfully
+ * @brief Show a conversation event from a peer
+ * @param type Conversation type for animation selection
  */
-static bool sendDiscoveryMessage() {
-  if (getCurrentESPNowState() == ESPNowState::OFF ||
-      currentStatus != ComStatus::DISCOVERY) {
-    return false;
+static void applyEvent(ConversationType type) {
+  currentAnimationPath = getAnimationPath(type);
+  currentConversationType = type;
+
+  if (type == ConversationType::SHOCK || type == ConversationType::ZONE) {
+    currentComState = ComState::PROCESSING;
+  } else if (currentAnimationPath != nullptr) {
+    currentComState = ComState::PROCESSING;
   }
+}
 
-  unsigned long currentTime = millis();
-  unsigned long previousMessageTime = lastMessageTime;
+/**
+ * @brief Queue a received event to be shown after the ones before it
+ * handleCommunication() takes the next event once finishConversationAnimation()
+ * reports that the previous one has played.
+ */
+static void queueReceivedEvent(uint8_t value) {
+  if (value > (uint8_t)ConversationType::SHOCK || receivedEventCount == ESPNOW_MAX_EVENTS) {
+    return;
+  }
+  receivedEvents[(receivedEventHead + receivedEventCount) % ESPNOW_MAX_EVENTS] = (ConversationType)value;
+  receivedEventCount++;
+}
 
-  if (currentTime - lastMessageTime < ComsInterval::DISCOVERY_INTERVAL)
-    return false;
+/**
+ * @brief Handle a frame taken from the radio queue
+ * @param mac MAC address of the sender
+ * @param frame Received frame
+ * @param length Received length, at least the header
+ */
+static void handleFrame(const uint8_t *mac, const Frame *frame, size_t length) {
+  const FrameHeader &header = frame->header;
+  if (header.version != ESPNOW_VERSION_BYTE) {
+    espnowDebug("Ignoring frame with version byte 0x%02X", header.version);
+    return;
+  }
 
-  if (currentTime - lastBroadcastTime < ComsInterval::DISCOVERY_INTERVAL) {
-    return false;
+  espnow_peer_t *peer = findPeer(mac);
+
+  if (header.type == FrameType::ACK) {
+    if (peer) {
+      peer->stats.lastHeard = millis();
+      handleAck(peer, header.seq);
+    }
+    return;
   }
 
-  lastMessageTime = currentTime;
-  lastBroadcastTime = currentTime;
-  broadcastAttempts++;
+  if (header.type != FrameType::DISCOVERY && header.type != FrameType::EVENTS) {
+    return;
+  }
 
-  espnowDebug("📡 Sending discovery broadcast #%d/%d: 'SEARCHING PEERS'", 
-           broadcastAttempts, MAX_BROADCAST_ATTEMPTS);
+  if (!peer) {
+    peer = addPeer(mac);
+    if (!peer) {
+      return;
+    }
 
-  Message msg = {};
-  msg.signature = APP_SIGNATURE;
-  WiFi.macAddress(msg.mac);
-  strcpy(msg.text, "SEARCHING PEERS");
-  msg.type = ConversationType::HELLO;
+    // Answer a newcomer's discovery so it does not wait out its own backoff
+    if (header.type == FrameType::DISCOVERY && !(header.flags & FRAME_FLAG_REPLY)) {
+      Frame reply;
+      reply.header = {ESPNOW_VERSION_BYTE, FrameType::DISCOVERY, FRAME_FLAG_REPLY, nextDiscoverySeq++};
+      sendFrame(mac, &reply, 0);
+    }
+    if (header.type == FrameType::DISCOVERY) {
+      queueReceivedEvent((uint8_t)ConversationType::HELLO);
+    }
+  }
+  peer->stats.lastHeard = millis();
 
-  uint8_t broadcastAddr[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  if (header.type == FrameType::DISCOVERY) {
+    return;
+  }
 
-  if (broadcastAttempts >= MAX_BROADCAST_ATTEMPTS) {
-    ESP_LOGW(ESPNOW_LOG, "Max discovery attempts reached, resetting discovery cycle");
-    handleConnectionLost();
-    broadcastAttempts = 0;
+  if (header.flags & FRAME_FLAG_ACK_REQUEST) {
+    sendAck(peer, header.seq);
   }
 
-  esp_err_t result = esp_now_send(broadcastAddr, (uint8_t *)&msg, sizeof(Message));
-  if (result == ESP_OK) {
-    ESP_LOGV(ESPNOW_LOG, "Discovery message sent successfully");
-    return true;
-  } else {
-    ESP_LOGW(ESPNOW_LOG, "Failed to send discovery message: %s", esp_err_to_name(result));
+  // A repeated sequence means our ACK was lost; the events were already queued
+  if (peer->lastSeqValid && header.seq == peer->lastSeq) {
+    return;
+  }
+  peer->lastSeq = header.seq;
+  peer->lastSeqValid = true;
+
+  for (size_t i = 0; i < length - sizeof(FrameHeader); i++) {
+    queueReceivedEvent(frame->payload[i]);
+  }
+
+  // The member after the speaker goes next
+  conversationTurn = getMemberRank(mac) + 1;
+}
+
+/**
+ * @brief Drain the radio queue filled by the callbacks
+ */
+static void processRadioEvents() {
+  radio_event_t event;
+  if (!radioEvents) {
+    return;
+  }
+  while (xQueueReceive(radioEvents, &event, 0) == pdTRUE) {
+    if (event.kind == RADIO_EVENT_RECEIVED) {
+      handleFrame(event.mac, (const Frame *)event.data, event.length);
+      continue;
+    }
+
+    // No link-layer ACK either - retry now instead of waiting out the timeout
+    espnow_peer_t *peer = findPeer(event.mac);
+    if (!event.delivered && peer && peer->inFlightActive) {
+      peer->inFlightSentAt = millis() - ESPNOW_ACK_TIMEOUT_MS;
+    }
+  }
+}
+
+/**
+ * @brief Drop every peer and the queued conversation, leaving the animation alone
+ * Also runs on the transition worker: only handleCommunication() reads this
+ * state, and the main loop does not call it while a transition is in flight.
+ */
+static void dropPeers() {
+  for (espnow_peer_t &peer : peers) {
+    if (peer.active) {
+      esp_now_del_peer(peer.mac);
+      peer.active = false;
+    }
+  }
+  peerCount = 0;
+  currentStatus = ComStatus::DISCOVERY;
+  ESP_LOGW(ESPNOW_LOG, "Connection reset - returning to discovery mode");
+
+  receivedEventCount = 0;
+  conversationTurn = 0;
+  lastMessageTime = 0;
+  resetDiscoveryBackoff();
+
+  if (!startDiscovery()) {
+    ESP_LOGE(ESPNOW_LOG, "Failed to return to discovery mode");
+    return;
+  }
+}
+
+/**
+ * @brief Drop every peer and return to discovery mode
+ */
+static void handleConnectionLost() {
+  dropPeers();
+  resetAnimationPath();
+}
+
+/**
+ * @brief Send a discovery beacon when one is due
+ * @return true if a beacon was sent
+ *
+ * Beacons go out while the peer table has room. Each is followed by a
+ * listen window for the replies, and the interval to the next one doubles,
+ * jittered, up to DISCOVERY_MAX_INTERVAL; a change in the group resets it.
+ */
+static bool sendDiscoveryMessage() {
+  if (getCurrentESPNowState() == ESPNowState::OFF || peerCount == ESPNOW_MAX_PEERS) {
+    return false;
+  }
+
+  unsigned long currentTime = millis();
+  if ((long)(currentTime - nextBeaconTime) < 0) {
     return false;
   }
+
+  listenUntil = currentTime + ESPNOW_LISTEN_WINDOW_MS;
+  nextBeaconTime = currentTime + jitterInterval(discoveryInterval);
+  espnowDebug("📡 Sending discovery beacon, next in %lu ms", nextBeaconTime - currentTime);
+
+  discoveryInterval *= 2;
+  if (discoveryInterval > ComsInterval::DISCOVERY_MAX_INTERVAL) {
+    discoveryInterval = ComsInterval::DISCOVERY_MAX_INTERVAL;
+  }
+
+  Frame frame;
+  frame.header = {ESPNOW_VERSION_BYTE, FrameType::DISCOVERY, 0, nextDiscoverySeq++};
+
+  uint8_t broadcastAddr[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+  return sendFrame(broadcastAddr, &frame, 0);
 }
 
 /**
- * @brief Send a data message to the paired device
- * @param text Message text content
+ * @brief Queue an event for every peer and play it locally
  * @param type Conversation type for animation selection
- * @return true if message was sent successfully
+ * @return true if the event was queued
+ *
+ * Events queued while a peer's frame is waiting for its ACK go out together
+ * in that peer's next frame.
  */
-static bool sendDataMessage(const char *text,
-                            ConversationType type = ConversationType::HELLO) {
+static bool sendEvent(ConversationType type) {
   if (!isPaired())
     return false;
 
   unsigned long currentTime = millis();
-  unsigned long previousMessageTime = lastMessageTime;
 
   if (currentTime - lastMessageTime < ComsInterval::MESSAGE_INTERVAL)
     return false;
 
   lastMessageTime = currentTime;
 
-  Message msg = {};
-  msg.signature = APP_SIGNATURE;
-  WiFi.macAddress(msg.mac);
-  strncpy(msg.text, text, sizeof(msg.text) - 1);
-  msg.text[sizeof(msg.text) - 1] = '\0';
-  msg.type = type;
-  
-  currentAnimationPath = getAnimationPath(msg.type);
-  currentComState = ComState::PROCESSING;
+  for (espnow_peer_t &peer : peers) {
+    if (peer.active && peer.pendingEventCount < ESPNOW_MAX_EVENTS) {
+      peer.pendingEvents[peer.pendingEventCount++] = type;
+      flushEvents(&peer);
+    }
+  }
 
-  return esp_now_send(peerMac, (uint8_t *)&msg, sizeof(Message)) == ESP_OK;
+  currentAnimationPath = getAnimationPath(type);
+  currentComState = ComState::PROCESSING;
+  return true;
 }
 
 /**
- * @brief Handle sequential conversation between paired devices
+ * @brief Handle the round-robin conversation between paired devices
+ * Members speak in rank order, one per MESSAGE_INTERVAL.
  */
 static void handleSequentialConversation() {
   static unsigned long lastConversationTime = 0;
   static int sequenceIndex = 0;
   static bool orientationTriggered = false;
 
-  if (!isPaired() || currentRole == DeviceRole::UNKNOWN ||
-      millis() - lastConversationTime < ComsInterval::MESSAGE_INTERVAL) {
+  if (!isPaired() || millis() - lastConversationTime < ComsInterval::MESSAGE_INTERVAL) {
+    return;
+  }
+
+  // Do not talk over an animation that has not been shown yet
+  if (currentComState == ComState::PROCESSING) {
     return;
   }
 
   if (motionOriented()) {
     if (!orientationTriggered) {
-      if (sendDataMessage("ORIENTATION_CHANGE", ConversationType::SHOCK)) {
+      if (sendEvent(ConversationType::SHOCK)) {
         orientationTriggered = true;
         lastConversationTime = millis();
       }
     } else {
-      if (sendDataMessage("ORIENTATION_ZONED", ConversationType::ZONE)) {
+      if (sendEvent(ConversationType::ZONE)) {
         orientationTriggered = false;
         lastConversationTime = millis();
       }
@@ -492,20 +830,19 @@ static void handleSequentialConversation() {
     const size_t sequenceLength =
         sizeof(CONVERSATIONS) / sizeof(CONVERSATIONS[0]);
 
-    bool activeSender =
-        (currentRole == DeviceRole::INITIATOR && sequenceIndex % 2 == 0) ||
-        (currentRole == DeviceRole::RESPONDER && sequenceIndex % 2 == 1);
+    bool activeSender = conversationTurn % (peerCount + 1) == getMemberRank(ownMac);
 
     currentComState = ComState::WAITING;
 
     if (activeSender) {
       delay(random(100, 500));
-      if (sendDataMessage("CONVERSE", CONVERSATIONS[sequenceIndex].type)) {
+      if (sendEvent(CONVERSATIONS[sequenceIndex].type)) {
         lastConversationTime = millis();
       }
     }
 
     sequenceIndex = (sequenceIndex + 1) % sequenceLength;
+    conversationTurn++;
   }
 }
 
@@ -522,6 +859,13 @@ void resetAnimationPath() {
   currentComState = ComState::NONE;
 }
 
+void finishConversationAnimation() {
+  if (currentComState == ComState::PROCESSING) {
+    currentAnimationPath = nullptr;
+    currentComState = ComState::WAITING;
+  }
+}
+
 bool initializeESPNOW() {
   espnowDebug("Initializing ESP-NOW protocol...");
 
@@ -530,6 +874,17 @@ bool initializeESPNOW() {
     return false;
   }
 
+  if (!radioEvents) {
+    radioEvents = xQueueCreate(ESPNOW_QUEUE_LENGTH, sizeof(radio_event_t));
+    if (!radioEvents) {
+      ESP_LOGE(ESPNOW_LOG, "Failed to create radio event queue");
+      esp_now_deinit();
+      return false;
+    }
+  }
+
+  WiFi.macAddress(ownMac);
+
   espnowDebug("Registering ESP-NOW callbacks...");
   
   esp_err_t send_result = esp_now_register_send_cb(Send_data_cb);
@@ -555,6 +910,20 @@ bool isPaired() {
   return espnowState == ESPNowState::ON && currentStatus == ComStatus::PAIRED;
 }
 
+size_t getPeerCount() {
+  return peerCount;
+}
+
+size_t getPeerLinkStats(PeerLinkStats *stats, size_t maxPeers) {
+  size_t count = 0;
+  for (const espnow_peer_t &peer : peers) {
+    if (peer.active && count < maxPeers) {
+      stats[count++] = peer.stats;
+    }
+  }
+  return count;
+}
+
 bool startDiscovery() {
   if (getCurrentESPNowState() == ESPNowState::OFF) {
     espnowDebug("Cannot start discovery - ESP-NOW is OFF");
@@ -590,14 +959,29 @@ void handleCommunication() {
   if (getCurrentESPNowState() == ESPNowState::OFF)
     return;
 
+  processRadioEvents();
+  for (espnow_peer_t &peer : peers) {
+    if (peer.active) {
+      checkAckTimeout(&peer);
+    }
+  }
+
+  // The previous event's animation has to play before the next replaces it
+  if (receivedEventCount > 0 && currentComState != ComState::PROCESSING) {
+    applyEvent(receivedEvents[receivedEventHead]);
+    receivedEventHead = (receivedEventHead + 1) % ESPNOW_MAX_EVENTS;
+    receivedEventCount--;
+  }
+
+  // Discovery keeps going while paired so more devices can join
+  if (currentStatus == ComStatus::DISCOVERY && !firstDiscoveryLogShown) {
+    espnowDebug("🔍 ESP-NOW discovery active - looking for peers...");
+    firstDiscoveryLogShown = true;
+  }
+  sendDiscoveryMessage();
+
   if (millis() - lastAttempt > ComsInterval::STATUS_INTERVAL) {
-    if (currentStatus == ComStatus::DISCOVERY) {
-      if (!firstDiscoveryLogShown) {
-        espnowDebug("🔍 ESP-NOW discovery active - looking for peers...");
-        firstDiscoveryLogShown = true;
-      }
-      sendDiscoveryMessage();
-    } else if (currentStatus == ComStatus::PAIRED) {
+    if (currentStatus == ComStatus::PAIRED) {
       firstDiscoveryLogShown = false; // Reset for next discovery cycle
       handleSequentialConversation();
     }
@@ -605,6 +989,31 @@ void handleCommunication() {
   }
 }
 
+void handleDiscoveryPowerSave() {
+  if (getCurrentESPNowState() == ESPNowState::OFF || isPaired() || !motionSleep()) {
+    return;
+  }
+
+  unsigned long idleTime = getRadioIdleTime();
+  if (idleTime < ESPNOW_MIN_LIGHT_SLEEP_MS) {
+    return;
+  }
+
+  espnowDebug("Radio idle - light sleeping %lu ms until the next beacon", idleTime);
+  esp_wifi_stop();
+  // A button press (menu, leaving ESP mode) must not wait out the sleep
+  menuButton_enableWakeup();
+  bool motionWake = enterLightSleep(idleTime);
+  menuButton_disableWakeup();
+  esp_wifi_start();
+  esp_wifi_set_channel(ESPNOW_CHANNEL, WIFI_SECOND_CHAN_NONE);
+
+  // Someone picked the device up - look for peers right away
+  if (motionWake) {
+    resetDiscoveryBackoff();
+  }
+}
+
 void forceDisconnect() {
   if (isPaired() || currentStatus == ComStatus::DISCOVERY) {
     handleConnectionLost();
@@ -613,8 +1022,15 @@ void forceDisconnect() {
 
 void shutdownCommunication() {
   espnowDebug("Shutting down ESP-NOW communication...");
-  forceDisconnect();
+  dropPeers();
   esp_now_deinit();
+  if (radioEvents) {
+    xQueueReset(radioEvents);
+  }
+  if (droppedRadioEvents > 0) {
+    ESP_LOGW(ESPNOW_LOG, "%lu radio events were dropped", (unsigned long)droppedRadioEvents);
+    droppedRadioEvents = 0;
+  }
   espnowDebug("ESP-NOW communication shutdown completed");
   if (getCurrentState() == SystemState::ESP_MODE) {
     WiFi.disconnect(true);
@@ -638,9 +1054,11 @@ bool restartCommunication() {
 
   currentESPNowState = ESPNowState::ON;
   currentStatus = ComStatus::DISCOVERY;
+  resetDiscoveryBackoff();
 
   espnowDebug("ESP-NOW communication restarted - entering DISCOVERY mode");
-  espnowDebug("Broadcasting discovery messages every %lu ms", ComsInterval::DISCOVERY_INTERVAL);
+  espnowDebug("Discovery beacons from every %lu ms, backing off to %lu ms, %d ms listen windows",
+              ComsInterval::DISCOVERY_INTERVAL, ComsInterval::DISCOVERY_MAX_INTERVAL, ESPNOW_LISTEN_WINDOW_MS);
 
   if (!startDiscovery()) {
     currentESPNowState = ESPNowState::OFF;
@@ -8,6 +8,7 @@
 
 #include "flash_module.h"
 #include "common.h"
+#include <esp_system.h>
 
 //==============================================================================
 // GLOBAL VARIABLES
@@ -119,7 +120,9 @@ FSStatus initializeFS(bool formatOnFail) {
  
   FSInitialized = true;
   
-  if (!checkCriticalFiles()) {
+  // Files only change with a filesystem update, which restarts rather than
+  // sleeps, so a deep-sleep wake trusts the check made at the cold boot
+  if (esp_reset_reason() != ESP_RST_DEEPSLEEP && !checkCriticalFiles()) {
     ESP_LOGE(FLASH_LOG, "Critical files missing from filesystem");
     return FSStatus::FS_FILE_MISSING;
   }
@@ -18,6 +18,7 @@ AnimatedGIF gif;
 GIFContext gifContext = {nullptr, 0, 0};
 const size_t frameBufferSize = GIF_WIDTH * GIF_HEIGHT * 2;
 bool isInitialized = false;
+static volatile uint32_t framesPlayed = 0; // Read by the telemetry sampler
 File gifFile;
 
 //==============================================================================
@@ -207,7 +208,19 @@ bool loadGIF(const char *filename) {
  * @return Status code (0 = success, 1 = finished, negative = error)
  */
 int playGIFFrame(bool bSync, int *delayMilliseconds) {
-  return gif.playFrame(bSync, delayMilliseconds);
+  int result = gif.playFrame(bSync, delayMilliseconds);
+  if (result >= 0) {
+    framesPlayed++;
+  }
+  return result;
+}
+
+/**
+ * @brief Get the number of frames drawn since boot
+ * @return Frame counter (wraps)
+ */
+uint32_t getGIFFrameCount() {
+  return framesPlayed;
 }
 
 /**
@@ -0,0 +1,342 @@
+/**
+ * @file gzip_module.cpp
+ * @brief Implementation of streaming gzip decompression
+ *
+ * This module handles:
+ * - Incremental parsing of the gzip member header and optional fields
+ * - Inflating the deflate stream through a 32 KB circular window
+ * - Forwarding each inflated run to the output callback
+ * - Verifying the CRC32 and size trailer
+ */
+
+#include "gzip_module.h"
+#include <esp_rom_crc.h>
+#include <rom/miniz.h>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef enum {
+  GZIP_STATE_IDLE,
+  GZIP_STATE_HEADER,
+  GZIP_STATE_EXTRA_LENGTH,
+  GZIP_STATE_SKIP,
+  GZIP_STATE_STRING,
+  GZIP_STATE_DEFLATE,
+  GZIP_STATE_TRAILER,
+  GZIP_STATE_DONE,
+  GZIP_STATE_ERROR
+} gzip_state_t;
+
+typedef struct {
+  gzip_state_t state;
+  gzip_output_t output;
+  tinfl_decompressor *inflator;
+  uint8_t *window;        // TINFL_LZ_DICT_SIZE circular output window
+  size_t windowOffset;
+  uint8_t field[GZIP_HEADER_SIZE]; // Header, extra length or trailer being collected
+  size_t filled;
+  size_t skip;            // Bytes left in an optional field being skipped
+  uint8_t flags;          // Optional header fields still to parse
+  uint32_t crc;
+  size_t produced;
+  const char *error;
+} gzip_session_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static gzip_session_t gzip = {};
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Put the session into the error state
+ * @param message Error description, or NULL if the output callback failed
+ * @return Always false
+ */
+static bool failGzip(const char *message) {
+  if (message) {
+    ESP_LOGE(GZIP_LOG, "%s", message);
+  }
+  gzip.error = message;
+  gzip.state = GZIP_STATE_ERROR;
+  return false;
+}
+
+/**
+ * @brief Allocate a session buffer, preferring PSRAM
+ * @param size Number of bytes
+ * @return Buffer, or NULL if no memory is available
+ */
+static void *allocateBuffer(size_t size) {
+  void *buffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  if (!buffer) {
+    buffer = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+  }
+  return buffer;
+}
+
+/**
+ * @brief Release the inflater and window
+ */
+static void freeBuffers() {
+  if (gzip.inflator) {
+    heap_caps_free(gzip.inflator);
+    gzip.inflator = NULL;
+  }
+  if (gzip.window) {
+    heap_caps_free(gzip.window);
+    gzip.window = NULL;
+  }
+}
+
+/**
+ * @brief Collect bytes into the field buffer
+ * @param data Input bytes
+ * @param length Number of bytes available
+ * @param size Field size
+ * @return Number of bytes consumed
+ */
+static size_t collectField(const uint8_t *data, size_t length, size_t size) {
+  size_t count = min(length, size - gzip.filled);
+  memcpy(gzip.field + gzip.filled, data, count);
+  gzip.filled += count;
+  return count;
+}
+
+/**
+ * @brief Move to the next optional header field, or to the deflate stream
+ */
+static void nextHeaderField() {
+  gzip.filled = 0;
+
+  if (gzip.flags & GZIP_FLAG_EXTRA) {
+    gzip.flags &= ~GZIP_FLAG_EXTRA;
+    gzip.state = GZIP_STATE_EXTRA_LENGTH;
+  } else if (gzip.flags & GZIP_FLAG_NAME) {
+    gzip.flags &= ~GZIP_FLAG_NAME;
+    gzip.state = GZIP_STATE_STRING;
+  } else if (gzip.flags & GZIP_FLAG_COMMENT) {
+    gzip.flags &= ~GZIP_FLAG_COMMENT;
+    gzip.state = GZIP_STATE_STRING;
+  } else if (gzip.flags & GZIP_FLAG_HCRC) {
+    gzip.flags &= ~GZIP_FLAG_HCRC;
+    gzip.skip = 2;
+    gzip.state = GZIP_STATE_SKIP;
+  } else {
+    tinfl_init(gzip.inflator);
+    gzip.state = GZIP_STATE_DEFLATE;
+  }
+}
+
+/**
+ * @brief Validate the fixed gzip header
+ * @return true if this is a deflate-compressed gzip member
+ */
+static bool processHeader() {
+  if (gzip.field[0] != GZIP_MAGIC_0 || gzip.field[1] != GZIP_MAGIC_1) {
+    return failGzip("Not a gzip image");
+  }
+  if (gzip.field[2] != GZIP_METHOD_DEFLATE) {
+    return failGzip("Unsupported gzip compression method");
+  }
+
+  gzip.flags = gzip.field[3];
+  nextHeaderField();
+  return true;
+}
+
+/**
+ * @brief Inflate compressed bytes and forward the output
+ * @param data Compressed bytes
+ * @param length Number of bytes available
+ * @param consumed Receives the number of bytes consumed
+ * @return false on corrupt data or output failure
+ */
+static bool inflateData(const uint8_t *data, size_t length, size_t *consumed) {
+  *consumed = 0;
+
+  while (true) {
+    size_t inSize = length - *consumed;
+    size_t outSize = TINFL_LZ_DICT_SIZE - gzip.windowOffset;
+    tinfl_status status = tinfl_decompress(gzip.inflator, data + *consumed, &inSize, gzip.window,
+                                           gzip.window + gzip.windowOffset, &outSize,
+                                           TINFL_FLAG_HAS_MORE_INPUT);
+    *consumed += inSize;
+
+    if (outSize > 0) {
+      const uint8_t *out = gzip.window + gzip.windowOffset;
+      gzip.crc = esp_rom_crc32_le(gzip.crc, out, outSize);
+      gzip.produced += outSize;
+      if (!gzip.output(out, outSize)) {
+        return failGzip(NULL);
+      }
+      gzip.windowOffset = (gzip.windowOffset + outSize) & (TINFL_LZ_DICT_SIZE - 1);
+    }
+
+    if (status < TINFL_STATUS_DONE) {
+      return failGzip("Corrupt compressed data");
+    }
+    if (status == TINFL_STATUS_DONE) {
+      gzip.filled = 0;
+      gzip.state = GZIP_STATE_TRAILER;
+      return true;
+    }
+    if (status == TINFL_STATUS_NEEDS_MORE_INPUT && *consumed == length) {
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Check the CRC32 and size trailer
+ * @return true if the inflated stream matches the trailer
+ */
+static bool processTrailer() {
+  uint32_t crc;
+  uint32_t size;
+  memcpy(&crc, gzip.field, sizeof(crc));
+  memcpy(&size, gzip.field + 4, sizeof(size));
+
+  if (crc != gzip.crc) {
+    return failGzip("Compressed image CRC mismatch");
+  }
+  if (size != (uint32_t)gzip.produced) {
+    return failGzip("Compressed image size mismatch");
+  }
+
+  gzip.state = GZIP_STATE_DONE;
+  return true;
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+bool gzipStream_begin(gzip_output_t output) {
+  gzipStream_abort();
+
+  gzip.inflator = (tinfl_decompressor *)allocateBuffer(sizeof(tinfl_decompressor));
+  gzip.window = (uint8_t *)allocateBuffer(TINFL_LZ_DICT_SIZE);
+  if (!gzip.inflator || !gzip.window) {
+    freeBuffers();
+    return failGzip("Not enough memory for decompression");
+  }
+
+  gzip.output = output;
+  gzip.windowOffset = 0;
+  gzip.filled = 0;
+  gzip.crc = 0;
+  gzip.produced = 0;
+  gzip.error = NULL;
+  gzip.state = GZIP_STATE_HEADER;
+  return true;
+}
+
+bool gzipStream_write(const uint8_t *data, size_t length) {
+  while (length > 0) {
+    size_t count = 0;
+
+    switch (gzip.state) {
+    case GZIP_STATE_HEADER:
+      count = collectField(data, length, GZIP_HEADER_SIZE);
+      if (gzip.filled == GZIP_HEADER_SIZE && !processHeader()) {
+        return false;
+      }
+      break;
+
+    case GZIP_STATE_EXTRA_LENGTH:
+      count = collectField(data, length, 2);
+      if (gzip.filled == 2) {
+        gzip.skip = gzip.field[0] | (gzip.field[1] << 8);
+        gzip.state = GZIP_STATE_SKIP;
+        if (gzip.skip == 0) {
+          nextHeaderField();
+        }
+      }
+      break;
+
+    case GZIP_STATE_SKIP:
+      count = min(length, gzip.skip);
+      gzip.skip -= count;
+      if (gzip.skip == 0) {
+        nextHeaderField();
+      }
+      break;
+
+    case GZIP_STATE_STRING: {
+      const uint8_t *end = (const uint8_t *)memchr(data, 0, length);
+      count = end ? (size_t)(end - data) + 1 : length;
+      if (end) {
+        nextHeaderField();
+      }
+      break;
+    }
+
+    case GZIP_STATE_DEFLATE:
+      if (!inflateData(data, length, &count)) {
+        return false;
+      }
+      break;
+
+    case GZIP_STATE_TRAILER:
+      count = collectField(data, length, GZIP_TRAILER_SIZE);
+      if (gzip.filled == GZIP_TRAILER_SIZE && !processTrailer()) {
+        return false;
+      }
+      break;
+
+    case GZIP_STATE_DONE:
+      return failGzip("Unexpected data after end of compressed image");
+
+    default:
+      if (gzip.state == GZIP_STATE_IDLE) {
+        gzip.error = "No decompression in progress";
+      }
+      return false;
+    }
+
+    data += count;
+    length -= count;
+  }
+
+  return true;
+}
+
+bool gzipStream_end() {
+  bool complete = gzip.state == GZIP_STATE_DONE;
+  if (!complete && gzip.state != GZIP_STATE_ERROR) {
+    failGzip("Compressed image is incomplete");
+  }
+
+  freeBuffers();
+  if (complete) {
+    ESP_LOGI(GZIP_LOG, "Inflated %u bytes", (unsigned)gzip.produced);
+    gzip.state = GZIP_STATE_IDLE;
+  }
+  return complete;
+}
+
+void gzipStream_abort() {
+  freeBuffers();
+  if (gzip.state != GZIP_STATE_ERROR) {
+    gzip.state = GZIP_STATE_IDLE;
+  }
+}
+
+bool gzipStream_isActive() {
+  return gzip.state != GZIP_STATE_IDLE && gzip.state != GZIP_STATE_ERROR;
+}
+
+size_t gzipStream_outputSize() {
+  return gzip.produced;
+}
+
+const char *gzipStream_errorString() {
+  return gzip.error;
+}
@@ -0,0 +1,672 @@
+/**
+ * @file http_module.cpp
+ * @brief Implementation of the event-driven HTTP server
+ *
+ * This module handles:
+ * - The route table and the esp_http_server lifecycle
+ * - Status lines, JSON/text responses and chunked file responses
+ * - Header, query string and form argument access
+ * - Streaming line-by-line bodies and multipart/form-data uploads
+ * - WebSocket frames and broadcasts queued onto the server task
+ */
+
+#include "http_module.h"
+
+//==============================================================================
+// CONSTANTS & DEFINITIONS
+//==============================================================================
+
+// Upload data plus room to hold back a partial "\r\n--boundary" delimiter
+#define HTTP_RECEIVE_BUFFER_SIZE (HTTP_CHUNK_SIZE + HTTP_BOUNDARY_MAX + 4)
+#define HTTP_QUERY_MAX 256
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef enum {
+  MULTIPART_PREAMBLE, // Skipping up to the next delimiter
+  MULTIPART_BOUNDARY, // Delimiter found, "--" (end) or CRLF (part) follows
+  MULTIPART_HEADERS,  // Collecting part headers up to the blank line
+  MULTIPART_DATA,     // Delivering file bytes up to the next delimiter
+  MULTIPART_DONE
+} multipart_state_t;
+
+// Frame copied for httpd_queue_work, freed by the server task
+typedef struct {
+  size_t length;
+  uint8_t data[];
+} http_broadcast_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static httpd_handle_t server = NULL;
+static httpd_uri_t routes[HTTP_MAX_ROUTES];
+static size_t routeCount = 0;
+
+// Shared by all handlers; the server task runs one handler at a time
+static uint8_t *chunkBuffer = NULL;
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Get the status line for an HTTP status code
+ * @param status HTTP status code
+ * @return Status line as sent after "HTTP/1.1"
+ */
+static const char *statusLine(int status) {
+  switch (status) {
+  case 200:
+    return "200 OK";
+  case 202:
+    return "202 Accepted";
+  case 304:
+    return "304 Not Modified";
+  case 400:
+    return "400 Bad Request";
+  case 404:
+    return "404 Not Found";
+  case 413:
+    return "413 Payload Too Large";
+  case 503:
+    return "503 Service Unavailable";
+  default:
+    return "500 Internal Server Error";
+  }
+}
+
+/**
+ * @brief Allocate a buffer, preferring PSRAM
+ * @param size Number of bytes
+ * @return Buffer, or NULL if no memory is available
+ */
+static void *allocateBuffer(size_t size) {
+  void *buffer = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  if (!buffer) {
+    buffer = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+  }
+  return buffer;
+}
+
+/**
+ * @brief Receive body bytes, retrying socket timeouts
+ * @return Bytes received, or <= 0 if the connection failed
+ */
+static int receiveChunk(httpd_req_t *req, void *buffer, size_t size) {
+  for (int retry = 0; retry < HTTP_RECV_RETRIES; retry++) {
+    int received = httpd_req_recv(req, (char *)buffer, size);
+    if (received != HTTPD_SOCK_ERR_TIMEOUT) {
+      return received;
+    }
+  }
+  return HTTPD_SOCK_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Find a byte pattern
+ * @return Start of the first match, or NULL
+ */
+static const uint8_t *findBytes(const uint8_t *data, size_t length, const char *pattern, size_t patternLength) {
+  const uint8_t *end = data + length;
+  while (length >= patternLength) {
+    const uint8_t *match = (const uint8_t *)memchr(data, pattern[0], length - patternLength + 1);
+    if (!match) {
+      return NULL;
+    }
+    if (memcmp(match, pattern, patternLength) == 0) {
+      return match;
+    }
+    data = match + 1;
+    length = end - data;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Decode "+" and "%XX" escapes in place
+ * @param text Terminated string
+ */
+static void urlDecode(char *text) {
+  char *out = text;
+  for (const char *in = text; *in; in++) {
+    if (*in == '+') {
+      *out++ = ' ';
+    } else if (in[0] == '%' && isxdigit((unsigned char)in[1]) && isxdigit((unsigned char)in[2])) {
+      char hex[3] = {in[1], in[2], '\0'};
+      *out++ = (char)strtol(hex, NULL, 16);
+      in += 2;
+    } else {
+      *out++ = *in;
+    }
+  }
+  *out = '\0';
+}
+
+/**
+ * @brief Extract filename="..." from a part's header block
+ * @return true if the part is a file field
+ */
+static bool parseFilename(const uint8_t *headers, size_t length, char *filename, size_t size) {
+  static const char KEY[] = "filename=\"";
+  const uint8_t *start = findBytes(headers, length, KEY, sizeof(KEY) - 1);
+  if (!start) {
+    return false;
+  }
+  start += sizeof(KEY) - 1;
+
+  const uint8_t *end = (const uint8_t *)memchr(start, '"', headers + length - start);
+  if (!end || (size_t)(end - start) >= size) {
+    return false;
+  }
+  memcpy(filename, start, end - start);
+  filename[end - start] = '\0';
+  return true;
+}
+
+/**
+ * @brief Reply 404 for unregistered paths
+ */
+static esp_err_t handleNotFound(httpd_req_t *req, httpd_err_code_t error) {
+  return httpServer_sendText(req, 404, "Not found");
+}
+
+/**
+ * @brief Receive a raw (non-multipart) upload body
+ * The file name comes from the "filename" query argument.
+ */
+static esp_err_t receiveRawUpload(httpd_req_t *req, http_upload_begin_t begin, http_upload_write_t write) {
+  char filename[HTTP_HEADER_MAX];
+  if (!httpServer_queryArg(req, "filename", filename, sizeof(filename))) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!begin(req, filename)) {
+    return ESP_FAIL;
+  }
+
+  size_t remaining = req->content_len;
+  while (remaining > 0) {
+    int received = receiveChunk(req, chunkBuffer, min(remaining, (size_t)HTTP_CHUNK_SIZE));
+    if (received <= 0) {
+      return ESP_ERR_TIMEOUT;
+    }
+    remaining -= received;
+    if (!write(chunkBuffer, received)) {
+      return ESP_FAIL;
+    }
+  }
+  return ESP_OK;
+}
+
+/**
+ * @brief Receive a multipart/form-data body, delivering its first file part
+ * @param boundary Text after "boundary=" in the Content-Type header
+ *
+ * The body is read as if it began with CRLF so the opening boundary line
+ * matches the same "\r\n--boundary" delimiter as every later one. File bytes
+ * are passed on as soon as they cannot be the start of a delimiter.
+ */
+static esp_err_t receiveMultipart(httpd_req_t *req, const char *boundary, http_upload_begin_t begin,
+                                  http_upload_write_t write) {
+  if (*boundary == '"') {
+    boundary++;
+  }
+  size_t boundaryLength = strcspn(boundary, "\"; ");
+  if (boundaryLength == 0 || boundaryLength > HTTP_BOUNDARY_MAX) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  char delimiter[HTTP_BOUNDARY_MAX + 5];
+  size_t delimiterLength = snprintf(delimiter, sizeof(delimiter), "\r\n--%.*s", (int)boundaryLength, boundary);
+
+  uint8_t *buffer = chunkBuffer;
+  memcpy(buffer, "\r\n", 2);
+  size_t held = 2;
+  size_t remaining = req->content_len;
+  multipart_state_t state = MULTIPART_PREAMBLE;
+  bool delivered = false;
+
+  while (state != MULTIPART_DONE) {
+    if (remaining > 0 && held < HTTP_RECEIVE_BUFFER_SIZE) {
+      int received = receiveChunk(req, buffer + held, min(remaining, HTTP_RECEIVE_BUFFER_SIZE - held));
+      if (received <= 0) {
+        return ESP_ERR_TIMEOUT;
+      }
+      held += received;
+      remaining -= received;
+    }
+
+    size_t consumed = 0;
+    switch (state) {
+    case MULTIPART_PREAMBLE:
+    case MULTIPART_DATA: {
+      const uint8_t *found = findBytes(buffer, held, delimiter, delimiterLength);
+      size_t end = found ? (size_t)(found - buffer) : (held >= delimiterLength ? held - delimiterLength + 1 : 0);
+      if (state == MULTIPART_DATA && end > 0 && !write(buffer, end)) {
+        return ESP_FAIL;
+      }
+      if (found) {
+        consumed = end + delimiterLength;
+        state = MULTIPART_BOUNDARY;
+      } else if (remaining == 0) {
+        return ESP_ERR_INVALID_ARG;
+      } else {
+        consumed = end;
+      }
+      break;
+    }
+
+    case MULTIPART_BOUNDARY:
+      if (held < 2) {
+        if (remaining == 0) {
+          return ESP_ERR_INVALID_ARG;
+        }
+      } else if (buffer[0] == '-' && buffer[1] == '-') {
+        state = MULTIPART_DONE;
+      } else if (buffer[0] == '\r' && buffer[1] == '\n') {
+        consumed = 2;
+        state = MULTIPART_HEADERS;
+      } else {
+        return ESP_ERR_INVALID_ARG;
+      }
+      break;
+
+    case MULTIPART_HEADERS: {
+      const uint8_t *end = findBytes(buffer, held, "\r\n\r\n", 4);
+      if (!end) {
+        if (remaining == 0 || held == HTTP_RECEIVE_BUFFER_SIZE) {
+          return ESP_ERR_INVALID_ARG;
+        }
+        break;
+      }
+      consumed = end - buffer + 4;
+
+      // Later parts (form fields, extra files) are skipped
+      char filename[HTTP_HEADER_MAX];
+      if (!delivered && parseFilename(buffer, end - buffer, filename, sizeof(filename))) {
+        delivered = true;
+        if (!begin(req, filename)) {
+          return ESP_FAIL;
+        }
+        state = MULTIPART_DATA;
+      } else {
+        state = MULTIPART_PREAMBLE;
+      }
+      break;
+    }
+
+    default:
+      break;
+    }
+
+    memmove(buffer, buffer + consumed, held - consumed);
+    held -= consumed;
+  }
+
+  return delivered ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief Add or replace a route and register it if the server is running
+ * @return false if the route table is full
+ */
+static bool addRoute(const char *uri, httpd_method_t method, http_handler_t handler, void *context, bool webSocket) {
+  httpd_uri_t *route = NULL;
+  for (size_t i = 0; i < routeCount; i++) {
+    if (routes[i].method == method && strcmp(routes[i].uri, uri) == 0) {
+      route = &routes[i];
+      if (server) {
+        httpd_unregister_uri_handler(server, uri, method);
+      }
+      break;
+    }
+  }
+
+  if (!route) {
+    if (routeCount == HTTP_MAX_ROUTES) {
+      ESP_LOGE(HTTP_LOG, "Route table full, %s not registered", uri);
+      return false;
+    }
+    route = &routes[routeCount++];
+  }
+
+  *route = {};
+  route->uri = uri;
+  route->method = method;
+  route->handler = handler;
+  route->user_ctx = context;
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+  route->is_websocket = webSocket;
+#endif
+
+  if (server && httpd_register_uri_handler(server, route) != ESP_OK) {
+    ESP_LOGE(HTTP_LOG, "Failed to register %s", uri);
+    return false;
+  }
+  return true;
+}
+
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+/**
+ * @brief Send a queued broadcast to every WebSocket client (server task)
+ * @param arg http_broadcast_t to send and free
+ */
+static void sendBroadcast(void *arg) {
+  http_broadcast_t *broadcast = (http_broadcast_t *)arg;
+  int fds[HTTP_MAX_OPEN_SOCKETS];
+  size_t count = HTTP_MAX_OPEN_SOCKETS;
+
+  if (server && httpd_get_client_list(server, &count, fds) == ESP_OK) {
+    httpd_ws_frame_t frame = {};
+    frame.type = HTTPD_WS_TYPE_BINARY;
+    frame.final = true;
+    frame.payload = broadcast->data;
+    frame.len = broadcast->length;
+    for (size_t i = 0; i < count; i++) {
+      if (httpd_ws_get_fd_info(server, fds[i]) == HTTPD_WS_CLIENT_WEBSOCKET) {
+        httpd_ws_send_frame_async(server, fds[i], &frame);
+      }
+    }
+  }
+  free(broadcast);
+}
+#endif
+
+//==============================================================================
+// SERVER MANAGEMENT API
+//==============================================================================
+
+bool httpServer_on(const char *uri, httpd_method_t method, http_handler_t handler, void *context) {
+  return addRoute(uri, method, handler, context, false);
+}
+
+bool httpServer_start(uint16_t port) {
+  if (server) {
+    return true;
+  }
+
+  if (!chunkBuffer) {
+    chunkBuffer = (uint8_t *)allocateBuffer(HTTP_RECEIVE_BUFFER_SIZE);
+    if (!chunkBuffer) {
+      ESP_LOGE(HTTP_LOG, "Not enough memory for HTTP buffers");
+      return false;
+    }
+  }
+
+  httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+  config.server_port = port;
+  config.max_uri_handlers = HTTP_MAX_ROUTES;
+  config.max_open_sockets = HTTP_MAX_OPEN_SOCKETS;
+  config.stack_size = HTTP_SERVER_STACK;
+  config.recv_wait_timeout = HTTP_RECV_TIMEOUT_S;
+  config.send_wait_timeout = HTTP_RECV_TIMEOUT_S;
+  config.lru_purge_enable = true; // Drop idle keep-alive sockets before refusing new ones
+
+  if (httpd_start(&server, &config) != ESP_OK) {
+    ESP_LOGE(HTTP_LOG, "Failed to start HTTP server on port %u", port);
+    server = NULL;
+    return false;
+  }
+
+  for (size_t i = 0; i < routeCount; i++) {
+    httpd_register_uri_handler(server, &routes[i]);
+  }
+  httpd_register_err_handler(server, HTTPD_404_NOT_FOUND, handleNotFound);
+
+  ESP_LOGI(HTTP_LOG, "HTTP server started on port %u (%u routes)", port, (unsigned)routeCount);
+  return true;
+}
+
+void httpServer_stop() {
+  // Each mode registers its own routes before the next start, even if this
+  // one failed to start
+  routeCount = 0;
+  if (!server) {
+    return;
+  }
+
+  httpd_stop(server);
+  server = NULL;
+  heap_caps_free(chunkBuffer);
+  chunkBuffer = NULL;
+  ESP_LOGI(HTTP_LOG, "HTTP server stopped");
+}
+
+bool httpServer_isRunning() {
+  return server != NULL;
+}
+
+//==============================================================================
+// RESPONSE API
+//==============================================================================
+
+esp_err_t httpServer_send(httpd_req_t *req, int status, const char *contentType, const char *body, size_t length) {
+  httpd_resp_set_status(req, statusLine(status));
+  if (contentType) {
+    httpd_resp_set_type(req, contentType);
+  }
+  return httpd_resp_send(req, body, length);
+}
+
+esp_err_t httpServer_sendJson(httpd_req_t *req, int status, const String &json) {
+  return httpServer_send(req, status, "application/json", json.c_str(), json.length());
+}
+
+esp_err_t httpServer_sendText(httpd_req_t *req, int status, const char *text) {
+  return httpServer_send(req, status, "text/plain", text, strlen(text));
+}
+
+esp_err_t httpServer_sendFile(httpd_req_t *req, File &file, const char *contentType) {
+  const char *name = file.name();
+  size_t nameLength = strlen(name);
+  httpd_resp_set_type(req, contentType);
+  if (nameLength > 3 && strcmp(name + nameLength - 3, ".gz") == 0) {
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+  }
+
+  size_t length;
+  while ((length = file.read(chunkBuffer, HTTP_CHUNK_SIZE)) > 0) {
+    if (httpd_resp_send_chunk(req, (const char *)chunkBuffer, length) != ESP_OK) {
+      ESP_LOGW(HTTP_LOG, "Client went away while sending %s", name);
+      return ESP_FAIL;
+    }
+  }
+  return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+//==============================================================================
+// REQUEST API
+//==============================================================================
+
+bool httpServer_header(httpd_req_t *req, const char *name, char *value, size_t size) {
+  size_t length = httpd_req_get_hdr_value_len(req, name);
+  if (length == 0 || length >= size) {
+    return false;
+  }
+  return httpd_req_get_hdr_value_str(req, name, value, size) == ESP_OK;
+}
+
+bool httpServer_queryArg(httpd_req_t *req, const char *name, char *value, size_t size) {
+  char query[HTTP_QUERY_MAX];
+  size_t length = httpd_req_get_url_query_len(req);
+  if (length == 0 || length >= sizeof(query) ||
+      httpd_req_get_url_query_str(req, query, sizeof(query)) != ESP_OK) {
+    return false;
+  }
+  return httpServer_formArg(query, name, value, size);
+}
+
+bool httpServer_formArg(const char *form, const char *name, char *value, size_t size) {
+  if (httpd_query_key_value(form, name, value, size) != ESP_OK) {
+    return false;
+  }
+  urlDecode(value);
+  return true;
+}
+
+int httpServer_readBody(httpd_req_t *req, char *buffer, size_t size) {
+  if (req->content_len >= size) {
+    return -1;
+  }
+
+  size_t received = 0;
+  while (received < req->content_len) {
+    int count = receiveChunk(req, buffer + received, req->content_len - received);
+    if (count <= 0) {
+      return -1;
+    }
+    received += count;
+  }
+  buffer[received] = '\0';
+  return received;
+}
+
+esp_err_t httpServer_receiveLines(httpd_req_t *req, http_line_t onLine, void *context) {
+  char *buffer = (char *)chunkBuffer;
+  size_t held = 0;
+  size_t remaining = req->content_len;
+
+  while (remaining > 0 || held > 0) {
+    if (remaining > 0) {
+      if (held == HTTP_CHUNK_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+      }
+      int received = receiveChunk(req, buffer + held, min(remaining, HTTP_CHUNK_SIZE - held));
+      if (received <= 0) {
+        return ESP_ERR_TIMEOUT;
+      }
+      held += received;
+      remaining -= received;
+    }
+
+    size_t start = 0;
+    while (start < held) {
+      const char *newline = (const char *)memchr(buffer + start, '\n', held - start);
+      if (!newline && remaining > 0) {
+        break; // Wait for the rest of the line
+      }
+      size_t end = newline ? (size_t)(newline - buffer) : held;
+      size_t length = end - start;
+      if (length > 0 && buffer[start + length - 1] == '\r') {
+        length--;
+      }
+      if (!onLine(buffer + start, length, context)) {
+        return ESP_FAIL;
+      }
+      start = end + 1;
+    }
+
+    start = min(start, held);
+    memmove(buffer, buffer + start, held - start);
+    held -= start;
+  }
+  return ESP_OK;
+}
+
+esp_err_t httpServer_receiveUpload(httpd_req_t *req, http_upload_begin_t begin, http_upload_write_t write) {
+  char contentType[HTTP_HEADER_MAX];
+  if (!httpServer_header(req, "Content-Type", contentType, sizeof(contentType)) ||
+      strncmp(contentType, "multipart/", 10) != 0) {
+    return receiveRawUpload(req, begin, write);
+  }
+
+  const char *boundary = strstr(contentType, "boundary=");
+  if (!boundary) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  return receiveMultipart(req, boundary + strlen("boundary="), begin, write);
+}
+
+//==============================================================================
+// WEBSOCKET API
+//==============================================================================
+
+#ifdef CONFIG_HTTPD_WS_SUPPORT
+
+bool httpServer_onWebSocket(const char *uri, http_handler_t handler, void *context) {
+  return addRoute(uri, HTTP_GET, handler, context, true);
+}
+
+int httpServer_receiveFrame(httpd_req_t *req, uint8_t *buffer, size_t size) {
+  httpd_ws_frame_t frame = {};
+  if (httpd_ws_recv_frame(req, &frame, 0) != ESP_OK || frame.len > size) {
+    return -1;
+  }
+  frame.payload = buffer;
+  if (frame.len > 0 && httpd_ws_recv_frame(req, &frame, frame.len) != ESP_OK) {
+    return -1;
+  }
+  return (int)frame.len;
+}
+
+esp_err_t httpServer_sendFrame(httpd_req_t *req, const uint8_t *data, size_t length) {
+  httpd_ws_frame_t frame = {};
+  frame.type = HTTPD_WS_TYPE_BINARY;
+  frame.final = true;
+  frame.payload = (uint8_t *)data;
+  frame.len = length;
+  return httpd_ws_send_frame(req, &frame);
+}
+
+bool httpServer_broadcast(const uint8_t *data, size_t length) {
+  if (!server) {
+    return false;
+  }
+
+  http_broadcast_t *broadcast = (http_broadcast_t *)malloc(sizeof(http_broadcast_t) + length);
+  if (!broadcast) {
+    return false;
+  }
+  broadcast->length = length;
+  memcpy(broadcast->data, data, length);
+
+  if (httpd_queue_work(server, sendBroadcast, broadcast) != ESP_OK) {
+    free(broadcast);
+    return false;
+  }
+  return true;
+}
+
+size_t httpServer_webSocketClients() {
+  int fds[HTTP_MAX_OPEN_SOCKETS];
+  size_t count = HTTP_MAX_OPEN_SOCKETS;
+  if (!server || httpd_get_client_list(server, &count, fds) != ESP_OK) {
+    return 0;
+  }
+
+  size_t clients = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (httpd_ws_get_fd_info(server, fds[i]) == HTTPD_WS_CLIENT_WEBSOCKET) {
+      clients++;
+    }
+  }
+  return clients;
+}
+
+#else
+
+bool httpServer_onWebSocket(const char *uri, http_handler_t handler, void *context) {
+  ESP_LOGE(HTTP_LOG, "WebSocket support is disabled, %s not registered", uri);
+  return false;
+}
+
+int httpServer_receiveFrame(httpd_req_t *req, uint8_t *buffer, size_t size) {
+  return -1;
+}
+
+esp_err_t httpServer_sendFrame(httpd_req_t *req, const uint8_t *data, size_t length) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+
+bool httpServer_broadcast(const uint8_t *data, size_t length) {
+  return false;
+}
+
+size_t httpServer_webSocketClients() {
+  return 0;
+}
+
+#endif /* CONFIG_HTTPD_WS_SUPPORT */
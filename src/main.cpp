@@ -9,6 +9,7 @@
 
 #include "adxl_module.h"
 #include "animation_module.h"
+#include "boot_module.h"
 #include "clock_module.h"
 #include "clock_sync.h"
 #include "common.h"
@@ -81,80 +82,57 @@ static void checkDeviceCrashModes() {
 // INITIALIZATION FUNCTIONS
 //==============================================================================
 
-/**
- * @brief Initialize all hardware components
- * @return true if successful, false otherwise
- */
-static bool initializeHardware() {
-
-  if (!initializeI2C()) {
-    ESP_LOGE("BYTE-90", "I2C initialization failed");
-    return false;
-  }
-
-  if (!initializeOLED()) {
-    ESP_LOGE("BYTE-90", "Display initialization failed");
-    return false;
-  }
-
-  if (initializeSpeaker(true)) {
-    ESP_LOGI("BYTE-90", "Speaker initialized successfully");
-  } else {
-    ESP_LOGW("BYTE-90", "Speaker initialization skipped (not supported)");
-  }
-
-  if (initializeHaptics(HAPTIC_ACTUATOR_ERM)) {
-    ESP_LOGI("BYTE-90", "Haptics initialized successfully");
-  } else {
-    ESP_LOGW("BYTE-90", "Haptics initialization skipped (not supported)");
-  }
-
-  if (initializeClock()) {
-    ESP_LOGI("BYTE-90", "Clock initialized successfully");
-  } else {
-    ESP_LOGW("BYTE-90", "Clock initialization skipped (not supported)");
-  }
-
-  if (!initializeADXL345()) {
-    ESP_LOGE("BYTE-90", "Motion detection (ADXL345) initialization failed");
-    return false;
-  }
-
-  if (initializeFS() != FSStatus::FS_SUCCESS) {
-    ESP_LOGE("BYTE-90", "Flash filesystem initialization failed");
-    return false;
-  }
-
-  return true;
-}
+// Boot stages, in table order; see bootStages
+enum {
+  STAGE_PREFERENCES,
+  STAGE_FILESYSTEM,
+  STAGE_I2C,
+  STAGE_DISPLAY,
+  STAGE_SPEAKER,
+  STAGE_HAPTICS,
+  STAGE_CLOCK,
+  STAGE_MOTION,
+  STAGE_MENU,
+  STAGE_GIF,
+  STAGE_CLOCK_SYNC,
+  STAGE_SFX,
+  STAGE_WIFI,
+  STAGE_STATES,
+  STAGE_COUNT
+};
+
+#define STAGE(stage) BOOT_STAGE_BIT(STAGE_##stage)
+
+static_assert(STAGE_COUNT <= BOOT_MAX_STAGES, "Too many boot stages");
 
 /**
- * @brief Initialize all software components
- * @return true if successful, false otherwise
+ * @brief Hardware and software initializers with their dependencies
+ *
+ * Hardware stages run concurrently; the I2C devices share the bus, which
+ * serializes their transactions. Software stages run on the setup task in
+ * table order as soon as what they use is ready. The state manager goes last
+ * because entering the first mode may touch any of the others.
+ *
+ * The filesystem (mount, and format on a failed mount), display and speaker
+ * stages keep the 8 KB the Arduino loop task gave them before they ran in
+ * parallel; the boot timeline prints each stage's unused stack.
  */
-static bool initializeSoftware() {
-  menu_init();
-  delay(500);
-  if (!initializeGIFPlayer()) {
-    ESP_LOGE("BYTE-90", "GIF player initialization failed");
-    return false;
-  }
-
-  if (!initializeClockSync()) {
-    ESP_LOGE("BYTE-90", "Clock sync initialization failed");
-    return false;
-  }
-
-  sfxInit();
-
-  initPreferencesManager();  // 1. Initialize preferences system first
-  delay(500);
-  initWiFiManager();         // 2. Then WiFi manager (needs preferences)
-  delay(500);
-  initSystemStateManager();  // 3. Finally state manager (calls enableWiFi)
-  
-  return true;
-}
+static const boot_stage_t bootStages[STAGE_COUNT] = {
+    {"preferences", [] { initPreferencesManager(); return true; }, 0, true, false, 4096},
+    {"filesystem", [] { return initializeFS() == FSStatus::FS_SUCCESS; }, 0, true, true, 8192},
+    {"i2c", initializeI2C, 0, true, true, 4096},
+    {"display", initializeOLED, 0, true, true, 8192},
+    {"speaker", [] { return initializeSpeaker(true); }, STAGE(PREFERENCES) | STAGE(FILESYSTEM), true, false, 8192},
+    {"haptics", [] { return initializeHaptics(HAPTIC_ACTUATOR_ERM); }, STAGE(I2C), true, false, 4096},
+    {"clock", initializeClock, STAGE(I2C), true, false, 4096},
+    {"motion", initializeADXL345, STAGE(I2C), true, true, 4096},
+    {"menu", [] { menu_init(); return true; }, STAGE(PREFERENCES) | STAGE(DISPLAY), false, true, 0},
+    {"gif", initializeGIFPlayer, STAGE(FILESYSTEM), false, true, 0},
+    {"clock sync", initializeClockSync, STAGE(PREFERENCES) | STAGE(CLOCK), false, true, 0},
+    {"sfx", [] { sfxInit(); return true; }, STAGE(SPEAKER), false, false, 0},
+    {"wifi", [] { initWiFiManager(); return true; }, STAGE(PREFERENCES), false, false, 0},
+    {"states", [] { initSystemStateManager(); return true; }, BOOT_STAGE_BIT(STAGE_STATES) - 1, false, true, 0},
+};
 
 /**
  * @brief Show startup animation and message
@@ -163,19 +141,35 @@ static void showSystemStartUp() {
   completeDisplaySetup();
   
   // Initialize new modular effects system BEFORE DOS animation
+  int stage = boot_beginStage("effects");
   effectsCore_init();
   effectsRetro_init();
   effectsMatrix_init();
+  boot_endStage(stage, true);
   
+  initializeAnimationModule();
+
+  // After deep sleep, continue with the chain and emotes from before it
+  bool sleepWake = boot_restoreAfterSleep();
+
+  // A sleep wake or quick boot goes straight to the resumed animation
+  if (sleepWake || boot_isQuickBoot()) {
+    clearDisplay();
+    return;
+  }
+
   // Note: Individual effect states are already loaded from preferences
   // Now DOS animation can use theme colors
+  stage = boot_beginStage("dos animation");
   displayDOSStartupAnimation();
-  initializeAnimationModule();
+  boot_endStage(stage, true);
 
   clearDisplay();
   displayStaticImage(STARTUP_STATIC, 128, 128, true);
   delay(300);
+  stage = boot_beginStage("boot animation");
   playBootAnimation();
+  boot_endStage(stage, true);
 }
 
 //==============================================================================
@@ -193,16 +187,10 @@ void setup() {
   setStatesDebug(false);
 
 
-  if (!initializeHardware()) {
-    ESP_LOGE("BYTE-90", "Hardware initialization failed!");
-    checkDeviceCrashModes();
-    delay(1000);
-    return;
-  }
-
-  if (!initializeSoftware()) {
-    ESP_LOGE("BYTE-90", "Software initialization failed!");
+  if (!boot_runStages(bootStages, STAGE_COUNT)) {
+    ESP_LOGE("BYTE-90", "System initialization failed!");
     checkDeviceCrashModes();
+    boot_printTimeline();
     delay(1000);
     return;
   }
@@ -211,6 +199,8 @@ void setup() {
   showSystemStartUp();
 
   ESP_LOGI("SYSTEM", "System initialization complete");
+  boot_mark("interactive");
+  boot_printTimeline();
   printSystemStatus();
   
   ESP_LOGE("BYTE-90", "=== BOOT COMPLETE ===");
@@ -226,15 +216,24 @@ void loop() {
   // Update audio system (always needed)
   audioLoop();
   
-  // Handle WiFi preference changes (automatic mode transitions)
+  // Finish state transitions once the radio is ready
   updateSystemStateMachine();
   // Monitor serial update state changes and handle serial commands
   updateSerialState();
+  // Commit settings changes once they settle
+  handlePreferences();
   
   // If menu is active, skip system mode operations
   if (menu_isActive()) {
     return;
   }
+
+  // Keep animating while a state transition reconfigures the radio
+  if (isStateTransitioning()) {
+    playEmotes();
+    ADXLDataPolling();
+    return;
+  }
   
   // Handle different system modes (5-mode architecture)
   if (getCurrentState() == SystemState::UPDATE_MODE) {
@@ -249,6 +248,7 @@ void loop() {
     handleCommunication();
     playEmotes();
     ADXLDataPolling();
+    handleDiscoveryPowerSave();
   } else if (getCurrentState() == SystemState::WIFI_MODE) {
     playEmotes();
     ADXLDataPolling();
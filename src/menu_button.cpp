@@ -21,6 +21,8 @@
 #include "soundsfx_module.h"
 #include "haptics_module.h"
 #include "haptics_effects.h"
+#include <driver/gpio.h>
+#include <esp_sleep.h>
 
 //==============================================================================
 // PRIVATE VARIABLES
@@ -244,3 +246,36 @@ void menuButton_reset() {
      // Re-enable interrupts
      attachInterrupt(digitalPinToInterrupt(MENU_BUTTON_PIN), buttonInterruptHandler, CHANGE);
  }
+
+/**
+ * @brief Let a press of the button end the next light sleep
+ * 
+ * Light sleep only wakes on a GPIO level, so the pin's edge interrupt is
+ * swapped for a low-level (pressed) wake-up until menuButton_disableWakeup().
+ */
+void menuButton_enableWakeup() {
+     detachInterrupt(digitalPinToInterrupt(MENU_BUTTON_PIN));
+     gpio_wakeup_enable((gpio_num_t)digitalPinToInterrupt(MENU_BUTTON_PIN), GPIO_INTR_LOW_LEVEL);
+     esp_sleep_enable_gpio_wakeup();
+ }
+
+/**
+ * @brief Restore the button interrupt after a light sleep
+ * 
+ * The press that woke the device happened while no interrupt was attached,
+ * so it is recorded here; its release then completes a click as usual.
+ */
+void menuButton_disableWakeup() {
+     esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+     gpio_wakeup_disable((gpio_num_t)digitalPinToInterrupt(MENU_BUTTON_PIN));
+
+     if (digitalRead(MENU_BUTTON_PIN) == LOW && lastButtonReading == HIGH) {
+         unsigned long currentTime = millis();
+         lastDebounceTime = currentTime;
+         lastButtonReading = LOW;
+         buttonPressStartTime = currentTime;
+         buttonState = BTN_PRESSED;
+     }
+
+     attachInterrupt(digitalPinToInterrupt(MENU_BUTTON_PIN), buttonInterruptHandler, CHANGE);
+ }
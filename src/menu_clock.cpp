@@ -97,8 +97,7 @@ static bool wifiEnabled = false;
     disableHaptics();
     
     // Transition to clock mode
-    transitionToState(SystemState::CLOCK_MODE);
-    if (getCurrentState() == SystemState::CLOCK_MODE) {
+    if (transitionToState(SystemState::CLOCK_MODE)) {
         menuClockDebug("Successfully entered clock mode");
     } else {
         ESP_LOGE("MENU_CLOCK", "Failed to transition to clock mode");
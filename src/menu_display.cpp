@@ -17,12 +17,16 @@
  * - Theme and timezone active state visualization
  * - Color management and DOS-style theming
  * - Performance optimization through selective redraws
+ * - Off-screen composition with dirty-row flushing (no clear-then-draw flash)
+ * - Pixel-level scroll animation using the SSD1351 hardware start line
  */
 
 #include "menu_display.h"
 #include "display_module.h"
+#include "display_font.h"
 #include "effects_core.h"
 #include "effects_tints.h"
+#include "menu_effects.h"
 #include "preferences_module.h"
 #include "clock_sync.h"
 
@@ -39,6 +43,20 @@ static String lastTitle = "";
 static bool forceFullRedraw = true;
 static int scrollOffset = 0;  // For scrolling long lists
 
+// Off-screen composition - menu frames are drawn here and only dirty rows
+// are pushed to the panel. Falls back to drawing on the panel directly if
+// the framebuffer could not be allocated.
+static GFXcanvas16* menuCanvas = nullptr;
+static int16_t dirtyTop = DISPLAY_HEIGHT;
+static int16_t dirtyBottom = 0;   // Exclusive
+static bool batchDraw = false;    // Defer flushing until menuDisplay_draw finishes
+
+#if MENU_SMOOTH_SCROLL
+// Copy of the frame on screen before a scroll, used to find rows that still
+// differ once the hardware scroll animation has finished
+static uint16_t* previousFrame = nullptr;
+#endif
+
 //==============================================================================
 // SCROLLING CONSTANTS
 //==============================================================================
@@ -70,6 +88,108 @@ static void menuDisplay_drawScrollIndicators(int scrollOffset, int totalItems, i
 // PRIVATE FUNCTIONS
 //==============================================================================
 
+/**
+ * @brief Get the surface menu drawing goes to (framebuffer or panel)
+ */
+static Adafruit_GFX* drawTarget() {
+    if (menuCanvas) {
+        return menuCanvas;
+    }
+    return &oled;
+}
+
+/**
+ * @brief Extend the dirty row range that needs flushing
+ */
+static void markDirty(int y, int h) {
+    if (y < dirtyTop) {
+        dirtyTop = max(0, y);
+    }
+    if (y + h > dirtyBottom) {
+        dirtyBottom = min(DISPLAY_HEIGHT, y + h);
+    }
+}
+
+/**
+ * @brief Push dirty framebuffer rows to the panel as one full-row blit
+ */
+static void flushDirtyRows() {
+    if (menuCanvas && dirtyBottom > dirtyTop) {
+        flushFramebufferRows(menuCanvas->getBuffer(), dirtyTop, dirtyBottom - dirtyTop);
+    }
+    dirtyTop = DISPLAY_HEIGHT;
+    dirtyBottom = 0;
+}
+
+#if MENU_SMOOTH_SCROLL
+/**
+ * @brief Animate a one-item scroll by rotating the panel's start line
+ * @param direction 1 to scroll down (content moves up), -1 to scroll up
+ * 
+ * The new frame must already be composed in the framebuffer and the old one
+ * saved in previousFrame. Each animation frame moves the hardware start line
+ * by a few rows and only writes the rows that enter the list area plus the
+ * header (which must stay put while the panel RAM rotates under it). Rows
+ * that still differ afterwards (selection highlight, indicators) are marked
+ * dirty for the normal flush.
+ */
+static void animateScroll(int direction) {
+    const uint16_t* newFrame = menuCanvas->getBuffer();
+    int bandTop = FIRST_ITEM_Y - MENU_ITEM_Y_OFFSET;
+    int bandHeight = DISPLAY_HEIGHT - bandTop;
+    int distance = (8 + MENU_ITEM_Y_OFFSET) + MENU_ITEM_Y_OFFSET; // One item spacing
+    const uint16_t* newBand = newFrame + (bandTop * DISPLAY_WIDTH);
+    const uint16_t* oldBand = previousFrame + (bandTop * DISPLAY_WIDTH);
+    
+    for (int progress = 0; progress < distance; ) {
+        unsigned long frameStart = millis();
+        int step = min(MENU_SCROLL_STEP_PX, distance - progress);
+        progress += step;
+        
+        if (direction > 0) {
+            // RAM rotates up: incoming rows appear at the bottom of the list
+            setDisplayStartLine(getDisplayStartLine() + step);
+            flushPixelRows(newBand + ((bandHeight - distance + progress - step) * DISPLAY_WIDTH),
+                           DISPLAY_HEIGHT - step, step);
+            flushFramebufferRows(newFrame, 0, bandTop);
+        } else {
+            // RAM rotates down: incoming rows appear just under the header
+            setDisplayStartLine(getDisplayStartLine() + DISPLAY_HEIGHT - step);
+            flushFramebufferRows(newFrame, 0, bandTop);
+            flushPixelRows(newBand + ((distance - progress) * DISPLAY_WIDTH), bandTop, step);
+        }
+        
+        unsigned long elapsed = millis() - frameStart;
+        if (elapsed < MENU_SCROLL_FRAME_MS) {
+            delay(MENU_SCROLL_FRAME_MS - elapsed);
+        }
+    }
+    
+    // Rows carried over from the old frame may differ (highlight, indicators)
+    for (int row = 0; row < bandHeight; row++) {
+        int oldRow = row + (direction > 0 ? distance : -distance);
+        if (oldRow < 0 || oldRow >= bandHeight) {
+            continue; // Row was written during the animation
+        }
+        if (memcmp(oldBand + (oldRow * DISPLAY_WIDTH), newBand + (row * DISPLAY_WIDTH),
+                   DISPLAY_WIDTH * sizeof(uint16_t)) != 0) {
+            flushFramebufferRows(newFrame, bandTop + row, 1);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Draw menu text through the glyph atlas onto the current surface
+ */
+static void drawMenuText(int x, int y, const char* text, uint16_t fg, uint16_t bg) {
+    if (menuCanvas) {
+        displayFont_composeText(menuCanvas->getBuffer(), DISPLAY_WIDTH, DISPLAY_HEIGHT, x, y, text, fg, bg);
+    } else {
+        displayFont_drawText(x, y, text, fg, bg);
+    }
+}
+
 /**
  * @brief Get current DOS colors for UI
  */
@@ -84,49 +204,14 @@ static void getCurrentColors(uint16_t* primaryColor, uint16_t* accentColor) {
  * @return Truncated text string
  */
 static String truncateText(const String& text, int maxWidth) {
-    // Set text size for measurement
-    oled.setTextSize(MENU_TEXT_SIZE);
-    
-    // Check if text fits
-    int16_t x1, y1;
-    uint16_t textWidth, textHeight;
-    oled.getTextBounds(text.c_str(), 0, 0, &x1, &y1, &textWidth, &textHeight);
-    
-    if (textWidth <= maxWidth) {
+    // Fixed-pitch font - measurement is arithmetic, no getTextBounds passes
+    if (displayFont_textWidth(text.c_str()) <= maxWidth) {
         return text; // Text fits, no truncation needed
     }
     
-    // Text is too long, need to truncate
-    String truncated = text;
-    String ellipsis = "...";
-    
-    // Get width of ellipsis
-    oled.getTextBounds(ellipsis.c_str(), 0, 0, &x1, &y1, &textWidth, &textHeight);
-    int ellipsisWidth = textWidth;
-    
-    // Calculate available width for text (total width minus ellipsis)
-    int availableWidth = maxWidth - ellipsisWidth;
-    
-    // Binary search to find the right length
-    int left = 0;
-    int right = truncated.length();
-    String bestFit = "";
-    
-    while (left <= right) {
-        int mid = (left + right) / 2;
-        String testText = truncated.substring(0, mid);
-        
-        oled.getTextBounds(testText.c_str(), 0, 0, &x1, &y1, &textWidth, &textHeight);
-        
-        if (textWidth <= availableWidth) {
-            bestFit = testText;
-            left = mid + 1; // Try longer
-        } else {
-            right = mid - 1; // Try shorter
-        }
-    }
-    
-    return bestFit + ellipsis;
+    // Keep as many characters as fit alongside the ellipsis
+    int availableWidth = maxWidth - displayFont_textWidth("...");
+    return text.substring(0, displayFont_charsForWidth(availableWidth)) + "...";
 }
 
 /**
@@ -224,6 +309,20 @@ static bool isThemeActive(const char* themeLabel) {
     return false;
 }
 
+/**
+ * @brief Determine if an action item shows the active marker
+ *
+ * Presets are matched by slot rather than label, since their names are
+ * user-chosen and may repeat or match a theme or timezone label.
+ */
+static bool isActionActive(const MenuItem* item) {
+    int presetSlot = menuPresets_getSlot(item);
+    if (presetSlot >= 0) {
+        return presetSlot == effectsCore_getActivePreset();
+    }
+    return isThemeActive(item->label) || isTimezoneActive(item->label);
+}
+
 /**
  * @brief Get menu item display text
  */
@@ -247,9 +346,9 @@ static String getItemDisplayText(const MenuItem* item) {
         text += ": ";
         text += item->info();
     } else if (item->type == MENU_ACTION) {
-        // Check if this is a theme action or timezone action and if it's currently active
+        // Check if this is a theme, timezone or preset action and if it's currently active
         text = String(item->label);
-        if (isThemeActive(item->label) || isTimezoneActive(item->label)) {
+        if (isActionActive(item)) {
             text += " "; // Add space for the circle that will be drawn separately
         }
     } else {
@@ -316,6 +415,26 @@ static void resetDisplayState() {
 void menuDisplay_init() {
      // Display initialization is handled by display_module
      resetDisplayState();
+     
+     if (!menuCanvas) {
+         menuCanvas = new GFXcanvas16(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+         if (!menuCanvas->getBuffer()) {
+             ESP_LOGW(MENU_DISPLAY_LOG, "Menu framebuffer allocation failed - drawing directly to display");
+             delete menuCanvas;
+             menuCanvas = nullptr;
+         } else {
+             menuCanvas->fillScreen(COLOR_BLACK);
+         }
+     }
+     
+#if MENU_SMOOTH_SCROLL
+     if (menuCanvas && !previousFrame) {
+         previousFrame = (uint16_t*)heap_caps_malloc(DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+         if (!previousFrame) {
+             ESP_LOGW(MENU_DISPLAY_LOG, "Scroll buffer allocation failed - smooth scrolling disabled");
+         }
+     }
+#endif
  }
 
 /**
@@ -327,6 +446,11 @@ void menuDisplay_init() {
  */
 void menuDisplay_clear() {
      clearDisplay();
+     if (menuCanvas) {
+         menuCanvas->fillScreen(COLOR_BLACK);
+     }
+     dirtyTop = DISPLAY_HEIGHT;
+     dirtyBottom = 0;
      resetDisplayState();
      scrollOffset = 0;  // Reset scroll when explicitly clearing for menu changes
      
@@ -346,26 +470,22 @@ void menuDisplay_drawHeader(const char* title) {
      uint16_t primaryColor, accentColor;
      getCurrentColors(&primaryColor, &accentColor);
      
-     // Set text properties - ensure default font is used
-     oled.setFont();
-     oled.setTextSize(MENU_TEXT_SIZE);
-     oled.setTextColor(primaryColor);
-     
      // Calculate centered position
-     int16_t x1, y1;
-     uint16_t textWidth, textHeight;
-     oled.getTextBounds(title, 0, 0, &x1, &y1, &textWidth, &textHeight);
-     
-     int centerX = (DISPLAY_WIDTH - textWidth) / 2;
+     int textWidth = displayFont_textWidth(title);
+     int centerX = max(0, (DISPLAY_WIDTH - textWidth) / 2);
      int headerY = 8;
      
      // Draw header
-     oled.setCursor(centerX, headerY);
-     oled.println(title);
+     drawMenuText(centerX, headerY, title, primaryColor, COLOR_BLACK);
      
      // Draw underline
-     int lineY = headerY + textHeight + 2;
-     oled.drawLine(MENU_PADDING, lineY, DISPLAY_WIDTH - MENU_PADDING, lineY, primaryColor);
+     int lineY = headerY + FONT_CHAR_HEIGHT + 2;
+     drawTarget()->drawLine(MENU_PADDING, lineY, DISPLAY_WIDTH - MENU_PADDING, lineY, primaryColor);
+     
+     markDirty(headerY, lineY - headerY + 1);
+     if (!batchDraw) {
+         flushDirtyRows();
+     }
  }
 
 /**
@@ -378,6 +498,7 @@ void menuDisplay_drawHeader(const char* title) {
  * and various item type indicators automatically.
  */
 void menuDisplay_drawItem(int index, const MenuItem* item, bool selected) {
+     Adafruit_GFX* target = drawTarget();
      uint16_t primaryColor, accentColor;
      getCurrentColors(&primaryColor, &accentColor);
      
@@ -398,14 +519,8 @@ void menuDisplay_drawItem(int index, const MenuItem* item, bool selected) {
      String truncatedText = truncateText(displayText, availableWidth);
      const char* text = truncatedText.c_str();
      
-     // Set text size FIRST before getting bounds - ensure default font is used
-     oled.setFont();
-     oled.setTextSize(MENU_TEXT_SIZE);
-     
-     // Get text bounds with correct text size
-     int16_t x1, y1;
-     uint16_t textWidth, textHeight;
-     oled.getTextBounds(text, 0, 0, &x1, &y1, &textWidth, &textHeight);
+     int textWidth = displayFont_textWidth(text);
+     int textHeight = FONT_CHAR_HEIGHT;
      
      int itemHeight = textHeight + 4;
      int fullMenuWidth = DISPLAY_WIDTH - (MENU_PADDING * 2);
@@ -415,52 +530,48 @@ void menuDisplay_drawItem(int index, const MenuItem* item, bool selected) {
      uint16_t circleColor = selected ? COLOR_BLACK : primaryColor;
      
      // Clear item area
-     oled.fillRect(MENU_PADDING, y - MENU_ITEM_Y_OFFSET, fullMenuWidth, itemHeight, COLOR_BLACK);
+     target->fillRect(MENU_PADDING, y - MENU_ITEM_Y_OFFSET, fullMenuWidth, itemHeight, COLOR_BLACK);
+     markDirty(y - MENU_ITEM_Y_OFFSET, itemHeight);
      
      // Calculate if this item needs extra space for circle
-     bool needsCircleSpace = (item->type == MENU_ACTION && (isThemeActive(item->label) || isTimezoneActive(item->label))) ||
+     bool needsCircleSpace = (item->type == MENU_ACTION && isActionActive(item)) ||
                             (item->type == MENU_TOGGLE && item->statusFlag && *item->statusFlag && !shouldShowActionText(item->label));
      int extraSpace = needsCircleSpace ? 8 : 0; // 6px margin + 6px circle diameter
      
      // Draw selection highlight
+     uint16_t textColor = selected ? COLOR_BLACK : primaryColor;
+     uint16_t backgroundColor = selected ? primaryColor : COLOR_BLACK;
      if (selected) {
          int highlightWidth = item->type == MENU_SUBMENU ? textWidth + 15 : textWidth + 6 + extraSpace;
-         oled.fillRect(x - MENU_ITEM_X_OFFSET, y - MENU_ITEM_Y_OFFSET, 
-                      highlightWidth, itemHeight, primaryColor);
-         oled.setTextColor(COLOR_BLACK);
-     } else {
-         oled.setTextColor(primaryColor);
+         target->fillRect(x - MENU_ITEM_X_OFFSET, y - MENU_ITEM_Y_OFFSET, 
+                          highlightWidth, itemHeight, primaryColor);
      }
      
-     // Draw text (text size already set above)
-     oled.setCursor(x, y);
-     oled.println(text);
+     // Draw text from the glyph atlas
+     drawMenuText(x, y, text, textColor, backgroundColor);
      
      // Add icon for menu item types
      if (item->type == MENU_SUBMENU) {
-         // Draw arrow for submenus
+         // Draw arrow for submenus - simple right arrow: >
          int arrowX = x + textWidth + 4;
-         int arrowY = y + (textHeight / 2);
-         uint16_t arrowColor = selected ? COLOR_BLACK : primaryColor;
-         
-         // Simple right arrow: > (ensure consistent text size)
-         oled.setTextColor(arrowColor);
-         oled.setTextSize(MENU_TEXT_SIZE);
-         oled.setCursor(arrowX, y);
-         oled.print(">");
+         drawMenuText(arrowX, y, ">", textColor, backgroundColor);
      } else if (item->type == MENU_ACTION) {
-         // Check if this is a theme action or timezone action and if it's currently active
-         if (isThemeActive(item->label) || isTimezoneActive(item->label)) {
+         // Check if this is a theme, timezone or preset action and if it's currently active
+         if (isActionActive(item)) {
              // Draw filled circle (3px radius = 6px diameter)
-             oled.fillCircle(circleX, circleY, 2, circleColor);
+             target->fillCircle(circleX, circleY, 2, circleColor);
          }
      } else if (item->type == MENU_TOGGLE && item->statusFlag) {
          // Check if this toggle item is enabled and should show dots (not action text)
          if (*item->statusFlag && !shouldShowActionText(item->label)) {
              // Draw filled circle (3px radius = 6px diameter)
-             oled.fillCircle(circleX, circleY, 2, circleColor);
+             target->fillCircle(circleX, circleY, 2, circleColor);
          }
      }
+     
+     if (!batchDraw) {
+         flushDirtyRows();
+     }
  }
 
 /**
@@ -475,9 +586,9 @@ void menuDisplay_draw(const MenuContext* context) {
          return;
      }
      
-     // Ensure default font is set to prevent font persistence from other modules
-     oled.setFont();
-     oled.setTextSize(MENU_TEXT_SIZE);
+     // Compose everything off-screen, then flush the dirty rows once
+     batchDraw = true;
+     Adafruit_GFX* target = drawTarget();
      
      // Calculate scroll offset for current selection
      int newScrollOffset = calculateScrollOffset(context->selectedIndex, context->itemCount);
@@ -487,18 +598,35 @@ void menuDisplay_draw(const MenuContext* context) {
      bool titleChanged = (lastTitle != String(context->title ? context->title : ""));
      bool itemCountChanged = (lastItemCount != context->itemCount);
      bool selectionChanged = (lastSelectedIndex != context->selectedIndex);
+     bool fullRedraw = forceFullRedraw || titleChanged || itemCountChanged;
      
-     // Force full redraw for context changes, scroll changes, or first time
-     if (forceFullRedraw || titleChanged || itemCountChanged || scrollChanged) {
+     // Redraw the frame for context changes, scroll changes, or first time
+     if (fullRedraw || scrollChanged) {
+         int scrollDelta = newScrollOffset - scrollOffset;
+         bool animate = false;
+#if MENU_SMOOTH_SCROLL
+         // Single-item scrolls slide smoothly; jumps (wrap-around) redraw
+         animate = !fullRedraw && menuCanvas && previousFrame && abs(scrollDelta) == 1;
+         if (animate) {
+             memcpy(previousFrame, menuCanvas->getBuffer(), DISPLAY_WIDTH * DISPLAY_HEIGHT * sizeof(uint16_t));
+         }
+#endif
+         
          // Update scroll offset
          scrollOffset = newScrollOffset;
          
-         // Clear display for full redraw
-         clearDisplay();
-         
-         // Draw header
-         if (context->title) {
-             menuDisplay_drawHeader(context->title);
+         if (fullRedraw) {
+             // Blank the whole frame and redraw the header
+             target->fillScreen(COLOR_BLACK);
+             markDirty(0, DISPLAY_HEIGHT);
+             if (context->title) {
+                 menuDisplay_drawHeader(context->title);
+             }
+         } else {
+             // Scrolling only - the header is unchanged, blank the item area
+             int itemsTop = FIRST_ITEM_Y - MENU_ITEM_Y_OFFSET;
+             target->fillRect(0, itemsTop, DISPLAY_WIDTH, DISPLAY_HEIGHT - itemsTop, COLOR_BLACK);
+             markDirty(itemsTop, DISPLAY_HEIGHT - itemsTop);
          }
          
          // Draw visible menu items (with scrolling)
@@ -515,6 +643,15 @@ void menuDisplay_draw(const MenuContext* context) {
              menuDisplay_drawScrollIndicators(scrollOffset, context->itemCount, maxVisibleItems);
          }
          
+#if MENU_SMOOTH_SCROLL
+         if (animate) {
+             // The animation writes the rows it needs - skip the band flush
+             dirtyTop = DISPLAY_HEIGHT;
+             dirtyBottom = 0;
+             animateScroll(scrollDelta > 0 ? 1 : -1);
+         }
+#endif
+         
          // Update tracking state
          lastTitle = String(context->title ? context->title : "");
          lastItemCount = context->itemCount;
@@ -544,6 +681,9 @@ void menuDisplay_draw(const MenuContext* context) {
          // Update selection tracking
          lastSelectedIndex = context->selectedIndex;
      }
+     
+     batchDraw = false;
+     flushDirtyRows();
  }
 
 /**
@@ -555,17 +695,11 @@ static void menuDisplay_drawScrollIndicators(int scrollOffset, int totalItems, i
     
     int indicatorX = DISPLAY_WIDTH - 6;  // Right edge
     
-    // Store current text size to restore later
-    uint8_t originalTextSize = MENU_TEXT_SIZE;
-    
     // Draw up arrow if we can scroll up
     if (scrollOffset > 0) {
         // Simple up arrow at top right
-        oled.setFont(); // Ensure default font
-        oled.setTextColor(primaryColor);
-        oled.setTextSize(1);
-        oled.setCursor(indicatorX, FIRST_ITEM_Y);
-        oled.print("^");
+        drawMenuText(indicatorX, FIRST_ITEM_Y, "^", primaryColor, COLOR_BLACK);
+        markDirty(FIRST_ITEM_Y, FONT_CHAR_HEIGHT);
     }
     
     // Draw down arrow if we can scroll down
@@ -574,15 +708,9 @@ static void menuDisplay_drawScrollIndicators(int scrollOffset, int totalItems, i
         // Calculate item spacing dynamically
         int itemSpacing = (8 + MENU_ITEM_Y_OFFSET) + MENU_ITEM_Y_OFFSET;
         int bottomY = FIRST_ITEM_Y + (maxVisibleItems - 1) * itemSpacing + 8;
-        oled.setFont(); // Ensure default font
-        oled.setTextColor(primaryColor);
-        oled.setTextSize(1);
-        oled.setCursor(indicatorX, bottomY);
-        oled.print("v");
+        drawMenuText(indicatorX, bottomY, "v", primaryColor, COLOR_BLACK);
+        markDirty(bottomY, FONT_CHAR_HEIGHT);
     }
-    
-    // Restore original text size
-    oled.setTextSize(originalTextSize);
 }
 
 /**
@@ -596,6 +724,20 @@ void menuDisplay_forceRedraw() {
      forceFullRedraw = true;
  }
 
-
-
-
+/**
+ * @brief Restore the hardware scroll position for direct drawing
+ * 
+ * Smooth scrolling leaves the panel's start line rotated while the menu is
+ * shown. Other modules draw straight to the panel, so menu actions call this
+ * first: the start line is reset and the current menu frame re-flushed.
+ */
+void menuDisplay_resetScroll() {
+     if (getDisplayStartLine() == 0) {
+         return;
+     }
+     
+     setDisplayStartLine(0);
+     if (menuCanvas) {
+         flushFramebufferRows(menuCanvas->getBuffer(), 0, DISPLAY_HEIGHT);
+     }
+ }
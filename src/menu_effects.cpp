@@ -15,6 +15,7 @@
  * - Menu context management and item counting
  * - Real-time effect status synchronization
  * - Visual effects system coordination
+ * - Preset submenu listing the stored presets by name
  */
 
 #include "menu_effects.h"
@@ -239,10 +240,66 @@ static bool glitchEnabled = false;
     menuEffectsDebug("Glitch effect applied: %s", enabled ? "ON" : "OFF");
 }
 
+//==============================================================================
+// PRESET SELECTION FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Switch to a stored preset and remember it as the effect chain
+ * @param slot Preset bank slot
+ */
+static void selectPresetSlot(uint8_t slot) {
+    if (!effectsCore_selectPreset(slot)) {
+        ESP_LOGW("EFFECTS", "Preset slot %u is empty", slot);
+        return;
+    }
+
+    effectsCore_saveToPreferences();
+    menuEffects_updateStatus();
+    menuEffectsDebug("Preset %u (%s) selected", slot, effectsCore_getPresetName(slot));
+}
+
+static void selectPreset1() { selectPresetSlot(0); }
+static void selectPreset2() { selectPresetSlot(1); }
+static void selectPreset3() { selectPresetSlot(2); }
+static void selectPreset4() { selectPresetSlot(3); }
+static void selectPreset5() { selectPresetSlot(4); }
+static void selectPreset6() { selectPresetSlot(5); }
+static void selectPreset7() { selectPresetSlot(6); }
+static void selectPreset8() { selectPresetSlot(7); }
+
+static const ActionFunction presetActions[] = {
+    selectPreset1, selectPreset2, selectPreset3, selectPreset4,
+    selectPreset5, selectPreset6, selectPreset7, selectPreset8,
+};
+
+static_assert(MENU_ITEM_COUNT(presetActions) == EFFECT_PRESET_SLOTS, "One menu action per preset slot");
+
 //==============================================================================
 // MENU DEFINITION
 //==============================================================================
 
+/**
+ * @brief Preset submenu - rebuilt from the bank each time it is entered
+ * Labels point at the names held by the effects core.
+ */
+static MenuItem presetsMenu[EFFECT_PRESET_SLOTS + 1];
+static int presetsMenuCount = 0;
+
+/**
+ * @brief List the stored presets, in slot order, followed by GO BACK
+ */
+static void buildPresetsMenu() {
+    presetsMenuCount = 0;
+    for (uint8_t slot = 0; slot < EFFECT_PRESET_SLOTS; slot++) {
+        const char* name = effectsCore_getPresetName(slot);
+        if (name) {
+            presetsMenu[presetsMenuCount++] = DEFINE_MENU_ACTION(preset, name, presetActions[slot]);
+        }
+    }
+    presetsMenu[presetsMenuCount++] = DEFINE_MENU_BACK();
+}
+
 /**
  * @brief Individual effects menu items
  */
@@ -253,6 +310,7 @@ static MenuItem effectsMenu[] = {
     DEFINE_MENU_TOGGLE(pixelate, MENU_LABEL_PIXELATE, togglePixelate, &pixelateEnabled),
     DEFINE_MENU_TOGGLE(scanlines, MENU_LABEL_SCANLINES, toggleScanlines, &scanlinesEnabled),
     DEFINE_MENU_TOGGLE(glitch, MENU_LABEL_GLITCH, toggleGlitch, &glitchEnabled),
+    DEFINE_MENU_SUBMENU(presets, MENU_LABEL_PRESETS, presetsMenu, EFFECT_PRESET_SLOTS + 1),
     DEFINE_MENU_BACK()
 };
 
@@ -262,6 +320,23 @@ static const int effectsMenuCount = MENU_ITEM_COUNT(effectsMenu);
 // PUBLIC API IMPLEMENTATION
 //==============================================================================
 
+/**
+ * @brief Find the preset slot a menu item selects
+ * @param item Menu item to check
+ * @return Slot index, or -1 if the item is not a preset action
+ */
+int menuPresets_getSlot(const MenuItem* item) {
+    if (item->type != MENU_ACTION) {
+        return -1;
+    }
+    for (int slot = 0; slot < EFFECT_PRESET_SLOTS; slot++) {
+        if (item->action == presetActions[slot]) {
+            return slot;
+        }
+    }
+    return -1;
+}
+
 /**
  * @brief Initialize effects module
  * 
@@ -325,3 +400,28 @@ void menuEffects_getContext(MenuContext* context) {
          context->title = MENU_LABEL_EFFECTS;
      }
  }
+
+/**
+ * @brief Get the preset submenu items
+ * @return Pointer to preset menu array
+ * 
+ */
+MenuItem* menuPresets_getItems() {
+     return presetsMenu;
+ }
+
+/**
+ * @brief Get the preset submenu context
+ * @param context Pointer to context to populate
+ * 
+ * Rebuilds the list so presets stored since the last visit appear.
+ */
+void menuPresets_getContext(MenuContext* context) {
+     if (context) {
+         buildPresetsMenu();
+         context->items = presetsMenu;
+         context->itemCount = presetsMenuCount;
+         context->selectedIndex = 0;
+         context->title = MENU_LABEL_PRESETS;
+     }
+ }
@@ -111,8 +111,7 @@ bool menuActive = false;
  
      menu_exit();
      
-     transitionToState(SystemState::ESP_MODE);
-     if (getCurrentState() == SystemState::ESP_MODE) {
+     if (transitionToState(SystemState::ESP_MODE)) {
          menuModuleDebug("Successfully entered ESP pairing mode");
      } else {
          ESP_LOGE("MENU", "Failed to transition to update mode");
@@ -274,6 +273,9 @@ bool menuActive = false;
      } else if (item->submenu == menuSettings_getItems()) {
          menuModuleDebug("Setting up SETTINGS submenu");
          menuSettings_getContext(&currentMenuContext);
+     } else if (item->submenu == menuPresets_getItems()) {
+         menuModuleDebug("Setting up PRESETS submenu");
+         menuPresets_getContext(&currentMenuContext);
      } else if (item->submenu == menuTimezone_getItems()) {
          menuModuleDebug("Setting up TIMEZONE submenu");
          menuTimezone_getContext(&currentMenuContext);
@@ -327,6 +329,7 @@ bool menuActive = false;
              
          case MENU_TOGGLE:
              if (item->toggle && item->statusFlag) {
+                 menuDisplay_resetScroll();
                  bool currentState = *item->statusFlag;
                  bool newState = !currentState;
                  menuModuleDebug("Toggling %s: %s -> %s", item->label, 
@@ -344,6 +347,7 @@ bool menuActive = false;
              
          case MENU_ACTION:
              if (item->action) {
+                 menuDisplay_resetScroll();
                  item->action();
                  // Auto-exit after actions (like applying themes)
                  // But don't exit for UPDATE_MODE since it needs to stay in that mode
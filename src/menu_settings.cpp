@@ -75,6 +75,7 @@ void setMenuSettingsDebug(bool enabled) {
 
 static bool audioEnabled = false;
  static bool hapticEnabled = true;
+ static bool quickBootEnabled = false;
  
  //==============================================================================
  // SETTINGS TOGGLE FUNCTIONS
@@ -134,6 +135,15 @@ static bool audioEnabled = false;
      setHapticEnabled(enabled);
  }
  
+ /**
+  * @brief Toggle quick boot
+  * @param enabled true to skip the startup sequence on warm boots
+  */
+ static void toggleQuickBoot(bool enabled) {
+     quickBootEnabled = enabled;
+     setQuickBootEnabled(enabled);
+ }
+ 
  /**
   * @brief Clear all effects and themes
   * 
@@ -156,6 +166,7 @@ static bool audioEnabled = false;
  // Pre-defined menu items (safe initialization)
  static MenuItem audioItem = DEFINE_MENU_TOGGLE(audio, MENU_LABEL_AUDIO, toggleAudio, &audioEnabled);
  static MenuItem hapticItem = DEFINE_MENU_TOGGLE(haptic, MENU_LABEL_HAPTIC, toggleHaptic, &hapticEnabled);
+ static MenuItem quickBootItem = DEFINE_MENU_TOGGLE(quick_boot, MENU_LABEL_QUICK_BOOT, toggleQuickBoot, &quickBootEnabled);
  static MenuItem clearEffectsItem = DEFINE_MENU_ACTION(clear_effects, MENU_LABEL_CLEAR_EFFECTS, clearEffects);
  static MenuItem backItem = DEFINE_MENU_BACK();
  
@@ -187,7 +198,8 @@ static bool audioEnabled = false;
          dynamicSettingsMenu[dynamicSettingsCount++] = &hapticItem;
      }
      
-     // Always include clear effects action and back button
+     // Always include quick boot, clear effects action and back button
+     dynamicSettingsMenu[dynamicSettingsCount++] = &quickBootItem;
      dynamicSettingsMenu[dynamicSettingsCount++] = &clearEffectsItem;
      dynamicSettingsMenu[dynamicSettingsCount++] = &backItem;
      
@@ -259,6 +271,7 @@ void menuSettings_init() {
 void menuSettings_updateStatus() {
      updateAudioStatus();
      updateHapticStatus();
+     quickBootEnabled = getQuickBootEnabled();
      
      // Rebuild menu to ensure it's current
      buildSettingsMenu();
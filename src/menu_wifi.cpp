@@ -125,8 +125,7 @@ static void toggleWifi(bool enabled) {
    // Disable haptics to save power during update mode
    disableHaptics();
    // Transition to update mode using system module
-   transitionToState(SystemState::UPDATE_MODE);
-   if (getCurrentState() == SystemState::UPDATE_MODE) {
+   if (transitionToState(SystemState::UPDATE_MODE)) {
      menuWifiDebug("Successfully entered update mode");
    } else {
      ESP_LOGE("MENU_WIFI", "Failed to transition to update mode");
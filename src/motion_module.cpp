@@ -26,6 +26,7 @@
 #include "menu_module.h"
 #include "soundsfx_module.h"
 #include "speaker_module.h"
+#include "states_module.h"
 
 //==============================================================================
 // CONSTANTS & DEFINITIONS
@@ -47,6 +48,8 @@ const unsigned long IDLE_TIMEOUT = timeToMillis(1, 00);
 //==============================================================================
 
 static bool g_motionStates[static_cast<size_t>(MotionStateType::MOTION_STATE_COUNT)] = {false};
+static volatile uint32_t g_motionEvents = 0; // Bit per state raised since the last takeMotionEvents()
+static bool deepSleepPending = false; // Requested during a state transition
 
 unsigned long INACTIVITY_TIME = 0;
 unsigned long DISPLAY_TIME = 0;
@@ -227,6 +230,9 @@ static void monitorSleep(uint8_t samples) {
  */
 void setMotionState(MotionStateType state, bool value) {
   g_motionStates[static_cast<size_t>(state)] = value;
+  if (value) {
+    __atomic_fetch_or(&g_motionEvents, 1u << static_cast<uint32_t>(state), __ATOMIC_RELAXED);
+  }
   clearInterrupts();
 }
 
@@ -254,6 +260,14 @@ void resetMotionState() {
   }
 }
 
+/**
+ * @brief Collect the motion states raised since the previous call
+ * @return Bit mask indexed by MotionStateType
+ */
+uint32_t takeMotionEvents() {
+  return __atomic_exchange_n(&g_motionEvents, 0, __ATOMIC_RELAXED);
+}
+
 /**
  * @brief Monitor and update haptics power state based on device activity
  * @param samples Number of samples to analyze for activity detection
@@ -417,8 +431,17 @@ bool motionShaking() {
  * 
  * Prepares the device for deep sleep by dimming the display, checking device modes,
  * and initiating the deep sleep sequence. Called when inactivity is detected.
+ * Deferred while a state transition is in flight.
  */
 void handleDeepSleep() {
+  // The transition worker may be inside WiFi.mode() or esp_now_init();
+  // ADXLDataPolling() retries once the main loop has finished it
+  if (isStateTransitioning()) {
+    deepSleepPending = true;
+    return;
+  }
+  deepSleepPending = false;
+
   setDisplayBrightness(DISPLAY_BRIGHTNESS_DIM);
   checkDeviceModes();
   enterDeepSleep();
@@ -660,6 +683,10 @@ bool motionSuddenAcceleration() {
 void ADXLDataPolling() {
   menu_update();
 
+  if (deepSleepPending && !isStateTransitioning()) {
+    handleDeepSleep();
+  }
+
   if (!isSensorEnabled())
     return;
 
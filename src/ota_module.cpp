@@ -5,9 +5,15 @@
  */
 
 #include "ota_module.h"
+#include "asset_module.h"
 #include "common.h"
+#include "delta_module.h"
+#include "gzip_module.h"
 #include "display_module.h"
+#include "http_module.h"
 #include "wifi_module.h"
+#include <atomic>
+#include <freertos/stream_buffer.h>
 
 //==============================================================================
 // GLOBAL VARIABLES
@@ -18,6 +24,20 @@ String otaMessage = "";
 static int uploadTotal = 0;
 static int fileSize = 0;
 static String currentFilename = "";
+static bool otaDeltaUpdate = false;
+static bool otaCompressedUpdate = false;
+static unsigned long otaRestartTime = 0; // Set once the success response is sent
+
+// Upload pipeline - the HTTP handler only copies into otaRing, the writer
+// task owns Update.write until the ring is drained
+static StreamBufferHandle_t otaRing = NULL;
+static StaticStreamBuffer_t otaRingControl;
+static uint8_t *otaRingStorage = NULL;
+static volatile TaskHandle_t otaWriterTask = NULL;
+static std::atomic<size_t> otaReceivedBytes(0);
+static std::atomic<size_t> otaFlashedBytes(0);
+static std::atomic<bool> otaWriteFailed(false);
+static std::atomic<bool> otaWriterStop(false);
 
 //==============================================================================
 // UTILITY FUNCTIONS (STATIC)
@@ -99,21 +119,201 @@ static bool isValidUpdateState(OTAState state) {
   }
 }
 
+/**
+ * @brief Write image data to flash, through the delta applier for patches
+ * @param data Data to write
+ * @param length Number of bytes
+ * @return true if all bytes were accepted
+ */
+static bool writeImageData(const uint8_t *data, size_t length) {
+  if (otaDeltaUpdate) {
+    return deltaUpdate_write(data, length);
+  }
+  return Update.write((uint8_t *)data, length) == length;
+}
+
+/**
+ * @brief Write upload data, inflating it first for .gz uploads
+ * @param data Data as uploaded
+ * @param length Number of bytes
+ * @return true if all bytes were accepted
+ */
+static bool writeUpdateData(const uint8_t *data, size_t length) {
+  if (otaCompressedUpdate) {
+    return gzipStream_write(data, length);
+  }
+  return writeImageData(data, length);
+}
+
+/**
+ * @brief Finish the decompression, delta and Update stages in order
+ * @return true if the new image is complete and bootable
+ */
+static bool endUpdateData() {
+  if (otaCompressedUpdate && !gzipStream_end()) {
+    return false;
+  }
+  return otaDeltaUpdate ? deltaUpdate_end() : Update.end(true);
+}
+
+/**
+ * @brief Abort the update in progress, including any delta or gzip session
+ */
+static void abortUpdateData() {
+  if (otaCompressedUpdate) {
+    gzipStream_abort();
+  }
+  if (otaDeltaUpdate) {
+    deltaUpdate_abort();
+  } else {
+    Update.abort();
+  }
+}
+
+/**
+ * @brief Get the last error of the active update path
+ * @return Error message
+ */
+static const char *updateErrorString() {
+  const char *error = otaCompressedUpdate ? gzipStream_errorString() : NULL;
+  if (error) {
+    return error;
+  }
+  return otaDeltaUpdate ? deltaUpdate_errorString() : Update.errorString();
+}
+
+/**
+ * @brief Flash writer task - drains the upload ring into the Update partition
+ * @param parameter Unused
+ *
+ * Update.write erases each 4 KB sector immediately before programming it, so
+ * running it here lets erase and program time overlap with TCP receive.
+ */
+static void otaWriterTaskFunction(void *parameter) {
+  static uint8_t chunk[OTA_WRITE_CHUNK_SIZE];
+
+  while (!otaWriterStop) {
+    size_t length = xStreamBufferReceive(otaRing, chunk, sizeof(chunk), pdMS_TO_TICKS(50));
+    if (length == 0 || otaWriteFailed) {
+      continue;
+    }
+
+    if (!writeUpdateData(chunk, length)) {
+      otaWriteFailed = true;
+    } else {
+      otaFlashedBytes += length;
+    }
+  }
+
+  otaWriterTask = NULL;
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Stop the flash writer task and release the upload ring
+ */
+static void stopOtaWriter() {
+  if (otaWriterTask) {
+    otaWriterStop = true;
+    unsigned long startTime = millis();
+    while (otaWriterTask && millis() - startTime < OTA_DRAIN_TIMEOUT_MS) {
+      delay(1);
+    }
+    if (otaWriterTask) {
+      ESP_LOGE(OTA_LOG, "Flash writer task did not stop");
+      return;
+    }
+  }
+
+  if (otaRing) {
+    vStreamBufferDelete(otaRing);
+    otaRing = NULL;
+  }
+  if (otaRingStorage) {
+    heap_caps_free(otaRingStorage);
+    otaRingStorage = NULL;
+  }
+}
+
+/**
+ * @brief Allocate the upload ring and start the flash writer task
+ * @return true if the pipeline is ready
+ */
+static bool startOtaWriter() {
+  stopOtaWriter();
+
+  otaRingStorage = (uint8_t *)heap_caps_malloc(OTA_RING_BUFFER_SIZE + 1, MALLOC_CAP_SPIRAM);
+  if (!otaRingStorage) {
+    otaRingStorage = (uint8_t *)heap_caps_malloc(OTA_RING_BUFFER_SIZE + 1, MALLOC_CAP_8BIT);
+  }
+  if (!otaRingStorage) {
+    ESP_LOGE(OTA_LOG, "Failed to allocate upload ring buffer");
+    return false;
+  }
+
+  otaRing = xStreamBufferCreateStatic(OTA_RING_BUFFER_SIZE, 1, otaRingStorage, &otaRingControl);
+  otaReceivedBytes = 0;
+  otaFlashedBytes = 0;
+  otaWriteFailed = false;
+  otaWriterStop = false;
+
+  TaskHandle_t task = NULL;
+  if (xTaskCreatePinnedToCore(otaWriterTaskFunction, "OTAFlash", OTA_WRITER_STACK, NULL, OTA_WRITER_PRIORITY, &task,
+                              OTA_WRITER_CORE) != pdPASS) {
+    ESP_LOGE(OTA_LOG, "Failed to create flash writer task");
+    stopOtaWriter();
+    return false;
+  }
+  otaWriterTask = task;
+  return true;
+}
+
+/**
+ * @brief Wait until everything received has been written to flash
+ * @return true if the ring drained without a write failure
+ */
+static bool drainOtaWriter() {
+  unsigned long startTime = millis();
+  while (!otaWriteFailed && otaFlashedBytes < otaReceivedBytes) {
+    if (millis() - startTime >= OTA_DRAIN_TIMEOUT_MS) {
+      return false;
+    }
+    delay(1);
+  }
+  return !otaWriteFailed;
+}
+
+/**
+ * @brief Get upload progress from the flashed byte counter
+ * @return Progress percentage (0-100)
+ */
+static int getUploadProgress() {
+  size_t total = fileSize > 0 ? (size_t)fileSize : Update.size();
+  if (total == 0) {
+    return 0;
+  }
+  return min((int)((otaFlashedBytes * 100) / total), 100);
+}
+
 /**
  * @brief Initialize file upload for OTA update
- * @param upload HTTP upload object
+ * @param filename Uploaded file name
+ * @param contentLength Request body length (includes a few hundred bytes of
+ *                      multipart framing)
  * @return true if initialization was successful
  */
-static bool initializeUpload(HTTPUpload &upload) {
+static bool initializeUpload(const String &filename, size_t contentLength) {
   const size_t MAX_FIRMWARE_SIZE = 1536 * 1024;
   const size_t MAX_SPIFFS_SIZE = 3 * 1024 * 1024;
 
-  bool isFileSystem = upload.filename.indexOf(FILESYSTEM_BIN) >= 0;
+  bool isFileSystem = filename.indexOf(FILESYSTEM_BIN) >= 0;
+  otaDeltaUpdate = filename.indexOf(FIRMWARE_PATCH) >= 0;
+  otaCompressedUpdate = filename.endsWith(".gz");
   size_t maxSize = isFileSystem ? MAX_SPIFFS_SIZE : MAX_FIRMWARE_SIZE;
 
-  if (upload.totalSize > maxSize) {
+  if (contentLength > maxSize) {
     otaState = OTAState::ERROR;
-    otaMessage = "File too large: " + String(upload.totalSize) +
+    otaMessage = "File too large: " + String(contentLength) +
                  " bytes exceeds " + String(maxSize) + " byte limit";
     ESP_LOGE(OTA_LOG, "%s", otaMessage.c_str());
     return false;
@@ -122,70 +322,93 @@ static bool initializeUpload(HTTPUpload &upload) {
   otaState = OTAState::UPLOADING;
   otaMessage = "Your update is being uploaded to your device, please wait.";
   uploadTotal = 0;
-  currentFilename = upload.filename;
-  fileSize = upload.totalSize;
+  currentFilename = filename;
+  fileSize = contentLength;
 
   int command = isFileSystem ? U_SPIFFS : U_FLASH;
 
-  if (!Update.begin(UPDATE_SIZE_UNKNOWN, command)) {
+  // A delta session opens the partition itself once the patch header
+  // has been checked against the running image
+  bool started = otaDeltaUpdate ? deltaUpdate_begin() : Update.begin(UPDATE_SIZE_UNKNOWN, command);
+  if (started && otaCompressedUpdate && !gzipStream_begin(writeImageData)) {
+    started = false;
+  }
+  if (!started) {
     otaState = OTAState::ERROR;
-    otaMessage = "Error: " + String(Update.errorString());
+    otaMessage = "Error: " + String(updateErrorString());
     ESP_LOGE(OTA_LOG, "%s", otaMessage.c_str());
+    abortUpdateData();
+    return false;
+  }
+
+  if (!startOtaWriter()) {
+    abortUpdateData();
+    otaState = OTAState::ERROR;
+    otaMessage = "Error: Not enough memory for upload buffer";
     return false;
   }
   return true;
 }
 
 /**
- * @brief Handle the writing of uploaded data during OTA update
- * @param upload HTTP upload object
- * @return Current progress percentage
+ * @brief Queue uploaded data for the flash writer task
+ * @param data Uploaded bytes
+ * @param length Number of bytes
+ * @return false if the update failed and the upload should stop
  */
-static int handleUploadWrite(HTTPUpload &upload) {
-  int progress = 0;
-  if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
-    Update.abort();
-    otaState = OTAState::ERROR;
-    otaMessage = "Error: Flash write failed";
-    return progress;
+static bool handleUploadWrite(const uint8_t *data, size_t length) {
+  size_t queued = 0;
+  if (!otaWriteFailed) {
+    queued = xStreamBufferSend(otaRing, data, length, pdMS_TO_TICKS(OTA_SEND_TIMEOUT_MS));
   }
 
-  otaState = OTAState::UPLOADING;
-  uploadTotal = Update.size();
-  fileSize = Update.size();
-
-  progress = (Update.progress() * 100) / Update.size();
-  otaMessage = "Progress: " + String(progress) + "%";
-  ESP_LOGW(OTA_LOG, "Progress: %d%% (Written: %d, Total: %d)\n", progress,
-           Update.progress(), uploadTotal);
+  if (otaWriteFailed || queued != length) {
+    stopOtaWriter();
+    otaState = OTAState::ERROR;
+    otaMessage = otaWriteFailed ? "Error: " + String(updateErrorString()) : "Error: Flash writer stalled";
+    abortUpdateData();
+    return false;
+  }
 
-  return progress;
+  otaReceivedBytes += queued;
+  uploadTotal = otaReceivedBytes;
+  return true;
 }
 
 /**
  * @brief Finalize an OTA update after upload is complete
- * @param upload HTTP upload object
  * @return true if update was successfully finalized
  */
-static bool finalizeUpload(HTTPUpload &upload) {
+static bool finalizeUpload() {
   otaState = OTAState::UPDATING;
   otaMessage = "BYTE-90 is updates are being applied.";
 
-  if (Update.end(true)) {
+  bool drained = drainOtaWriter();
+  stopOtaWriter();
+  if (!drained) {
+    otaState = OTAState::ERROR;
+    otaMessage = otaWriteFailed ? "Error: " + String(updateErrorString()) : "Error: Flash writer timeout";
+    abortUpdateData();
+    return false;
+  }
+
+  if (endUpdateData()) {
     otaState = OTAState::SUCCESS;
     otaMessage = "Update successful! Device will restart in a moment.";
     return true;
   } else {
     otaState = OTAState::ERROR;
-    otaMessage = "Error: " + String(Update.errorString());
+    otaMessage = "Error: " + String(updateErrorString());
+    abortUpdateData();
     return false;
   }
 }
 
 /**
  * @brief Handle completion of the update process
+ * @param req Update request
  */
-static void handleUpdateComplete() {
+static esp_err_t handleUpdateComplete(httpd_req_t *req) {
   String jsonResponse;
   if (otaState == OTAState::ERROR || Update.hasError()) {
     otaState = OTAState::ERROR;
@@ -195,13 +418,40 @@ static void handleUpdateComplete() {
     jsonResponse = createJsonResponse(true, true, "100");
   }
 
-  webServer.send(200, "application/json", jsonResponse);
+  esp_err_t result = httpServer_sendJson(req, 200, jsonResponse);
 
+  // The server cannot stop itself from a handler; handleOTA() restarts
   if (otaState == OTAState::SUCCESS) {
-    webServer.handleClient();
-    delay(1000);
-    stopWiFiAP(true);
+    otaRestartTime = millis();
   }
+  return result;
+}
+
+/**
+ * @brief Validate the uploaded file name and open the update
+ * @param req Update request
+ * @param filename Uploaded file name
+ * @return true if the upload should be received
+ */
+static bool beginFileUpload(httpd_req_t *req, const char *filename) {
+  String name = filename;
+
+  if (!name.endsWith(".bin") && !name.endsWith(".patch") && !name.endsWith(".gz")) {
+    otaState = OTAState::ERROR;
+    otaMessage =
+        "Invalid file type, please choose the correct firmware files.";
+    return false;
+  }
+
+  if (name.indexOf(FIRMWARE_BIN) < 0 && name.indexOf(FILESYSTEM_BIN) < 0 &&
+      name.indexOf(FIRMWARE_PATCH) < 0) {
+    otaState = OTAState::ERROR;
+    otaMessage = "Invalid firmware, the file must be " FIRMWARE_BIN
+                 ", " FILESYSTEM_BIN " or " FIRMWARE_PATCH " (optionally .gz).";
+    return false;
+  }
+
+  return initializeUpload(name, req->content_len);
 }
 
 //==============================================================================
@@ -214,6 +464,7 @@ bool initOTA() {
       esp_ota_get_next_update_partition(NULL);
 
   setupOTAEndpoints();
+  setupAssetEndpoints();
   
   if (!running || !update_partition) {
     ESP_LOGE(OTA_LOG, "Failed to get OTA partitions");
@@ -222,60 +473,46 @@ bool initOTA() {
   return true;
 }
 
-void handleFileUpload() {
-  HTTPUpload &upload = webServer.upload();
+esp_err_t handleFileUpload(httpd_req_t *req) {
+  otaState = OTAState::IDLE;
+  esp_err_t result = httpServer_receiveUpload(req, beginFileUpload, handleUploadWrite);
 
-  switch (upload.status) {
-  case UPLOAD_FILE_START:
-    if (!upload.filename.endsWith(".bin")) {
+  if (otaState == OTAState::UPLOADING) {
+    if (result == ESP_OK) {
+      finalizeUpload();
+    } else {
       otaState = OTAState::ERROR;
-      otaMessage =
-          "Invalid file type, please choose the correct firmware files.";
-      return;
+      otaMessage = result == ESP_ERR_TIMEOUT ? "Device has timed out, upload aborted."
+                                             : "Upload was incomplete, please try again.";
+      stopOtaWriter();
+      abortUpdateData();
     }
+  } else if (otaState != OTAState::ERROR) {
+    otaState = OTAState::ERROR;
+    otaMessage = "No firmware file was uploaded.";
+  }
 
-    if (upload.filename.indexOf(FIRMWARE_BIN) < 0 &&
-        upload.filename.indexOf(FILESYSTEM_BIN) < 0) {
-      otaState = OTAState::ERROR;
-      otaMessage = "Invalid firmware, the file must be " FIRMWARE_BIN
-                   " or " FILESYSTEM_BIN ".";
-      return;
-    }
-    if (!initializeUpload(upload)) {
-      return;
-    }
-    break;
-  case UPLOAD_FILE_WRITE:
-    if (otaState != OTAState::ERROR) {
-      handleUploadWrite(upload);
-    }
-    break;
-
-  case UPLOAD_FILE_END:
-    if (otaState != OTAState::ERROR) {
-      finalizeUpload(upload);
-    }
-    break;
+  return handleUpdateComplete(req);
+}
 
-  case UPLOAD_FILE_ABORTED:
-    otaState = OTAState::ERROR;
-    otaMessage = "Device has timed out, upload aborted.";
-    Update.abort();
-    break;
+void handleOTA() {
+  if (otaRestartTime && millis() - otaRestartTime >= OTA_RESTART_DELAY_MS) {
+    otaRestartTime = 0;
+    stopWiFiAP(true);
   }
 }
 
 void setupOTAEndpoints() {
-  webServer.on("/update", HTTP_POST, handleUpdateComplete, handleFileUpload);
-  webServer.on("/update/status", HTTP_GET, []() {
-    int progress = 0;
-    if (Update.size() > 0) {
-      progress = (Update.progress() * 100) / Update.size();
+  httpServer_on("/update", HTTP_POST, handleFileUpload);
+  httpServer_on("/update/status", HTTP_GET, [](httpd_req_t *req) {
+    int progress = getUploadProgress();
+    if (otaState == OTAState::UPLOADING) {
+      otaMessage = "Progress: " + String(progress) + "%";
     }
 
     String jsonResponse =
         createJsonResponse(isValidUpdateState(otaState),
                            otaState == OTAState::SUCCESS, String(progress));
-    webServer.send(200, "application/json", jsonResponse);
+    return httpServer_sendJson(req, 200, jsonResponse);
   });
 }
\ No newline at end of file
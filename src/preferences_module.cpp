@@ -5,7 +5,12 @@
  * Provides functionality for persistent storage and retrieval of system preferences,
  * user settings, WiFi credentials, and configuration data using ESP32 NVS (Non-Volatile Storage)
  * for the BYTE-90 device.
- * 
+ *
+ * All settings live in one versioned, packed struct in RAM that is persisted
+ * as a single NVS blob. Getters read the struct; setters update it and mark
+ * it dirty, and handlePreferences() commits once the changes settle, so a
+ * burst of menu toggles costs one flash write instead of one per toggle.
+ *
  * This module handles:
  * - System preferences (WiFi mode, startup mode, last known good state)
  * - WiFi credentials storage and retrieval
@@ -13,6 +18,8 @@
  * - Visual effects settings (glitch, scanlines, dithering, etc.)
  * - Tint effect configuration (color and intensity)
  * - Timezone information storage
+ * - Migration of the old per-key namespaces into the settings blob
+ * - A copy of the settings in RTC memory so a deep-sleep wake skips NVS
  * - Debug logging and storage information
  * - NVS storage management and error handling
  */
@@ -21,6 +28,8 @@
 #include "common.h"
 #include <Preferences.h>
 #include <esp_log.h>
+#include <esp_rom_crc.h>
+#include <esp_system.h>
 #include <stdarg.h>
 
 //==============================================================================
@@ -39,7 +48,7 @@ static void preferencesDebug(const char* format, ...) {
   if (!preferencesDebugEnabled) {
     return;
   }
-  
+
   va_list args;
   va_start(args, format);
   esp_log_writev(ESP_LOG_INFO, "PREF_MGR", format, args);
@@ -49,12 +58,12 @@ static void preferencesDebug(const char* format, ...) {
 /**
  * @brief Enable or disable debug logging for preferences operations
  * @param enabled true to enable debug logging, false to disable
- * 
+ *
  * @example
  * // Enable debug logging
  * setPreferencesDebug(true);
- * 
- * // Disable debug logging  
+ *
+ * // Disable debug logging
  * setPreferencesDebug(false);
  */
 void setPreferencesDebug(bool enabled) {
@@ -72,28 +81,52 @@ void setPreferencesDebug(bool enabled) {
 
 static const char* TAG = "PREF_MGR";
 
-// Preferences object
-static Preferences preferences;
-
-// Storage namespaces - organized by category
+// Settings blob - the whole settings struct under a single key
+static const char* SETTINGS_NAMESPACE = "settings";
+static const char* SETTINGS_BLOB_KEY = "blob";
+#define SETTINGS_VERSION 2
+
+// Effect preset bank - its own key, rewritten only when a slot is stored
+static const char* PRESETS_BLOB_KEY = "presets";
+
+#define TIMEZONE_MAX_LEN 64
+#define THEME_MAX_LEN 16
+
+// Bits of preferences_blob_t.flags
+#define FLAG_WIFI_MODE   (1 << 0)
+#define FLAG_AUDIO       (1 << 1)
+#define FLAG_HAPTIC      (1 << 2)
+#define FLAG_GLITCH      (1 << 3)
+#define FLAG_SCANLINES   (1 << 4)
+#define FLAG_DITHERING   (1 << 5)
+#define FLAG_CHROMATIC   (1 << 6)
+#define FLAG_DOT_MATRIX  (1 << 7)
+#define FLAG_PIXELATE    (1 << 8)
+#define FLAG_TINT        (1 << 9)
+#define FLAG_QUICK_BOOT  (1 << 10)
+
+// Dirty mask bits - which part of the blob changed since the last commit
+#define DIRTY_WIFI    (1 << 0)
+#define DIRTY_SYSTEM  (1 << 1)
+#define DIRTY_USER    (1 << 2)
+#define DIRTY_EFFECTS (1 << 3)
+#define DIRTY_PRESETS (1 << 4)
+#define DIRTY_SETTINGS (DIRTY_WIFI | DIRTY_SYSTEM | DIRTY_USER | DIRTY_EFFECTS) // Committed with the settings blob
+
+// Legacy per-key layout, read once to migrate into the settings blob
 static const char* WIFI_NAMESPACE = "wifiPrefs";        // WiFi credentials and network settings
-static const char* SYSTEM_NAMESPACE = "systemPrefs";    // System state and operational settings  
-static const char* USER_NAMESPACE = "userPrefs";        // User customizable settings (TBD)
+static const char* SYSTEM_NAMESPACE = "systemPrefs";    // System state and operational settings
+static const char* USER_NAMESPACE = "userPrefs";        // User customizable settings
 static const char* TIMEZONE_KEY = "timezone";
 
-// WiFi preference keys
 static const char* WIFI_SSID_KEY = "wifi_ssid";
 static const char* WIFI_PASS_KEY = "wifi_password";
-// Future WiFi keys: "static_ip", "dns_server", "auto_connect", etc.
 
-// System preference keys
 static const char* STARTUP_MODE_KEY = "startup_mode";
 static const char* LAST_GOOD_STATE_KEY = "last_good_state";
 static const char* USER_WIFI_MODE_ENABLED_KEY = "wifi_mode_en";
 
-// User preference keys (example)
 static const char* USER_THEME_KEY = "theme";
-// Future user keys can be added here: "display_timeout", "language", etc.
 static const char* USER_AUDIO_ENABLED_KEY = "audio_en";
 static const char* USER_HAPTIC_ENABLED_KEY = "haptic_en";
 static const char* USER_GLITCH_ENABLED_KEY = "glitch_en";
@@ -108,37 +141,368 @@ static const char* USER_TINT_INTENSITY_KEY = "tint_intensity";
 
 // Default values - no hardcoded real credentials
 static const uint8_t DEFAULT_STARTUP_MODE = 0; // IDLE_MODE
-static const bool DEFAULT_WIFI_MODE_ENABLED = false;
-static const char* DEFAULT_SSID = "";          // Empty - forces configuration
-static const char* DEFAULT_PASSWORD = "";      // Empty - forces configuration
 static const char* DEFAULT_TIMEZONE = "EST5EDT,M3.2.0,M11.1.0"; // Eastern Time with DST
 static const char* DEFAULT_THEME = "dark";
-
-static const bool DEFAULT_AUDIO_ENABLED = true;
-static const bool DEFAULT_HAPTIC_ENABLED = true;
-static const bool DEFAULT_GLITCH_ENABLED = false;
-static const bool DEFAULT_SCANLINES_ENABLED = false;
-static const bool DEFAULT_DITHERING_ENABLED = false;
-static const bool DEFAULT_CHROMATIC_ENABLED = false;
-static const bool DEFAULT_DOT_MATRIX_ENABLED = false;
-static const bool DEFAULT_PIXELATE_ENABLED = false;
-static const bool DEFAULT_TINT_ENABLED = false;
+static const uint16_t DEFAULT_FLAGS = FLAG_AUDIO | FLAG_HAPTIC; // WiFi mode and all effects off
 static const uint16_t DEFAULT_TINT_COLOR = 0x07E0; // Green
 static const float DEFAULT_TINT_INTENSITY = 0.8f;
 
 //==============================================================================
-// CACHING VARIABLES
+// TYPE DEFINITIONS
+//==============================================================================
+
+/**
+ * @brief Every persisted setting, stored as-is in one NVS blob
+ * Bump SETTINGS_VERSION when the layout changes. New fields are only ever
+ * appended, so an older blob loads as a prefix of the current layout.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t version;                          // SETTINGS_VERSION
+    uint8_t startupMode;
+    uint8_t lastGoodState;
+    uint8_t reserved;
+    uint16_t flags;                           // FLAG_* bits
+    uint16_t tintColor;                       // RGB565
+    float tintIntensity;                      // 0.0 to 1.0
+    char timezone[TIMEZONE_MAX_LEN];
+    char theme[THEME_MAX_LEN];
+    char ssid[WIFI_SSID_MAX_LEN];
+    char password[WIFI_PASSWORD_MAX_LEN];
+    // Version 2
+    uint8_t effectPresetLength;               // 0 when no preset is stored
+    uint8_t effectPreset[PREFERENCES_EFFECT_PRESET_MAX];
+} preferences_blob_t;
+
+/**
+ * @brief Stored effect presets, opaque to this module
+ * Unversioned: a bank of a different size is discarded on load.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t length[PREFERENCES_PRESET_SLOTS];   // 0 for an empty slot
+    uint8_t data[PREFERENCES_PRESET_SLOTS][PREFERENCES_EFFECT_PRESET_MAX];
+} preset_bank_t;
+
+/**
+ * @brief Settings as they were when the device went to deep sleep
+ * Includes the dirty mask, so changes that could not be committed before
+ * sleeping are committed after the wake.
+ */
+typedef struct {
+    preferences_blob_t settings;
+    preset_bank_t presets;
+    uint8_t dirtyMask;
+    uint32_t crc; // CRC32 of the fields above
+} __attribute__((packed)) sleep_cache_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static preferences_blob_t settings;
+static preset_bank_t presetBank;
+static bool preferencesAvailable = false;
+
+// Uncommitted changes; the web server task writes settings too
+static uint8_t dirtyMask = 0;
+static unsigned long dirtySince = 0;    // First change since the last commit
+static unsigned long lastChange = 0;
+static portMUX_TYPE settingsLock = portMUX_INITIALIZER_UNLOCKED;
+
+// Orders whole flushes, so an older snapshot can never be written last
+static StaticSemaphore_t flushMutexBuffer;
+static SemaphoreHandle_t flushMutex = xSemaphoreCreateMutexStatic(&flushMutexBuffer);
+
+// Retained through deep sleep only; checked against its CRC before use
+static RTC_DATA_ATTR sleep_cache_t sleepCache;
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
 //==============================================================================
-static bool cachedWiFiModeEnabled = DEFAULT_WIFI_MODE_ENABLED;
-static bool wifiModePreferenceCached = false;
 
-// Audio preference caching
-static bool cachedAudioEnabled = DEFAULT_AUDIO_ENABLED;
-static bool audioPreferenceCached = false;
+/**
+ * @brief Fill a settings blob with factory defaults
+ */
+static void applyDefaults(preferences_blob_t* blob) {
+    memset(blob, 0, sizeof(*blob));
+    blob->version = SETTINGS_VERSION;
+    blob->startupMode = DEFAULT_STARTUP_MODE;
+    blob->lastGoodState = DEFAULT_STARTUP_MODE;
+    blob->flags = DEFAULT_FLAGS;
+    blob->tintColor = DEFAULT_TINT_COLOR;
+    blob->tintIntensity = DEFAULT_TINT_INTENSITY;
+    strlcpy(blob->timezone, DEFAULT_TIMEZONE, sizeof(blob->timezone));
+    strlcpy(blob->theme, DEFAULT_THEME, sizeof(blob->theme));
+}
+
+/**
+ * @brief Record a change; the caller holds settingsLock
+ */
+static void markDirtyLocked(uint8_t mask) {
+    unsigned long now = millis();
+    if (dirtyMask == 0) {
+        dirtySince = now;
+    }
+    dirtyMask |= mask;
+    lastChange = now;
+}
+
+static bool getFlag(uint16_t flag) {
+    return (settings.flags & flag) != 0;
+}
+
+/**
+ * @brief Update one flag, marking the blob dirty only if it changed
+ * @return true if the change will be persisted
+ */
+static bool setFlag(uint16_t flag, bool enabled, uint8_t dirty) {
+    portENTER_CRITICAL(&settingsLock);
+    if (getFlag(flag) != enabled) {
+        settings.flags ^= flag;
+        markDirtyLocked(dirty);
+    }
+    portEXIT_CRITICAL(&settingsLock);
+    return preferencesAvailable;
+}
+
+/**
+ * @brief Copy a string field out of the settings under the lock
+ */
+static void readString(const char* field, char* buffer, size_t size) {
+    portENTER_CRITICAL(&settingsLock);
+    strlcpy(buffer, field, size);
+    portEXIT_CRITICAL(&settingsLock);
+}
+
+/**
+ * @brief Replace a string field, marking the blob dirty only if it changed
+ */
+static void writeString(char* field, size_t size, const char* value, uint8_t dirty) {
+    portENTER_CRITICAL(&settingsLock);
+    if (strncmp(field, value, size) != 0) {
+        strlcpy(field, value, size);
+        markDirtyLocked(dirty);
+    }
+    portEXIT_CRITICAL(&settingsLock);
+}
+
+/**
+ * @brief Read the old per-key namespaces into a blob
+ * @return true if any legacy namespace existed
+ *
+ * Keys missing from the old layout keep their defaults.
+ */
+static bool loadLegacyPreferences(preferences_blob_t* blob) {
+    Preferences legacy;
+    bool found = false;
+
+    if (legacy.begin(WIFI_NAMESPACE, true)) {
+        legacy.getString(WIFI_SSID_KEY, blob->ssid, sizeof(blob->ssid));
+        legacy.getString(WIFI_PASS_KEY, blob->password, sizeof(blob->password));
+        legacy.end();
+        found = true;
+    }
+
+    if (legacy.begin(SYSTEM_NAMESPACE, true)) {
+        blob->startupMode = legacy.getUChar(STARTUP_MODE_KEY, blob->startupMode);
+        blob->lastGoodState = legacy.getUChar(LAST_GOOD_STATE_KEY, blob->lastGoodState);
+        if (legacy.isKey(TIMEZONE_KEY)) {
+            legacy.getString(TIMEZONE_KEY, blob->timezone, sizeof(blob->timezone));
+        }
+        legacy.end();
+        found = true;
+    }
+
+    if (legacy.begin(USER_NAMESPACE, true)) {
+        static const struct {
+            const char* key;
+            uint16_t flag;
+        } legacyFlags[] = {
+            {USER_WIFI_MODE_ENABLED_KEY, FLAG_WIFI_MODE},
+            {USER_AUDIO_ENABLED_KEY, FLAG_AUDIO},
+            {USER_HAPTIC_ENABLED_KEY, FLAG_HAPTIC},
+            {USER_GLITCH_ENABLED_KEY, FLAG_GLITCH},
+            {USER_SCANLINES_ENABLED_KEY, FLAG_SCANLINES},
+            {USER_DITHERING_ENABLED_KEY, FLAG_DITHERING},
+            {USER_CHROMATIC_ENABLED_KEY, FLAG_CHROMATIC},
+            {USER_DOT_MATRIX_ENABLED_KEY, FLAG_DOT_MATRIX},
+            {USER_PIXELATE_ENABLED_KEY, FLAG_PIXELATE},
+            {USER_TINT_ENABLED_KEY, FLAG_TINT},
+        };
+
+        for (const auto& entry : legacyFlags) {
+            bool enabled = legacy.getBool(entry.key, (blob->flags & entry.flag) != 0);
+            blob->flags = enabled ? (blob->flags | entry.flag) : (blob->flags & ~entry.flag);
+        }
+        if (legacy.isKey(USER_THEME_KEY)) {
+            legacy.getString(USER_THEME_KEY, blob->theme, sizeof(blob->theme));
+        }
+        blob->tintColor = legacy.getUShort(USER_TINT_COLOR_KEY, blob->tintColor);
+        blob->tintIntensity = legacy.getFloat(USER_TINT_INTENSITY_KEY, blob->tintIntensity);
+        legacy.end();
+        found = true;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Erase the old per-key namespaces once the blob holds their values
+ */
+static void clearLegacyPreferences() {
+    Preferences legacy;
+    const char* namespaces[] = {WIFI_NAMESPACE, SYSTEM_NAMESPACE, USER_NAMESPACE};
+
+    for (const char* name : namespaces) {
+        if (legacy.begin(name, false)) {
+            legacy.clear();
+            legacy.end();
+        }
+    }
+}
+
+/**
+ * @brief Persist one blob with a single NVS commit
+ *
+ * Uses its own Preferences instance since flushes can come from the web
+ * server task as well as the main loop.
+ */
+static bool writeBlob(const char* key, const void* data, size_t length) {
+    Preferences store;
+    if (!store.begin(SETTINGS_NAMESPACE, false)) {
+        ESP_LOGE(TAG, "Failed to open settings namespace for writing");
+        return false;
+    }
+
+    bool success = store.putBytes(key, data, length) == length;
+    store.end();
+
+    if (!success) {
+        ESP_LOGE(TAG, "Failed to write %s blob", key);
+    }
+    return success;
+}
+
+/**
+ * @brief Replace preset bytes, marking them dirty only if they changed
+ * @return true if the preset will be persisted
+ */
+static bool writePreset(uint8_t* storedLength, uint8_t* stored, const void* preset, size_t length, uint8_t dirty) {
+    if (!preset || length == 0 || length > PREFERENCES_EFFECT_PRESET_MAX) {
+        ESP_LOGE(TAG, "Invalid effect preset (%d bytes) - not saving", length);
+        return false;
+    }
+
+    portENTER_CRITICAL(&settingsLock);
+    if (*storedLength != length || memcmp(stored, preset, length) != 0) {
+        memcpy(stored, preset, length);
+        *storedLength = length;
+        markDirtyLocked(dirty);
+    }
+    portEXIT_CRITICAL(&settingsLock);
+
+    return preferencesAvailable;
+}
+
+/**
+ * @brief Copy preset bytes out under the lock
+ * @return Preset length, or 0 if none is stored or it does not fit
+ */
+static size_t readPreset(const uint8_t* storedLength, const uint8_t* stored, void* preset, size_t size) {
+    if (!preset) {
+        return 0;
+    }
+
+    portENTER_CRITICAL(&settingsLock);
+    size_t length = *storedLength;
+    if (length > size) {
+        length = 0;
+    } else {
+        memcpy(preset, stored, length);
+    }
+    portEXIT_CRITICAL(&settingsLock);
+
+    return length;
+}
+
+/**
+ * @brief Restores the settings saved by savePreferencesForSleep()
+ * @return true if the device woke from deep sleep with a valid copy
+ */
+static bool loadSleepCache() {
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP ||
+        sleepCache.crc != esp_rom_crc32_le(0, (const uint8_t*)&sleepCache, offsetof(sleep_cache_t, crc)) ||
+        sleepCache.settings.version != SETTINGS_VERSION) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&settingsLock);
+    settings = sleepCache.settings;
+    presetBank = sleepCache.presets;
+    if (sleepCache.dirtyMask) {
+        markDirtyLocked(sleepCache.dirtyMask);
+    }
+    portEXIT_CRITICAL(&settingsLock);
+
+    // Used once; a later wake must not pick up stale settings
+    sleepCache.crc = ~sleepCache.crc;
+    return true;
+}
 
-// Haptic preference caching  
-static bool cachedHapticEnabled = DEFAULT_HAPTIC_ENABLED;
-static bool hapticPreferenceCached = false;
+/**
+ * @brief Load the settings blob, migrating the old layout if there is none
+ * @return true if NVS is usable
+ */
+static bool loadSettings() {
+    Preferences store;
+    if (!store.begin(SETTINGS_NAMESPACE, false)) {
+        return false;
+    }
+
+    applyDefaults(&settings);
+    size_t length = store.getBytesLength(SETTINGS_BLOB_KEY);
+    bool loaded = false;
+
+    if (length > 0 && length <= sizeof(settings)) {
+        preferences_blob_t stored = settings;
+        if (store.getBytes(SETTINGS_BLOB_KEY, &stored, length) == length && stored.version > 0 &&
+            (stored.version == SETTINGS_VERSION ? length == sizeof(settings) : stored.version < SETTINGS_VERSION)) {
+            settings = stored;
+            loaded = true;
+        }
+    }
+
+    memset(&presetBank, 0, sizeof(presetBank));
+    if (store.getBytesLength(PRESETS_BLOB_KEY) == sizeof(presetBank)) {
+        store.getBytes(PRESETS_BLOB_KEY, &presetBank, sizeof(presetBank));
+    }
+    store.end();
+
+    if (loaded) {
+        preferencesDebug("Settings blob loaded (version %d, %d bytes)", settings.version, length);
+        if (settings.version < SETTINGS_VERSION) {
+            // Fields the old blob lacks already hold their defaults
+            ESP_LOGI(TAG, "Upgrading settings blob from version %d", settings.version);
+            settings.version = SETTINGS_VERSION;
+            portENTER_CRITICAL(&settingsLock);
+            markDirtyLocked(DIRTY_SYSTEM | DIRTY_USER | DIRTY_EFFECTS);
+            portEXIT_CRITICAL(&settingsLock);
+        }
+        return true;
+    }
+
+    if (length > 0) {
+        ESP_LOGW(TAG, "Settings blob has an unknown layout (%d bytes) - resetting to defaults", length);
+    }
+
+    if (loadLegacyPreferences(&settings)) {
+        // Only drop the old keys once their values are safely in the blob
+        if (writeBlob(SETTINGS_BLOB_KEY, &settings, sizeof(settings))) {
+            clearLegacyPreferences();
+            ESP_LOGI(TAG, "Migrated per-key preferences into the settings blob");
+        }
+    }
+    return true;
+}
 
 //==============================================================================
 // PUBLIC API FUNCTIONS
@@ -146,26 +510,128 @@ static bool hapticPreferenceCached = false;
 
 /**
  * @brief Initializes the preferences manager and NVS storage
- * 
- * Initializes the ESP32 NVS (Non-Volatile Storage) system for persistent
- * preferences storage. Tests NVS availability and sets up the preferences
- * manager for use by other modules.
+ *
+ * Initializes the ESP32 NVS (Non-Volatile Storage) system and loads the
+ * settings blob into RAM, migrating the old per-key layout on first boot.
+ * Falls back to defaults, kept in RAM only, if NVS is unavailable.
  */
 void initPreferencesManager() {
     preferencesDebug("Initializing Preferences Manager...");
-    
-    // Test NVS availability with system namespace
-    if (!preferences.begin(SYSTEM_NAMESPACE, true)) {
-        ESP_LOGE(TAG, "Failed to initialize NVS - preferences will not work");
+
+    // Waking from deep sleep: the settings never left RTC memory
+    if (loadSleepCache()) {
+        preferencesAvailable = true;
+        preferencesDebug("Settings restored from RTC memory");
         return;
     }
-    preferences.end();
-    
+
+    preferencesAvailable = loadSettings();
+    if (!preferencesAvailable) {
+        ESP_LOGE(TAG, "Failed to initialize NVS - preferences will not persist");
+        applyDefaults(&settings);
+        return;
+    }
+
     preferencesDebug("NVS storage available - preferences ready");
-    preferencesDebug("Preference categories: WiFi, System, User(TBD)");
     printStorageInfo();
 }
 
+/**
+ * @brief Commits pending changes once they have settled
+ *
+ * Waits for PREFERENCES_COMMIT_DELAY_MS without changes so bursts of
+ * setters coalesce into one write, but never holds changes back longer
+ * than PREFERENCES_COMMIT_MAX_DELAY_MS.
+ */
+void handlePreferences() {
+    portENTER_CRITICAL(&settingsLock);
+    unsigned long now = millis();
+    bool due = dirtyMask != 0 &&
+               (now - lastChange >= PREFERENCES_COMMIT_DELAY_MS ||
+                now - dirtySince >= PREFERENCES_COMMIT_MAX_DELAY_MS);
+    portEXIT_CRITICAL(&settingsLock);
+
+    if (due) {
+        flushPreferences();
+    }
+}
+
+/**
+ * @brief Commits pending changes immediately
+ * @return true if nothing is left uncommitted
+ *
+ * Takes a snapshot so setters from other tasks are never blocked by the
+ * flash write. Concurrent flushes from the web server task and the main
+ * loop take turns, each snapshotting and writing before the next starts.
+ * On failure the changes stay dirty and the next attempt is pushed back by
+ * a full commit delay.
+ */
+bool flushPreferences() {
+    preferences_blob_t snapshot;
+    preset_bank_t bankSnapshot;
+
+    xSemaphoreTake(flushMutex, portMAX_DELAY);
+    portENTER_CRITICAL(&settingsLock);
+    uint8_t mask = dirtyMask;
+    if (mask & DIRTY_SETTINGS) {
+        snapshot = settings;
+    }
+    if (mask & DIRTY_PRESETS) {
+        bankSnapshot = presetBank;
+    }
+    dirtyMask = 0;
+    portEXIT_CRITICAL(&settingsLock);
+
+    if (mask == 0) {
+        xSemaphoreGive(flushMutex);
+        return true;
+    }
+
+    // Each blob is only rewritten when something in it changed
+    uint8_t failed = 0;
+    if ((mask & DIRTY_SETTINGS) &&
+        !(preferencesAvailable && writeBlob(SETTINGS_BLOB_KEY, &snapshot, sizeof(snapshot)))) {
+        failed |= mask & DIRTY_SETTINGS;
+    }
+    if ((mask & DIRTY_PRESETS) &&
+        !(preferencesAvailable && writeBlob(PRESETS_BLOB_KEY, &bankSnapshot, sizeof(bankSnapshot)))) {
+        failed |= DIRTY_PRESETS;
+    }
+
+    if (failed) {
+        portENTER_CRITICAL(&settingsLock);
+        unsigned long now = millis();
+        dirtyMask |= failed;
+        dirtySince = now;
+        lastChange = now;
+        portEXIT_CRITICAL(&settingsLock);
+        xSemaphoreGive(flushMutex);
+        return false;
+    }
+
+    xSemaphoreGive(flushMutex);
+    preferencesDebug("Settings committed (dirty mask 0x%02X)", mask);
+    return true;
+}
+
+/**
+ * @brief Commits pending changes and keeps a copy in RTC memory for the wake
+ *
+ * The copy is taken even if the commit fails; its dirty mask makes the wake
+ * retry the commit.
+ */
+void savePreferencesForSleep() {
+    flushPreferences();
+
+    portENTER_CRITICAL(&settingsLock);
+    sleepCache.settings = settings;
+    sleepCache.presets = presetBank;
+    sleepCache.dirtyMask = dirtyMask;
+    portEXIT_CRITICAL(&settingsLock);
+
+    sleepCache.crc = esp_rom_crc32_le(0, (const uint8_t*)&sleepCache, offsetof(sleep_cache_t, crc));
+}
+
 // =============================================================================
 // WiFi Preferences - Network credentials and WiFi-related settings
 // =============================================================================
@@ -175,54 +641,33 @@ void initPreferencesManager() {
  * @param ssid WiFi network SSID
  * @param password WiFi network password
  * @return true if credentials saved successfully, false otherwise
- * 
- * Saves WiFi network credentials to NVS storage with validation of input
- * parameters and length limits. Handles both SSID and password storage.
+ *
+ * Validates the input parameters and length limits and stores both SSID
+ * and password in the settings blob.
  */
 bool saveWiFiCredentials(const char* ssid, const char* password) {
     if (!ssid || strlen(ssid) == 0) {
         ESP_LOGW(TAG, "Invalid SSID provided - not saving credentials");
         return false;
     }
-    
+
     if (strlen(ssid) >= WIFI_SSID_MAX_LEN) {
-        ESP_LOGW(TAG, "SSID too long (%d chars, max %d) - not saving credentials", 
+        ESP_LOGW(TAG, "SSID too long (%d chars, max %d) - not saving credentials",
                  strlen(ssid), WIFI_SSID_MAX_LEN - 1);
         return false;
     }
-    
+
     if (password && strlen(password) >= WIFI_PASSWORD_MAX_LEN) {
-        ESP_LOGW(TAG, "Password too long (%d chars, max %d) - not saving credentials", 
+        ESP_LOGW(TAG, "Password too long (%d chars, max %d) - not saving credentials",
                  strlen(password), WIFI_PASSWORD_MAX_LEN - 1);
         return false;
     }
-    
-    if (!preferences.begin(WIFI_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open WiFi preferences for writing");
-        return false;
-    }
-    
-    bool success = true;
-    
-    // Save SSID
-    if (preferences.putString(WIFI_SSID_KEY, ssid) == 0) {
-        ESP_LOGE(TAG, "Failed to save SSID to WiFi preferences");
-        success = false;
-    }
-    
-    // Save password (can be empty)
-    if (preferences.putString(WIFI_PASS_KEY, password ? password : "") == 0) {
-        ESP_LOGE(TAG, "Failed to save password to WiFi preferences");
-        success = false;
-    }
-    
-    preferences.end();
-    
-    if (success) {
-        preferencesDebug("WiFi credentials saved to wifiPrefs namespace - SSID: %s", ssid);
-    }
-    
-    return success;
+
+    writeString(settings.ssid, sizeof(settings.ssid), ssid, DIRTY_WIFI);
+    writeString(settings.password, sizeof(settings.password), password ? password : "", DIRTY_WIFI);
+
+    preferencesDebug("WiFi credentials saved - SSID: %s", ssid);
+    return preferencesAvailable;
 }
 
 /**
@@ -230,8 +675,8 @@ bool saveWiFiCredentials(const char* ssid, const char* password) {
  * @param ssid Buffer to store SSID (must be at least WIFI_SSID_MAX_LEN bytes)
  * @param password Buffer to store password (must be at least WIFI_PASSWORD_MAX_LEN bytes)
  * @return true if credentials loaded successfully, false otherwise
- * 
- * Loads WiFi network credentials from NVS storage into provided buffers.
+ *
+ * Copies the stored credentials into the provided buffers.
  * Validates buffer pointers and handles missing credentials gracefully.
  */
 bool loadWiFiCredentials(char* ssid, char* password) {
@@ -239,56 +684,32 @@ bool loadWiFiCredentials(char* ssid, char* password) {
         ESP_LOGE(TAG, "Invalid buffers provided for credential loading");
         return false;
     }
-    
-    if (!preferences.begin(WIFI_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open WiFi preferences - no credentials available");
-        ssid[0] = '\0';
-        password[0] = '\0';
-        return false;
-    }
-    
-    // Load SSID
-    String storedSSID = preferences.getString(WIFI_SSID_KEY, DEFAULT_SSID);
-    if (storedSSID.length() == 0) {
+
+    portENTER_CRITICAL(&settingsLock);
+    strlcpy(ssid, settings.ssid, WIFI_SSID_MAX_LEN);
+    strlcpy(password, settings.password, WIFI_PASSWORD_MAX_LEN);
+    portEXIT_CRITICAL(&settingsLock);
+
+    if (ssid[0] == '\0') {
         ESP_LOGW(TAG, "No SSID found in WiFi preferences");
-        ssid[0] = '\0';
         password[0] = '\0';
-        preferences.end();
         return false;
     }
-    
-    // Load password
-    String storedPassword = preferences.getString(WIFI_PASS_KEY, DEFAULT_PASSWORD);
-    
-    preferences.end();
-    
-    // Copy to output buffers safely
-    strncpy(ssid, storedSSID.c_str(), WIFI_SSID_MAX_LEN - 1);
-    ssid[WIFI_SSID_MAX_LEN - 1] = '\0';
-    strncpy(password, storedPassword.c_str(), WIFI_PASSWORD_MAX_LEN - 1);
-    password[WIFI_PASSWORD_MAX_LEN - 1] = '\0';
-    
-    preferencesDebug("WiFi credentials loaded from wifiPrefs - SSID: %s", ssid);
+
+    preferencesDebug("WiFi credentials loaded - SSID: %s", ssid);
     return true;
 }
 
 /**
  * @brief Clears stored WiFi credentials from persistent storage
- * 
- * Removes all WiFi credentials from NVS storage, effectively forgetting
- * the stored network information. Used for network changes or security.
+ *
+ * Forgets the stored network information. Used for network changes or security.
  */
 void clearWiFiCredentials() {
-    if (!preferences.begin(WIFI_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open WiFi preferences for clearing");
-        return;
-    }
-    
-    preferences.remove(WIFI_SSID_KEY);
-    preferences.remove(WIFI_PASS_KEY);
-    preferences.end();
-    
-    preferencesDebug("WiFi credentials cleared from wifiPrefs namespace");
+    writeString(settings.ssid, sizeof(settings.ssid), "", DIRTY_WIFI);
+    writeString(settings.password, sizeof(settings.password), "", DIRTY_WIFI);
+
+    preferencesDebug("WiFi credentials cleared");
 }
 
 // =============================================================================
@@ -296,125 +717,87 @@ void clearWiFiCredentials() {
 // =============================================================================
 
 void saveStartupMode(uint8_t mode) {
-    if (!preferences.begin(SYSTEM_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open system preferences for writing startup mode");
-        return;
+    portENTER_CRITICAL(&settingsLock);
+    if (settings.startupMode != mode) {
+        settings.startupMode = mode;
+        markDirtyLocked(DIRTY_SYSTEM);
     }
-    
-    if (preferences.putUChar(STARTUP_MODE_KEY, mode) == 0) {
-        ESP_LOGE(TAG, "Failed to save startup mode to system preferences");
-    } else {
-        ESP_LOGD(TAG, "Startup mode saved to systemPrefs: %d", mode);
-    }
-    
-    preferences.end();
+    portEXIT_CRITICAL(&settingsLock);
+
+    ESP_LOGD(TAG, "Startup mode saved: %d", mode);
 }
 
 uint8_t loadStartupMode() {
-    if (!preferences.begin(SYSTEM_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open system preferences - using default startup mode");
-        return DEFAULT_STARTUP_MODE;
-    }
-    
-    uint8_t mode = preferences.getUChar(STARTUP_MODE_KEY, DEFAULT_STARTUP_MODE);
-    preferences.end();
-    
+    uint8_t mode = settings.startupMode;
+
     // Validate mode against SystemState enum values:
     // 0=IDLE_MODE, 1=WIFI_MODE, 4=ESP_MODE are valid startup states
     // 2=UPDATE_MODE, 3=CLOCK_MODE are temporary and not valid for startup
     if (mode > 4 || mode == 2 || mode == 3) {
-        ESP_LOGW(TAG, "Invalid startup mode %d loaded from systemPrefs - using default", mode);
+        ESP_LOGW(TAG, "Invalid startup mode %d loaded - using default", mode);
         mode = DEFAULT_STARTUP_MODE;
         saveStartupMode(mode); // Save corrected value
     }
-    
-    ESP_LOGD(TAG, "Startup mode loaded from systemPrefs: %d", mode);
+
+    ESP_LOGD(TAG, "Startup mode loaded: %d", mode);
     return mode;
 }
 
 void saveLastKnownGoodState(uint8_t state) {
-    if (!preferences.begin(SYSTEM_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open system preferences for writing last good state");
-        return;
+    portENTER_CRITICAL(&settingsLock);
+    if (settings.lastGoodState != state) {
+        settings.lastGoodState = state;
+        markDirtyLocked(DIRTY_SYSTEM);
     }
-    
-    if (preferences.putUChar(LAST_GOOD_STATE_KEY, state) == 0) {
-        ESP_LOGE(TAG, "Failed to save last known good state to system preferences");
-    } else {
-        ESP_LOGD(TAG, "Last known good state saved to systemPrefs: %d", state);
-    }
-    
-    preferences.end();
+    portEXIT_CRITICAL(&settingsLock);
+
+    ESP_LOGD(TAG, "Last known good state saved: %d", state);
 }
 
 uint8_t loadLastKnownGoodState() {
-    if (!preferences.begin(SYSTEM_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open system preferences - using default last good state");
-        return DEFAULT_STARTUP_MODE;
-    }
-    
-    uint8_t state = preferences.getUChar(LAST_GOOD_STATE_KEY, DEFAULT_STARTUP_MODE);
-    preferences.end();
-    
-    ESP_LOGD(TAG, "Last known good state loaded from systemPrefs: %d", state);
+    uint8_t state = settings.lastGoodState;
+    ESP_LOGD(TAG, "Last known good state loaded: %d", state);
     return state;
 }
 
 /**
  * @brief Gets the current WiFi mode enabled state
  * @return true if WiFi mode is enabled, false otherwise
- * 
- * Retrieves the WiFi mode enabled state from NVS storage with caching
- * for performance. Returns default value if not found or on error.
  */
 bool getWiFiModeEnabled() {
-    // Return cached value if available
-    if (wifiModePreferenceCached) {
-        return cachedWiFiModeEnabled;
-    }
-    
-    // Load from preferences and cache
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        cachedWiFiModeEnabled = DEFAULT_WIFI_MODE_ENABLED;
-        wifiModePreferenceCached = true;
-        return cachedWiFiModeEnabled;
-    }
-    
-    cachedWiFiModeEnabled = preferences.getBool(USER_WIFI_MODE_ENABLED_KEY, DEFAULT_WIFI_MODE_ENABLED);
-    preferences.end();
-    wifiModePreferenceCached = true;
-    
-    return cachedWiFiModeEnabled;
+    return getFlag(FLAG_WIFI_MODE);
 }
 
 /**
  * @brief Sets the WiFi mode enabled state
  * @param enabled true to enable WiFi mode, false to disable
  * @return true if state saved successfully, false otherwise
- * 
- * Saves the WiFi mode enabled state to NVS storage and updates the cache.
+ *
  * Used to control whether WiFi functionality is enabled on the device.
  */
 bool setWiFiModeEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for writing WiFi mode");
-        return false;
-    }
-    
-    if (preferences.putBool(USER_WIFI_MODE_ENABLED_KEY, enabled) == 0) {
-        ESP_LOGE(TAG, "Failed to save WiFi mode to user preferences");
-        preferences.end();
-        return false;
-    }
-    
-    preferences.end();
-    
-    // Update cache
-    cachedWiFiModeEnabled = enabled;
-    wifiModePreferenceCached = true;
-    
+    bool success = setFlag(FLAG_WIFI_MODE, enabled, DIRTY_SYSTEM);
     preferencesDebug("WiFi mode saved: %s", enabled ? "enabled" : "disabled");
-    return true;
+    return success;
+}
+
+/**
+ * @brief Gets whether warm boots skip the startup sequence
+ * @return true if quick boot is enabled, false otherwise
+ */
+bool getQuickBootEnabled() {
+    return getFlag(FLAG_QUICK_BOOT);
+}
+
+/**
+ * @brief Sets whether warm boots skip the startup sequence
+ * @param enabled true to enable quick boot, false to disable
+ * @return true if state saved successfully, false otherwise
+ */
+bool setQuickBootEnabled(bool enabled) {
+    bool success = setFlag(FLAG_QUICK_BOOT, enabled, DIRTY_SYSTEM);
+    preferencesDebug("Quick boot saved: %s", enabled ? "enabled" : "disabled");
+    return success;
 }
 
 bool saveTimezone(const char* timezone) {
@@ -422,26 +805,16 @@ bool saveTimezone(const char* timezone) {
         ESP_LOGW(TAG, "Invalid timezone provided - not saving");
         return false;
     }
-    
-    if (strlen(timezone) >= 64) {  // Reasonable timezone string length limit
-        ESP_LOGW(TAG, "Timezone string too long (%d chars, max 63) - not saving", strlen(timezone));
-        return false;
-    }
-    
-    if (!preferences.begin(SYSTEM_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open system preferences for writing timezone");
-        return false;
-    }
-    
-    if (preferences.putString(TIMEZONE_KEY, timezone) == 0) {
-        ESP_LOGE(TAG, "Failed to save timezone to system preferences");
-        preferences.end();
+
+    if (strlen(timezone) >= TIMEZONE_MAX_LEN) {
+        ESP_LOGW(TAG, "Timezone string too long (%d chars, max %d) - not saving", strlen(timezone),
+                 TIMEZONE_MAX_LEN - 1);
         return false;
     }
-    
-    preferences.end();
-    preferencesDebug("Timezone saved to systemPrefs: %s", timezone);
-    return true;
+
+    writeString(settings.timezone, sizeof(settings.timezone), timezone, DIRTY_SYSTEM);
+    preferencesDebug("Timezone saved: %s", timezone);
+    return preferencesAvailable;
 }
 
 bool loadTimezone(char* timezone) {
@@ -449,40 +822,26 @@ bool loadTimezone(char* timezone) {
         ESP_LOGE(TAG, "Invalid buffer provided for timezone loading");
         return false;
     }
-    
-    if (!preferences.begin(SYSTEM_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open system preferences - using default timezone");
-        strncpy(timezone, DEFAULT_TIMEZONE, 63);
-        timezone[63] = '\0';
-        return false;
-    }
-    
-    String storedTimezone = preferences.getString(TIMEZONE_KEY, DEFAULT_TIMEZONE);
-    preferences.end();
-    
-    strncpy(timezone, storedTimezone.c_str(), 63);
-    timezone[63] = '\0';
-    
-    ESP_LOGD(TAG, "Timezone loaded from systemPrefs: %s", timezone);
+
+    readString(settings.timezone, timezone, TIMEZONE_MAX_LEN);
+
+    ESP_LOGD(TAG, "Timezone loaded: %s", timezone);
     return true;
 }
 
 void clearSystemPreferences() {
-    if (!preferences.begin(SYSTEM_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open system preferences for clearing");
-        return;
-    }
-    
-    preferences.remove(STARTUP_MODE_KEY);
-    preferences.remove(LAST_GOOD_STATE_KEY);
-    preferences.remove(TIMEZONE_KEY);
-    preferences.end();
-    
-    preferencesDebug("System preferences cleared from systemPrefs namespace");
+    portENTER_CRITICAL(&settingsLock);
+    settings.startupMode = DEFAULT_STARTUP_MODE;
+    settings.lastGoodState = DEFAULT_STARTUP_MODE;
+    strlcpy(settings.timezone, DEFAULT_TIMEZONE, sizeof(settings.timezone));
+    markDirtyLocked(DIRTY_SYSTEM);
+    portEXIT_CRITICAL(&settingsLock);
+
+    preferencesDebug("System preferences reset to defaults");
 }
 
 // =============================================================================
-// User Preferences - User customizable settings (Example Implementation)
+// User Preferences - User customizable settings
 // =============================================================================
 
 void saveUserTheme(const char* theme) {
@@ -490,24 +849,14 @@ void saveUserTheme(const char* theme) {
         ESP_LOGW(TAG, "Invalid theme provided - not saving");
         return;
     }
-    
-    if (strlen(theme) >= 16) {  // Reasonable theme name length limit
-        ESP_LOGW(TAG, "Theme name too long (%d chars, max 15) - not saving", strlen(theme));
-        return;
-    }
-    
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for writing theme");
+
+    if (strlen(theme) >= THEME_MAX_LEN) {
+        ESP_LOGW(TAG, "Theme name too long (%d chars, max %d) - not saving", strlen(theme), THEME_MAX_LEN - 1);
         return;
     }
-    
-    if (preferences.putString(USER_THEME_KEY, theme) == 0) {
-        ESP_LOGE(TAG, "Failed to save theme to user preferences");
-    } else {
-        preferencesDebug("User theme saved to userPrefs: %s", theme);
-    }
-    
-    preferences.end();
+
+    writeString(settings.theme, sizeof(settings.theme), theme, DIRTY_USER);
+    preferencesDebug("User theme saved: %s", theme);
 }
 
 bool loadUserTheme(char* theme) {
@@ -515,49 +864,25 @@ bool loadUserTheme(char* theme) {
         ESP_LOGE(TAG, "Invalid buffer provided for theme loading");
         return false;
     }
-    
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open user preferences - using default theme");
-        strncpy(theme, DEFAULT_THEME, 15);
-        theme[15] = '\0';
-        return false;
-    }
-    
-    String storedTheme = preferences.getString(USER_THEME_KEY, DEFAULT_THEME);
-    preferences.end();
-    
-    strncpy(theme, storedTheme.c_str(), 15);
-    theme[15] = '\0';
-    
-    ESP_LOGD(TAG, "User theme loaded from userPrefs: %s", theme);
+
+    readString(settings.theme, theme, THEME_MAX_LEN);
+
+    ESP_LOGD(TAG, "User theme loaded: %s", theme);
     return true;
 }
 
 void clearUserPreferences() {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for clearing");
-        return;
-    }
-    
-    preferences.remove(USER_THEME_KEY);
-    preferences.remove(USER_AUDIO_ENABLED_KEY);
-    preferences.remove(USER_HAPTIC_ENABLED_KEY);
-    preferences.remove(USER_GLITCH_ENABLED_KEY);
-    preferences.remove(USER_SCANLINES_ENABLED_KEY);
-    preferences.remove(USER_DITHERING_ENABLED_KEY);
-    preferences.remove(USER_CHROMATIC_ENABLED_KEY);
-    preferences.remove(USER_DOT_MATRIX_ENABLED_KEY);
-    preferences.remove(USER_PIXELATE_ENABLED_KEY);
-    preferences.remove(USER_TINT_ENABLED_KEY);
-    preferences.remove(USER_TINT_COLOR_KEY);
-    preferences.remove(USER_TINT_INTENSITY_KEY);
-    preferences.end();
-    
-    // Clear cached values so they get reloaded from defaults
-    audioPreferenceCached = false;
-    hapticPreferenceCached = false;
-    
-    preferencesDebug("User preferences cleared from userPrefs namespace");
+    portENTER_CRITICAL(&settingsLock);
+    // WiFi mode is a system setting that happens to share the flags word
+    settings.flags = (settings.flags & FLAG_WIFI_MODE) | DEFAULT_FLAGS;
+    settings.tintColor = DEFAULT_TINT_COLOR;
+    settings.tintIntensity = DEFAULT_TINT_INTENSITY;
+    strlcpy(settings.theme, DEFAULT_THEME, sizeof(settings.theme));
+    settings.effectPresetLength = 0;
+    markDirtyLocked(DIRTY_USER | DIRTY_EFFECTS);
+    portEXIT_CRITICAL(&settingsLock);
+
+    preferencesDebug("User preferences reset to defaults");
 }
 
 // =============================================================================
@@ -567,8 +892,7 @@ void clearUserPreferences() {
 /**
  * @brief Gets the current audio enabled state
  * @return true if audio is enabled, false otherwise
- * 
- * Retrieves the audio enabled state from NVS storage with caching for performance.
+ *
  * Checks hardware support and returns false if audio hardware is not available.
  */
 bool getAudioEnabled() {
@@ -576,56 +900,19 @@ bool getAudioEnabled() {
     if (!checkHardwareSupport()) {
         return false;
     }
-    
-    // Return cached value if available
-    if (audioPreferenceCached) {
-        return cachedAudioEnabled;
-    }
-    
-    // Load from preferences and cache the result
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open user preferences - using default audio setting");
-        cachedAudioEnabled = DEFAULT_AUDIO_ENABLED;
-        audioPreferenceCached = true;
-        return cachedAudioEnabled;
-    }
-    
-    cachedAudioEnabled = preferences.getBool(USER_AUDIO_ENABLED_KEY, DEFAULT_AUDIO_ENABLED);
-    preferences.end();
-    audioPreferenceCached = true;
-    
-    preferencesDebug("Audio enabled loaded from userPrefs: %s", cachedAudioEnabled ? "true" : "false");
-    return cachedAudioEnabled;
+
+    return getFlag(FLAG_AUDIO);
 }
 
 /**
  * @brief Sets the audio enabled state
  * @param enabled true to enable audio, false to disable
  * @return true if state saved successfully, false otherwise
- * 
- * Saves the audio enabled state to NVS storage and updates the cache.
- * Checks hardware support and prevents enabling if audio hardware is not available.
  */
 bool setAudioEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for writing audio enabled");
-        return false;
-    }
-    
-    if (preferences.putBool(USER_AUDIO_ENABLED_KEY, enabled) == 0) {
-        ESP_LOGE(TAG, "Failed to save audio enabled to user preferences");
-        preferences.end();
-        return false;
-    }
-    
-    preferences.end();
-    
-    // Update cache with new value
-    cachedAudioEnabled = enabled;
-    audioPreferenceCached = true;
-    
-    preferencesDebug("Audio enabled saved to userPrefs: %s", enabled ? "true" : "false");
-    return true;
+    bool success = setFlag(FLAG_AUDIO, enabled, DIRTY_USER);
+    preferencesDebug("Audio enabled saved: %s", enabled ? "true" : "false");
+    return success;
 }
 
 // =============================================================================
@@ -635,8 +922,7 @@ bool setAudioEnabled(bool enabled) {
 /**
  * @brief Gets the current haptic feedback enabled state
  * @return true if haptic feedback is enabled, false otherwise
- * 
- * Retrieves the haptic feedback enabled state from NVS storage with caching for performance.
+ *
  * Checks hardware support and returns false if haptic hardware is not available.
  */
 bool getHapticEnabled() {
@@ -644,56 +930,19 @@ bool getHapticEnabled() {
     if (!checkHardwareSupport()) {
         return false;
     }
-    
-    // Return cached value if available
-    if (hapticPreferenceCached) {
-        return cachedHapticEnabled;
-    }
-    
-    // Load from preferences and cache the result
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open user preferences - using default haptic setting");
-        cachedHapticEnabled = DEFAULT_HAPTIC_ENABLED;
-        hapticPreferenceCached = true;
-        return cachedHapticEnabled;
-    }
-    
-    cachedHapticEnabled = preferences.getBool(USER_HAPTIC_ENABLED_KEY, DEFAULT_HAPTIC_ENABLED);
-    preferences.end();
-    hapticPreferenceCached = true;
-    
-    preferencesDebug("Haptic enabled loaded from userPrefs: %s", cachedHapticEnabled ? "true" : "false");
-    return cachedHapticEnabled;
+
+    return getFlag(FLAG_HAPTIC);
 }
 
 /**
  * @brief Sets the haptic feedback enabled state
  * @param enabled true to enable haptic feedback, false to disable
  * @return true if state saved successfully, false otherwise
- * 
- * Saves the haptic feedback enabled state to NVS storage and updates the cache.
- * Checks hardware support and prevents enabling if haptic hardware is not available.
  */
 bool setHapticEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for writing haptic enabled");
-        return false;
-    }
-    
-    if (preferences.putBool(USER_HAPTIC_ENABLED_KEY, enabled) == 0) {
-        ESP_LOGE(TAG, "Failed to save haptic enabled to user preferences");
-        preferences.end();
-        return false;
-    }
-    
-    preferences.end();
-    
-    // Update cache with new value
-    cachedHapticEnabled = enabled;
-    hapticPreferenceCached = true;
-    
-    preferencesDebug("Haptic enabled saved to userPrefs: %s", enabled ? "true" : "false");
-    return true;
+    bool success = setFlag(FLAG_HAPTIC, enabled, DIRTY_USER);
+    preferencesDebug("Haptic enabled saved: %s", enabled ? "true" : "false");
+    return success;
 }
 
 // =============================================================================
@@ -701,201 +950,94 @@ bool setHapticEnabled(bool enabled) {
 // =============================================================================
 
 bool getGlitchEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        ESP_LOGW(TAG, "Failed to open user preferences - using default glitch setting");
-        return DEFAULT_GLITCH_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_GLITCH_ENABLED_KEY, DEFAULT_GLITCH_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_GLITCH);
 }
 
 bool setGlitchEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        ESP_LOGE(TAG, "Failed to open user preferences for writing glitch enabled");
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_GLITCH_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    
-    if (success) {
-        preferencesDebug("Glitch effect saved to userPrefs: %s", enabled ? "enabled" : "disabled");
-    }
-    return success;
+    return setFlag(FLAG_GLITCH, enabled, DIRTY_EFFECTS);
 }
 
 bool getScanlinesEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_SCANLINES_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_SCANLINES_ENABLED_KEY, DEFAULT_SCANLINES_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_SCANLINES);
 }
 
 bool setScanlinesEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_SCANLINES_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_SCANLINES, enabled, DIRTY_EFFECTS);
 }
 
 bool getDitheringEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_DITHERING_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_DITHERING_ENABLED_KEY, DEFAULT_DITHERING_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_DITHERING);
 }
 
 bool setDitheringEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_DITHERING_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_DITHERING, enabled, DIRTY_EFFECTS);
 }
 
 bool getChromaticEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_CHROMATIC_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_CHROMATIC_ENABLED_KEY, DEFAULT_CHROMATIC_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_CHROMATIC);
 }
 
 bool setChromaticEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_CHROMATIC_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_CHROMATIC, enabled, DIRTY_EFFECTS);
 }
 
 bool getDotMatrixEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_DOT_MATRIX_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_DOT_MATRIX_ENABLED_KEY, DEFAULT_DOT_MATRIX_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_DOT_MATRIX);
 }
 
 bool setDotMatrixEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_DOT_MATRIX_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_DOT_MATRIX, enabled, DIRTY_EFFECTS);
 }
 
 bool getPixelateEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_PIXELATE_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_PIXELATE_ENABLED_KEY, DEFAULT_PIXELATE_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_PIXELATE);
 }
 
 bool setPixelateEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_PIXELATE_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_PIXELATE, enabled, DIRTY_EFFECTS);
 }
 
 bool getTintEnabled() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_TINT_ENABLED;
-    }
-    
-    bool enabled = preferences.getBool(USER_TINT_ENABLED_KEY, DEFAULT_TINT_ENABLED);
-    preferences.end();
-    return enabled;
+    return getFlag(FLAG_TINT);
 }
 
 bool setTintEnabled(bool enabled) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
-    bool success = preferences.putBool(USER_TINT_ENABLED_KEY, enabled) > 0;
-    preferences.end();
-    return success;
+    return setFlag(FLAG_TINT, enabled, DIRTY_EFFECTS);
 }
 
 /**
  * @brief Gets the current tint color value
  * @return Tint color as 16-bit RGB565 value
- * 
- * Retrieves the tint color from NVS storage. Returns default color if not found.
  */
 uint16_t getTintColor() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_TINT_COLOR;
-    }
-    
-    uint16_t color = preferences.getUShort(USER_TINT_COLOR_KEY, DEFAULT_TINT_COLOR);
-    preferences.end();
-    return color;
+    return settings.tintColor;
 }
 
 /**
  * @brief Sets the tint color value
  * @param color Tint color as 16-bit RGB565 value
  * @return true if color saved successfully, false otherwise
- * 
- * Saves the tint color to NVS storage for visual effect customization.
  */
 bool setTintColor(uint16_t color) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
+    portENTER_CRITICAL(&settingsLock);
+    if (settings.tintColor != color) {
+        settings.tintColor = color;
+        markDirtyLocked(DIRTY_EFFECTS);
     }
-    
-    bool success = preferences.putUShort(USER_TINT_COLOR_KEY, color) > 0;
-    preferences.end();
-    
-    if (success) {
-        preferencesDebug("Tint color saved to userPrefs: 0x%04X", color);
-    }
-    return success;
+    portEXIT_CRITICAL(&settingsLock);
+
+    preferencesDebug("Tint color saved: 0x%04X", color);
+    return preferencesAvailable;
 }
 
 /**
  * @brief Gets the current tint intensity value
  * @return Tint intensity as float (0.0 to 1.0)
- * 
- * Retrieves the tint intensity from NVS storage. Returns default intensity if not found.
  */
 float getTintIntensity() {
-    if (!preferences.begin(USER_NAMESPACE, true)) {
-        return DEFAULT_TINT_INTENSITY;
-    }
-    
-    float intensity = preferences.getFloat(USER_TINT_INTENSITY_KEY, DEFAULT_TINT_INTENSITY);
-    preferences.end();
+    portENTER_CRITICAL(&settingsLock);
+    float intensity = settings.tintIntensity;
+    portEXIT_CRITICAL(&settingsLock);
     return intensity;
 }
 
@@ -903,25 +1045,69 @@ float getTintIntensity() {
  * @brief Sets the tint intensity value
  * @param intensity Tint intensity as float (0.0 to 1.0)
  * @return true if intensity saved successfully, false otherwise
- * 
- * Saves the tint intensity to NVS storage for visual effect customization.
  */
 bool setTintIntensity(float intensity) {
-    if (!preferences.begin(USER_NAMESPACE, false)) {
-        return false;
-    }
-    
     // Clamp intensity to valid range
     if (intensity < 0.0f) intensity = 0.0f;
     if (intensity > 1.0f) intensity = 1.0f;
-    
-    bool success = preferences.putFloat(USER_TINT_INTENSITY_KEY, intensity) > 0;
-    preferences.end();
-    
-    if (success) {
-        preferencesDebug("Tint intensity saved to userPrefs: %.2f", intensity);
+
+    portENTER_CRITICAL(&settingsLock);
+    if (settings.tintIntensity != intensity) {
+        settings.tintIntensity = intensity;
+        markDirtyLocked(DIRTY_EFFECTS);
     }
-    return success;
+    portEXIT_CRITICAL(&settingsLock);
+
+    preferencesDebug("Tint intensity saved: %.2f", intensity);
+    return preferencesAvailable;
+}
+
+/**
+ * @brief Stores the serialized effect chain
+ * @param preset Preset bytes, opaque to this module
+ * @param length Preset length, at most PREFERENCES_EFFECT_PRESET_MAX
+ * @return true if the preset will be persisted
+ */
+bool saveEffectPreset(const void* preset, size_t length) {
+    return writePreset(&settings.effectPresetLength, settings.effectPreset, preset, length, DIRTY_EFFECTS);
+}
+
+/**
+ * @brief Copies the stored effect chain
+ * @param preset Receives the preset bytes
+ * @param size Buffer size
+ * @return Preset length, or 0 if none is stored or it does not fit
+ */
+size_t loadEffectPreset(void* preset, size_t size) {
+    return readPreset(&settings.effectPresetLength, settings.effectPreset, preset, size);
+}
+
+/**
+ * @brief Stores a preset in the bank
+ * @param slot Bank slot (0 to PREFERENCES_PRESET_SLOTS - 1)
+ * @param preset Preset bytes, opaque to this module
+ * @param length Preset length, at most PREFERENCES_EFFECT_PRESET_MAX
+ * @return true if the preset will be persisted
+ */
+bool saveEffectPresetSlot(uint8_t slot, const void* preset, size_t length) {
+    if (slot >= PREFERENCES_PRESET_SLOTS) {
+        return false;
+    }
+    return writePreset(&presetBank.length[slot], presetBank.data[slot], preset, length, DIRTY_PRESETS);
+}
+
+/**
+ * @brief Copies a preset from the bank
+ * @param slot Bank slot (0 to PREFERENCES_PRESET_SLOTS - 1)
+ * @param preset Receives the preset bytes
+ * @param size Buffer size
+ * @return Preset length, or 0 if the slot is empty or does not fit
+ */
+size_t loadEffectPresetSlot(uint8_t slot, void* preset, size_t size) {
+    if (slot >= PREFERENCES_PRESET_SLOTS) {
+        return 0;
+    }
+    return readPreset(&presetBank.length[slot], presetBank.data[slot], preset, size);
 }
 
 // =============================================================================
@@ -929,92 +1115,47 @@ bool setTintIntensity(float intensity) {
 // =============================================================================
 
 bool isPreferencesAvailable() {
-    bool available = preferences.begin(SYSTEM_NAMESPACE, true);
-    if (available) {
-        preferences.end();
-    }
-    return available;
+    return preferencesAvailable;
 }
 
 void printStorageInfo() {
-    preferencesDebug("=== NVS Storage Info by Category ===");
-    
-    // Check WiFi preferences namespace
-    if (preferences.begin(WIFI_NAMESPACE, true)) {
-        String ssid = preferences.getString(WIFI_SSID_KEY, "");
-        String password = preferences.getString(WIFI_PASS_KEY, "");
-        size_t wifiUsed = ssid.length() + password.length();
-        preferencesDebug("WiFi Preferences (wifiPrefs): %d bytes used", wifiUsed);
-        preferences.end();
+    preferencesDebug("=== NVS Storage Info ===");
+
+    Preferences store;
+    if (store.begin(SETTINGS_NAMESPACE, true)) {
+        preferencesDebug("Settings blob (settings): %d bytes, version %d", store.getBytesLength(SETTINGS_BLOB_KEY),
+                         settings.version);
+        preferencesDebug("Preset bank (presets): %d bytes", store.getBytesLength(PRESETS_BLOB_KEY));
+        preferencesDebug("Free NVS entries: %d", store.freeEntries());
+        store.end();
     } else {
-        preferencesDebug("WiFi Preferences (wifiPrefs): Not initialized");
+        preferencesDebug("Settings blob (settings): Not initialized");
     }
-    
-    // Check system preferences namespace
-    if (preferences.begin(SYSTEM_NAMESPACE, true)) {
-        size_t systemUsed = preferences.getBytesLength(STARTUP_MODE_KEY) + 
-            preferences.getBytesLength(LAST_GOOD_STATE_KEY) +
-            preferences.getBytesLength(TIMEZONE_KEY);
-        preferencesDebug("System Preferences (systemPrefs): %d bytes used", systemUsed);
-        preferences.end();
-    } else {
-        preferencesDebug("System Preferences (systemPrefs): Not initialized");
-    }
-    
-    // Check user preferences namespace
-    if (preferences.begin(USER_NAMESPACE, true)) {
-        size_t userUsed = preferences.getBytesLength(USER_THEME_KEY) +
-            preferences.getBytesLength(USER_AUDIO_ENABLED_KEY) +
-            preferences.getBytesLength(USER_HAPTIC_ENABLED_KEY) +
-            preferences.getBytesLength(USER_GLITCH_ENABLED_KEY) +
-            preferences.getBytesLength(USER_SCANLINES_ENABLED_KEY) +
-            preferences.getBytesLength(USER_DITHERING_ENABLED_KEY) +
-            preferences.getBytesLength(USER_CHROMATIC_ENABLED_KEY) +
-            preferences.getBytesLength(USER_DOT_MATRIX_ENABLED_KEY) +
-            preferences.getBytesLength(USER_PIXELATE_ENABLED_KEY) +
-            preferences.getBytesLength(USER_TINT_ENABLED_KEY) +
-            preferences.getBytesLength(USER_TINT_COLOR_KEY) +
-            preferences.getBytesLength(USER_TINT_INTENSITY_KEY);
-        preferencesDebug("User Preferences (userPrefs): %d bytes used", userUsed);
-        preferences.end();
-    } else {
-        preferencesDebug("User Preferences (userPrefs): Not initialized");
-    }
-    
+
+    preferencesDebug("Uncommitted changes: 0x%02X", dirtyMask);
+
     // Get free heap as a proxy for available memory
     preferencesDebug("Free heap: %d bytes", ESP.getFreeHeap());
     preferencesDebug("=====================================");
 }
 
 void clearAllPreferences() {
-    preferencesDebug("Clearing all preference categories...");
-    
-    // Clear WiFi preferences
-    if (preferences.begin(WIFI_NAMESPACE, false)) {
-        preferences.clear();
-        preferences.end();
-        preferencesDebug("WiFi preferences cleared");
-    }
-    
-    // Clear system preferences  
-    if (preferences.begin(SYSTEM_NAMESPACE, false)) {
-        preferences.clear();
-        preferences.end();
-        preferencesDebug("System preferences cleared");
-    }
-    
-    // Clear user preferences
-    if (preferences.begin(USER_NAMESPACE, false)) {
-        preferences.clear();
-        preferences.end();
-        preferencesDebug("User preferences cleared");
+    preferencesDebug("Clearing all preferences...");
+
+    portENTER_CRITICAL(&settingsLock);
+    applyDefaults(&settings);
+    memset(&presetBank, 0, sizeof(presetBank));
+    dirtyMask = 0;
+    portEXIT_CRITICAL(&settingsLock);
+
+    Preferences store;
+    if (store.begin(SETTINGS_NAMESPACE, false)) {
+        store.clear();
+        store.end();
     }
-    
-    // Clear cached values so they get reloaded from defaults
-    audioPreferenceCached = false;
-    hapticPreferenceCached = false;
-    
-    preferencesDebug("All preference categories cleared");
+    clearLegacyPreferences();
+
+    preferencesDebug("All preferences cleared");
 }
 
 // =============================================================================
@@ -1024,4 +1165,4 @@ void clearAllPreferences() {
 bool getClockEnabled() {
     // SERIES_2 flag overrides user preferences
     return checkHardwareSupport();
-}
\ No newline at end of file
+}
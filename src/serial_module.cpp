@@ -5,7 +5,11 @@
  */
 
 #include "serial_module.h"
+#include "asset_module.h"
 #include "common.h"
+#include "delta_module.h"
+#include "effects_core.h"
+#include "gzip_module.h"
 #include "flash_module.h"
 #include "ota_module.h"
 #include "preferences_module.h"
@@ -13,19 +17,59 @@
 #include "wifi_endpoints.h"
 #include "wifi_module.h"
 #include <esp_ota_ops.h>
+#include <esp_rom_crc.h>
 
 //==============================================================================
 // GLOBAL VARIABLES
 //==============================================================================
 
 static SerialUpdateState currentSerialState = SerialUpdateState::IDLE;
-static String commandBuffer = "";
+static char commandBuffer[SERIAL_COMMAND_BUFFER_SIZE + 1];
+static size_t commandLength = 0;
+static bool commandOverflow = false;
 static UpdateProgress updateProgress = {0, 0, 0, ""};
 static bool verboseLogging = false;
 static size_t expectedFirmwareSize = 0;
 static int currentUpdateCommand = U_FLASH;
+static bool deltaUpdateActive = false;
+static bool compressedUpdate = false;
+static bool assetTransferActive = false;
 static size_t total_written = 0;
 
+//==============================================================================
+// BINARY LINK STATE
+//==============================================================================
+
+typedef struct {
+  uint8_t type;
+  uint16_t seq;
+  uint16_t length;
+  uint8_t payload[SERIAL_FRAME_MAX_PAYLOAD];
+} serial_frame_t;
+
+enum class FrameParseState { SYNC, HEADER, PAYLOAD, CRC };
+
+typedef struct {
+  bool active;
+  FrameParseState parseState;
+  uint8_t header[SERIAL_FRAME_HEADER_SIZE];
+  uint8_t crc[SERIAL_FRAME_CRC_SIZE];
+  size_t filled;
+  serial_frame_t *frame;       // Pool buffer currently being received
+  uint16_t expectedSeq;
+  bool nakSent;                // One NAK per gap until the host goes back
+  int lastProgressPercent;
+  unsigned long lastActivity;
+} binary_link_t;
+
+static binary_link_t binaryLink = {};
+static serial_frame_t *framePool = NULL;
+static QueueHandle_t freeFrameQueue = NULL;
+static QueueHandle_t writeFrameQueue = NULL;
+static volatile TaskHandle_t flashWriterTask = NULL;
+static volatile size_t flashedBytes = 0;
+static volatile bool flashWriteFailed = false;
+
 //==============================================================================
 // CONSTANTS & DEFINITIONS
 //==============================================================================
@@ -56,18 +100,19 @@ static const uint8_t base64_decode_table[256] = {
 
 /**
  * @brief Decode base64 encoded string with validation
- * @param input Base64 encoded string
+ * @param input Base64 encoded characters
+ * @param inputLen Number of input characters
  * @param output Buffer to store decoded data
  * @param maxOutputSize Maximum size of output buffer
  * @return Number of bytes decoded, or 0 on error
  */
-static size_t simpleBase64Decode(const String &input, uint8_t *output,
-                                 size_t maxOutputSize) {
-  if (input.length() % 4 != 0) {
+static size_t simpleBase64Decode(const char *input, size_t inputLen,
+                                 uint8_t *output, size_t maxOutputSize) {
+  if (inputLen % 4 != 0) {
     return 0;
   }
 
-  for (size_t i = 0; i < input.length(); i++) {
+  for (size_t i = 0; i < inputLen; i++) {
     char c = input[i];
     if (!((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
           (c >= '0' && c <= '9') || c == '+' || c == '/' || c == '=')) {
@@ -76,7 +121,6 @@ static size_t simpleBase64Decode(const String &input, uint8_t *output,
   }
 
   size_t outputLen = 0;
-  size_t inputLen = input.length();
 
   for (size_t i = 0; i < inputLen && outputLen < maxOutputSize - 3; i += 4) {
     uint8_t a = base64_decode_table[(uint8_t)input[i]];
@@ -126,111 +170,270 @@ static const char *getSerialStateString() {
 }
 
 /**
- * @brief Parse incoming serial command
- * @param line Raw command line
- * @return Parsed SerialCommand structure
+ * @brief Strip leading and trailing whitespace in place
+ * @param text Mutable null-terminated string
+ * @return Pointer to the first non-whitespace character
+ */
+static char *trimInPlace(char *text) {
+  while (isspace((unsigned char)*text)) {
+    text++;
+  }
+  char *end = text + strlen(text);
+  while (end > text && isspace((unsigned char)end[-1])) {
+    *--end = '\0';
+  }
+  return text;
+}
+
+/**
+ * @brief Copy a span of text into a fixed buffer, trimming whitespace
+ * @param dest Destination buffer
+ * @param destSize Size of the destination buffer
+ * @param src Start of the span
+ * @param length Length of the span
+ * @return Length of the trimmed copy
  */
-static SerialCommand parseCommand(const String &line) {
+static size_t copyTrimmed(char *dest, size_t destSize, const char *src, size_t length) {
+  while (length > 0 && isspace((unsigned char)*src)) {
+    src++;
+    length--;
+  }
+  while (length > 0 && isspace((unsigned char)src[length - 1])) {
+    length--;
+  }
+  length = min(length, destSize - 1);
+  memcpy(dest, src, length);
+  dest[length] = '\0';
+  return length;
+}
+
+/**
+ * @brief Split a command line in place into command and data
+ * @param line Mutable command line (modified in place)
+ * @return SerialCommand pointing into the line
+ */
+static SerialCommand parseCommand(char *line) {
   SerialCommand cmd;
-  int colonPos = line.indexOf(':');
+  char *colon = strchr(line, ':');
 
-  if (colonPos != -1) {
-    cmd.command = line.substring(0, colonPos);
-    cmd.data = line.substring(colonPos + 1);
-    cmd.command.trim();
-    cmd.data.trim();
+  if (colon) {
+    *colon = '\0';
+    cmd.data = trimInPlace(colon + 1);
   } else {
-    cmd.command = line;
-    cmd.command.trim();
+    cmd.data = "";
   }
+  cmd.command = trimInPlace(line);
+  cmd.dataLength = strlen(cmd.data);
 
   return cmd;
 }
 
 /**
- * @brief Send JSON response over serial
- * @param jsonResponse Pre-formatted JSON response string
+ * @brief Send a pre-formatted JSON response over serial
+ * @param jsonResponse JSON string produced by another module
  * @param isError Whether this is an error response
  */
 static void sendSerialResponse(const String &jsonResponse,
                                bool isError = false) {
-  Serial.println((isError ? RESP_ERROR : RESP_OK) + jsonResponse);
+  Serial.print(isError ? RESP_ERROR : RESP_OK);
+  Serial.println(jsonResponse);
 }
 
 /**
- * @brief Forward declaration of createSerialJsonResponse
+ * @file serial_module.cpp - Part 2: JSON Response Functions
+ * @brief Streaming JSON writer and response functions for each command type
+ *
+ * Responses are written field by field through a small stack buffer that is
+ * flushed straight into the serial TX buffer, so no response allocates heap.
  */
-static String createSerialJsonResponse(bool success, const String &message,
-                                       bool completed = false,
-                                       int progress = 0);
+
+//==============================================================================
+// JSON WRITER (STATIC)
+//==============================================================================
+
+typedef struct {
+  char buffer[SERIAL_JSON_BUFFER_SIZE];
+  size_t length;
+  bool firstField;
+} json_writer_t;
 
 /**
- * @brief Send progress update over serial
- * @param percentage Progress percentage
- * @param message Status message
+ * @brief Push buffered JSON bytes into the serial TX buffer
+ */
+static void jsonFlush(json_writer_t *writer) {
+  if (writer->length > 0) {
+    Serial.write((const uint8_t *)writer->buffer, writer->length);
+    writer->length = 0;
+  }
+}
+
+static void jsonPutChar(json_writer_t *writer, char c) {
+  if (writer->length == sizeof(writer->buffer)) {
+    jsonFlush(writer);
+  }
+  writer->buffer[writer->length++] = c;
+}
+
+static void jsonPutRaw(json_writer_t *writer, const char *text) {
+  while (*text) {
+    jsonPutChar(writer, *text++);
+  }
+}
+
+/**
+ * @brief Append text with JSON string escaping
  */
-static void sendProgressUpdate(int percentage, const String &message) {
-  String jsonResponse = createSerialJsonResponse(
-      (currentSerialState != SerialUpdateState::ERROR), message,
-      (currentSerialState == SerialUpdateState::SUCCESS), percentage);
-  Serial.println(RESP_PROGRESS + jsonResponse);
+static void jsonPutEscaped(json_writer_t *writer, const char *text) {
+  for (; *text; text++) {
+    char c = *text;
+    switch (c) {
+    case '"':
+      jsonPutRaw(writer, "\\\"");
+      break;
+    case '\\':
+      jsonPutRaw(writer, "\\\\");
+      break;
+    case '\n':
+      jsonPutRaw(writer, "\\n");
+      break;
+    case '\r':
+      jsonPutRaw(writer, "\\r");
+      break;
+    case '\t':
+      jsonPutRaw(writer, "\\t");
+      break;
+    default:
+      if ((unsigned char)c < 0x20) {
+        char escaped[8];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+        jsonPutRaw(writer, escaped);
+      } else {
+        jsonPutChar(writer, c);
+      }
+      break;
+    }
+  }
 }
 
 /**
- * @file serial_module.cpp - Part 2: JSON Response Functions
- * @brief JSON response creation functions for different command types
+ * @brief Start a response line with a protocol prefix and open the object
+ * @param writer Writer to initialize
+ * @param prefix Line prefix (RESP_OK, RESP_ERROR, RESP_PROGRESS, ...)
  */
+static void jsonBegin(json_writer_t *writer, const char *prefix) {
+  writer->length = 0;
+  writer->firstField = true;
+  jsonPutRaw(writer, prefix);
+  jsonPutChar(writer, '{');
+}
+
+static void jsonKey(json_writer_t *writer, const char *key) {
+  if (!writer->firstField) {
+    jsonPutChar(writer, ',');
+  }
+  writer->firstField = false;
+  jsonPutChar(writer, '"');
+  jsonPutRaw(writer, key);
+  jsonPutRaw(writer, "\":");
+}
+
+static void jsonString(json_writer_t *writer, const char *key, const char *value) {
+  jsonKey(writer, key);
+  jsonPutChar(writer, '"');
+  jsonPutEscaped(writer, value);
+  jsonPutChar(writer, '"');
+}
+
+static void jsonBool(json_writer_t *writer, const char *key, bool value) {
+  jsonKey(writer, key);
+  jsonPutRaw(writer, value ? "true" : "false");
+}
+
+static void jsonInt(json_writer_t *writer, const char *key, long value) {
+  char number[12];
+  snprintf(number, sizeof(number), "%ld", value);
+  jsonKey(writer, key);
+  jsonPutRaw(writer, number);
+}
+
+static void jsonUInt(json_writer_t *writer, const char *key, unsigned long value) {
+  char number[12];
+  snprintf(number, sizeof(number), "%lu", value);
+  jsonKey(writer, key);
+  jsonPutRaw(writer, number);
+}
+
+/**
+ * @brief Open a string field whose value is streamed with jsonPutEscaped
+ */
+static void jsonStringBegin(json_writer_t *writer, const char *key) {
+  jsonKey(writer, key);
+  jsonPutChar(writer, '"');
+}
+
+static void jsonStringEnd(json_writer_t *writer) { jsonPutChar(writer, '"'); }
+
+/**
+ * @brief Close the object, terminate the line and flush
+ */
+static void jsonEnd(json_writer_t *writer) {
+  jsonPutRaw(writer, "}\r\n");
+  jsonFlush(writer);
+}
 
 //==============================================================================
 // JSON RESPONSE FUNCTIONS (STATIC)
 //==============================================================================
 
 /**
- * @brief Create a JSON response with current update status
+ * @brief Write a JSON line with current update status
+ * @param prefix Line prefix
  * @param success Whether the operation was successful
  * @param message Status message
  * @param completed Whether the update process has completed
  * @param progress Current progress percentage
- * @return JSON string with status information
- */
-static String createSerialJsonResponse(bool success, const String &message,
-                                       bool completed, int progress) {
-  // Pre-calculate approximate size
-  const char *stateStr = getSerialStateString();
-  size_t estimatedSize =
-      150 + message.length() + strlen(stateStr) + strlen(FIRMWARE_VERSION);
-
-  String response;
-  response.reserve(estimatedSize);
-
-  response += "{\"success\":";
-  response += success ? "true" : "false";
-  response += ",\"state\":\"";
-  response += stateStr;
-  response += "\",\"progress\":";
-  response += progress;
-  response += ",\"received\":";
-  response += updateProgress.receivedSize;
-  response += ",\"total\":";
-  response += updateProgress.totalSize;
-  response += ",\"version\":\"";
-  response += FIRMWARE_VERSION;
-  response += "\",\"message\":\"";
-  response += message;
-  response += "\",\"completed\":";
-  response += completed ? "true" : "false";
-  response += "}";
-
-  return response;
-}
-
-/**
- * @brief Create a JSON response with device information
- */
-static String createDeviceInfoResponse(bool success, const String &message) {
-  size_t flashSize = ESP.getFlashChipSize();
-  size_t sketchSize = ESP.getSketchSize();
-  size_t freeHeap = ESP.getFreeHeap();
+ */
+static void writeStatusJson(const char *prefix, bool success, const char *message,
+                            bool completed, int progress) {
+  json_writer_t writer;
+  jsonBegin(&writer, prefix);
+  jsonBool(&writer, "success", success);
+  jsonString(&writer, "state", getSerialStateString());
+  jsonInt(&writer, "progress", progress);
+  jsonUInt(&writer, "received", updateProgress.receivedSize);
+  jsonUInt(&writer, "total", updateProgress.totalSize);
+  jsonString(&writer, "version", FIRMWARE_VERSION);
+  jsonString(&writer, "message", message);
+  jsonBool(&writer, "completed", completed);
+  jsonEnd(&writer);
+}
+
+/**
+ * @brief Send a status response, prefixed OK: or ERROR: by outcome
+ * @param success Whether the operation was successful
+ * @param message Status message
+ * @param completed Whether the update process has completed
+ * @param progress Current progress percentage
+ */
+static void sendStatusResponse(bool success, const char *message,
+                               bool completed = false, int progress = 0) {
+  writeStatusJson(success ? RESP_OK : RESP_ERROR, success, message, completed, progress);
+}
+
+/**
+ * @brief Send progress update over serial
+ * @param percentage Progress percentage
+ * @param message Status message
+ */
+static void sendProgressUpdate(int percentage, const char *message) {
+  writeStatusJson(RESP_PROGRESS, (currentSerialState != SerialUpdateState::ERROR), message,
+                  (currentSerialState == SerialUpdateState::SUCCESS), percentage);
+}
+
+/**
+ * @brief Send a JSON response with device information
+ */
+static void sendDeviceInfoResponse(bool success, const char *message) {
   StorageInfo fsInfo = getDetailedFlashStats();
 
   // Get partition info
@@ -238,145 +441,81 @@ static String createDeviceInfoResponse(bool success, const String &message) {
   const esp_partition_t *update_partition =
       esp_ota_get_next_update_partition(NULL);
 
-  // Pre-format variable strings
-  String flashSizeStr = formatBytes(flashSize);
-  String freeHeapStr = formatBytes(freeHeap);
-  String freeSpaceStr = String(fsInfo.freeSpaceMB, 2) + "MB";
-  String chipModelStr = ESP.getChipModel();
-  String chipRevisionStr = String(ESP.getChipRevision());
-  String currentModeStr = getCurrentState() == SystemState::UPDATE_MODE
-                              ? "Update Mode"
-                              : "Standby Mode";
-
-  // Calculate estimated size
-  size_t estimatedSize = 300 + message.length() + strlen(FIRMWARE_VERSION) +
-                         flashSizeStr.length() + freeHeapStr.length() +
-                         freeSpaceStr.length() + chipModelStr.length() +
-                         chipRevisionStr.length() + currentModeStr.length();
-
-  if (running)
-    estimatedSize += strlen(running->label) + 30;
-  if (update_partition)
-    estimatedSize += strlen(update_partition->label) + 60;
-
-  String response;
-  response.reserve(estimatedSize);
-
-  response += "{\"success\":";
-  response += success ? "true" : "false";
-  response += ",\"message\":\"";
-  response += message;
-  response += "\",\"firmware_version\":\"";
-  response += FIRMWARE_VERSION;
-  response += "\",\"mcu\":\"";
-  response += chipModelStr;
-  response += "\",\"chip_revision\":\"";
-  response += chipRevisionStr;
-  response += "\",\"flash_size\":\"";
-  response += flashSizeStr;
-  response += "\",\"flash_available\":\"";
-  response += freeSpaceStr;
-  response += "\",\"free_heap\":\"";
-  response += freeHeapStr;
-  response += "\",\"current_mode\":\"";
-  response += currentModeStr;
-  response += "\"";
+  char value[24];
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", success);
+  jsonString(&writer, "message", message);
+  jsonString(&writer, "firmware_version", FIRMWARE_VERSION);
+  jsonString(&writer, "mcu", ESP.getChipModel());
+  snprintf(value, sizeof(value), "%u", (unsigned)ESP.getChipRevision());
+  jsonString(&writer, "chip_revision", value);
+  jsonString(&writer, "flash_size", formatBytes(ESP.getFlashChipSize(), value, sizeof(value)));
+  snprintf(value, sizeof(value), "%.2fMB", fsInfo.freeSpaceMB);
+  jsonString(&writer, "flash_available", value);
+  jsonString(&writer, "free_heap", formatBytes(ESP.getFreeHeap(), value, sizeof(value)));
+  jsonString(&writer, "current_mode",
+             getCurrentState() == SystemState::UPDATE_MODE ? "Update Mode" : "Standby Mode");
 
   if (running) {
-    response += ",\"running_partition\":\"";
-    response += running->label;
-    response += "\"";
+    jsonString(&writer, "running_partition", running->label);
   }
 
   if (update_partition) {
-    response += ",\"update_partition\":\"";
-    response += update_partition->label;
-    response += "\",\"update_partition_size\":\"";
-    response += formatBytes(update_partition->size);
-    response += "\"";
+    jsonString(&writer, "update_partition", update_partition->label);
+    jsonString(&writer, "update_partition_size",
+               formatBytes(update_partition->size, value, sizeof(value)));
   }
 
-  response += "}";
-  return response;
+  jsonEnd(&writer);
 }
 
 /**
- * @brief Create a JSON response with status information
+ * @brief Send a JSON response with status information
  */
-static String createStatusResponse(bool success, const String &message) {
-  // Pre-format variable strings
-  const char *serialStateStr = getSerialStateString();
-  String systemModeStr = getCurrentState() == SystemState::UPDATE_MODE
-                             ? "Update Mode"
-                             : "Standby Mode";
-
-  // Calculate estimated size
-  size_t estimatedSize =
-      200 + message.length() + strlen(serialStateStr) + systemModeStr.length();
-
-  String response;
-  response.reserve(estimatedSize);
-
-  response += "{\"success\":";
-  response += success ? "true" : "false";
-  response += ",\"message\":\"";
-  response += message;
-  response += "\",\"state\":\"";
-  response += serialStateStr;
-  response += "\",\"system_mode\":\"";
-  response += systemModeStr;
-  response += "\",\"wifi_connected\":";
-  response += isWifiNetworkConnected() ? "true" : "false";
-  response += "\",\"update_active\":";
-  response +=
-      (currentSerialState != SerialUpdateState::IDLE) ? "true" : "false";
-  response += ",\"progress\":";
-  response += updateProgress.percentage;
-  response += ",\"received\":";
-  response += updateProgress.receivedSize;
-  response += ",\"total\":";
-  response += updateProgress.totalSize;
-  response += "}";
-
-  return response;
+static void sendDeviceStatusResponse(bool success, const char *message) {
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", success);
+  jsonString(&writer, "message", message);
+  jsonString(&writer, "state", getSerialStateString());
+  jsonString(&writer, "system_mode",
+             getCurrentState() == SystemState::UPDATE_MODE ? "Update Mode" : "Standby Mode");
+  jsonBool(&writer, "wifi_connected", isWifiNetworkConnected());
+  jsonBool(&writer, "update_active", currentSerialState != SerialUpdateState::IDLE);
+  jsonInt(&writer, "progress", updateProgress.percentage);
+  jsonUInt(&writer, "received", updateProgress.receivedSize);
+  jsonUInt(&writer, "total", updateProgress.totalSize);
+  jsonEnd(&writer);
 }
 
 /**
- * @brief Create a JSON response for WiFi saved credentials
+ * @brief Send a JSON response for WiFi saved credentials
  */
-static String createWiFiCredentialsResponse(bool success, const String &message,
-                                            const String &ssid = "",
-                                            bool hasCredentials = false) {
-  // Calculate estimated size
-  size_t estimatedSize = 120 + message.length() + ssid.length();
-
-  String response;
-  response.reserve(estimatedSize);
-
-  response += "{\"success\":";
-  response += success ? "true" : "false";
-  response += ",\"message\":\"";
-  response += message;
-  response += "\",\"ssid\":\"";
-  response += ssid;
-  response += "\",\"has_credentials\":";
-  response += hasCredentials ? "true" : "false";
-  response += "\"}";
-
-  return response;
+static void sendWiFiCredentialsResponse(bool success, const char *message,
+                                        const char *ssid = "",
+                                        bool hasCredentials = false) {
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", success);
+  jsonString(&writer, "message", message);
+  jsonString(&writer, "ssid", ssid);
+  jsonBool(&writer, "has_credentials", hasCredentials);
+  jsonEnd(&writer);
 }
 
 /**
- * @brief Create a serial-friendly string containing all preferences for JSON
- * responses
- * @return String containing all preference values formatted for serial output
+ * @brief Stream all preferences as one escaped multi-line string value
+ * @param writer Writer positioned inside an open string field
  */
-static String createPreferencesString(void) {
-  String result = "=== USER PREFERENCES ===\n";
+static void writePreferencesString(json_writer_t *writer) {
+  char value[32];
+
+  jsonPutEscaped(writer, "=== USER PREFERENCES ===\n");
 
   // Audio preferences using preferences module
-  result +=
-      "Audio: enabled=" + String(getAudioEnabled() ? "true" : "false") + "\n";
+  jsonPutEscaped(writer, "Audio: enabled=");
+  jsonPutEscaped(writer, getAudioEnabled() ? "true\n" : "false\n");
 
   // System preferences using preferences module and states module
   bool wifiEnabled = (getCurrentState() == SystemState::WIFI_MODE);
@@ -384,30 +523,43 @@ static String createPreferencesString(void) {
   char password[64] = {0};
   bool wifiSaved = loadWiFiCredentials(ssid, password);
 
-  result += "System: wifi=" + String(wifiEnabled ? "true" : "false");
-  result += ", wifiSaved=" + String(wifiSaved ? "true" : "false");
-  result += ", wifiAutoConnect=" + String("true"); // Default to true for now
+  jsonPutEscaped(writer, "System: wifi=");
+  jsonPutEscaped(writer, wifiEnabled ? "true" : "false");
+  jsonPutEscaped(writer, ", wifiSaved=");
+  jsonPutEscaped(writer, wifiSaved ? "true" : "false");
+  jsonPutEscaped(writer, ", wifiAutoConnect=true"); // Default to true for now
+  jsonPutEscaped(writer, ", quickBoot=");
+  jsonPutEscaped(writer, getQuickBootEnabled() ? "true" : "false");
   if (wifiSaved) {
-    result += ", ssid=" + String(ssid) + ", password=***HIDDEN***";
+    jsonPutEscaped(writer, ", ssid=");
+    jsonPutEscaped(writer, ssid);
+    jsonPutEscaped(writer, ", password=***HIDDEN***");
   }
-  result += "\n";
+  jsonPutEscaped(writer, "\n");
 
   // Visual effects preferences using preferences module
-  result += "Effects: glitch=" + String(getGlitchEnabled() ? "true" : "false");
-  result += ", scanlines=" + String(getScanlinesEnabled() ? "true" : "false");
-  result += ", dithering=" + String(getDitheringEnabled() ? "true" : "false");
-  result += ", chromatic=" + String(getChromaticEnabled() ? "true" : "false");
-  result += ", dotMatrix=" + String(getDotMatrixEnabled() ? "true" : "false");
-  result += ", pixelate=" + String(getPixelateEnabled() ? "true" : "false");
-  result += ", tint=" + String(getTintEnabled() ? "true" : "false");
-  result += ", tintColor=0x" + String(getTintColor(), HEX);
-  result += ", tintIntensity=" + String(getTintIntensity(), 2) + "\n";
+  jsonPutEscaped(writer, "Effects: glitch=");
+  jsonPutEscaped(writer, getGlitchEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", scanlines=");
+  jsonPutEscaped(writer, getScanlinesEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", dithering=");
+  jsonPutEscaped(writer, getDitheringEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", chromatic=");
+  jsonPutEscaped(writer, getChromaticEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", dotMatrix=");
+  jsonPutEscaped(writer, getDotMatrixEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", pixelate=");
+  jsonPutEscaped(writer, getPixelateEnabled() ? "true" : "false");
+  jsonPutEscaped(writer, ", tint=");
+  jsonPutEscaped(writer, getTintEnabled() ? "true" : "false");
+  snprintf(value, sizeof(value), ", tintColor=0x%x", (unsigned)getTintColor());
+  jsonPutEscaped(writer, value);
+  snprintf(value, sizeof(value), ", tintIntensity=%.2f\n", getTintIntensity());
+  jsonPutEscaped(writer, value);
 
   // Haptic preferences using preferences module
-  result +=
-      "User: haptic=" + String(getHapticEnabled() ? "true" : "false") + "\n";
-
-  return result;
+  jsonPutEscaped(writer, "User: haptic=");
+  jsonPutEscaped(writer, getHapticEnabled() ? "true\n" : "false\n");
 }
 
 /**
@@ -422,25 +574,19 @@ static String createPreferencesString(void) {
 /**
  * @brief Handle GET_INFO command
  */
-static void handleGetInfo() {
-  String jsonResponse = createDeviceInfoResponse(true, "Device information");
-  sendSerialResponse(jsonResponse);
-}
+static void handleGetInfo() { sendDeviceInfoResponse(true, "Device information"); }
 
 /**
  * @brief Handle GET_STATUS command
  */
-static void handleGetStatus() {
-  String jsonResponse = createStatusResponse(true, "Device status");
-  sendSerialResponse(jsonResponse);
-}
+static void handleGetStatus() { sendDeviceStatusResponse(true, "Device status"); }
 
 /**
  * @brief Handle RESTART command
  */
 static void handleRestart() {
-  String jsonResponse = createSerialJsonResponse(true, "Restarting device...");
-  sendSerialResponse(jsonResponse);
+  sendStatusResponse(true, "Restarting device...");
+  flushPreferences();
   delay(1000);
   ESP.restart();
 }
@@ -449,10 +595,8 @@ static void handleRestart() {
  * @brief Handle GET_LOGS command
  */
 static void handleGetLogs() {
-  String jsonResponse = createSerialJsonResponse(
-      true,
-      "Verbose logging " + String(verboseLogging ? "enabled" : "disabled"));
-  sendSerialResponse(jsonResponse);
+  sendStatusResponse(true, verboseLogging ? "Verbose logging enabled"
+                                          : "Verbose logging disabled");
 }
 
 /**
@@ -460,11 +604,9 @@ static void handleGetLogs() {
  * @param cmd Command with verbose setting data
  */
 static void handleVerbose(const SerialCommand &cmd) {
-  verboseLogging = (cmd.data == "1" || cmd.data.equalsIgnoreCase("true"));
-  String jsonResponse = createSerialJsonResponse(
-      true,
-      "Verbose logging " + String(verboseLogging ? "enabled" : "disabled"));
-  sendSerialResponse(jsonResponse);
+  verboseLogging = (strcmp(cmd.data, "1") == 0 || strcasecmp(cmd.data, "true") == 0);
+  sendStatusResponse(true, verboseLogging ? "Verbose logging enabled"
+                                          : "Verbose logging disabled");
 }
 
 /**
@@ -481,77 +623,65 @@ static void handleVerbose(const SerialCommand &cmd) {
  */
 static void handleWiFiScan() {
   if (isSerialUpdateActive()) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Cannot scan WiFi during firmware update");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Cannot scan WiFi during firmware update");
     return;
   }
 
-  String jsonResponse = scanWiFiNetworks();
-  sendSerialResponse(jsonResponse);
+  sendSerialResponse(scanWiFiNetworks());
 }
 
 /**
  * @brief Handle WIFI_STATUS command
  */
-static void handleWiFiStatus() {
-  String jsonResponse = getWiFiStatusJson();
-  sendSerialResponse(jsonResponse);
-}
+static void handleWiFiStatus() { sendSerialResponse(getWiFiStatusJson()); }
 
-/**
- * @brief Handle WIFI_CONNECT command
- * @param cmd Command with SSID and password data (format: "ssid,password")
- */
 /**
  * @brief Handle WIFI_CONNECT command
  * @param cmd Command with SSID and password data (format: "ssid,password")
  */
 static void handleWiFiConnect(const SerialCommand &cmd) {
   ESP_LOGE(SERIAL_LOG, "=== SERIAL WIFI CONNECT ===");
-  ESP_LOGE(SERIAL_LOG, "Raw command data: '%s'", cmd.data.c_str());
-  
+  ESP_LOGE(SERIAL_LOG, "Raw command data: '%s'", cmd.data);
+
   if (isSerialUpdateActive()) {
-    String jsonResponse = createSerialJsonResponse(false, "Cannot connect to WiFi during firmware update");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Cannot connect to WiFi during firmware update");
     return;
   }
 
-  int commaPos = cmd.data.indexOf(',');
-  if (commaPos == -1) {
+  const char *comma = strchr(cmd.data, ',');
+  if (!comma) {
     ESP_LOGE(SERIAL_LOG, "Invalid command format - no comma found");
-    String jsonResponse = createSerialJsonResponse(false, "Invalid WIFI_CONNECT format. Expected: ssid,password");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Invalid WIFI_CONNECT format. Expected: ssid,password");
     return;
   }
 
-  String ssid = cmd.data.substring(0, commaPos);
-  String password = cmd.data.substring(commaPos + 1);
-  
-  ssid.trim();
-  password.trim();
-  
-  ESP_LOGE(SERIAL_LOG, "Parsed SSID: '%s', Password: '%s' (length: %d)", 
-           ssid.c_str(), password.c_str(), password.length());
+  char ssid[33];
+  char password[65];
+  copyTrimmed(ssid, sizeof(ssid), cmd.data, comma - cmd.data);
+  size_t passwordLength = copyTrimmed(password, sizeof(password), comma + 1, strlen(comma + 1));
 
-  if (ssid.isEmpty()) {
+  ESP_LOGE(SERIAL_LOG, "Parsed SSID: '%s', Password: '%s' (length: %u)",
+           ssid, password, (unsigned)passwordLength);
+
+  if (ssid[0] == '\0') {
     ESP_LOGE(SERIAL_LOG, "SSID is empty after parsing");
-    String jsonResponse = createSerialJsonResponse(false, "SSID cannot be empty");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "SSID cannot be empty");
     return;
   }
 
+  char message[96];
+
   // Check if already connected to this network
-  if (isWifiNetworkConnected() && WiFi.SSID().equals(ssid)) {
+  if (isWifiNetworkConnected() && WiFi.SSID() == ssid) {
     ESP_LOGE(SERIAL_LOG, "Already connected to requested network");
-    
+
     // Save credentials since we're connected to this network
-    if (saveWiFiCredentials(ssid.c_str(), password.c_str())) {
+    if (saveWiFiCredentials(ssid, password)) {
       ESP_LOGE(SERIAL_LOG, "Credentials saved successfully");
     }
-    
-    String jsonResponse = createSerialJsonResponse(true, "Already connected to " + ssid);
-    sendSerialResponse(jsonResponse);
+
+    snprintf(message, sizeof(message), "Already connected to %s", ssid);
+    sendStatusResponse(true, message);
     return;
   }
 
@@ -564,38 +694,37 @@ static void handleWiFiConnect(const SerialCommand &cmd) {
 
   // Start connection attempt
   ESP_LOGE(SERIAL_LOG, "Attempting WiFi connection with provided credentials...");
-  connectToWiFi(ssid.c_str(), password.c_str());
+  connectToWiFi(ssid, password);
 
   // Wait for connection result with timeout
   unsigned long startTime = millis();
   const unsigned long TIMEOUT_MS = 20000; // 20 seconds timeout
   const unsigned long CHECK_INTERVAL = 1000; // Check every second
-  
+
   while (millis() - startTime < TIMEOUT_MS) {
     delay(CHECK_INTERVAL);
-    
+
     if (isWifiNetworkConnected()) {
       ESP_LOGE(SERIAL_LOG, "Connection successful");
-      
+
       // Save credentials on successful connection
-      if (saveWiFiCredentials(ssid.c_str(), password.c_str())) {
+      if (saveWiFiCredentials(ssid, password)) {
         ESP_LOGE(SERIAL_LOG, "Credentials saved successfully");
       } else {
         ESP_LOGW(SERIAL_LOG, "Failed to save credentials, but connection successful");
       }
-      
-      String jsonResponse = createSerialJsonResponse(true, "Successfully connected to " + ssid);
-      sendSerialResponse(jsonResponse);
+
+      snprintf(message, sizeof(message), "Successfully connected to %s", ssid);
+      sendStatusResponse(true, message);
       return;
     }
-    
+
     ESP_LOGE(SERIAL_LOG, "Still waiting for connection... (%lu ms elapsed)", millis() - startTime);
   }
-  
+
   // Timeout reached without successful connection
   ESP_LOGE(SERIAL_LOG, "Connection timeout reached after %lu ms", TIMEOUT_MS);
-  String jsonResponse = createSerialJsonResponse(false, "Connection failed: timeout or incorrect password");
-  sendSerialResponse(jsonResponse, true);
+  sendStatusResponse(false, "Connection failed: timeout or incorrect password");
 }
 
 /**
@@ -603,30 +732,26 @@ static void handleWiFiConnect(const SerialCommand &cmd) {
  */
 static void handleWiFiDisconnect() {
   if (isSerialUpdateActive()) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Cannot disconnect WiFi during firmware update");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Cannot disconnect WiFi during firmware update");
     return;
   }
 
-  String currentSSID = WiFi.SSID();
+  char message[64];
   bool wasConnected = isWifiNetworkConnected();
+  if (wasConnected) {
+    snprintf(message, sizeof(message), "Disconnected from %s", WiFi.SSID().c_str());
+  } else {
+    strlcpy(message, "WiFi was already disconnected", sizeof(message));
+  }
 
   // Disconnect from WiFi
   disconnectFromWiFi();
 
   // Check if disconnection was successful
-  bool isNowDisconnected = !isWifiNetworkConnected();
-
-  if (isNowDisconnected) {
-    String message = wasConnected ? "Disconnected from " + currentSSID
-                                  : "WiFi was already disconnected";
-    String jsonResponse = createSerialJsonResponse(true, message);
-    sendSerialResponse(jsonResponse);
+  if (!isWifiNetworkConnected()) {
+    sendStatusResponse(true, message);
   } else {
-    String jsonResponse =
-        createSerialJsonResponse(false, "Failed to disconnect from WiFi");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Failed to disconnect from WiFi");
   }
 }
 
@@ -639,14 +764,11 @@ static void handleWiFiGetSaved() {
   bool hasCredentials = loadWiFiCredentials(ssid, password);
 
   if (hasCredentials) {
-    String message = "Saved credentials found for network: " + String(ssid);
-    String jsonResponse =
-        createWiFiCredentialsResponse(true, message, String(ssid), true);
-    sendSerialResponse(jsonResponse);
+    char message[80];
+    snprintf(message, sizeof(message), "Saved credentials found for network: %s", ssid);
+    sendWiFiCredentialsResponse(true, message, ssid, true);
   } else {
-    String jsonResponse = createWiFiCredentialsResponse(
-        true, "No saved WiFi credentials found", "", false);
-    sendSerialResponse(jsonResponse);
+    sendWiFiCredentialsResponse(true, "No saved WiFi credentials found", "", false);
   }
 }
 
@@ -655,9 +777,7 @@ static void handleWiFiGetSaved() {
  */
 static void handleWiFiForget() {
   if (isSerialUpdateActive()) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Cannot clear WiFi credentials during firmware update");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Cannot clear WiFi credentials during firmware update");
     return;
   }
 
@@ -668,11 +788,13 @@ static void handleWiFiForget() {
   // Use preferences module to clear WiFi credentials
   clearWiFiCredentials();
 
-  String message = hadCredentials
-                       ? "Cleared saved credentials for " + String(ssid)
-                       : "No credentials were saved";
-  String jsonResponse = createWiFiCredentialsResponse(true, message, "", false);
-  sendSerialResponse(jsonResponse);
+  char message[80];
+  if (hadCredentials) {
+    snprintf(message, sizeof(message), "Cleared saved credentials for %s", ssid);
+  } else {
+    strlcpy(message, "No credentials were saved", sizeof(message));
+  }
+  sendWiFiCredentialsResponse(true, message, "", false);
 }
 
 /**
@@ -684,50 +806,141 @@ static void handleWiFiForget() {
 // FIRMWARE UPDATE COMMAND HANDLERS (STATIC)
 //==============================================================================
 
+/**
+ * @brief Write image data to flash, through the delta applier if active
+ * @param data Data to write
+ * @param length Number of bytes
+ * @return true if all bytes were accepted
+ */
+static bool writeImageData(const uint8_t *data, size_t length) {
+  if (assetTransferActive) {
+    return assetSync_write(data, length);
+  }
+  if (deltaUpdateActive) {
+    return deltaUpdate_write(data, length);
+  }
+  return Update.write((uint8_t *)data, length) == length;
+}
+
+/**
+ * @brief Write received update data, inflating it first if compressed
+ * @param data Data as received
+ * @param length Number of bytes
+ * @return true if all bytes were accepted
+ */
+static bool writeUpdateData(const uint8_t *data, size_t length) {
+  if (compressedUpdate) {
+    return gzipStream_write(data, length);
+  }
+  return writeImageData(data, length);
+}
+
+/**
+ * @brief Finish the decompression, delta and Update stages in order
+ * @return true if the new image is complete and bootable
+ */
+static bool endUpdateData() {
+  if (compressedUpdate && !gzipStream_end()) {
+    return false;
+  }
+  if (assetTransferActive) {
+    return assetSync_end();
+  }
+  return deltaUpdateActive ? deltaUpdate_end() : Update.end(true);
+}
+
+/**
+ * @brief Abort the update in progress, including any delta or gzip session
+ */
+static void abortUpdateData() {
+  if (compressedUpdate) {
+    gzipStream_abort();
+  }
+  if (assetTransferActive) {
+    assetSync_abort();
+  } else if (deltaUpdateActive) {
+    deltaUpdate_abort();
+  } else if (Update.isRunning()) {
+    Update.abort();
+  }
+}
+
+/**
+ * @brief Get the last error of the active update path
+ * @return Error message
+ */
+static const char *updateErrorString() {
+  const char *error = compressedUpdate ? gzipStream_errorString() : NULL;
+  if (error) {
+    return error;
+  }
+  if (assetTransferActive) {
+    return assetSync_errorString();
+  }
+  return deltaUpdateActive ? deltaUpdate_errorString() : Update.errorString();
+}
+
 /**
  * @brief Initialize file upload for serial update
  * @param cmd Command with firmware size and type parameters
  * @return true if initialization was successful
  */
 static bool initializeSerialUpdate(const SerialCommand &cmd) {
-  int commaPos = cmd.data.indexOf(',');
-  if (commaPos == -1) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Invalid START_UPDATE format. Expected: size,type");
-    sendSerialResponse(jsonResponse, true);
+  const char *comma = strchr(cmd.data, ',');
+  if (!comma) {
+    sendStatusResponse(false, "Invalid START_UPDATE format. Expected: size,type[,gzip]");
     return false;
   }
 
-  String sizeStr = cmd.data.substring(0, commaPos);
-  String typeStr = cmd.data.substring(commaPos + 1);
-
-  expectedFirmwareSize = sizeStr.toInt();
+  char typeStr[16];
+  const char *option = strchr(comma + 1, ',');
+  copyTrimmed(typeStr, sizeof(typeStr), comma + 1,
+              option ? (size_t)(option - comma - 1) : strlen(comma + 1));
+  expectedFirmwareSize = strtoul(cmd.data, NULL, 10);
+
+  assetTransferActive = false;
+  compressedUpdate = false;
+  if (option) {
+    if (strcmp(option + 1, "gzip") != 0) {
+      sendStatusResponse(false, "Invalid update option. Expected: gzip");
+      return false;
+    }
+    compressedUpdate = true;
+  }
 
+  size_t minAllowedSize = 1024;
   size_t maxAllowedSize;
-  if (typeStr == "filesystem") {
+  deltaUpdateActive = false;
+  if (strcmp(typeStr, "filesystem") == 0) {
     currentUpdateCommand = U_SPIFFS;
     maxAllowedSize = 3 * 1024 * 1024;
-  } else if (typeStr == "firmware") {
+  } else if (strcmp(typeStr, "firmware") == 0) {
     currentUpdateCommand = U_FLASH;
     maxAllowedSize = 1536 * 1024;
+  } else if (strcmp(typeStr, "delta") == 0) {
+    currentUpdateCommand = U_FLASH;
+    minAllowedSize = sizeof(delta_header_t) + sizeof(delta_op_t);
+    maxAllowedSize = 1536 * 1024;
+    deltaUpdateActive = true;
   } else {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Invalid update type. Expected: firmware or filesystem");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Invalid update type. Expected: firmware, filesystem or delta");
     return false;
   }
 
   if (expectedFirmwareSize == 0) {
-    String jsonResponse = createSerialJsonResponse(false, "Invalid file size");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Invalid file size");
     return false;
   }
 
-  if (expectedFirmwareSize < 1024 || expectedFirmwareSize > maxAllowedSize) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "File size out of range (1KB - " + formatBytes(maxAllowedSize) +
-                   " for " + typeStr + ")");
-    sendSerialResponse(jsonResponse, true);
+  char message[96];
+
+  if (expectedFirmwareSize < minAllowedSize || expectedFirmwareSize > maxAllowedSize) {
+    char minSize[16];
+    char maxSize[16];
+    snprintf(message, sizeof(message), "File size out of range (%s - %s for %s)",
+             formatBytes(minAllowedSize, minSize, sizeof(minSize)),
+             formatBytes(maxAllowedSize, maxSize, sizeof(maxSize)), typeStr);
+    sendStatusResponse(false, message);
     return false;
   }
 
@@ -738,16 +951,22 @@ static bool initializeSerialUpdate(const SerialCommand &cmd) {
           : esp_ota_get_next_update_partition(NULL);
 
   if (!update_partition || update_partition->size < expectedFirmwareSize) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "File too large for available partition");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "File too large for available partition");
     return false;
   }
 
-  if (!Update.begin(expectedFirmwareSize, currentUpdateCommand)) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Failed to initialize update: " + String(Update.errorString()));
-    sendSerialResponse(jsonResponse, true);
+  // A delta session opens the partition itself once the patch header
+  // has been checked against the running image. A compressed image only
+  // knows its inflated size once the gzip trailer arrives.
+  size_t imageSize = compressedUpdate ? UPDATE_SIZE_UNKNOWN : expectedFirmwareSize;
+  bool started = deltaUpdateActive ? deltaUpdate_begin() : Update.begin(imageSize, currentUpdateCommand);
+  if (started && compressedUpdate && !gzipStream_begin(writeImageData)) {
+    started = false;
+  }
+  if (!started) {
+    snprintf(message, sizeof(message), "Failed to initialize update: %s", updateErrorString());
+    sendStatusResponse(false, message);
+    abortUpdateData();
     return false;
   }
 
@@ -755,20 +974,67 @@ static bool initializeSerialUpdate(const SerialCommand &cmd) {
 }
 
 /**
- * @brief Handle START_UPDATE command
+ * @brief Open a LittleFS asset for a serial transfer
+ * @param cmd Command with a "size,sha256,path" manifest entry
+ * @return true if the temporary file is ready to receive data
+ */
+static bool initializeAssetTransfer(const SerialCommand &cmd) {
+  asset_entry_t entry;
+  if (!assetSync_parseEntry(cmd.data, cmd.dataLength, &entry)) {
+    sendStatusResponse(false, "Invalid asset entry. Expected: size,sha256,path");
+    return false;
+  }
+
+  assetTransferActive = true;
+  deltaUpdateActive = false;
+  compressedUpdate = false;
+  expectedFirmwareSize = entry.size;
+
+  if (!assetSync_begin(&entry)) {
+    sendStatusResponse(false, assetSync_errorString());
+    assetTransferActive = false;
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Forward declaration of stopBinaryLink
+ */
+static void stopBinaryLink();
+
+/**
+ * @brief Reset any previous session and begin a new serial update
  * @param cmd Command with firmware size and type parameters
+ * @param initialize Opens the destination (update partition or asset file)
+ * @return true if the destination is ready to receive data
  */
-static void handleStartUpdate(const SerialCommand &cmd) {
+static bool beginSerialUpdate(const SerialCommand &cmd,
+                              bool (*initialize)(const SerialCommand &) = initializeSerialUpdate) {
+  // Guards are only checked when a transition starts, so one already under
+  // way (e.g. leaving UPDATE_MODE) would stop the AP under the update
+  if (isStateTransitioning()) {
+    sendStatusResponse(false, "Mode change in progress, please try again");
+    return false;
+  }
+
   if (currentSerialState != SerialUpdateState::IDLE) {
-    if (Update.isRunning()) {
-      Update.abort();
-    }
+    stopBinaryLink();
+    abortUpdateData();
     currentSerialState = SerialUpdateState::IDLE;
     updateProgress = {0, 0, 0, ""};
   }
 
-  if (!initializeSerialUpdate(cmd)) {
-    return;
+  // A flash writer that did not stop still owns the frame pool and may
+  // still be writing into Update; nothing can start until it is gone
+  if (flashWriterTask) {
+    currentSerialState = SerialUpdateState::ERROR;
+    sendStatusResponse(false, "Previous update is still writing, please restart the device");
+    return false;
+  }
+
+  if (!initialize(cmd)) {
+    return false;
   }
 
   updateProgress.totalSize = expectedFirmwareSize;
@@ -778,10 +1044,19 @@ static void handleStartUpdate(const SerialCommand &cmd) {
   total_written = 0;
 
   currentSerialState = SerialUpdateState::RECEIVING;
+  return true;
+}
 
-  String jsonResponse = createSerialJsonResponse(
-      true, "Update initialized. Ready to receive data.");
-  sendSerialResponse(jsonResponse);
+/**
+ * @brief Handle START_UPDATE command
+ * @param cmd Command with firmware size and type parameters
+ */
+static void handleStartUpdate(const SerialCommand &cmd) {
+  if (!beginSerialUpdate(cmd)) {
+    return;
+  }
+
+  sendStatusResponse(true, "Update initialized. Ready to receive data.");
   sendProgressUpdate(0, "Ready to receive firmware data");
 }
 
@@ -792,8 +1067,8 @@ static void handleStartUpdate(const SerialCommand &cmd) {
  */
 static int handleChunkWrite(const SerialCommand &cmd) {
   static uint8_t decodedBuffer[2048];
-  size_t decodedSize =
-      simpleBase64Decode(cmd.data, decodedBuffer, sizeof(decodedBuffer));
+  size_t decodedSize = simpleBase64Decode(cmd.data, cmd.dataLength, decodedBuffer,
+                                          sizeof(decodedBuffer));
 
   if (decodedSize == 0) {
     Serial.println("ERROR:{\"success\":false,\"message\":\"Decode failed\"}");
@@ -802,23 +1077,21 @@ static int handleChunkWrite(const SerialCommand &cmd) {
 
   if (total_written + decodedSize > expectedFirmwareSize) {
     currentSerialState = SerialUpdateState::ERROR;
-    Update.abort();
+    abortUpdateData();
     Serial.println(
         "ERROR:{\"success\":false,\"message\":\"Data exceeds expected size\"}");
     return -1;
   }
 
-  size_t written = Update.write(decodedBuffer, decodedSize);
-  if (written != decodedSize) {
+  if (!writeUpdateData(decodedBuffer, decodedSize)) {
     currentSerialState = SerialUpdateState::ERROR;
-    Update.abort();
-    Serial.println(
-        "ERROR:{\"success\":false,\"message\":\"Flash write failed\"}");
+    sendStatusResponse(false, updateErrorString());
+    abortUpdateData();
     return -1;
   }
 
-  total_written += written;
-  updateProgress.receivedSize += written;
+  total_written += decodedSize;
+  updateProgress.receivedSize += decodedSize;
   updateProgress.percentage =
       (updateProgress.receivedSize * 100) / updateProgress.totalSize;
 
@@ -835,7 +1108,7 @@ static void handleSendChunk(const SerialCommand &cmd) {
     return;
   }
 
-  if (cmd.data.length() == 0) {
+  if (cmd.dataLength == 0) {
     Serial.println("ERROR:{\"success\":false,\"message\":\"Empty chunk\"}");
     return;
   }
@@ -859,53 +1132,65 @@ static void handleSendChunk(const SerialCommand &cmd) {
  * @return true if update was successfully finalized
  */
 static bool finalizeSerialUpdate() {
+  char message[96];
+
   if (total_written != expectedFirmwareSize) {
     currentSerialState = SerialUpdateState::ERROR;
-    Update.abort();
-    String jsonResponse = createSerialJsonResponse(
-        false, "Size mismatch - Expected: " + String(expectedFirmwareSize) +
-                   ", Received: " + String(total_written));
-    sendSerialResponse(jsonResponse, true);
-    ESP_LOGE(SERIAL_LOG, "Size mismatch - Expected: %d, Received: %d",
-             expectedFirmwareSize, total_written);
+    abortUpdateData();
+    snprintf(message, sizeof(message), "Size mismatch - Expected: %u, Received: %u",
+             (unsigned)expectedFirmwareSize, (unsigned)total_written);
+    sendStatusResponse(false, message);
+    ESP_LOGE(SERIAL_LOG, "%s", message);
     return false;
   }
 
-  if (Update.end(true)) {
+  if (endUpdateData()) {
     currentSerialState = SerialUpdateState::SUCCESS;
     updateProgress.message = "Update completed successfully";
     return true;
   } else {
     currentSerialState = SerialUpdateState::ERROR;
-    String jsonResponse = createSerialJsonResponse(
-        false, "Update failed: " + String(Update.errorString()));
-    sendSerialResponse(jsonResponse, true);
-    Update.abort();
+    snprintf(message, sizeof(message), "Update failed: %s", updateErrorString());
+    sendStatusResponse(false, message);
+    abortUpdateData();
     return false;
   }
 }
 
+/**
+ * @brief Finalize the update and restart into it on success
+ *
+ * Asset transfers only replace a file, so the device keeps running.
+ */
+static void completeSerialUpdate() {
+  if (assetTransferActive) {
+    if (finalizeSerialUpdate()) {
+      currentSerialState = SerialUpdateState::IDLE;
+      sendStatusResponse(true, "Asset saved", true, 100);
+    }
+    return;
+  }
+
+  if (finalizeSerialUpdate()) {
+    sendStatusResponse(true, "Update completed successfully. Device will restart.", true, 100);
+    flushPreferences();
+    delay(1000);
+    ESP.restart();
+  }
+}
+
 /**
  * @brief Handle FINISH_UPDATE command
  */
 static void handleFinishUpdate() {
   if (currentSerialState != SerialUpdateState::RECEIVING) {
-    String jsonResponse =
-        createSerialJsonResponse(false, "Not in receiving state");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Not in receiving state");
     return;
   }
 
   currentSerialState = SerialUpdateState::PROCESSING;
   sendProgressUpdate(100, "Finalizing update...");
-
-  if (finalizeSerialUpdate()) {
-    String jsonResponse = createSerialJsonResponse(
-        true, "Update completed successfully. Device will restart.", true, 100);
-    sendSerialResponse(jsonResponse);
-    delay(1000);
-    ESP.restart();
-  }
+  completeSerialUpdate();
 }
 
 /**
@@ -913,34 +1198,30 @@ static void handleFinishUpdate() {
  */
 static void handleAbortUpdate() {
   if (currentSerialState == SerialUpdateState::IDLE) {
-    String jsonResponse =
-        createSerialJsonResponse(true, "No update in progress");
-    sendSerialResponse(jsonResponse);
+    sendStatusResponse(true, "No update in progress");
     return;
   }
 
-  Update.abort();
+  stopBinaryLink();
+  abortUpdateData();
   currentSerialState = SerialUpdateState::IDLE;
   updateProgress = {0, 0, 0, "Update aborted"};
 
-  String jsonResponse = createSerialJsonResponse(true, "Update aborted");
-  sendSerialResponse(jsonResponse);
+  sendStatusResponse(true, "Update aborted");
 }
 
 /**
  * @brief Handle GET_PREFERENCES command - shows all current preferences
  */
 static void handleGetPreferences() {
-  String prefsExport = createPreferencesString();
-
-  // Convert the multi-line preferences export to a JSON-safe format
-  prefsExport.replace("\n", "\\n");
-  prefsExport.replace("\"", "\\\"");
-
-  String jsonResponse = "{\"success\":true,\"message\":\"Current "
-                        "preferences\",\"preferences\":\"" +
-                        prefsExport + "\"}";
-  sendSerialResponse(jsonResponse);
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", true);
+  jsonString(&writer, "message", "Current preferences");
+  jsonStringBegin(&writer, "preferences");
+  writePreferencesString(&writer);
+  jsonStringEnd(&writer);
+  jsonEnd(&writer);
 }
 
 /**
@@ -949,90 +1230,626 @@ static void handleGetPreferences() {
  */
 static void handleResetPreferences() {
   if (isSerialUpdateActive()) {
-    String jsonResponse = createSerialJsonResponse(
-        false, "Cannot reset preferences during firmware update");
-    sendSerialResponse(jsonResponse, true);
+    sendStatusResponse(false, "Cannot reset preferences during firmware update");
     return;
   }
 
   // Use preferences module to clear all preferences
   clearAllPreferences();
-  String jsonResponse = createSerialJsonResponse(
-      true, "All preferences reset to factory defaults");
-  sendSerialResponse(jsonResponse);
+  sendStatusResponse(true, "All preferences reset to factory defaults");
 }
 
+/**
+ * @brief Parse the preset slot carried in a preset command
+ * @param name Receives what follows a comma after the slot, or NULL if the
+ *             command does not take a name
+ * @return true if the data starts with a slot index below EFFECT_PRESET_SLOTS
+ */
+static bool parsePresetSlot(const SerialCommand &cmd, uint8_t *slot, const char **name = NULL) {
+  char *end;
+  unsigned long value = strtoul(cmd.data, &end, 10);
+  if (end == cmd.data || value >= EFFECT_PRESET_SLOTS) {
+    return false;
+  }
+
+  if (name && *end == ',') {
+    *name = end + 1;
+  } else if (*end != '\0') {
+    return false;
+  }
+  *slot = value;
+  return true;
+}
+
+/**
+ * @brief Handle SELECT_PRESET command - switches to a stored effect preset
+ * @param cmd Command with the slot index as data
+ */
+static void handleSelectPreset(const SerialCommand &cmd) {
+  uint8_t slot;
+  if (!parsePresetSlot(cmd, &slot)) {
+    sendStatusResponse(false, "Invalid preset slot");
+    return;
+  }
+
+  if (!effectsCore_selectPreset(slot)) {
+    sendStatusResponse(false, "Preset slot is empty");
+    return;
+  }
+
+  // Remember the selection; written with the next deferred commit
+  effectsCore_saveToPreferences();
+
+  char message[48];
+  snprintf(message, sizeof(message), "Preset %u (%s) selected", slot, effectsCore_getPresetName(slot));
+  sendStatusResponse(true, message);
+}
+
+/**
+ * @brief Handle STORE_PRESET command - stores the current effects in a slot
+ * @param cmd Command with the slot index and an optional name as data
+ *            (format: "slot" or "slot,name"); without a name the slot keeps its own
+ */
+static void handleStorePreset(const SerialCommand &cmd) {
+  uint8_t slot;
+  const char *name = NULL;
+  if (!parsePresetSlot(cmd, &slot, &name)) {
+    sendStatusResponse(false, "Invalid preset slot");
+    return;
+  }
+
+  if (!effectsCore_storePreset(slot, name)) {
+    sendStatusResponse(false, name ? "Invalid preset name or storage failed" : "Failed to store preset");
+    return;
+  }
+
+  char message[48];
+  snprintf(message, sizeof(message), "Preset %u (%s) stored", slot, effectsCore_getPresetName(slot));
+  sendStatusResponse(true, message);
+}
+
+/**
+ * @file serial_module.cpp - Part 6: Binary Framed Update
+ * @brief Length-prefixed, CRC-checked frames with a sliding window and a
+ * dedicated flash writer task
+ *
+ * The host keeps up to SERIAL_FRAME_WINDOW frames in flight. Every frame in
+ * sequence is answered with a cumulative "ACK:<seq>" line as soon as it is
+ * queued for flashing; a corrupt or out-of-order frame is answered once with
+ * "NAK:<expected seq>" and the host goes back to that frame. Flash writes run
+ * on their own task so erase/program time overlaps with reception.
+ */
+
 //==============================================================================
-// MAIN COMMAND PROCESSING (STATIC)
+// BINARY FRAMED UPDATE (STATIC)
 //==============================================================================
 
 /**
- * @brief Process a complete command line
- * @param commandBuffer Complete command string to process
- */
-static void processCommand(const String &commandBuffer) {
-  SerialCommand cmd = parseCommand(commandBuffer);
-
-  // Device Information Commands
-  if (cmd.command == CMD_GET_INFO) {
-    handleGetInfo();
-  } else if (cmd.command == CMD_GET_STATUS) {
-    handleGetStatus();
-  } else if (cmd.command == CMD_RESTART) {
-    handleRestart();
-  } else if (cmd.command == CMD_GET_LOGS) {
-    handleGetLogs();
-  } else if (cmd.command == CMD_GET_PREFERENCES) {
-    handleGetPreferences();
-  } else if (cmd.command == CMD_RESET_PREFERENCES) {
-    handleResetPreferences();
-  }
-
-  // Firmware Update Commands
-  else if (cmd.command == CMD_START_UPDATE) {
-    handleStartUpdate(cmd);
-  } else if (cmd.command == CMD_SEND_CHUNK) {
-    handleSendChunk(cmd);
-  } else if (cmd.command == CMD_FINISH_UPDATE) {
-    handleFinishUpdate();
-  } else if (cmd.command == CMD_ABORT_UPDATE) {
+ * @brief Flash writer task - drains queued frames into the Update partition
+ * @param parameter Unused
+ */
+static void flashWriterTaskFunction(void *parameter) {
+  serial_frame_t *frame = NULL;
+
+  while (xQueueReceive(writeFrameQueue, &frame, portMAX_DELAY) == pdTRUE) {
+    if (!frame) {
+      break;
+    }
+
+    if (!flashWriteFailed) {
+      if (!writeUpdateData(frame->payload, frame->length)) {
+        flashWriteFailed = true;
+      } else {
+        flashedBytes += frame->length;
+      }
+    }
+
+    xQueueSend(freeFrameQueue, &frame, portMAX_DELAY);
+  }
+
+  flashWriterTask = NULL;
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Allocate the frame pool and start the flash writer task
+ * @return true if the binary link is ready
+ */
+static bool startBinaryLink() {
+  if (flashWriterTask) {
+    ESP_LOGE(SERIAL_LOG, "Previous flash writer task is still running");
+    return false;
+  }
+
+  framePool = (serial_frame_t *)malloc(SERIAL_FRAME_POOL_SIZE * sizeof(serial_frame_t));
+  freeFrameQueue = xQueueCreate(SERIAL_FRAME_POOL_SIZE, sizeof(serial_frame_t *));
+  writeFrameQueue = xQueueCreate(SERIAL_FRAME_POOL_SIZE + 1, sizeof(serial_frame_t *));
+
+  if (!framePool || !freeFrameQueue || !writeFrameQueue) {
+    ESP_LOGE(SERIAL_LOG, "Failed to allocate binary update buffers");
+    stopBinaryLink();
+    return false;
+  }
+
+  for (int i = 0; i < SERIAL_FRAME_POOL_SIZE; i++) {
+    serial_frame_t *frame = &framePool[i];
+    xQueueSend(freeFrameQueue, &frame, 0);
+  }
+
+  flashedBytes = 0;
+  flashWriteFailed = false;
+
+  TaskHandle_t task = NULL;
+  if (xTaskCreatePinnedToCore(flashWriterTaskFunction, "SerialFlash", SERIAL_FRAME_WRITER_STACK, NULL,
+                              SERIAL_FRAME_WRITER_PRIORITY, &task, 0) != pdPASS) {
+    ESP_LOGE(SERIAL_LOG, "Failed to create flash writer task");
+    stopBinaryLink();
+    return false;
+  }
+  flashWriterTask = task;
+
+  binaryLink = {};
+  binaryLink.active = true;
+  binaryLink.parseState = FrameParseState::SYNC;
+  binaryLink.lastProgressPercent = -1;
+  binaryLink.lastActivity = millis();
+  return true;
+}
+
+/**
+ * @brief Stop the flash writer task and release the frame pool
+ * If the writer does not stop, the pool stays allocated and flashWriterTask
+ * stays set, which blocks new sessions until the device restarts.
+ */
+static void stopBinaryLink() {
+  binaryLink.active = false;
+  binaryLink.frame = NULL;
+
+  if (flashWriterTask) {
+    // Bounded, so a writer stuck on flash cannot also hang a later retry
+    serial_frame_t *stop = NULL;
+    xQueueSend(writeFrameQueue, &stop, pdMS_TO_TICKS(SERIAL_FRAME_DRAIN_TIMEOUT_MS));
+
+    unsigned long startTime = millis();
+    while (flashWriterTask && millis() - startTime < SERIAL_FRAME_DRAIN_TIMEOUT_MS) {
+      vTaskDelay(pdMS_TO_TICKS(1));
+    }
+  }
+
+  if (flashWriterTask) {
+    ESP_LOGE(SERIAL_LOG, "Flash writer task did not stop, leaving buffers allocated");
+    return;
+  }
+
+  if (writeFrameQueue) {
+    vQueueDelete(writeFrameQueue);
+    writeFrameQueue = NULL;
+  }
+  if (freeFrameQueue) {
+    vQueueDelete(freeFrameQueue);
+    freeFrameQueue = NULL;
+  }
+  if (framePool) {
+    free(framePool);
+    framePool = NULL;
+  }
+}
+
+/**
+ * @brief Wait until every queued frame has been written to flash
+ * @param timeoutMs Maximum time to wait in milliseconds
+ * @return true if the writer is idle with all buffers returned
+ */
+static bool waitForFlashWriter(unsigned long timeoutMs) {
+  unsigned long startTime = millis();
+  while (uxQueueMessagesWaiting(freeFrameQueue) + (binaryLink.frame ? 1 : 0) < SERIAL_FRAME_POOL_SIZE) {
+    if (millis() - startTime >= timeoutMs) {
+      return false;
+    }
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+  return true;
+}
+
+/**
+ * @brief Send a frame acknowledgement line
+ * @param prefix RESP_ACK or RESP_NAK
+ * @param seq Sequence number to report
+ */
+static void sendFrameReply(const char *prefix, uint16_t seq) {
+  Serial.print(prefix);
+  Serial.println(seq);
+}
+
+/**
+ * @brief End the binary session with an error response
+ * @param message Error message
+ */
+static void failBinaryUpdate(const char *message) {
+  stopBinaryLink();
+  sendStatusResponse(false, message);
+  abortUpdateData();
+  currentSerialState = SerialUpdateState::ERROR;
+}
+
+/**
+ * @brief Drain the writer and finalize after the END frame
+ */
+static void finishBinaryUpdate() {
+  currentSerialState = SerialUpdateState::PROCESSING;
+  sendProgressUpdate(100, "Finalizing update...");
+
+  bool drained = waitForFlashWriter(SERIAL_FRAME_DRAIN_TIMEOUT_MS);
+  if (!drained || flashWriteFailed) {
+    failBinaryUpdate(drained ? updateErrorString() : "Flash writer timeout");
+    return;
+  }
+
+  total_written = flashedBytes;
+  stopBinaryLink();
+  completeSerialUpdate();
+}
+
+/**
+ * @brief Act on a frame that passed the CRC check
+ * @param frame Received frame (owned by the link until queued)
+ */
+static void processBinaryFrame(serial_frame_t *frame) {
+  int16_t distance = (int16_t)(frame->seq - binaryLink.expectedSeq);
+  if (distance != 0) {
+    if (distance < 0) {
+      // Retransmission of a frame we already have - repeat the cumulative ACK
+      sendFrameReply(RESP_ACK, binaryLink.expectedSeq - 1);
+    } else if (!binaryLink.nakSent) {
+      sendFrameReply(RESP_NAK, binaryLink.expectedSeq);
+      binaryLink.nakSent = true;
+    }
+    return;
+  }
+
+  binaryLink.nakSent = false;
+
+  switch (frame->type) {
+  case SERIAL_FRAME_DATA: {
+    uint16_t seq = frame->seq;
+    uint16_t length = frame->length;
+    if (length == 0 || updateProgress.receivedSize + length > expectedFirmwareSize) {
+      failBinaryUpdate("Data exceeds expected size");
+      return;
+    }
+
+    xQueueSend(writeFrameQueue, &frame, portMAX_DELAY);
+    binaryLink.frame = NULL;
+    binaryLink.expectedSeq++;
+    sendFrameReply(RESP_ACK, seq);
+
+    updateProgress.receivedSize += length;
+    updateProgress.percentage = (updateProgress.receivedSize * 100) / updateProgress.totalSize;
+    if (updateProgress.percentage >= binaryLink.lastProgressPercent + 10) {
+      binaryLink.lastProgressPercent = updateProgress.percentage;
+      sendProgressUpdate(updateProgress.percentage, "Uploading firmware...");
+    }
+    break;
+  }
+
+  case SERIAL_FRAME_END:
+    binaryLink.expectedSeq++;
+    sendFrameReply(RESP_ACK, frame->seq);
+    finishBinaryUpdate();
+    break;
+
+  case SERIAL_FRAME_ABORT:
+    sendFrameReply(RESP_ACK, frame->seq);
     handleAbortUpdate();
+    break;
+
+  default:
+    failBinaryUpdate("Unknown frame type");
+    break;
   }
+}
 
-  // WiFi Configuration Commands
-  else if (cmd.command == CMD_WIFI_SCAN) {
-    handleWiFiScan();
-  } else if (cmd.command == CMD_WIFI_STATUS) {
-    handleWiFiStatus();
-  } else if (cmd.command == CMD_WIFI_CONNECT) {
-    handleWiFiConnect(cmd);
-  } else if (cmd.command == CMD_WIFI_DISCONNECT) {
-    handleWiFiDisconnect();
-  } else if (cmd.command == CMD_WIFI_GET_SAVED) {
-    handleWiFiGetSaved();
-  } else if (cmd.command == CMD_WIFI_FORGET) {
-    handleWiFiForget();
+/**
+ * @brief Check a fully received frame and hand it on
+ */
+static void completeBinaryFrame() {
+  serial_frame_t *frame = binaryLink.frame;
+  frame->type = binaryLink.header[1];
+  frame->seq = binaryLink.header[2] | (binaryLink.header[3] << 8);
+
+  uint32_t received = binaryLink.crc[0] | (binaryLink.crc[1] << 8) | (binaryLink.crc[2] << 16) |
+                      ((uint32_t)binaryLink.crc[3] << 24);
+  uint32_t computed = esp_rom_crc32_le(0, binaryLink.header + 1, SERIAL_FRAME_HEADER_SIZE - 1);
+  computed = esp_rom_crc32_le(computed, frame->payload, frame->length);
+
+  binaryLink.parseState = FrameParseState::SYNC;
+  binaryLink.filled = 0;
+
+  if (received != computed) {
+    if (!binaryLink.nakSent) {
+      sendFrameReply(RESP_NAK, binaryLink.expectedSeq);
+      binaryLink.nakSent = true;
+    }
+    return;
   }
 
-  // Utility Commands
-  else if (cmd.command == "VERBOSE") {
-    handleVerbose(cmd);
+  processBinaryFrame(frame);
+}
+
+/**
+ * @brief Read and parse binary frames from the serial port
+ */
+static void handleBinaryFrames() {
+  unsigned long now = millis();
+
+  if (flashWriteFailed) {
+    failBinaryUpdate(updateErrorString());
+    return;
   }
 
-  // Unknown Command
-  else {
-    String jsonResponse =
-        createSerialJsonResponse(false, "Unknown command: " + cmd.command);
-    sendSerialResponse(jsonResponse, true);
+  if (now - binaryLink.lastActivity > SERIAL_FRAME_IDLE_TIMEOUT_MS) {
+    failBinaryUpdate("Binary update timed out");
+    return;
+  }
+
+  if (binaryLink.parseState != FrameParseState::SYNC && now - binaryLink.lastActivity > SERIAL_FRAME_GAP_TIMEOUT_MS) {
+    // Partial frame went stale - drop it and hunt for the next magic byte
+    binaryLink.parseState = FrameParseState::SYNC;
+    binaryLink.filled = 0;
+  }
+
+  size_t budget = SERIAL_FRAME_READ_BUDGET;
+  while (binaryLink.active && budget > 0) {
+    // Leave bytes in the UART buffer while every frame buffer waits on flash
+    if (!binaryLink.frame && xQueueReceive(freeFrameQueue, &binaryLink.frame, 0) != pdTRUE) {
+      return;
+    }
+
+    int available = Serial.available();
+    if (available <= 0) {
+      return;
+    }
+    binaryLink.lastActivity = millis();
+
+    size_t count = 0;
+    switch (binaryLink.parseState) {
+    case FrameParseState::SYNC:
+      count = 1;
+      if (Serial.read() == SERIAL_FRAME_MAGIC) {
+        binaryLink.header[0] = SERIAL_FRAME_MAGIC;
+        binaryLink.filled = 1;
+        binaryLink.parseState = FrameParseState::HEADER;
+      }
+      break;
+
+    case FrameParseState::HEADER:
+      count = Serial.readBytes(binaryLink.header + binaryLink.filled,
+                               min((size_t)available, SERIAL_FRAME_HEADER_SIZE - binaryLink.filled));
+      binaryLink.filled += count;
+      if (binaryLink.filled == SERIAL_FRAME_HEADER_SIZE) {
+        binaryLink.frame->length = binaryLink.header[4] | (binaryLink.header[5] << 8);
+        binaryLink.filled = 0;
+        if (binaryLink.frame->length > SERIAL_FRAME_MAX_PAYLOAD) {
+          binaryLink.parseState = FrameParseState::SYNC;
+        } else {
+          binaryLink.parseState =
+              binaryLink.frame->length > 0 ? FrameParseState::PAYLOAD : FrameParseState::CRC;
+        }
+      }
+      break;
+
+    case FrameParseState::PAYLOAD:
+      count = Serial.readBytes(binaryLink.frame->payload + binaryLink.filled,
+                               min((size_t)available, (size_t)binaryLink.frame->length - binaryLink.filled));
+      binaryLink.filled += count;
+      if (binaryLink.filled == binaryLink.frame->length) {
+        binaryLink.filled = 0;
+        binaryLink.parseState = FrameParseState::CRC;
+      }
+      break;
+
+    case FrameParseState::CRC:
+      count = Serial.readBytes(binaryLink.crc + binaryLink.filled,
+                               min((size_t)available, SERIAL_FRAME_CRC_SIZE - binaryLink.filled));
+      binaryLink.filled += count;
+      if (binaryLink.filled == SERIAL_FRAME_CRC_SIZE) {
+        completeBinaryFrame();
+      }
+      break;
+    }
+
+    budget = (count < budget) ? budget - count : 0;
+  }
+}
+
+/**
+ * @brief Switch the link into binary framed mode for a begun transfer
+ */
+static void startBinaryTransfer() {
+  if (!startBinaryLink()) {
+    abortUpdateData();
+    currentSerialState = SerialUpdateState::ERROR;
+    sendStatusResponse(false, "Failed to start binary update");
+    return;
+  }
+
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", true);
+  jsonString(&writer, "message", "Binary update ready");
+  jsonUInt(&writer, "max_payload", SERIAL_FRAME_MAX_PAYLOAD);
+  jsonUInt(&writer, "window", SERIAL_FRAME_WINDOW);
+  jsonEnd(&writer);
+}
+
+/**
+ * @brief Handle START_BINARY_UPDATE command
+ * @param cmd Command with firmware size and type parameters
+ */
+static void handleStartBinaryUpdate(const SerialCommand &cmd) {
+  if (beginSerialUpdate(cmd)) {
+    startBinaryTransfer();
+  }
+}
+
+/**
+ * @brief Handle START_ASSET command - receive one LittleFS file over the binary link
+ * @param cmd Command with a "size,sha256,path" manifest entry
+ */
+static void handleStartAsset(const SerialCommand &cmd) {
+  if (beginSerialUpdate(cmd, initializeAssetTransfer)) {
+    startBinaryTransfer();
   }
 }
 
+/**
+ * @brief Handle ASSET_CHECK command - report whether a file needs to be sent
+ * @param cmd Command with a "size,sha256,path" manifest entry
+ */
+static void handleAssetCheck(const SerialCommand &cmd) {
+  asset_entry_t entry;
+  if (!assetSync_parseEntry(cmd.data, cmd.dataLength, &entry)) {
+    sendStatusResponse(false, "Invalid asset entry. Expected: size,sha256,path");
+    return;
+  }
+
+  json_writer_t writer;
+  jsonBegin(&writer, RESP_OK);
+  jsonBool(&writer, "success", true);
+  jsonString(&writer, "path", entry.path);
+  jsonBool(&writer, "changed", !assetSync_isCurrent(&entry));
+  jsonEnd(&writer);
+}
+
+//==============================================================================
+// MAIN COMMAND PROCESSING (STATIC)
+//==============================================================================
+
+typedef void (*serial_command_handler_t)(const SerialCommand &cmd);
+
+typedef struct {
+  const char *name;
+  serial_command_handler_t handler;
+} serial_command_entry_t;
+
+static const serial_command_entry_t commandTable[] = {
+    // Device Information Commands
+    {CMD_GET_INFO, [](const SerialCommand &) { handleGetInfo(); }},
+    {CMD_GET_STATUS, [](const SerialCommand &) { handleGetStatus(); }},
+    {CMD_RESTART, [](const SerialCommand &) { handleRestart(); }},
+    {CMD_GET_LOGS, [](const SerialCommand &) { handleGetLogs(); }},
+    {CMD_GET_PREFERENCES, [](const SerialCommand &) { handleGetPreferences(); }},
+    {CMD_RESET_PREFERENCES, [](const SerialCommand &) { handleResetPreferences(); }},
+    {CMD_SELECT_PRESET, handleSelectPreset},
+    {CMD_STORE_PRESET, handleStorePreset},
+
+    // Firmware Update Commands
+    {CMD_START_UPDATE, handleStartUpdate},
+    {CMD_SEND_CHUNK, handleSendChunk},
+    {CMD_FINISH_UPDATE, [](const SerialCommand &) { handleFinishUpdate(); }},
+    {CMD_ABORT_UPDATE, [](const SerialCommand &) { handleAbortUpdate(); }},
+    {CMD_START_BINARY_UPDATE, handleStartBinaryUpdate},
+
+    // Asset Sync Commands
+    {CMD_ASSET_CHECK, handleAssetCheck},
+    {CMD_START_ASSET, handleStartAsset},
+
+    // WiFi Configuration Commands
+    {CMD_WIFI_SCAN, [](const SerialCommand &) { handleWiFiScan(); }},
+    {CMD_WIFI_STATUS, [](const SerialCommand &) { handleWiFiStatus(); }},
+    {CMD_WIFI_CONNECT, handleWiFiConnect},
+    {CMD_WIFI_DISCONNECT, [](const SerialCommand &) { handleWiFiDisconnect(); }},
+    {CMD_WIFI_GET_SAVED, [](const SerialCommand &) { handleWiFiGetSaved(); }},
+    {CMD_WIFI_FORGET, [](const SerialCommand &) { handleWiFiForget(); }},
+
+    // Utility Commands
+    {CMD_VERBOSE, handleVerbose},
+};
+
+#define COMMAND_TABLE_COUNT (sizeof(commandTable) / sizeof(commandTable[0]))
+
+static_assert(COMMAND_TABLE_COUNT < SERIAL_COMMAND_BUCKETS, "Command hash table is too small");
+static_assert((SERIAL_COMMAND_BUCKETS & (SERIAL_COMMAND_BUCKETS - 1)) == 0,
+              "SERIAL_COMMAND_BUCKETS must be a power of two");
+
+// Open-addressed index into commandTable, keyed by FNV-1a hash of the name
+static const serial_command_entry_t *commandBuckets[SERIAL_COMMAND_BUCKETS];
+static bool commandBucketsReady = false;
+
+/**
+ * @brief FNV-1a hash of a command name
+ * @param name Null-terminated command name
+ * @return 32-bit hash
+ */
+static uint32_t hashCommandName(const char *name) {
+  uint32_t hash = 2166136261u;
+  while (*name) {
+    hash ^= (uint8_t)*name++;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * @brief Build the command hash index from commandTable
+ */
+static void buildCommandBuckets() {
+  memset(commandBuckets, 0, sizeof(commandBuckets));
+  for (size_t i = 0; i < COMMAND_TABLE_COUNT; i++) {
+    uint32_t slot = hashCommandName(commandTable[i].name) & (SERIAL_COMMAND_BUCKETS - 1);
+    while (commandBuckets[slot]) {
+      slot = (slot + 1) & (SERIAL_COMMAND_BUCKETS - 1);
+    }
+    commandBuckets[slot] = &commandTable[i];
+  }
+  commandBucketsReady = true;
+}
+
+/**
+ * @brief Look up a command handler by name
+ * @param name Command name
+ * @return Matching table entry, or NULL if unknown
+ */
+static const serial_command_entry_t *findCommand(const char *name) {
+  if (!commandBucketsReady) {
+    buildCommandBuckets();
+  }
+
+  uint32_t slot = hashCommandName(name) & (SERIAL_COMMAND_BUCKETS - 1);
+  while (commandBuckets[slot]) {
+    if (strcmp(commandBuckets[slot]->name, name) == 0) {
+      return commandBuckets[slot];
+    }
+    slot = (slot + 1) & (SERIAL_COMMAND_BUCKETS - 1);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Process a complete command line
+ * @param line Complete command line (modified in place)
+ */
+static void processCommand(char *line) {
+  SerialCommand cmd = parseCommand(line);
+
+  const serial_command_entry_t *entry = findCommand(cmd.command);
+  if (entry) {
+    entry->handler(cmd);
+    return;
+  }
+
+  // Unknown Command
+  char message[64];
+  snprintf(message, sizeof(message), "Unknown command: %s", cmd.command);
+  sendStatusResponse(false, message);
+}
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
 
 bool initSerial() {
-  Serial.setRxBufferSize(8192);
+  Serial.setRxBufferSize(SERIAL_RX_BUFFER_SIZE);
   Serial.setTxBufferSize(4096);
   Serial.begin(SERIAL_BAUD_RATE);
 
@@ -1044,35 +1861,45 @@ bool initSerial() {
   }
 
   currentSerialState = SerialUpdateState::IDLE;
-  commandBuffer = "";
+  commandLength = 0;
+  commandOverflow = false;
   verboseLogging = false;
+  buildCommandBuckets();
 
-  String jsonResponse = createSerialJsonResponse(
-      true, "BYTE-90 Serial Interface Ready - WiFi commands available");
-  sendSerialResponse(jsonResponse);
+  sendStatusResponse(true, "BYTE-90 Serial Interface Ready - WiFi commands available");
 
   return true;
 }
 
 void handleSerialCommands() {
+  if (binaryLink.active) {
+    handleBinaryFrames();
+    return;
+  }
+
   int processed = 0;
   while (Serial.available() && processed < 128) {
     char c = Serial.read();
     processed++;
 
     if (c == '\n' || c == '\r') {
-      if (commandBuffer.length() > 0) {
+      if (commandLength > 0 && !commandOverflow) {
+        commandBuffer[commandLength] = '\0';
         processCommand(commandBuffer);
-        commandBuffer = "";
       }
-    } else if (c != '\r') {
-      commandBuffer += c;
-
-      if (commandBuffer.length() > SERIAL_COMMAND_BUFFER_SIZE) {
-        commandBuffer = "";
-        String jsonResponse =
-            createSerialJsonResponse(false, "Command too long");
-        sendSerialResponse(jsonResponse, true);
+      commandLength = 0;
+      commandOverflow = false;
+      if (binaryLink.active) {
+        // Everything after START_BINARY_UPDATE belongs to the frame parser
+        return;
+      }
+    } else if (!commandOverflow) {
+      if (commandLength < SERIAL_COMMAND_BUFFER_SIZE) {
+        commandBuffer[commandLength++] = c;
+      } else {
+        // Drop the rest of the line rather than parse its tail as a command
+        commandOverflow = true;
+        sendStatusResponse(false, "Command too long");
       }
     }
   }
@@ -1084,7 +1911,8 @@ void cleanupSerial() {
   }
 
   currentSerialState = SerialUpdateState::IDLE;
-  commandBuffer = "";
+  commandLength = 0;
+  commandOverflow = false;
   verboseLogging = false;
   updateProgress = {0, 0, 0, ""};
 }
@@ -1103,9 +1931,7 @@ void notifyUpdateModeExit() {
   // Only send notification if we're actually in a state where clients might be
   // connected
   if (getCurrentState() == SystemState::UPDATE_MODE) {
-    String jsonResponse = createSerialJsonResponse(
-        true, "Update mode exiting - device will disconnect", true, 100);
-    Serial.println("NOTIFY:" + jsonResponse);
+    writeStatusJson(RESP_NOTIFY, true, "Update mode exiting - device will disconnect", true, 100);
     Serial.flush(); // Ensure message is sent immediately
     delay(200);     // Brief delay to allow transmission to complete
 
@@ -71,6 +71,7 @@ static audio_mode_t g_audioMode = AUDIO_MODE_SHUTDOWN;
 static bool g_beepInProgress = false;
 static bool g_i2sInitializedForBeep = false;
 static float g_sinePhase = 0.0f;
+static volatile uint32_t g_beepUnderruns = 0;
 
 //==============================================================================
 // UTILITY FUNCTIONS (STATIC)
@@ -113,8 +114,8 @@ static bool configureI2SSystem(bool pinsOnly = false) {
         .channel_format = I2S_CHANNEL_FORMAT,
         .communication_format = static_cast<i2s_comm_format_t>(I2S_COMM_FORMAT_STAND_I2S),
         .intr_alloc_flags = ESP_INTR_FLAG_LEVEL2,
-        .dma_buf_count = 2,
-        .dma_buf_len = 64,
+        .dma_buf_count = I2S_DMA_BUF_COUNT,
+        .dma_buf_len = I2S_DMA_BUF_LEN,
         .use_apll = false,
         .tx_desc_auto_clear = true,
         .fixed_mclk = 0};
@@ -453,13 +454,19 @@ void playBeep(uint16_t frequency, uint16_t duration, uint8_t volume) {
   g_sinePhase = 0.0f;
 
   size_t samples_remaining = total_samples;
+  unsigned long lastWrite = 0;
   while (samples_remaining > 0 && !g_audioShutdown) {
     size_t chunk_samples = (samples_remaining < samples_per_chunk) ? samples_remaining : samples_per_chunk;
 
     generateSineWave(audio_buffer, chunk_samples, frequency, amplitude);
 
+    if (lastWrite && micros() - lastWrite > I2S_DMA_BUFFER_US) {
+      g_beepUnderruns++;
+    }
+
     size_t bytes_written;
     esp_err_t write_err = i2s_write(I2S_NUM, audio_buffer, chunk_samples * sizeof(int16_t), &bytes_written, pdMS_TO_TICKS(100));
+    lastWrite = micros();
 
     if (write_err != ESP_OK) {
       ESP_LOGW(SPEAKER_LOG, "I2S write failed: %s", esp_err_to_name(write_err));
@@ -482,6 +489,10 @@ void playBeep(uint16_t frequency, uint16_t duration, uint8_t volume) {
 
 // MP3 playback functions moved to speaker_mp3 module
 
+uint32_t getAudioUnderrunCount() {
+  return g_beepUnderruns + getMP3UnderrunCount();
+}
+
 void audioLoop() {
   audio_state_t audioState = getAudioState();
   if (audioState != AUDIO_STATE_READY && audioState != AUDIO_STATE_PLAYING)
@@ -69,6 +69,8 @@ static int g_mp3Volume = MP3_DEFAULT_VOLUME;
 static String g_currentMP3File = "";
 static mp3_state_t g_mp3State = MP3_STATE_IDLE;
 static bool g_mp3Paused = false;
+static volatile uint32_t g_mp3Underruns = 0;
+static unsigned long g_mp3LastService = 0; // 0 while not playing
 
 //==============================================================================
 // UTILITY FUNCTIONS
@@ -374,14 +376,27 @@ void mp3Loop() {
     return;
   }
 
-  if (g_mp3State == MP3_STATE_PLAYING) {
-    mp3Audio->loop();
-    
-    // Check if playback has finished
-    if (!mp3Audio->isRunning()) {
-      speakerMp3Debug("MP3 playback finished");
-      g_mp3State = MP3_STATE_IDLE;
-      g_currentMP3File = "";
-    }
+  if (g_mp3State != MP3_STATE_PLAYING) {
+    g_mp3LastService = 0;
+    return;
   }
+
+  unsigned long now = millis();
+  if (g_mp3LastService && now - g_mp3LastService > MP3_SERVICE_GAP_MS) {
+    g_mp3Underruns++;
+  }
+  g_mp3LastService = now;
+
+  mp3Audio->loop();
+
+  // Check if playback has finished
+  if (!mp3Audio->isRunning()) {
+    speakerMp3Debug("MP3 playback finished");
+    g_mp3State = MP3_STATE_IDLE;
+    g_currentMP3File = "";
+  }
+}
+
+uint32_t getMP3UnderrunCount() {
+  return g_mp3Underruns;
 }
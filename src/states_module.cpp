@@ -7,21 +7,26 @@
  * 
  * This module handles:
  * - System state initialization and management
- * - State transitions with validation and cleanup
- * - State-specific entry and exit logic
+ * - Table-driven state transitions with guards checked up front
+ * - State entry and exit actions, run on a worker so the animation keeps going
+ * - Transition timing history
  * - Startup state configuration and persistence
  * - State machine updates and monitoring
  * - Integration with WiFi, display, and other system modules
  */
 
 #include "states_module.h"
+#include "boot_module.h"
 #include "wifi_module.h"
 #include "preferences_module.h"
 #include "display_module.h"
 #include "clock_sync.h"
 #include "espnow_module.h"
+#include "serial_module.h"
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <stdarg.h>
+#include <atomic>
 
 //==============================================================================
 // DEBUG SYSTEM
@@ -72,15 +77,280 @@ void setStatesDebug(bool enabled) {
 
 static const char* TAG = "STATE_MGR";
 
+#define STATE_ANY -1 // Matches every state in the transition table
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+typedef void (*state_action_t)(void);
+typedef bool (*state_guard_t)(void);
+
+/**
+ * @brief What entering and leaving a state involves
+ * Radio actions run on the transition worker; settle and cleanup actions
+ * touch what the main loop draws and so run there once the radio is ready.
+ */
+typedef struct {
+    state_action_t enter;   // Radio work when entering
+    state_action_t exit;    // Radio work when leaving
+    state_action_t settle;  // Main-loop work once entered
+    state_action_t cleanup; // Main-loop work once left
+    bool temporary;         // Not remembered as the previous or startup state
+} state_descriptor_t;
+
+/**
+ * @brief One row of the transition table; the first matching row decides
+ */
+typedef struct {
+    int8_t from;            // SystemState, or STATE_ANY
+    int8_t to;              // SystemState, or STATE_ANY
+    state_guard_t guard;    // NULL if always allowed
+    const char* reason;     // Logged when the guard refuses
+} state_transition_t;
+
+typedef enum {
+    TRANSITION_NONE,        // Nothing in flight
+    TRANSITION_RADIO,       // Worker is running the exit and enter actions
+    TRANSITION_SETTLE       // Waiting for the main loop to finish it
+} transition_phase_t;
+
+//==============================================================================
+// STATE ACTIONS (STATIC)
+//==============================================================================
+
+static void enterIdle() {
+    // Disable WiFi completely for power savings
+    disableWiFi();
+    statesDebug("WiFi disabled - power saving mode active");
+}
+
+static void enterWiFi() {
+    enableWiFi();
+    startStationWebServer();
+    statesDebug("WiFi enabled - waiting for station to be ready");
+}
+
+static void exitWiFi() {
+    statesDebug("Stopping station web server");
+    stopStationWebServer();
+}
+
+static void enterESP() {
+    // Enable WiFi for ESP-NOW but don't connect to any network
+    enableESPNowWiFi();
+    statesDebug("WiFi enabled for ESP-NOW communication");
+}
+
+static void exitESP() {
+    statesDebug("Stopping ESP-NOW communication");
+    shutdownCommunication();
+}
+
+static void cleanupESP() {
+    // The emotes read the conversation animation, so it is cleared here
+    resetAnimationPath();
+}
+
+static void enterUpdate() {
+    startWiFiAP();
+    statesDebug("WiFi AP started for updates");
+}
+
+static void exitUpdate() {
+    statesDebug("Stopping WiFi AP");
+    stopWiFiAP(false);
+    if (isWifiNetworkConnected()) {
+        ESP_LOGI("STATE_MGR", "WiFi connected during UPDATE_MODE exit - enabling WiFi mode");
+        setWiFiModeEnabled(true);
+    }
+}
+
+static void enterClock() {
+    // Enable WiFi and connect for NTP sync
+    enableWiFi();
+    statesDebug("WiFi enabled for clock synchronization");
+}
+
+static void settleClock() {
+    syncAndDisplayTime();
+}
+
+static void exitClock() {
+    // Disconnect WiFi if it was only for clock sync
+    if (!getWiFiModeEnabled()) {
+        disconnectFromWiFi();
+        statesDebug("WiFi disconnected - clock mode active");
+    }
+}
+
+//==============================================================================
+// STATE GUARDS (STATIC)
+//==============================================================================
+
+static bool noSerialUpdateActive() {
+    return !isSerialUpdateActive();
+}
+
+//==============================================================================
+// STATE TABLES
+//==============================================================================
+
+// Indexed by SystemState
+static const state_descriptor_t stateTable[] = {
+    /* IDLE_MODE   */ {enterIdle,   NULL,       NULL,        NULL,       false},
+    /* WIFI_MODE   */ {enterWiFi,   exitWiFi,   NULL,        NULL,       false},
+    /* ESP_MODE    */ {enterESP,    exitESP,    NULL,        cleanupESP, false},
+    /* UPDATE_MODE */ {enterUpdate, exitUpdate, NULL,        NULL,       true},
+    /* CLOCK_MODE  */ {enterClock,  exitClock,  settleClock, NULL,       true},
+};
+
+static const state_transition_t transitionTable[] = {
+    {UPDATE_MODE, STATE_ANY, noSerialUpdateActive, "serial update in progress"},
+    {STATE_ANY,   STATE_ANY, NULL,                 NULL},
+};
+
 //==============================================================================
 // GLOBAL VARIABLES
 //==============================================================================
 
 // State management variables
-static SystemState currentState = IDLE_MODE;
+static std::atomic<SystemState> currentState(IDLE_MODE);
 static SystemState startupState = IDLE_MODE;
 static SystemState previousState = IDLE_MODE;
 
+// Transition in flight; owned by the worker during TRANSITION_RADIO
+static std::atomic<transition_phase_t> transitionPhase(TRANSITION_NONE);
+static state_transition_record_t activeTransition;
+static uint32_t transitionStart = 0;
+static TaskHandle_t transitionWorker = NULL;
+
+// Completed transition timings, oldest overwritten first
+static state_transition_record_t transitionHistory[STATES_TRANSITION_HISTORY];
+static size_t transitionHistoryNext = 0;
+static size_t transitionHistoryCount = 0;
+static portMUX_TYPE transitionHistoryLock = portMUX_INITIALIZER_UNLOCKED;
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Checks if a state can be resumed after a warm boot
+ * @param state The state that was running before the reset
+ * @return true for the persistent modes and ESP_MODE, false for temporary ones
+ *
+ * WIFI_MODE is only resumed while WiFi mode is still enabled.
+ */
+static bool isResumableState(SystemState state) {
+    switch (state) {
+        case IDLE_MODE:
+        case ESP_MODE:
+            return true;
+        case WIFI_MODE:
+            return getWiFiModeEnabled();
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Finds the transition table row for a transition and checks its guard
+ * @return true if the transition is allowed
+ */
+static bool checkTransitionGuards(SystemState from, SystemState to) {
+    for (const state_transition_t& row : transitionTable) {
+        if ((row.from != STATE_ANY && row.from != from) || (row.to != STATE_ANY && row.to != to)) {
+            continue;
+        }
+        if (row.guard && !row.guard()) {
+            ESP_LOGW(TAG, "%s -> %s refused: %s", getStateString(from), getStateString(to), row.reason);
+            return false;
+        }
+        return true;
+    }
+    ESP_LOGW(TAG, "%s -> %s is not in the transition table", getStateString(from), getStateString(to));
+    return false;
+}
+
+/**
+ * @brief Runs the radio half of the active transition
+ * Leaves the old state before switching, so its exit actions still see it
+ * as the current state.
+ */
+static void runTransitionRadio() {
+    exitState(activeTransition.from);
+    currentState = activeTransition.to;
+    boot_saveResumeState((uint8_t)activeTransition.to);
+    if (stateTable[activeTransition.to].enter) {
+        stateTable[activeTransition.to].enter();
+    }
+
+    activeTransition.radioUs = (uint32_t)esp_timer_get_time() - transitionStart;
+    transitionPhase = TRANSITION_SETTLE;
+}
+
+/**
+ * @brief Transition worker task, woken by transitionToState()
+ */
+static void transitionTaskFunction(void* parameter) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (transitionPhase == TRANSITION_RADIO) {
+            runTransitionRadio();
+        }
+    }
+}
+
+/**
+ * @brief Finishes the active transition on the main loop
+ * Clears what the old state left for the main loop, draws for the new state,
+ * syncs the startup preferences and records the timing.
+ */
+static void completeTransition() {
+    SystemState oldState = activeTransition.from;
+    SystemState newState = activeTransition.to;
+
+    if (stateTable[oldState].cleanup) {
+        stateTable[oldState].cleanup();
+    }
+    if (stateTable[newState].settle) {
+        stateTable[newState].settle();
+    }
+    updateDisplayForMode(newState);
+
+    // Update startup preference for persistent states
+    if (isValidStartupState(newState) && !stateTable[oldState].temporary) {
+        startupState = newState;
+        saveStartupMode((uint8_t)startupState);
+
+        // Also sync WiFi mode preference
+        if (newState == WIFI_MODE) {
+            setWiFiModeEnabled(true);
+        } else if (newState == IDLE_MODE) {
+            setWiFiModeEnabled(false);
+        }
+
+        statesDebug("Startup mode updated to %s", getStateString(startupState));
+    }
+
+    // Save last known good state
+    saveLastKnownGoodState((uint8_t)newState);
+
+    activeTransition.totalUs = (uint32_t)esp_timer_get_time() - transitionStart;
+    portENTER_CRITICAL(&transitionHistoryLock);
+    transitionHistory[transitionHistoryNext] = activeTransition;
+    transitionHistoryNext = (transitionHistoryNext + 1) % STATES_TRANSITION_HISTORY;
+    if (transitionHistoryCount < STATES_TRANSITION_HISTORY) {
+        transitionHistoryCount++;
+    }
+    portEXIT_CRITICAL(&transitionHistoryLock);
+
+    statesDebug("%s -> %s took %.1f ms (radio %.1f ms)", getStateString(oldState), getStateString(newState),
+                activeTransition.totalUs / 1000.0f, activeTransition.radioUs / 1000.0f);
+    transitionPhase = TRANSITION_NONE;
+}
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -119,104 +389,95 @@ void initSystemStateManager() {
     // Set initial state
     currentState = startupState;
     previousState = startupState;
+
+    // A deep-sleep wake or quick boot picks up whatever was running, including ESP_MODE
+    uint8_t resumedState;
+    bool sleepWake = boot_isSleepWake();
+    if ((sleepWake || boot_isQuickBoot()) && boot_loadResumeState(&resumedState) &&
+        isResumableState((SystemState)resumedState)) {
+        currentState = (SystemState)resumedState;
+        statesDebug("%s - resuming %s", sleepWake ? "Sleep wake" : "Quick boot", getStateString(currentState));
+    }
+
+    if (!transitionWorker &&
+        xTaskCreatePinnedToCore(transitionTaskFunction, "StateWorker", STATES_WORKER_STACK, NULL,
+                                STATES_WORKER_PRIORITY, &transitionWorker, STATES_WORKER_CORE) != pdPASS) {
+        transitionWorker = NULL;
+        ESP_LOGW(TAG, "No transition worker - transitions will run inline");
+    }
     
     statesDebug("Starting in %s", getStateString(currentState));
     
-    // Initialize the starting state
+    // Boot has nothing to animate yet, so the starting state is entered inline
     enterState(currentState);
 }
 
 /**
  * @brief Updates the system state machine - should be called in main loop
  * 
- * Handles state transitions, timeouts, and state-specific logic.
- * Monitors current state and performs automatic transitions when needed.
+ * Finishes a transition once the worker has reconfigured the radio.
+ * No state currently transitions on its own.
  */
 void updateSystemStateMachine() {
-    unsigned long currentTime = millis();
-    
-    switch (currentState) {
-        case IDLE_MODE:
-            // No automatic transitions from IDLE_MODE
-            break;
-            
-        case WIFI_MODE:
-            // No automatic transitions from WIFI_MODE
-            // (24-hour clock sync is handled in main.cpp)
-            break;
-
-       case ESP_MODE:
-            // No automatic transitions from ESP_MODE
-            // ESP-NOW communication is persistent until user changes state
-            break;
-            
-        case UPDATE_MODE:
-            // No automatic transitions from UPDATE_MODE
-            // Update mode is persistent until user changes state
-            break;
-            
-        case CLOCK_MODE:
-             // No automatic transitions from CLOCK_MODE
-            // TODO: Add logic to detect NTP sync completion and return early
-            break;
+    if (transitionPhase == TRANSITION_SETTLE) {
+        completeTransition();
     }
 }
 
 /**
- * @brief Transitions the system to a new state
+ * @brief Starts a transition to a new state
  * @param newState The target state to transition to
+ * @return true if the transition passed its guards and was started
  * 
- * Handles state transitions with proper cleanup and initialization.
- * Manages state history and validates transitions.
+ * Checks the guards up front, then hands the exit and enter actions to the
+ * worker so the animation keeps running while the radio reconfigures.
  */
-void transitionToState(SystemState newState) {
-    if (newState == currentState) {
+bool transitionToState(SystemState newState) {
+    SystemState oldState = currentState;
+
+    if (transitionPhase != TRANSITION_NONE) {
+        ESP_LOGW(TAG, "Transition to %s refused - %s -> %s still in flight", getStateString(newState),
+                 getStateString(activeTransition.from), getStateString(activeTransition.to));
+        return false;
+    }
+    if (newState == oldState) {
         ESP_LOGD(TAG, "Already in %s - no transition needed", getStateString(newState));
-        return;
+        return false;
+    }
+    if (!checkTransitionGuards(oldState, newState)) {
+        return false;
     }
     
-    statesDebug("Transitioning from %s to %s", 
-             getStateString(currentState), getStateString(newState));
+    statesDebug("Transitioning from %s to %s", getStateString(oldState), getStateString(newState));
     
     // Store previous state (but not if transitioning from temporary modes)
-    if (currentState != UPDATE_MODE && currentState != CLOCK_MODE) {
-        previousState = currentState;
+    if (!stateTable[oldState].temporary) {
+        previousState = oldState;
     }
-    
-    // Exit current state
-    exitState(currentState);
-    
-    // Update state
-    SystemState oldState = currentState;
-    currentState = newState;
-    
-    // Enter new state
-    enterState(newState);
-    updateDisplayForMode(newState);
-    
-     // Update startup preference for persistent states
-     if (isValidStartupState(newState)) {
-        if (oldState != UPDATE_MODE && oldState != CLOCK_MODE) {
-            startupState = newState;
-            saveStartupMode((uint8_t)startupState);
-            
-            // NEW: Also sync WiFi mode preference
-            if (newState == WIFI_MODE) {
-                setWiFiModeEnabled(true);
-            } else if (newState == IDLE_MODE) {
-                setWiFiModeEnabled(false);
-            }
-            
-            statesDebug("Startup mode updated to %s", getStateString(startupState));
-        }
+
+    transitionStart = (uint32_t)esp_timer_get_time();
+    activeTransition = {oldState, newState, 0, 0};
+    transitionPhase = TRANSITION_RADIO;
+
+    if (transitionWorker) {
+        xTaskNotifyGive(transitionWorker);
+    } else {
+        runTransitionRadio();
+        completeTransition();
     }
-    
-    // Save last known good state
-    saveLastKnownGoodState((uint8_t)newState);
+    return true;
 }
 
 /**
- * @brief Handles cleanup and exit logic for a specific state
+ * @brief Checks whether a transition is still in flight
+ * @return true from transitionToState() until the main loop has finished it
+ */
+bool isStateTransitioning() {
+    return transitionPhase != TRANSITION_NONE;
+}
+
+/**
+ * @brief Runs the exit actions of a state on the calling task
  * @param state The state to exit from
  * 
  * Performs state-specific cleanup operations when exiting a state.
@@ -224,44 +485,14 @@ void transitionToState(SystemState newState) {
  */
 void exitState(SystemState state) {
     ESP_LOGD(TAG, "Exiting %s", getStateString(state));
-    
-    switch (state) {
-        case IDLE_MODE:
-            // Nothing to clean up
-            break;
-            
-        case WIFI_MODE:
-            // Keep WiFi connected for now - will be handled by entering state
-            break;
 
-        case ESP_MODE:
-            // Stop ESP-NOW (placeholder - actual implementation in ESP-NOW module)
-            statesDebug("Stopping ESP-NOW communication");
-            shutdownCommunication();
-            break;
-            
-        case UPDATE_MODE:
-            // Stop AP mode
-            statesDebug("Stopping WiFi AP");
-            stopWiFiAP(false);
-             if (isWifiNetworkConnected()) {
-                    ESP_LOGI("STATE_MGR", "WiFi connected during UPDATE_MODE exit - enabling WiFi mode");
-                    setWiFiModeEnabled(true);
-                }
-            break;
-            
-        case CLOCK_MODE:
-            // Disconnect WiFi if it was only for clock sync
-            if (!getWiFiModeEnabled()) {
-                disconnectFromWiFi();
-                statesDebug("WiFi disconnected - clock mode active");
-            }
-            break;
+    if (stateTable[state].exit) {
+        stateTable[state].exit();
     }
 }
 
 /**
- * @brief Handles initialization and entry logic for a specific state
+ * @brief Runs the enter actions of a state on the calling task
  * @param state The state to enter
  * 
  * Performs state-specific initialization operations when entering a state.
@@ -269,36 +500,13 @@ void exitState(SystemState state) {
  */
 void enterState(SystemState state) {
     ESP_LOGD(TAG, "Entering %s", getStateString(state));
-    
-    switch (state) {
-        case IDLE_MODE:
-            // Disable WiFi completely for power savings
-            disableWiFi();
-            statesDebug("WiFi disabled - power saving mode active");
-            break;
-            
-        case WIFI_MODE:
-            enableWiFi();
-            statesDebug("WiFi enabled - waiting for station to be ready");
-            break;
+    boot_saveResumeState((uint8_t)state);
 
-        case ESP_MODE:
-            // Enable WiFi for ESP-NOW but don't connect to any network
-            enableESPNowWiFi();
-            statesDebug("WiFi enabled for ESP-NOW communication");
-            break;
-            
-        case UPDATE_MODE:
-            startWiFiAP();
-            statesDebug("WiFi AP started for updates");
-            break;
-            
-        case CLOCK_MODE:
-            // Enable WiFi and connect for NTP sync
-            enableWiFi();
-            syncAndDisplayTime();
-            statesDebug("WiFi enabled for clock synchronization");
-            break;
+    if (stateTable[state].enter) {
+        stateTable[state].enter();
+    }
+    if (stateTable[state].settle) {
+        stateTable[state].settle();
     }
 }
 
@@ -312,6 +520,23 @@ SystemState getCurrentState() {
     return currentState;
 }
 
+/**
+ * @brief Copies the most recent transition timings
+ * @param records Receives the records, newest first
+ * @param maxRecords Capacity of records
+ * @return Number of records copied
+ */
+size_t getStateTransitionHistory(state_transition_record_t* records, size_t maxRecords) {
+    portENTER_CRITICAL(&transitionHistoryLock);
+    size_t count = min(transitionHistoryCount, maxRecords);
+    for (size_t i = 0; i < count; i++) {
+        size_t index = (transitionHistoryNext + STATES_TRANSITION_HISTORY - 1 - i) % STATES_TRANSITION_HISTORY;
+        records[i] = transitionHistory[index];
+    }
+    portEXIT_CRITICAL(&transitionHistoryLock);
+    return count;
+}
+
 /**
  * @brief Gets the startup state that should be used on system boot
  * @return Startup SystemState value
@@ -390,7 +615,19 @@ void printSystemStatus() {
     if (currentState == ESP_MODE) {
         Serial.println("WiFi Status: ESP-NOW Mode");
         Serial.printf("MAC Address: %s\n", WiFi.macAddress().c_str());
-        Serial.println("ESP-NOW Channel: 1"); // This could be made dynamic later
+        Serial.printf("ESP-NOW Channel: %d\n", ESPNOW_CHANNEL);
+
+        PeerLinkStats peerStats[ESPNOW_MAX_PEERS];
+        size_t peerCount = getPeerLinkStats(peerStats, ESPNOW_MAX_PEERS);
+        Serial.printf("ESP-NOW Peers: %u/%d\n", (unsigned)peerCount, ESPNOW_MAX_PEERS);
+        for (size_t i = 0; i < peerCount; i++) {
+            const PeerLinkStats& peer = peerStats[i];
+            Serial.printf("  %02X:%02X:%02X:%02X:%02X:%02X acked %lu/%lu, %lu retries, %lu lost, rtt %lu ms, heard %lu ms ago\n",
+                          peer.mac[0], peer.mac[1], peer.mac[2], peer.mac[3], peer.mac[4], peer.mac[5],
+                          (unsigned long)peer.framesAcked, (unsigned long)peer.framesSent,
+                          (unsigned long)peer.retries, (unsigned long)peer.framesLost,
+                          (unsigned long)peer.rttMs, millis() - peer.lastHeard);
+        }
     } else if (currentState != IDLE_MODE) {
         Serial.printf("WiFi Status: %s\n", isWifiNetworkConnected() ? "Connected" : "Disconnected");
         
@@ -433,6 +670,14 @@ void printSystemStatus() {
         Serial.println("Stored Password: None");
     }
     
+    state_transition_record_t transitions[STATES_TRANSITION_HISTORY];
+    size_t transitionCount = getStateTransitionHistory(transitions, STATES_TRANSITION_HISTORY);
+    for (size_t i = 0; i < transitionCount; i++) {
+        Serial.printf("Transition: %s -> %s in %.1f ms (radio %.1f ms)\n",
+                      getStateString(transitions[i].from), getStateString(transitions[i].to),
+                      transitions[i].totalUs / 1000.0f, transitions[i].radioUs / 1000.0f);
+    }
+    
     Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
     Serial.printf("Uptime: %lu seconds\n", millis() / 1000);
     Serial.println("====================\n");
@@ -0,0 +1,229 @@
+/**
+ * @file telemetry_module.cpp
+ * @brief Implementation of the live telemetry stream
+ *
+ * This module handles:
+ * - The low-priority sampler task and its counters
+ * - The ring buffer of recent samples
+ * - The /telemetry WebSocket endpoint and sample broadcasts
+ */
+
+#include "telemetry_module.h"
+#include "effects_core.h"
+#include "gif_module.h"
+#include "http_module.h"
+#include "motion_module.h"
+#include "speaker_module.h"
+#include <WiFi.h>
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+// Counter readings at the previous sample, to turn totals into rates
+typedef struct {
+  unsigned long time;
+  uint32_t frames;
+  uint32_t underruns;
+  uint32_t effectTime[EFFECT_COUNT];
+} telemetry_baseline_t;
+
+// data/script.js decodes the sample by offset
+static_assert(sizeof(telemetry_sample_t) == 28 + 2 * EFFECT_COUNT, "Telemetry sample layout changed");
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
+
+static telemetry_sample_t history[TELEMETRY_HISTORY];
+static size_t historyHead = 0; // Next slot to write
+static size_t historyCount = 0;
+static portMUX_TYPE historyLock = portMUX_INITIALIZER_UNLOCKED;
+
+static telemetry_baseline_t baseline = {};
+static uint16_t nextSequence = 0;
+
+static TaskHandle_t telemetryTask = NULL;
+static volatile bool telemetryStop = false;
+
+// Replay buffer for new subscribers; the server task runs one handler at a time
+static telemetry_sample_t replay[TELEMETRY_HISTORY];
+
+//==============================================================================
+// UTILITY FUNCTIONS (STATIC)
+//==============================================================================
+
+/**
+ * @brief Read the counters the next sample is measured against
+ */
+static void resetBaseline() {
+  effect_performance_t performance;
+  effectsCore_getPerformance(&performance);
+
+  baseline.time = millis();
+  baseline.frames = getGIFFrameCount();
+  baseline.underruns = getAudioUnderrunCount();
+  memcpy(baseline.effectTime, performance.effectTime, sizeof(baseline.effectTime));
+  takeMotionEvents();
+}
+
+/**
+ * @brief Measure the interval since the previous sample
+ * @param sample Receives the sample
+ */
+static void takeSample(telemetry_sample_t *sample) {
+  effect_performance_t performance;
+  effectsCore_getPerformance(&performance);
+  unsigned long now = millis();
+  uint32_t elapsed = max(now - baseline.time, 1UL);
+  uint32_t frames = getGIFFrameCount();
+  uint32_t underruns = getAudioUnderrunCount();
+
+  memset(sample, 0, sizeof(*sample));
+  sample->version = TELEMETRY_VERSION;
+  sample->effectCount = EFFECT_COUNT;
+  sample->sequence = nextSequence++;
+  sample->uptime = now;
+  sample->fps = min((uint64_t)(frames - baseline.frames) * 100000 / elapsed, (uint64_t)UINT16_MAX);
+  sample->motionEvents = takeMotionEvents();
+  sample->heapFree = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+  sample->heapMinFree = heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL);
+  sample->psramFree = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+  sample->audioUnderruns = min(underruns - baseline.underruns, (uint32_t)UINT16_MAX);
+  sample->rssi = WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0;
+
+  // Microseconds per millisecond of interval is 0.1%; scale to 0.01%
+  for (int i = 0; i < EFFECT_COUNT; i++) {
+    uint32_t spent = performance.effectTime[i] - baseline.effectTime[i];
+    sample->effectLoad[i] = min((uint64_t)spent * 10 / elapsed, (uint64_t)10000);
+  }
+
+  baseline.time = now;
+  baseline.frames = frames;
+  baseline.underruns = underruns;
+  memcpy(baseline.effectTime, performance.effectTime, sizeof(baseline.effectTime));
+}
+
+/**
+ * @brief Append a sample to the ring, dropping the oldest when full
+ */
+static void pushHistory(const telemetry_sample_t *sample) {
+  portENTER_CRITICAL(&historyLock);
+  history[historyHead] = *sample;
+  historyHead = (historyHead + 1) % TELEMETRY_HISTORY;
+  if (historyCount < TELEMETRY_HISTORY) {
+    historyCount++;
+  }
+  portEXIT_CRITICAL(&historyLock);
+}
+
+/**
+ * @brief Copy the ring, oldest sample first
+ * @param samples Receives up to TELEMETRY_HISTORY samples
+ * @return Number of samples copied
+ */
+static size_t copyHistory(telemetry_sample_t *samples) {
+  portENTER_CRITICAL(&historyLock);
+  size_t count = historyCount;
+  size_t first = (historyHead + TELEMETRY_HISTORY - count) % TELEMETRY_HISTORY;
+  for (size_t i = 0; i < count; i++) {
+    samples[i] = history[(first + i) % TELEMETRY_HISTORY];
+  }
+  portEXIT_CRITICAL(&historyLock);
+  return count;
+}
+
+/**
+ * @brief Sampler task - one sample per TELEMETRY_INTERVAL_MS
+ * @param parameter Unused
+ *
+ * Sampling only reads counters the other modules already keep, so it stays
+ * cheap enough to leave running under full animation load.
+ */
+static void telemetryTaskFunction(void *parameter) {
+  TickType_t wakeTime = xTaskGetTickCount();
+
+  while (!telemetryStop) {
+    vTaskDelayUntil(&wakeTime, pdMS_TO_TICKS(TELEMETRY_INTERVAL_MS));
+
+    telemetry_sample_t sample;
+    takeSample(&sample);
+    pushHistory(&sample);
+
+    if (httpServer_webSocketClients() > 0) {
+      httpServer_broadcast((const uint8_t *)&sample, sizeof(sample));
+    }
+  }
+
+  telemetryTask = NULL;
+  vTaskDelete(NULL);
+}
+
+/**
+ * @brief Handle the /telemetry WebSocket
+ * Replays the ring once the handshake completes; frames from the client
+ * carry no commands and are discarded.
+ */
+static esp_err_t handleTelemetrySocket(httpd_req_t *req) {
+  if (req->method == HTTP_GET) {
+    size_t count = copyHistory(replay);
+    if (count == 0) {
+      return ESP_OK;
+    }
+    return httpServer_sendFrame(req, (const uint8_t *)replay, count * sizeof(telemetry_sample_t));
+  }
+
+  uint8_t frame[32];
+  return httpServer_receiveFrame(req, frame, sizeof(frame)) < 0 ? ESP_FAIL : ESP_OK;
+}
+
+//==============================================================================
+// PUBLIC API FUNCTIONS
+//==============================================================================
+
+bool telemetry_start() {
+  if (telemetryTask) {
+    return true;
+  }
+
+  resetBaseline();
+  telemetryStop = false;
+
+  TaskHandle_t task = NULL;
+  if (xTaskCreatePinnedToCore(telemetryTaskFunction, "Telemetry", TELEMETRY_STACK, NULL, TELEMETRY_PRIORITY, &task,
+                              TELEMETRY_CORE) != pdPASS) {
+    ESP_LOGE(TELEMETRY_LOG, "Failed to create telemetry task");
+    return false;
+  }
+  telemetryTask = task;
+  return true;
+}
+
+void telemetry_stop() {
+  if (!telemetryTask) {
+    return;
+  }
+
+  telemetryStop = true;
+  unsigned long startTime = millis();
+  while (telemetryTask && millis() - startTime < 2 * TELEMETRY_INTERVAL_MS) {
+    delay(10);
+  }
+  if (telemetryTask) {
+    ESP_LOGE(TELEMETRY_LOG, "Telemetry task did not stop");
+  }
+}
+
+bool telemetry_latest(telemetry_sample_t *sample) {
+  portENTER_CRITICAL(&historyLock);
+  bool available = historyCount > 0;
+  if (available) {
+    *sample = history[(historyHead + TELEMETRY_HISTORY - 1) % TELEMETRY_HISTORY];
+  }
+  portEXIT_CRITICAL(&historyLock);
+  return available;
+}
+
+void setupTelemetryEndpoints() {
+  httpServer_onWebSocket("/telemetry", handleTelemetrySocket);
+}
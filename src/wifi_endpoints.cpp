@@ -7,11 +7,14 @@
 #include "wifi_endpoints.h"
 #include "common.h"
 #include "flash_module.h"
+#include "http_module.h"
 #include "ota_module.h"
 #include "preferences_module.h"
 #include "states_module.h"
+#include "telemetry_module.h"
 #include "wifi_common.h"
 #include "wifi_module.h"
+#include <esp_rom_crc.h>
 
 //==============================================================================
 // CONSTANTS & DEFINITIONS
@@ -19,17 +22,75 @@
 
 static const char *WIFI_ENDPOINTS_LOG = "::WIFI_ENDPOINTS::";
 
+// Assets are not versioned by name, so browsers keep them but revalidate
+// on every load; an unchanged asset then costs a 304 instead of a download
+static const char *STATIC_CACHE_CONTROL = "no-cache";
+
+// Scan results younger than this are served without rescanning
+static const unsigned long SCAN_CACHE_TTL_MS = 30000;
+
+// How long a blocking scan waits for a background scan already running
+static const unsigned long SCAN_WAIT_MS = 10000;
+static const unsigned long SCAN_POLL_MS = 50;
+
+// How long /disconnect waits for the main loop to drop the network
+static const uint32_t DISCONNECT_WAIT_MS = 5000;
+
+#define STATIC_ETAG_SIZE 24
+#define STATIC_READ_BUFFER_SIZE 512
+#define STATIC_PATH_MAX 32
+#define CONNECT_FORM_MAX 256
+
 //==============================================================================
-// GLOBAL VARIABLES
+// TYPE DEFINITIONS
 //==============================================================================
 
-WebServer webServer(WEB_SERVER_PORT);
+typedef enum {
+  STATIC_VARIANT_PLAIN,
+  STATIC_VARIANT_GZIP,
+  STATIC_VARIANT_COUNT
+} static_variant_t;
+
+typedef struct {
+  const char *uri;
+  const char *path;
+  const char *contentType;
+  char etag[STATIC_VARIANT_COUNT][STATIC_ETAG_SIZE]; // Computed on first request
+} static_asset_t;
+
+//==============================================================================
+// GLOBAL VARIABLES
+//==============================================================================
 
 // Access Point configuration using common constants
 IPAddress AP_LOCAL_IP = getDefaultAPIP();
 IPAddress AP_GATEWAY = getDefaultAPGateway();
 IPAddress AP_NETWORK_MASK = getDefaultAPNetworkMask();
 
+// Web UI files; each may have a pre-compressed ".gz" sibling produced by
+// tools/gzip_web_assets.py
+static static_asset_t staticAssets[] = {
+    {"/", "/index.html", "text/html", {}},
+    {"/styles.css", "/styles.css", "text/css", {}},
+    {"/script.js", "/script.js", "application/javascript", {}},
+};
+
+// Last completed scan, as the JSON array sent in "networks". Shared by the
+// web server task and serial WIFI_SCAN, so only touched under the lock.
+static String scanCache = "[]";
+static int scanCacheCount = -1; // -1 until the first scan completes
+static unsigned long scanCacheTime = 0;
+static StaticSemaphore_t scanCacheMutexBuffer;
+static SemaphoreHandle_t scanCacheMutex = xSemaphoreCreateMutexStatic(&scanCacheMutexBuffer);
+
+/**
+ * @brief Holds the scan cache lock for the enclosing scope
+ */
+struct ScanCacheLock {
+  ScanCacheLock() { xSemaphoreTake(scanCacheMutex, portMAX_DELAY); }
+  ~ScanCacheLock() { xSemaphoreGive(scanCacheMutex); }
+};
+
 //==============================================================================
 // UTILITY FUNCTIONS
 //==============================================================================
@@ -72,35 +133,189 @@ String createJsonResponse(bool success, const String &ssid, int rssi,
   return response;
 }
 
+/**
+ * @brief Create the JSON response for a connect job
+ * Adds "job" and "state" to the common status fields
+ */
+static String createConnectJobResponse(const wifi_connect_job_t &job) {
+  bool connected = job.state == WIFI_JOB_CONNECTED;
+  String message;
+
+  switch (job.state) {
+  case WIFI_JOB_PENDING:
+    message = "Connecting to " + String(job.ssid) + " (attempt " + String(job.attempt) + ")";
+    break;
+  case WIFI_JOB_CONNECTED:
+    message = "Connected successfully";
+    break;
+  default:
+    if (job.reason) {
+      message = "Connection failed (" + String(getDisconnectReasonString(job.reason)) +
+                ") - please verify password";
+    } else {
+      message = "Connection timeout - please verify password";
+    }
+    break;
+  }
+
+  String response = createJsonResponse(job.state != WIFI_JOB_FAILED, job.ssid,
+                                       connected ? WiFi.RSSI() : 0, message, connected, "[]");
+
+  // Reopen the object to append the job fields
+  response.remove(response.length() - 1);
+  response += ",\"job\":";
+  response += job.id;
+  response += ",\"state\":\"";
+  response += getWiFiJobStateString(job.state);
+  response += "\"}";
+  return response;
+}
+
+/**
+ * @brief Store the results of a completed scan and release them
+ * @param networkCount Number of networks found
+ */
+static void cacheScanResults(int networkCount) {
+  String networks = "[";
+  for (int i = 0; i < networkCount; i++) {
+    if (i > 0)
+      networks += ",";
+    int rssi = WiFi.RSSI(i);
+    wifi_auth_mode_t encryptionType = WiFi.encryptionType(i);
+
+    networks += "{\"ssid\":\"";
+    networks += WiFi.SSID(i);
+    networks += "\",\"rssi\":";
+    networks += rssi;
+    networks += ",\"signal_strength\":\"";
+    networks += getNetworkSignalStrength(rssi);
+    networks += "\",\"encryption_type\":";
+    networks += encryptionType;
+    networks += ",\"is_open\":";
+    networks += (encryptionType == WIFI_AUTH_OPEN ? "true" : "false");
+    networks += ",\"security\":\"";
+    networks += getNetworkSecurityType(encryptionType);
+    networks += "\"}";
+  }
+  networks += "]";
+
+  scanCache = networks;
+  scanCacheCount = networkCount;
+  scanCacheTime = millis();
+  WiFi.scanDelete();
+}
+
+/**
+ * @brief Pick up the results of a finished background scan, if any
+ */
+static void collectScanResults() {
+  int16_t result = WiFi.scanComplete();
+  if (result >= 0) {
+    cacheScanResults(result);
+  }
+}
+
+/**
+ * @brief Check whether the cached scan results can be served as they are
+ */
+static bool isScanCacheFresh() {
+  return scanCacheCount >= 0 && millis() - scanCacheTime < SCAN_CACHE_TTL_MS;
+}
+
+/**
+ * @brief Create the JSON response for the cached scan results
+ */
+static String createScanResponse() {
+  String message = "Network scan complete, found " + String(scanCacheCount) + " networks.";
+  return createJsonResponse(true, "", 0, message, isWifiNetworkConnected(), scanCache);
+}
+
+/**
+ * @brief Compute a strong ETag from the size and CRC32 of a file
+ * @param file Open file, read from the start
+ * @param etag Receives the quoted ETag
+ */
+static void computeETag(File &file, char *etag) {
+  uint8_t buffer[STATIC_READ_BUFFER_SIZE];
+  uint32_t crc = 0;
+  size_t count;
+
+  while ((count = file.read(buffer, sizeof(buffer))) > 0) {
+    crc = esp_rom_crc32_le(crc, buffer, count);
+  }
+  file.seek(0);
+
+  snprintf(etag, STATIC_ETAG_SIZE, "\"%x-%08x\"", (unsigned)file.size(), (unsigned)crc);
+}
+
+/**
+ * @brief Serve a web UI file, preferring its gzip variant
+ * Answers 304 when the client already holds the current version
+ * @param req Request; user_ctx is the static asset table entry
+ */
+static esp_err_t serveStaticAsset(httpd_req_t *req) {
+  static_asset_t &asset = *(static_asset_t *)req->user_ctx;
+  char header[HTTP_HEADER_MAX];
+  char path[STATIC_PATH_MAX];
+  static_variant_t variant = STATIC_VARIANT_PLAIN;
+
+  snprintf(path, sizeof(path), "%s.gz", asset.path);
+  if (httpServer_header(req, "Accept-Encoding", header, sizeof(header)) && strstr(header, "gzip") &&
+      LittleFS.exists(path)) {
+    variant = STATIC_VARIANT_GZIP;
+  } else {
+    strlcpy(path, asset.path, sizeof(path));
+  }
+
+  File file = LittleFS.open(path, "r");
+  if (!file) {
+    ESP_LOGE(WIFI_ENDPOINTS_LOG, "Failed to open %s", path);
+    return httpServer_sendText(req, 500, "Failed to load configuration page");
+  }
+
+  char *etag = asset.etag[variant];
+  if (etag[0] == '\0') {
+    computeETag(file, etag);
+  }
+
+  httpd_resp_set_hdr(req, "ETag", etag);
+  httpd_resp_set_hdr(req, "Cache-Control", STATIC_CACHE_CONTROL);
+  httpd_resp_set_hdr(req, "Vary", "Accept-Encoding");
+
+  if (httpServer_header(req, "If-None-Match", header, sizeof(header)) && strstr(header, etag)) {
+    file.close();
+    return httpServer_send(req, 304, NULL, NULL, 0);
+  }
+
+  // sendFile adds Content-Encoding: gzip for ".gz" file names
+  esp_err_t result = httpServer_sendFile(req, file, asset.contentType);
+  file.close();
+  return result;
+}
+
 //==============================================================================
 // WEB SERVER SETUP FUNCTIONS
 //==============================================================================
 
 /**
- * @brief Set up the root endpoint for the configuration portal
+ * @brief Set up the root endpoint and the web UI files it references
  */
 void setupRootEndpoint() {
-  getWiFiWebServer().on("/", HTTP_GET, []() {
-    File file = LittleFS.open("/index.html", "r");
-    if (!file) {
-      String message = "Failed to load configuration page";
-      getWiFiWebServer().send(500, "text/plain", message);
-      return;
-    }
-
-    getWiFiWebServer().streamFile(file, "text/html");
-    file.close();
-  });
+  for (static_asset_t &asset : staticAssets) {
+    httpServer_on(asset.uri, HTTP_GET, serveStaticAsset, &asset);
+  }
 }
 
 /**
  * @brief Set up the restart endpoint
  */
 void setupRestartEndpoint() {
-  getWiFiWebServer().on("/restart", HTTP_POST, []() {
-    getWiFiWebServer().send(200, "text/plain", "Restarting...");
+  httpServer_on("/restart", HTTP_POST, [](httpd_req_t *req) {
+    httpServer_sendText(req, 200, "Restarting...");
+    flushPreferences();
     delay(1000);
     ESP.restart();
+    return ESP_OK;
   });
 }
 
@@ -114,25 +329,49 @@ void setupWebEndpoints() {
   setupConnectionStatusEndpoint();
   setupConnectEndpoint();
   setupDisconnectEndpoint();
+  // Unknown paths get a 404 from the HTTP module
+}
 
-  // Set up catch-all handler for 404
-  getWiFiWebServer().onNotFound(
-      []() { getWiFiWebServer().send(404, "text/plain", "Not found"); });
+/**
+ * @brief Set up the read-only endpoints served on the joined network
+ * Only the web UI, /status and telemetry; the portal's restart, connect,
+ * scan and update routes stay on the setup access point
+ */
+void setupStationEndpoints() {
+  setupRootEndpoint();
+  setupConnectionStatusEndpoint();
+  setupTelemetryEndpoints();
 }
 
 /**
  * @brief Set up the network scan endpoint
- * Returns JSON with available networks and their signal strengths
+ * Returns cached results (200) or starts a background scan and answers 202
+ * with the previous results until it completes; "?refresh=1" forces a rescan
  */
 void setupScanEndpoint() {
-  getWiFiWebServer().on("/scan", HTTP_GET, []() {
-    ESP_LOGI(WIFI_ENDPOINTS_LOG, "Network scan requested");
+  httpServer_on("/scan", HTTP_GET, [](httpd_req_t *req) {
+    char refresh[8];
+    bool forceScan = httpServer_queryArg(req, "refresh", refresh, sizeof(refresh));
 
-    String networks = scanWiFiNetworks();
-    String response =
-        createJsonResponse(true, "", 0, "Scan completed", false, networks);
+    ScanCacheLock lock;
+    collectScanResults();
+
+    if (isScanCacheFresh() && !forceScan) {
+      return httpServer_sendJson(req, 200, createScanResponse());
+    }
 
-    getWiFiWebServer().send(200, "application/json", response);
+    if (WiFi.scanComplete() != WIFI_SCAN_RUNNING) {
+      ESP_LOGI(WIFI_ENDPOINTS_LOG, "Network scan requested");
+      if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED) {
+        String response = createJsonResponse(false, "", 0, "Failed to scan networks, please try again.",
+                                             isWifiNetworkConnected(), scanCache);
+        return httpServer_sendJson(req, 500, response);
+      }
+    }
+
+    String response = createJsonResponse(true, "", 0, "Scanning for networks",
+                                         isWifiNetworkConnected(), scanCache);
+    return httpServer_sendJson(req, 202, response);
   });
 }
 
@@ -141,97 +380,55 @@ void setupScanEndpoint() {
  * Returns JSON with current connection information
  */
 void setupConnectionStatusEndpoint() {
-  getWiFiWebServer().on("/status", HTTP_GET, []() {
+  httpServer_on("/status", HTTP_GET, [](httpd_req_t *req) {
     String statusJson = getWiFiStatusJson();
-    getWiFiWebServer().send(200, "application/json", statusJson);
+    return httpServer_sendJson(req, 200, statusJson);
   });
 }
 
 /**
  * @brief Set up the connect endpoint
- * Handles POST requests to connect to a specific network
+ * Handles POST requests to connect to a specific network. Answers 202 with a
+ * job id at once; progress is polled from /connect/status?job=<id>
  */
 void setupConnectEndpoint() {
-  getWiFiWebServer().on("/connect", HTTP_POST, []() {
-    if (!getWiFiWebServer().hasArg("ssid") ||
-        !getWiFiWebServer().hasArg("password")) {
+  httpServer_on("/connect", HTTP_POST, [](httpd_req_t *req) {
+    // Oversized fields fail to fit and are rejected by the job's validation
+    char form[CONNECT_FORM_MAX];
+    char ssid[WIFI_SSID_MAX_LEN + 1];
+    char password[WIFI_PASSWORD_MAX_LEN + 1];
+    if (httpServer_readBody(req, form, sizeof(form)) < 0 ||
+        !httpServer_formArg(form, "ssid", ssid, sizeof(ssid)) ||
+        !httpServer_formArg(form, "password", password, sizeof(password))) {
       String response = createJsonResponse(
           false, "", 0, "Missing SSID or password", false, "[]");
-      getWiFiWebServer().send(400, "application/json", response);
-      return;
-    }
-
-    String ssid = getWiFiWebServer().arg("ssid");
-    String password = getWiFiWebServer().arg("password");
-
-    ESP_LOGI(WIFI_ENDPOINTS_LOG, "Connection attempt to: %s", ssid.c_str());
-
-    // Use the new connectToWiFi function with parameters (includes validation)
-    bool connectionInitiated = connectToWiFi(ssid.c_str(), password.c_str());
-
-    if (!connectionInitiated) {
-      // Check if we're already connected to the requested network
-      if (isWifiNetworkConnected() && WiFi.SSID().equals(ssid)) {
-        ESP_LOGI(WIFI_ENDPOINTS_LOG, "Already connected to requested network");
-
-        // Save credentials since we're connected to this network
-        if (saveWiFiCredentials(ssid.c_str(), password.c_str())) {
-          ESP_LOGI(WIFI_ENDPOINTS_LOG, "Credentials saved successfully");
-        }
-
-        String response = createJsonResponse(true, ssid, WiFi.RSSI(),
-                                             "Already connected", true, "[]");
-        getWiFiWebServer().send(200, "application/json", response);
-        return;
-      } else {
-        // Connection failed due to validation or other error
-        ESP_LOGE(WIFI_ENDPOINTS_LOG,
-                 "Connection failed - validation error or invalid parameters");
-        String response = createJsonResponse(
-            false, ssid, 0, "Invalid credentials format or connection failed",
-            false, "[]");
-        getWiFiWebServer().send(400, "application/json", response);
-        return;
-      }
+      return httpServer_sendJson(req, 400, response);
     }
 
-    // Connection attempt initiated - wait for result with timeout
-    ESP_LOGI(WIFI_ENDPOINTS_LOG,
-             "Connection attempt initiated, waiting for result...");
-
-    unsigned long startTime = millis();
-    const unsigned long TIMEOUT_MS = 15000; // 15 seconds timeout
-
-    while (millis() - startTime < TIMEOUT_MS) {
-      delay(500);
+    ESP_LOGI(WIFI_ENDPOINTS_LOG, "Connection attempt to: %s", ssid);
 
-      if (isWifiNetworkConnected()) {
-        ESP_LOGI(WIFI_ENDPOINTS_LOG, "Connection successful");
-
-        // Save credentials on successful connection
-        if (saveWiFiCredentials(ssid.c_str(), password.c_str())) {
-          ESP_LOGI(WIFI_ENDPOINTS_LOG, "Credentials saved successfully");
-        } else {
-          ESP_LOGW(WIFI_ENDPOINTS_LOG,
-                   "Failed to save credentials, but connection successful");
-        }
+    wifi_connect_job_t job;
+    uint32_t jobId = startWiFiConnectJob(ssid, password);
+    if (jobId == 0 || !getWiFiConnectJob(jobId, &job)) {
+      String response = createJsonResponse(
+          false, ssid, 0, "Invalid credentials format", false, "[]");
+      return httpServer_sendJson(req, 400, response);
+    }
 
-        String response = createJsonResponse(
-            true, ssid, WiFi.RSSI(), "Connected successfully", true, "[]");
-        getWiFiWebServer().send(200, "application/json", response);
-        return;
-      }
+    return httpServer_sendJson(req, 202, createConnectJobResponse(job));
+  });
 
-      // Continue connection attempt
-      connectToWiFi(ssid.c_str(), password.c_str());
+  httpServer_on("/connect/status", HTTP_GET, [](httpd_req_t *req) {
+    char jobArg[12];
+    wifi_connect_job_t job;
+    uint32_t jobId = httpServer_queryArg(req, "job", jobArg, sizeof(jobArg)) ? strtoul(jobArg, NULL, 10) : 0;
+    if (!getWiFiConnectJob(jobId, &job)) {
+      String response =
+          createJsonResponse(false, "", 0, "Unknown connect job", false, "[]");
+      return httpServer_sendJson(req, 404, response);
     }
 
-    // Timeout reached without successful connection
-    ESP_LOGE(WIFI_ENDPOINTS_LOG, "Connection timeout reached");
-    String response = createJsonResponse(
-        false, ssid, 0, "Connection timeout - please verify password", false,
-        "[]");
-    getWiFiWebServer().send(500, "application/json", response);
+    return httpServer_sendJson(req, 200, createConnectJobResponse(job));
   });
 }
 
@@ -240,27 +437,24 @@ void setupConnectEndpoint() {
  * Handles POST requests to disconnect from current network
  */
 void setupDisconnectEndpoint() {
-  getWiFiWebServer().on("/disconnect", HTTP_POST, []() {
+  httpServer_on("/disconnect", HTTP_POST, [](httpd_req_t *req) {
     ESP_LOGI(WIFI_ENDPOINTS_LOG, "Disconnect requested");
 
     String currentSSID = WiFi.SSID();
     bool wasConnected = isWifiNetworkConnected();
 
-    // Disconnect from WiFi
-    disconnectFromWiFi();
-
-    // Check if disconnection was successful
-    bool isNowDisconnected = !isWifiNetworkConnected();
+    // The main loop owns the radio; wait for it to disconnect
+    bool isNowDisconnected = requestWiFiDisconnect(DISCONNECT_WAIT_MS) && !isWifiNetworkConnected();
 
     if (isNowDisconnected) {
       String message = wasConnected ? "Disconnected from " + currentSSID
                                     : "WiFi was already disconnected";
       String response = createJsonResponse(true, "", 0, message, false, "[]");
-      getWiFiWebServer().send(200, "application/json", response);
+      return httpServer_sendJson(req, 200, response);
     } else {
       String response =
           createJsonResponse(false, "", 0, "Disconnect failed", false, "[]");
-      getWiFiWebServer().send(500, "application/json", response);
+      return httpServer_sendJson(req, 500, response);
     }
   });
 }
@@ -278,8 +472,11 @@ bool initWiFiEndpoints() {
   // Set up all endpoints
   setupWebEndpoints();
 
-  // Start the web server
-  getWiFiWebServer().begin();
+  // Start the web server task
+  if (!httpServer_start(WEB_SERVER_PORT)) {
+    ESP_LOGE(WIFI_ENDPOINTS_LOG, "Failed to start web server");
+    return false;
+  }
 
   ESP_LOGI(WIFI_ENDPOINTS_LOG, "WiFi endpoints initialized successfully");
   return true;
@@ -290,7 +487,48 @@ bool initWiFiEndpoints() {
  */
 void stopWiFiEndpoints() {
   ESP_LOGI(WIFI_ENDPOINTS_LOG, "Stopping WiFi endpoints");
-  getWiFiWebServer().close();
+  httpServer_stop();
+}
+
+/**
+ * @brief Start the web server on the station interface with live telemetry
+ * WiFi mode keeps animating, so this is where the samples carry frame rate
+ * and effect cost; the portal in update mode does not render.
+ */
+bool initStationEndpoints() {
+  ESP_LOGI(WIFI_ENDPOINTS_LOG, "Initializing station endpoints");
+
+  setupStationEndpoints();
+
+  if (!httpServer_start(WEB_SERVER_PORT)) {
+    ESP_LOGE(WIFI_ENDPOINTS_LOG, "Failed to start web server");
+    return false;
+  }
+
+  // Telemetry is best effort; the page works without it
+  if (!telemetry_start()) {
+    ESP_LOGW(WIFI_ENDPOINTS_LOG, "Telemetry stream unavailable");
+  }
+  return true;
+}
+
+/**
+ * @brief Stop the telemetry sampler and the station web server
+ */
+void stopStationEndpoints() {
+  telemetry_stop();
+  stopWiFiEndpoints();
+}
+
+/**
+ * @brief Forget the cached ETags of the web UI files
+ */
+void invalidateStaticAssetCache() {
+  for (static_asset_t &asset : staticAssets) {
+    for (int variant = 0; variant < STATIC_VARIANT_COUNT; variant++) {
+      asset.etag[variant][0] = '\0';
+    }
+  }
 }
 
 //==============================================================================
@@ -299,46 +537,37 @@ void stopWiFiEndpoints() {
 
 /**
  * @brief Scan for available WiFi networks and return JSON response
+ * Reuses results younger than SCAN_CACHE_TTL_MS; otherwise blocks for a scan
  */
 String scanWiFiNetworks() {
+  {
+    ScanCacheLock lock;
+    collectScanResults();
+    if (isScanCacheFresh()) {
+      return createScanResponse();
+    }
+  }
 
-  int networkCount = WiFi.scanNetworks(false);
-  bool scanSuccess = networkCount >= 0;
+  // A second scan cannot start while the one from /scan runs; wait for it
+  // (without the lock, so /scan keeps answering) and use its results
+  unsigned long waitStart = millis();
+  while (WiFi.scanComplete() == WIFI_SCAN_RUNNING && millis() - waitStart < SCAN_WAIT_MS) {
+    delay(SCAN_POLL_MS);
+  }
 
-  String message = scanSuccess ? "Network scan complete, found " +
-                                     String(networkCount) + " networks."
-                               : "Failed to scan networks, please try again.";
+  ScanCacheLock lock;
+  collectScanResults();
 
-  String networks = "[";
-  if (scanSuccess) {
-    for (int i = 0; i < networkCount; i++) {
-      if (i > 0)
-        networks += ",";
-      int rssi = WiFi.RSSI(i);
-      wifi_auth_mode_t encryptionType = WiFi.encryptionType(i);
-
-      networks += "{\"ssid\":\"";
-      networks += WiFi.SSID(i);
-      networks += "\",\"rssi\":";
-      networks += rssi;
-      networks += ",\"signal_strength\":\"";
-      networks += getNetworkSignalStrength(rssi);
-      networks += "\",\"encryption_type\":";
-      networks += encryptionType;
-      networks += ",\"is_open\":";
-      networks += (encryptionType == WIFI_AUTH_OPEN ? "true" : "false");
-      networks += ",\"security\":\"";
-      networks += getNetworkSecurityType(encryptionType);
-      networks += "\"}";
+  if (!isScanCacheFresh()) {
+    int networkCount = WiFi.scanNetworks(false);
+    if (networkCount < 0) {
+      return createJsonResponse(false, "", 0, "Failed to scan networks, please try again.",
+                                isWifiNetworkConnected(), "[]");
     }
+    cacheScanResults(networkCount);
   }
-  networks += "]";
 
-  String jsonResponse = createJsonResponse(scanSuccess, "", 0, message,
-                                           isWifiNetworkConnected(), networks);
-
-  WiFi.scanDelete();
-  return jsonResponse;
+  return createScanResponse();
 }
 
 /**
@@ -371,12 +600,3 @@ String getWiFiStatusJson() {
   return createJsonResponse(success, currentSSID, rssi, message, isConnected,
                             "[]");
 }
-
-//==============================================================================
-// WEB SERVER INTEGRATION
-//==============================================================================
-
-/**
- * @brief Get the web server instance for endpoint integration
- */
-WebServer &getWiFiWebServer() { return webServer; }
@@ -80,6 +80,26 @@ static const char* AP_PASSWORD = "12345678";
 // Connection management
 static const int MAX_CONNECTION_ATTEMPTS = 3;
 static const unsigned long CONNECTION_TIMEOUT = 30000; // 30 seconds
+static const unsigned long CONNECT_JOB_TIMEOUT = 15000; // 15 seconds
+
+//==============================================================================
+// TYPE DEFINITIONS
+//==============================================================================
+
+// Connect job shared between the web server task, the WiFi event task and
+// the main loop; only touched under connectJobMutex
+typedef struct {
+    uint32_t id;
+    wifi_job_state_t state;
+    bool startPending;       // Posted, loop should start the attempt
+    bool retryPending;       // Disconnected, loop should retry or give up
+    bool credentialsPending; // Connected, loop should save credentials
+    uint8_t reason;
+    uint8_t attempt;
+    unsigned long startTime;
+    char ssid[WIFI_SSID_MAX_LEN];
+    char password[WIFI_PASSWORD_MAX_LEN];
+} connect_job_session_t;
 
 //==============================================================================
 // GLOBAL VARIABLES
@@ -93,6 +113,24 @@ char wifi_password[WIFI_PASSWORD_MAX_LEN] = "";
 static int connectionAttempts = 0;
 static unsigned long connectionStartTime = 0;
 static bool connectionInProgress = false;
+
+static connect_job_session_t connectJob = {};
+static uint32_t nextConnectJobId = 1;
+static StaticSemaphore_t connectJobMutexBuffer;
+static SemaphoreHandle_t connectJobMutex = xSemaphoreCreateMutexStatic(&connectJobMutexBuffer);
+
+// Disconnect posted by the web server task, done on the main loop
+static volatile bool disconnectRequested = false;
+static StaticSemaphore_t disconnectDoneBuffer;
+static SemaphoreHandle_t disconnectDone = xSemaphoreCreateBinaryStatic(&disconnectDoneBuffer);
+
+/**
+ * @brief Holds the connect job lock for the enclosing scope
+ */
+struct ConnectJobLock {
+    ConnectJobLock() { xSemaphoreTake(connectJobMutex, portMAX_DELAY); }
+    ~ConnectJobLock() { xSemaphoreGive(connectJobMutex); }
+};
  
 //==============================================================================
 // UTILITY FUNCTIONS
@@ -218,6 +256,13 @@ void onWiFiStationDisconnected(WiFiEvent_t event, WiFiEventInfo_t info) {
 
     wifiNetworkConnected = false;
     connectionInProgress = false;
+
+    // Our own disconnects (superseded attempts) leave with ASSOC_LEAVE
+    ConnectJobLock lock;
+    if (connectJob.state == WIFI_JOB_PENDING && reason != WIFI_REASON_ASSOC_LEAVE) {
+        connectJob.reason = reason;
+        connectJob.retryPending = true;
+    }
     // Don't auto-reconnect - let state machine handle reconnection logic
 }
 
@@ -239,6 +284,12 @@ void onWiFiStationGotIP(WiFiEvent_t event, WiFiEventInfo_t info) {
     wifiNetworkConnected = true;
     connectionInProgress = false;
     connectionAttempts = 0;
+
+    ConnectJobLock lock;
+    if (connectJob.state == WIFI_JOB_PENDING) {
+        connectJob.state = WIFI_JOB_CONNECTED;
+        connectJob.credentialsPending = true;
+    }
 }
 
 /**
@@ -265,6 +316,120 @@ void onWiFiAPStopped(WiFiEvent_t event, WiFiEventInfo_t info) {
     wifiDebug("Access Point stopped");
  }
  
+//==============================================================================
+// CONNECT JOB FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Marks the connect job as failed; call with the lock held
+ */
+static void failConnectJob() {
+    ESP_LOGW(TAG, "Connect job %u to %s failed after %u attempt(s): %s",
+             (unsigned)connectJob.id, connectJob.ssid, connectJob.attempt,
+             connectJob.reason ? getDisconnectReasonString(connectJob.reason) : "timeout");
+    connectJob.state = WIFI_JOB_FAILED;
+}
+
+/**
+ * @brief Starts the attempt for a posted connect job from the main loop
+ * @param id Job id the credentials were copied from
+ * @param ssid WiFi network SSID
+ * @param password WiFi network password
+ */
+static void beginConnectJob(uint32_t id, const char* ssid, const char* password) {
+    if (isWifiNetworkConnected() && WiFi.SSID().equals(ssid)) {
+        wifiDebug("Connect job %u - already connected", (unsigned)id);
+        ConnectJobLock lock;
+        if (connectJob.id == id) {
+            connectJob.state = WIFI_JOB_CONNECTED;
+            connectJob.credentialsPending = true;
+        }
+        return;
+    }
+
+    // The new job supersedes whatever attempt is under way
+    disconnectFromWiFi();
+
+    {
+        ConnectJobLock lock;
+        if (connectJob.id != id) {
+            return; // Superseded meanwhile; the next pass starts the new one
+        }
+        connectJob.state = WIFI_JOB_PENDING;
+        connectJob.startTime = millis();
+    }
+
+    wifiDebug("Connect job %u - connecting to %s", (unsigned)id, ssid);
+    connectToWiFi(ssid, password);
+}
+
+/**
+ * @brief Advances the connect job from the main loop
+ * 
+ * Performs posted disconnects, starts posted jobs, saves the credentials
+ * once the event handlers report a connection, retries after a disconnect
+ * and gives up after MAX_CONNECTION_ATTEMPTS or CONNECT_JOB_TIMEOUT. All
+ * WiFi calls happen here, on a copy of the job taken under the lock.
+ * Never blocks.
+ */
+static void serviceWiFiConnectJob() {
+    if (disconnectRequested) {
+        disconnectRequested = false;
+        disconnectFromWiFi();
+        xSemaphoreGive(disconnectDone);
+    }
+
+    char ssid[WIFI_SSID_MAX_LEN];
+    char password[WIFI_PASSWORD_MAX_LEN];
+    uint32_t id;
+    bool start, save, retry = false, fail = false;
+    {
+        ConnectJobLock lock;
+        id = connectJob.id;
+        strcpy(ssid, connectJob.ssid);
+        strcpy(password, connectJob.password);
+        start = connectJob.startPending;
+        save = connectJob.credentialsPending;
+        connectJob.startPending = false;
+        connectJob.credentialsPending = false;
+
+        if (!start && connectJob.state == WIFI_JOB_PENDING) {
+            if (millis() - connectJob.startTime > CONNECT_JOB_TIMEOUT) {
+                fail = true;
+            } else if (connectJob.retryPending) {
+                connectJob.retryPending = false;
+                if (connectJob.attempt >= MAX_CONNECTION_ATTEMPTS) {
+                    fail = true;
+                } else {
+                    connectJob.attempt++;
+                    retry = true;
+                    wifiDebug("Connect job %u - retrying (attempt %u/%d)",
+                              (unsigned)id, connectJob.attempt, MAX_CONNECTION_ATTEMPTS);
+                }
+            }
+            if (fail) {
+                failConnectJob();
+            }
+        }
+    }
+
+    if (save) {
+        if (saveWiFiCredentials(ssid, password)) {
+            wifiDebug("Credentials saved for %s", ssid);
+        } else {
+            ESP_LOGW(TAG, "Failed to save credentials, but connection successful");
+        }
+    }
+
+    if (start) {
+        beginConnectJob(id, ssid, password);
+    } else if (fail) {
+        disconnectFromWiFi();
+    } else if (retry) {
+        connectToWiFi(ssid, password);
+    }
+}
+
 //==============================================================================
 // PUBLIC API FUNCTIONS
 //==============================================================================
@@ -341,10 +506,10 @@ void enableESPNowWiFi() {
     delay(500);
     WiFi.disconnect(false);
 
-    esp_wifi_set_channel(1, WIFI_SECOND_CHAN_NONE);
+    esp_wifi_set_channel(ESPNOW_CHANNEL, WIFI_SECOND_CHAN_NONE);
     delay(100);
 
-    wifiDebug("WiFi channel set to 1 for ESP-NOW");
+    wifiDebug("WiFi channel set to %d for ESP-NOW", ESPNOW_CHANNEL);
 
     if (!initializeESPNOW()) {
         ESP_LOGE(TAG, "Failed to initialize ESP-NOW");
@@ -361,7 +526,7 @@ void enableESPNowWiFi() {
     esp_wifi_get_channel(&primary, &second);
     
     wifiDebug("Verified WiFi channel: %d", primary);
-    wifiDebug("WiFi hardware enabled for ESP-NOW on channel 1");
+    wifiDebug("WiFi hardware enabled for ESP-NOW on channel %d", ESPNOW_CHANNEL);
     wifiDebug("MAC Address: %s", WiFi.macAddress().c_str());
 }
 
@@ -516,6 +681,86 @@ void disconnectFromWiFi() {
     connectionAttempts = 0;
 }
 
+/**
+ * @brief Posts a disconnect to the main loop and waits for it
+ * @param timeoutMs How long to wait
+ * @return false if the main loop did not get to it in time
+ */
+bool requestWiFiDisconnect(uint32_t timeoutMs) {
+    xSemaphoreTake(disconnectDone, 0); // Drop a completion nobody waited for
+    disconnectRequested = true;
+    return xSemaphoreTake(disconnectDone, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+/**
+ * @brief Posts a background connection attempt
+ * @param ssid WiFi network SSID
+ * @param password WiFi network password
+ * @return Job id, or 0 if the credentials are invalid
+ * 
+ * Returns immediately; the main loop starts the attempt and progress is
+ * reported through getWiFiConnectJob().
+ */
+uint32_t startWiFiConnectJob(const char* ssid, const char* password) {
+    if (!ssid || ssid[0] == '\0' || strlen(ssid) >= WIFI_SSID_MAX_LEN ||
+        !password || strlen(password) >= WIFI_PASSWORD_MAX_LEN) {
+        ESP_LOGE(TAG, "Invalid credentials - connect job rejected");
+        return 0;
+    }
+
+    ConnectJobLock lock;
+    // Parked until the main loop starts it, so events for the old one are ignored
+    connectJob.state = WIFI_JOB_NONE;
+    connectJob.id = nextConnectJobId++;
+    strcpy(connectJob.ssid, ssid);
+    strcpy(connectJob.password, password);
+    connectJob.startPending = true;
+    connectJob.retryPending = false;
+    connectJob.credentialsPending = false;
+    connectJob.reason = 0;
+    connectJob.attempt = 1;
+    connectJob.startTime = millis();
+
+    wifiDebug("Connect job %u - queued for %s", (unsigned)connectJob.id, ssid);
+    return connectJob.id;
+}
+
+/**
+ * @brief Gets the progress of a connect job
+ * @param id Job id
+ * @param job Receives the job snapshot
+ * @return false if the id is unknown or superseded
+ */
+bool getWiFiConnectJob(uint32_t id, wifi_connect_job_t* job) {
+    ConnectJobLock lock;
+    if (id == 0 || id != connectJob.id) {
+        return false;
+    }
+
+    job->id = connectJob.id;
+    // A posted job counts as pending until the main loop starts it
+    job->state = connectJob.startPending ? WIFI_JOB_PENDING : connectJob.state;
+    strcpy(job->ssid, connectJob.ssid);
+    job->attempt = connectJob.attempt;
+    job->reason = connectJob.reason;
+    job->elapsed = millis() - connectJob.startTime;
+    return true;
+}
+
+/**
+ * @brief Converts a connect job state to a string
+ * @param state Job state
+ * @return State name used by the web portal
+ */
+const char* getWiFiJobStateString(wifi_job_state_t state) {
+    switch (state) {
+        case WIFI_JOB_PENDING: return "pending";
+        case WIFI_JOB_CONNECTED: return "connected";
+        case WIFI_JOB_FAILED: return "failed";
+        default: return "none";
+    }
+}
+
 static void setupUpdateModeServices() {
     if (!getFSStatus()) {
         ESP_LOGE(TAG, "Failed to initialize file system for update mode");
@@ -534,6 +779,32 @@ static void setupUpdateModeServices() {
     }
 }
 
+/**
+ * @brief Starts the web interface on the station interface
+ * 
+ * Serves the web UI, connection status and the live telemetry stream to
+ * clients on the joined network. The routes that change the device
+ * (restart, connect, scan, update) are only served on the setup AP.
+ */
+void startStationWebServer() {
+    if (!getFSStatus()) {
+        ESP_LOGE(TAG, "Failed to initialize file system for the station web server");
+        return;
+    }
+
+    if (!initStationEndpoints()) {
+        ESP_LOGE(TAG, "Failed to start the station web server");
+    }
+}
+
+/**
+ * @brief Stops the web interface started by startStationWebServer()
+ */
+void stopStationWebServer() {
+    wifiDebug("Stopping station web server");
+    stopStationEndpoints();
+}
+
 /**
  * @brief Starts WiFi Access Point mode
  * 
@@ -606,6 +877,7 @@ void stopWiFiAP(bool restart) {
     delay(100);
     if (restart) {
         wifiDebug("Restarting device after stopping WiFi Access Point");
+        flushPreferences();
         ESP.restart();
      } else {
         WiFi.mode(WIFI_MODE_STA);
@@ -644,14 +916,16 @@ bool isWifiNetworkConnected() {
 }
 
 /**
- * @brief Handles web server requests and responses
+ * @brief Services the main-loop side of the web interface
  * 
- * Processes incoming web server requests for device configuration
- * and firmware updates. Manages client connections and request routing.
+ * Requests are answered by the HTTP server task; this advances the
+ * background connect job, restarts after a successful update and
+ * tracks connected clients.
  */
 void handleWebServer() {
 
-    getWiFiWebServer().handleClient();
+    serviceWiFiConnectJob();
+    handleOTA();
     // Check connected clients every 30 seconds
     static unsigned long lastClientCheck = 0;
     static int lastClientCount = -1; // Track previous count to detect changes
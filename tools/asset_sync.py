@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""
+BYTE-90 asset sync (Linux host)
+
+Pushes only the LittleFS files that differ from a local asset tree (by
+default data/) instead of flashing a whole filesystem image. The device
+compares a manifest of "size,sha256,path" entries against its own files and
+each changed file is written to a temporary file, hash-checked and renamed
+into place (src/asset_module.cpp).
+
+Transports:
+    --http URL      POST /assets/diff, then /assets/upload per file
+                    (device in Update Mode, e.g. http://192.168.4.1)
+    --serial PORT   ASSET_CHECK per file, then START_ASSET over the binary
+                    framed protocol shared with serial_update.py
+
+Usage:
+    tools/asset_sync.py --serial /dev/ttyACM0
+    tools/asset_sync.py --http http://192.168.4.1 --root data
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import sys
+import urllib.error
+import urllib.parse
+import urllib.request
+
+import gzip_web_assets
+import serial_update as su
+
+PATH_MAX = 64
+MULTIPART_BOUNDARY = "byte90-asset-boundary"
+
+
+class SyncError(Exception):
+    pass
+
+
+class Entry:
+    """One manifest entry."""
+
+    def __init__(self, path, data):
+        self.path = path
+        self.data = data
+        self.size = len(data)
+        self.digest = hashlib.sha256(data).hexdigest()
+
+    def spec(self):
+        return "%d,%s,%s" % (self.size, self.digest, self.path)
+
+
+def build_manifest(root):
+    """Collect every file under root as device paths ("/gifs/rest.gif")."""
+    entries = []
+    for directory, dirs, files in os.walk(root):
+        dirs[:] = sorted(name for name in dirs if not name.startswith("."))
+        for name in sorted(files):
+            if name.startswith("."):
+                continue
+            local = os.path.join(directory, name)
+            path = "/" + os.path.relpath(local, root).replace(os.sep, "/")
+            if len(path) > PATH_MAX or "," in path or '"' in path:
+                raise SyncError("Unsupported asset path: %s" % path)
+            with open(local, "rb") as handle:
+                entries.append(Entry(path, handle.read()))
+    return entries
+
+
+class HttpDevice:
+    """Asset endpoints of the Update Mode web server."""
+
+    def __init__(self, base_url, timeout=30.0):
+        self.base_url = base_url.rstrip("/")
+        self.timeout = timeout
+
+    def post(self, path, body, content_type):
+        request = urllib.request.Request(self.base_url + path, data=body, method="POST",
+                                         headers={"Content-Type": content_type})
+        try:
+            with urllib.request.urlopen(request, timeout=self.timeout) as response:
+                return json.loads(response.read())
+        except urllib.error.HTTPError as error:
+            raise SyncError(json.loads(error.read()).get("message", str(error)))
+
+    def changed(self, entries):
+        manifest = "".join(entry.spec() + "\n" for entry in entries).encode()
+        return set(self.post("/assets/diff", manifest, "text/plain")["changed"])
+
+    def put(self, entry):
+        body = b"".join([
+            ("--%s\r\n" % MULTIPART_BOUNDARY).encode(),
+            ('Content-Disposition: form-data; name="file"; filename="%s"\r\n'
+             % entry.path.rsplit("/", 1)[-1]).encode(),
+            b"Content-Type: application/octet-stream\r\n\r\n",
+            entry.data,
+            ("\r\n--%s--\r\n" % MULTIPART_BOUNDARY).encode(),
+        ])
+        query = urllib.parse.urlencode({"entry": entry.spec()})
+        result = self.post("/assets/upload?" + query, body,
+                           "multipart/form-data; boundary=" + MULTIPART_BOUNDARY)
+        if not result.get("success"):
+            raise SyncError(result.get("message", "Upload failed"))
+
+
+class SerialDevice:
+    """ASSET_CHECK / START_ASSET over the serial command link."""
+
+    def __init__(self, fd):
+        self.fd = fd
+        self.reader = su.LineReader(fd)
+
+    def changed(self, entries):
+        paths = set()
+        for entry in entries:
+            if su.send_command(self.fd, self.reader, "ASSET_CHECK:" + entry.spec()).get("changed"):
+                paths.add(entry.path)
+        return paths
+
+    def put(self, entry):
+        su.send_binary(self.fd, self.reader, "START_ASSET:" + entry.spec(), entry.data)
+
+
+def sync(device, entries, dry_run=False, log=print):
+    """Send the entries the device reports as changed; return their paths."""
+    changed = device.changed(entries)
+    sent = []
+    for entry in entries:
+        if entry.path not in changed:
+            continue
+        log("%s %s (%d bytes)" % ("would send" if dry_run else "sending", entry.path, entry.size))
+        if not dry_run:
+            device.put(entry)
+        sent.append(entry.path)
+    return sent
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BYTE-90 asset sync")
+    target = parser.add_mutually_exclusive_group(required=True)
+    target.add_argument("--http", metavar="URL", help="device base URL, e.g. http://192.168.4.1")
+    target.add_argument("--serial", metavar="PORT", help="serial device, e.g. /dev/ttyACM0")
+    parser.add_argument("--root", default="data", help="local asset tree (default: data)")
+    parser.add_argument("--dry-run", action="store_true", help="only list the files that differ")
+    parser.add_argument("--baud", type=int, default=su.DEFAULT_BAUD)
+    args = parser.parse_args()
+
+    # Keep the served .gz variants in step with the files they compress
+    gzip_web_assets.compress_assets(args.root)
+    entries = build_manifest(args.root)
+    fd = None
+    try:
+        if args.http:
+            device = HttpDevice(args.http)
+        else:
+            fd = su.open_port(args.serial, args.baud)
+            device = SerialDevice(fd)
+        sent = sync(device, entries, args.dry_run)
+    except (SyncError, su.UpdateError, OSError) as error:
+        print("Sync failed: %s" % error)
+        return 1
+    finally:
+        if fd is not None:
+            os.close(fd)
+
+    print("%d of %d files %s" % (len(sent), len(entries), "differ" if args.dry_run else "updated"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""
+Pre-compress the web UI for LittleFS
+
+Writes index.html.gz, script.js.gz and styles.css.gz next to the originals
+in data/. The web server sends the .gz variant with Content-Encoding: gzip
+when it exists (src/wifi_endpoints.cpp). Output is deterministic (no
+timestamp or file name in the gzip header), so an unchanged asset keeps
+the same bytes and the same ETag.
+
+Runs automatically before the filesystem image is built (extra_scripts in
+platformio.ini), or by hand:
+    tools/gzip_web_assets.py [data]
+"""
+
+import gzip
+import os
+import sys
+
+WEB_ASSETS = ("index.html", "script.js", "styles.css")
+
+
+def compress_assets(root):
+    """(Re)write the .gz variants that are missing or out of date; return their paths."""
+    written = []
+    for name in WEB_ASSETS:
+        source = os.path.join(root, name)
+        target = source + ".gz"
+        if not os.path.exists(source):
+            continue
+        with open(source, "rb") as handle:
+            data = gzip.compress(handle.read(), 9, mtime=0)
+        if os.path.exists(target):
+            with open(target, "rb") as handle:
+                if handle.read() == data:
+                    continue
+        with open(target, "wb") as handle:
+            handle.write(data)
+        written.append(target)
+    return written
+
+
+def main():
+    root = sys.argv[1] if len(sys.argv) > 1 else "data"
+    for path in compress_assets(root):
+        print("Compressed %s (%d bytes)" % (path, os.path.getsize(path)))
+    return 0
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO (SCons)
+except NameError:
+    env = None
+
+if env is not None:
+    def before_buildfs(source, target, env):
+        for path in compress_assets(env.subst("$PROJECT_DATA_DIR")):
+            print("Compressed %s" % path)
+
+    env.AddPreAction("$BUILD_DIR/littlefs.bin", before_buildfs)
+elif __name__ == "__main__":
+    sys.exit(main())
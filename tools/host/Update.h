@@ -0,0 +1,54 @@
+/**
+ * @file Update.h
+ * @brief Host stand-in for the Arduino Update class, collecting the image in memory
+ */
+
+#ifndef UPDATE_H
+#define UPDATE_H
+
+#include "common.h"
+#include <vector>
+
+#define U_FLASH 0
+
+class UpdateClass {
+public:
+  bool begin(size_t size, int command) {
+    (void)command;
+    running = true;
+    expected = size;
+    image.clear();
+    return true;
+  }
+
+  size_t write(uint8_t *data, size_t length) {
+    // Like the real class, refuse to write past the announced size
+    if (!running || image.size() + length > expected) {
+      return 0;
+    }
+    image.insert(image.end(), data, data + length);
+    return length;
+  }
+
+  bool end(bool evenIfRemaining) {
+    (void)evenIfRemaining;
+    running = false;
+    finished = true;
+    return true;
+  }
+
+  void abort() { running = false; }
+  bool isRunning() { return running; }
+  const char *errorString() { return "Update error"; }
+
+  std::vector<uint8_t> image;
+  bool finished = false;
+
+private:
+  bool running = false;
+  size_t expected = 0;
+};
+
+extern UpdateClass Update;
+
+#endif /* UPDATE_H */
@@ -0,0 +1,28 @@
+/**
+ * @file common.h
+ * @brief Host stand-in for the firmware's common.h
+ *
+ * Only what the modules built by the host tests use; see tools/test_delta_module.py.
+ */
+
+#ifndef COMMON_H
+#define COMMON_H
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+using std::max;
+using std::min;
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+#define ESP_LOGE(tag, format, ...) fprintf(stderr, "E %s " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) fprintf(stderr, "W %s " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) fprintf(stderr, "I %s " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ((void)0)
+
+#endif /* COMMON_H */
@@ -0,0 +1,67 @@
+/**
+ * @file delta_host.cpp
+ * @brief Runs src/delta_module.cpp on the host for tools/test_delta_module.py
+ *
+ * Usage: delta_host old.bin patch.bin out.bin chunk_size
+ * Feeds the patch in chunk_size pieces, writes the rebuilt image to out.bin
+ * on success and prints "OK" or the applier's error string.
+ */
+
+#include "delta_module.h"
+#include <vector>
+
+esp_partition_t hostRunningPartition = {0, NULL};
+UpdateClass Update;
+
+static bool readFile(const char *path, std::vector<uint8_t> *contents) {
+  FILE *file = fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  uint8_t buffer[4096];
+  size_t count;
+  while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    contents->insert(contents->end(), buffer, buffer + count);
+  }
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  std::vector<uint8_t> old, patch;
+  if (argc != 5 || !readFile(argv[1], &old) || !readFile(argv[2], &patch)) {
+    fprintf(stderr, "usage: delta_host old.bin patch.bin out.bin chunk_size\n");
+    return 2;
+  }
+  size_t chunk = strtoul(argv[4], NULL, 10);
+  if (chunk == 0) {
+    chunk = 1;
+  }
+
+  hostRunningPartition.size = old.size();
+  hostRunningPartition.data = old.data();
+
+  bool ok = deltaUpdate_begin();
+  for (size_t offset = 0; ok && offset < patch.size(); offset += chunk) {
+    ok = deltaUpdate_write(patch.data() + offset, min(chunk, patch.size() - offset));
+  }
+  if (ok) {
+    ok = deltaUpdate_end();
+  } else {
+    deltaUpdate_abort();
+  }
+
+  if (!ok) {
+    printf("%s\n", deltaUpdate_errorString());
+    return 1;
+  }
+
+  FILE *out = fopen(argv[3], "wb");
+  if (!out || fwrite(Update.image.data(), 1, Update.image.size(), out) != Update.image.size()) {
+    printf("Failed to write %s\n", argv[3]);
+    return 2;
+  }
+  fclose(out);
+  printf("OK\n");
+  return 0;
+}
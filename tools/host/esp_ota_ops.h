@@ -0,0 +1,32 @@
+/**
+ * @file esp_ota_ops.h
+ * @brief Host stand-in for the running partition, backed by a file's bytes
+ */
+
+#ifndef ESP_OTA_OPS_H
+#define ESP_OTA_OPS_H
+
+#include "common.h"
+
+typedef struct {
+  uint32_t size;
+  const uint8_t *data;
+} esp_partition_t;
+
+// Set by the test driver before the session starts
+extern esp_partition_t hostRunningPartition;
+
+static inline const esp_partition_t *esp_ota_get_running_partition() {
+  return &hostRunningPartition;
+}
+
+static inline esp_err_t esp_partition_read(const esp_partition_t *partition, size_t offset, void *buffer,
+                                           size_t length) {
+  if (offset > partition->size || length > partition->size - offset) {
+    return ESP_FAIL;
+  }
+  memcpy(buffer, partition->data + offset, length);
+  return ESP_OK;
+}
+
+#endif /* ESP_OTA_OPS_H */
@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""
+BYTE-90 delta patch generator
+
+Builds a patch that turns the firmware image currently on the device
+(old.bin) into a new image (new.bin). The device applies it in a streaming
+way (src/delta_module.cpp), reading the running partition and writing the
+inactive OTA partition, so only the patch crosses the link.
+
+Patch layout (little-endian):
+    header  "B90P", version u8, reserved[3], old_size u32, new_size u32,
+            sha256(old)[32], sha256(new)[32]
+    ops     type u8, offset u32, length u32 [, payload]
+              COPY   new += old[offset:offset+length]
+              ADD    new += old[offset+i] + payload[i] (mod 256)
+              INSERT new += payload
+              END
+
+Matching follows the bsdiff idea: regions of the new image are aligned to
+the old image, and small differences inside an aligned region (relocated
+addresses, changed constants) become short ADD runs between COPY runs.
+
+Usage:
+    tools/make_delta.py old.bin new.bin byte90.patch
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+
+MAGIC = b"B90P"
+VERSION = 1
+
+OP_END = 0x00
+OP_COPY = 0x01
+OP_ADD = 0x02
+OP_INSERT = 0x03
+
+HEADER = struct.Struct("<4sB3xII32s32s")
+OP = struct.Struct("<BII")
+
+KEY_SIZE = 12       # bytes hashed to find candidate alignments
+INDEX_STEP = 4      # index every Nth old offset (the new image is scanned bytewise)
+MIN_COPY = 16       # shorter exact runs are folded into the surrounding ADD
+SCORE_SLACK = 32    # mismatches tolerated past the best point of an aligned region
+
+
+class PatchError(Exception):
+    pass
+
+
+def build_index(old):
+    index = {}
+    for offset in range(0, len(old) - KEY_SIZE + 1, INDEX_STEP):
+        index.setdefault(old[offset:offset + KEY_SIZE], offset)
+    return index
+
+
+def find_alignment(old, new, pos, index, last_shift):
+    """Return the old offset aligned with new[pos], or None."""
+    key = new[pos:pos + KEY_SIZE]
+    if len(key) < KEY_SIZE:
+        return None
+
+    # Keep following the previous alignment when it still matches; this
+    # carries matching across small edits in shifted code
+    if last_shift is not None:
+        candidate = pos + last_shift
+        if 0 <= candidate and old[candidate:candidate + KEY_SIZE] == key:
+            return candidate
+
+    # Sampled index: try each phase so a match at any old offset is found
+    for phase in range(INDEX_STEP):
+        if pos < phase:
+            break
+        candidate = index.get(new[pos - phase:pos - phase + KEY_SIZE])
+        if candidate is not None and old[candidate + phase:candidate + phase + KEY_SIZE] == key:
+            return candidate + phase
+    return None
+
+
+def extend_region(old, new, pos, old_pos):
+    """Grow an aligned region forward while matches outweigh mismatches."""
+    limit = min(len(new) - pos, len(old) - old_pos)
+    score = best_score = 0
+    best_length = 0
+    length = 0
+    while length < limit:
+        if new[pos + length] == old[old_pos + length]:
+            score += 1
+            if score > best_score:
+                best_score = score
+                best_length = length + 1
+        else:
+            score -= 1
+            if score < best_score - SCORE_SLACK:
+                break
+        length += 1
+    return best_length
+
+
+def encode_region(ops, old, new, pos, old_pos, length):
+    """Split an aligned region into COPY runs and ADD runs."""
+    diff = bytes((new[pos + i] - old[old_pos + i]) & 0xFF for i in range(length))
+    start = 0
+    while start < length:
+        # Exact run
+        end = start
+        while end < length and diff[end] == 0:
+            end += 1
+        if end - start >= MIN_COPY or end == length:
+            if end > start:
+                ops.append((OP_COPY, old_pos + start, end - start, b""))
+            start = end
+            continue
+
+        # ADD run until the next exact run worth a COPY
+        end = start
+        while end < length:
+            if diff[end] == 0:
+                zeros = end
+                while zeros < length and diff[zeros] == 0:
+                    zeros += 1
+                if zeros - end >= MIN_COPY or zeros == length:
+                    break
+                end = zeros
+            else:
+                end += 1
+        ops.append((OP_ADD, old_pos + start, end - start, diff[start:end]))
+        start = end
+
+
+def diff_images(old, new):
+    """Compute the op list turning old into new."""
+    index = build_index(old)
+    ops = []
+    pos = 0
+    literal_start = 0
+    last_shift = None
+
+    while pos < len(new):
+        old_pos = find_alignment(old, new, pos, index, last_shift)
+        if old_pos is None:
+            pos += 1
+            continue
+
+        length = extend_region(old, new, pos, old_pos)
+        if length < KEY_SIZE:
+            pos += 1
+            continue
+
+        if pos > literal_start:
+            ops.append((OP_INSERT, 0, pos - literal_start, new[literal_start:pos]))
+        encode_region(ops, old, new, pos, old_pos, length)
+        last_shift = old_pos - pos
+        pos += length
+        literal_start = pos
+
+    if literal_start < len(new):
+        ops.append((OP_INSERT, 0, len(new) - literal_start, new[literal_start:]))
+    return ops
+
+
+def make_patch(old, new):
+    header = HEADER.pack(MAGIC, VERSION, len(old), len(new),
+                         hashlib.sha256(old).digest(), hashlib.sha256(new).digest())
+    parts = [header]
+    for op_type, offset, length, payload in diff_images(old, new):
+        parts.append(OP.pack(op_type, offset, length))
+        parts.append(payload)
+    parts.append(OP.pack(OP_END, 0, 0))
+    return b"".join(parts)
+
+
+def apply_patch(old, patch):
+    """Reference implementation of the device-side applier."""
+    magic, version, old_size, new_size, old_hash, new_hash = HEADER.unpack_from(patch, 0)
+    if magic != MAGIC or version != VERSION:
+        raise PatchError("Not a BYTE-90 delta patch")
+    if old_size > len(old) or hashlib.sha256(old[:old_size]).digest() != old_hash:
+        raise PatchError("Patch does not match the running firmware")
+
+    out = bytearray()
+    pos = HEADER.size
+    while True:
+        op_type, offset, length = OP.unpack_from(patch, pos)
+        pos += OP.size
+        if op_type == OP_END:
+            break
+        if len(out) + length > new_size:
+            raise PatchError("Patch writes past the end of the new image")
+        if op_type in (OP_COPY, OP_ADD) and offset + length > old_size:
+            raise PatchError("Patch reads past the end of the running image")
+
+        if op_type == OP_COPY:
+            out += old[offset:offset + length]
+        elif op_type == OP_ADD:
+            payload = patch[pos:pos + length]
+            pos += length
+            out += bytes((old[offset + i] + payload[i]) & 0xFF for i in range(length))
+        elif op_type == OP_INSERT:
+            out += patch[pos:pos + length]
+            pos += length
+        else:
+            raise PatchError("Unknown delta operation")
+
+    if pos != len(patch):
+        raise PatchError("Unexpected data after end of patch")
+    if len(out) != new_size or hashlib.sha256(out).digest() != new_hash:
+        raise PatchError("Rebuilt image hash mismatch")
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BYTE-90 delta patch generator")
+    parser.add_argument("old", help="firmware image currently on the device")
+    parser.add_argument("new", help="firmware image to update to")
+    parser.add_argument("patch", help="output patch file")
+    args = parser.parse_args()
+
+    with open(args.old, "rb") as handle:
+        old = handle.read()
+    with open(args.new, "rb") as handle:
+        new = handle.read()
+
+    patch = make_patch(old, new)
+    apply_patch(old, patch)  # never ship a patch that does not round-trip
+
+    with open(args.patch, "wb") as handle:
+        handle.write(patch)
+    print("%s: %d bytes (%.1f%% of %d)" % (args.patch, len(patch), len(patch) * 100 / len(new), len(new)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
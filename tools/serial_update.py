@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""
+BYTE-90 binary serial updater (Linux host)
+
+Uploads a firmware, filesystem or delta patch image over the binary framed protocol
+started with START_BINARY_UPDATE. Frames are length-prefixed and CRC32
+checked, and up to a window of frames is kept in flight so the link is
+never idle waiting for a round-trip.
+
+Frame layout (little-endian):
+    [0xB9][type][seq u16][length u16][payload ...][crc32 u32]
+The CRC32 (IEEE, same as zlib) covers type through the end of the payload.
+
+The device answers each in-sequence frame with "ACK:<seq>" (cumulative) and
+a corrupt or out-of-order frame with "NAK:<expected seq>", after which the
+uploader goes back to that frame.
+
+Gzip images (or any image with --compress) are announced with a ",gzip"
+option and inflated on the device as they arrive.
+
+Usage:
+    tools/serial_update.py /dev/ttyACM0 firmware.bin
+    tools/serial_update.py /dev/ttyACM0 littlefs.bin --type filesystem
+    tools/serial_update.py /dev/ttyACM0 firmware.bin --compress
+"""
+
+import argparse
+import gzip
+import json
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+import zlib
+
+FRAME_MAGIC = 0xB9
+FRAME_DATA = 0x01
+FRAME_END = 0x02
+FRAME_ABORT = 0x03
+
+GZIP_MAGIC = b"\x1f\x8b"
+
+DEFAULT_BAUD = 921600
+DEFAULT_MAX_PAYLOAD = 2048
+DEFAULT_WINDOW = 4
+
+ACK_TIMEOUT_S = 1.0
+MAX_RETRIES = 10
+FINISH_TIMEOUT_S = 30.0
+
+
+class UpdateError(Exception):
+    pass
+
+
+def build_frame(frame_type, seq, payload=b""):
+    """Encode one frame."""
+    body = struct.pack("<BHH", frame_type, seq & 0xFFFF, len(payload)) + payload
+    return bytes([FRAME_MAGIC]) + body + struct.pack("<I", zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def open_port(path, baud=DEFAULT_BAUD):
+    """Open a serial device (or pty) in raw mode."""
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    if os.isatty(fd):
+        tty.setraw(fd)
+        attrs = termios.tcgetattr(fd)
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is not None:
+            attrs[4] = attrs[5] = speed
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+class LineReader:
+    """Collect newline-terminated response lines from the device."""
+
+    def __init__(self, fd):
+        self.fd = fd
+        self.pending = b""
+
+    def read_line(self, timeout):
+        deadline = time.monotonic() + timeout
+        while b"\n" not in self.pending:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return None
+            ready, _, _ = select.select([self.fd], [], [], remaining)
+            if ready:
+                chunk = os.read(self.fd, 4096)
+                if not chunk:
+                    raise UpdateError("Serial port closed")
+                self.pending += chunk
+        line, self.pending = self.pending.split(b"\n", 1)
+        return line.strip(b"\r").decode("utf-8", "replace")
+
+
+def write_all(fd, data):
+    view = memoryview(data)
+    while view:
+        _, ready, _ = select.select([], [fd], [], ACK_TIMEOUT_S)
+        if ready:
+            view = view[os.write(fd, view):]
+
+
+def wait_for_response(reader, timeout):
+    """Wait for an OK:/ERROR: line and return its JSON body."""
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        line = reader.read_line(deadline - time.monotonic())
+        if line is None:
+            break
+        if line.startswith("OK:"):
+            return json.loads(line[3:])
+        if line.startswith("ERROR:"):
+            raise UpdateError(line[6:])
+    raise UpdateError("No response from device")
+
+
+def resolve_seq(value, base, limit):
+    """Map a 16-bit sequence number onto the absolute frame index in [base, limit]."""
+    distance = (value - base) & 0xFFFF
+    return base + distance if base + distance <= limit else None
+
+
+def upload(fd, image, update_type="firmware", progress=None):
+    """Send an image to the device and wait for it to finalize."""
+    option = ",gzip" if image[:2] == GZIP_MAGIC else ""
+    start = "START_BINARY_UPDATE:%d,%s%s" % (len(image), update_type, option)
+    return send_binary(fd, LineReader(fd), start, image, progress)
+
+
+def send_command(fd, reader, line, timeout=5.0):
+    """Send one text command and return the JSON body of its OK: reply."""
+    write_all(fd, (line + "\n").encode())
+    return wait_for_response(reader, timeout)
+
+
+def send_binary(fd, reader, start, image, progress=None):
+    """Open a binary transfer with a START_* command, send data and wait for the result."""
+    ready = send_command(fd, reader, start)
+    max_payload = int(ready.get("max_payload", DEFAULT_MAX_PAYLOAD))
+    window = int(ready.get("window", DEFAULT_WINDOW))
+
+    data_frames = (len(image) + max_payload - 1) // max_payload
+    total_frames = data_frames + 1  # trailing END frame
+
+    def frame_at(index):
+        if index == data_frames:
+            return build_frame(FRAME_END, index)
+        return build_frame(FRAME_DATA, index, image[index * max_payload:(index + 1) * max_payload])
+
+    base = 0
+    next_index = 0
+    retries = 0
+
+    while base < total_frames:
+        while next_index < total_frames and next_index - base < window:
+            write_all(fd, frame_at(next_index))
+            next_index += 1
+
+        line = reader.read_line(ACK_TIMEOUT_S)
+        if line is None:
+            retries += 1
+            if retries > MAX_RETRIES:
+                raise UpdateError("Device stopped acknowledging frames")
+            next_index = base
+            continue
+
+        if line.startswith("ACK:"):
+            acked = resolve_seq(int(line[4:]), base, next_index - 1)
+            if acked is not None:
+                base = acked + 1
+                retries = 0
+                if progress:
+                    progress(min(base, data_frames) * max_payload, len(image))
+        elif line.startswith("NAK:"):
+            wanted = resolve_seq(int(line[4:]), base, next_index)
+            if wanted is not None:
+                base = next_index = wanted
+        elif line.startswith("ERROR:"):
+            raise UpdateError(line[6:])
+
+    result = wait_for_response(reader, FINISH_TIMEOUT_S)
+    if not result.get("success"):
+        raise UpdateError(result.get("message", "Update failed"))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="BYTE-90 binary serial updater")
+    parser.add_argument("port", help="serial device, e.g. /dev/ttyACM0")
+    parser.add_argument("image", help="firmware or filesystem .bin, or a .patch from make_delta.py (optionally .gz)")
+    parser.add_argument("--type", choices=("firmware", "filesystem", "delta"), default="firmware")
+    parser.add_argument("--compress", action="store_true", help="gzip the image before sending")
+    parser.add_argument("--baud", type=int, default=DEFAULT_BAUD)
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as handle:
+        image = handle.read()
+    if args.compress and image[:2] != GZIP_MAGIC:
+        image = gzip.compress(image, 9, mtime=0)
+
+    def report(sent, total):
+        sys.stdout.write("\r%3d%% %d/%d bytes" % (sent * 100 // total, min(sent, total), total))
+        sys.stdout.flush()
+
+    fd = open_port(args.port, args.baud)
+    started = time.monotonic()
+    try:
+        result = upload(fd, image, args.type, report)
+    except UpdateError as error:
+        print("\nUpdate failed: %s" % error)
+        return 1
+    finally:
+        os.close(fd)
+
+    elapsed = time.monotonic() - started
+    print("\n%s (%.1f KB/s)" % (result.get("message", "Done"), len(image) / 1024 / elapsed))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
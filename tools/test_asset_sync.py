@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+Loopback tests for asset_sync.py
+
+The serial transport runs against the pty device emulator from
+test_serial_update.py; the HTTP transport runs against a small in-process
+server that mirrors the /assets endpoints of src/asset_module.cpp.
+
+Run with:
+    python3 -m unittest discover -s tools
+"""
+
+import email
+import hashlib
+import http.server
+import json
+import os
+import shutil
+import tempfile
+import threading
+import tty
+import unittest
+import urllib.parse
+
+import asset_sync as sync
+import serial_update as su
+from test_serial_update import DeviceEmulator
+
+
+class AssetHandler(http.server.BaseHTTPRequestHandler):
+    """Device side of /assets/diff and /assets/upload."""
+
+    def log_message(self, *args):
+        pass
+
+    def reply(self, code, body):
+        data = json.dumps(body).encode()
+        self.send_response(code)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def do_POST(self):
+        url = urllib.parse.urlparse(self.path)
+        body = self.rfile.read(int(self.headers["Content-Length"]))
+        files = self.server.files
+
+        if url.path == "/assets/diff":
+            changed = []
+            for line in body.decode().splitlines():
+                size, digest, path = line.split(",", 2)
+                data = files.get(path)
+                if data is None or len(data) != int(size) or hashlib.sha256(data).hexdigest() != digest:
+                    changed.append(path)
+            self.reply(200, {"success": True, "changed": changed})
+        elif url.path == "/assets/upload":
+            size, digest, path = urllib.parse.parse_qs(url.query)["entry"][0].split(",", 2)
+            message = email.message_from_bytes(
+                b"Content-Type: " + self.headers["Content-Type"].encode() + b"\r\n\r\n" + body)
+            data = message.get_payload()[0].get_payload(decode=True)
+            if len(data) != int(size) or hashlib.sha256(data).hexdigest() != digest:
+                self.reply(500, {"success": False, "message": "Asset hash mismatch"})
+                return
+            files[path] = data
+            self.server.uploads.append(path)
+            self.reply(200, {"success": True, "message": "Asset saved"})
+        else:
+            self.reply(404, {"success": False, "message": "Not found"})
+
+
+class AssetSyncTest(unittest.TestCase):
+
+    def setUp(self):
+        self.root = tempfile.mkdtemp()
+        self.files = {
+            "/index.html": b"<html>byte90</html>",
+            "/gifs/rest.gif": os.urandom(3000),
+            "/gifs/wink.gif": os.urandom(1500),
+        }
+        for path, data in self.files.items():
+            local = os.path.join(self.root, path.lstrip("/"))
+            os.makedirs(os.path.dirname(local), exist_ok=True)
+            with open(local, "wb") as handle:
+                handle.write(data)
+        with open(os.path.join(self.root, ".DS_Store"), "wb") as handle:
+            handle.write(b"ignored")
+
+    def tearDown(self):
+        shutil.rmtree(self.root)
+
+    def test_manifest(self):
+        entries = sync.build_manifest(self.root)
+        self.assertEqual([entry.path for entry in entries], ["/index.html", "/gifs/rest.gif", "/gifs/wink.gif"])
+        spec = entries[0].spec().split(",")
+        self.assertEqual(int(spec[0]), len(self.files["/index.html"]))
+        self.assertEqual(spec[1], hashlib.sha256(self.files["/index.html"]).hexdigest())
+
+    def test_serial_sends_only_changed_files(self):
+        master, slave = os.openpty()
+        tty.setraw(slave)
+        rest = self.files["/gifs/rest.gif"]
+        device = DeviceEmulator(master, assets={
+            "/index.html": (len(self.files["/index.html"]), hashlib.sha256(self.files["/index.html"]).hexdigest()),
+            "/gifs/rest.gif": (len(rest), hashlib.sha256(b"old").hexdigest()),
+        })
+        device.start()
+        fd = su.open_port(os.ttyname(slave))
+        try:
+            sent = sync.sync(sync.SerialDevice(fd), sync.build_manifest(self.root), log=lambda *_: None)
+        finally:
+            os.close(fd)
+            os.close(slave)
+            os.close(master)
+
+        self.assertEqual(sent, ["/gifs/rest.gif", "/gifs/wink.gif"])
+        self.assertEqual([t[0] for t in device.transfers], ["START_ASSET", "START_ASSET"])
+        self.assertEqual(device.transfers[0][2], rest)
+        self.assertTrue(device.transfers[1][1].endswith(",/gifs/wink.gif"))
+
+    def test_http_sends_only_changed_files(self):
+        server = http.server.ThreadingHTTPServer(("127.0.0.1", 0), AssetHandler)
+        server.files = {"/gifs/wink.gif": self.files["/gifs/wink.gif"]}
+        server.uploads = []
+        thread = threading.Thread(target=server.serve_forever, daemon=True)
+        thread.start()
+        try:
+            device = sync.HttpDevice("http://127.0.0.1:%d" % server.server_address[1])
+            entries = sync.build_manifest(self.root)
+            sent = sync.sync(device, entries, log=lambda *_: None)
+            again = sync.sync(device, entries, log=lambda *_: None)
+        finally:
+            server.shutdown()
+            server.server_close()
+
+        self.assertEqual(sent, ["/index.html", "/gifs/rest.gif"])
+        self.assertEqual(again, [])
+        self.assertEqual(server.files, self.files)
+
+
+if __name__ == "__main__":
+    unittest.main()
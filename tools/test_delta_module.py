@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Host tests for the device-side delta applier (src/delta_module.cpp)
+
+The applier is compiled against the stand-ins in tools/host, then fed
+patches from make_delta.py in different chunk sizes, plus hand-made
+patches that are truncated or reach outside the images. Skipped when no
+C++ compiler is available.
+
+Run with:
+    python3 -m unittest discover -s tools
+"""
+
+import hashlib
+import os
+import random
+import shutil
+import subprocess
+import tempfile
+import unittest
+
+import make_delta as md
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(TOOLS)
+HOST = os.path.join(TOOLS, "host")
+COMPILER = shutil.which("c++") or shutil.which("g++")
+
+
+def build_patch(old, new, ops, new_size=None, new_hash=None):
+    """Hand-assemble a patch from (type, offset, length, payload) tuples."""
+    header = md.HEADER.pack(md.MAGIC, md.VERSION, len(old),
+                            len(new) if new_size is None else new_size,
+                            hashlib.sha256(old).digest(),
+                            new_hash or hashlib.sha256(new).digest())
+    parts = [header]
+    for op_type, offset, length, payload in ops:
+        parts.append(md.OP.pack(op_type, offset, length))
+        parts.append(payload)
+    return b"".join(parts)
+
+
+@unittest.skipUnless(COMPILER, "no C++ compiler")
+class DeltaModuleTest(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.work = tempfile.mkdtemp(prefix="delta_host_")
+        # Copied next to the stand-ins so "common.h" resolves to tools/host
+        shutil.copytree(HOST, cls.work, dirs_exist_ok=True)
+        shutil.copy(os.path.join(REPO, "include", "delta_module.h"), cls.work)
+        shutil.copy(os.path.join(REPO, "src", "delta_module.cpp"), cls.work)
+        cls.binary = os.path.join(cls.work, "delta_host")
+        subprocess.run([COMPILER, "-std=c++17", "-Wall", "-I", cls.work, "-o", cls.binary,
+                        os.path.join(cls.work, "delta_host.cpp"),
+                        os.path.join(cls.work, "delta_module.cpp")],
+                       check=True, capture_output=True)
+
+        rng = random.Random(34)
+        cls.old = bytes(rng.getrandbits(8) for _ in range(64 * 1024))
+        cls.rng = rng
+
+    @classmethod
+    def tearDownClass(cls):
+        shutil.rmtree(cls.work, ignore_errors=True)
+
+    def apply(self, patch, chunk=4096, old=None):
+        """Run the device applier; returns (ok, message, rebuilt image)."""
+        paths = [os.path.join(self.work, name) for name in ("old.bin", "patch.bin", "out.bin")]
+        for path, data in zip(paths, (self.old if old is None else old, patch, b"")):
+            with open(path, "wb") as f:
+                f.write(data)
+        result = subprocess.run([self.binary, *paths, str(chunk)], capture_output=True, text=True)
+        self.assertIn(result.returncode, (0, 1), result.stderr)
+        with open(paths[2], "rb") as f:
+            return result.returncode == 0, result.stdout.strip(), f.read()
+
+    def assertRejected(self, patch, message, chunk=4096):
+        ok, error, _ = self.apply(patch, chunk)
+        self.assertFalse(ok)
+        self.assertEqual(error, message)
+
+    def test_generated_patches_in_any_chunk_size(self):
+        inserted = bytes(self.rng.getrandbits(8) for _ in range(300))
+        new = bytearray(self.old[:9000] + inserted + self.old[9000:40000] + self.old[41000:])
+        for offset in range(12000, 30000, 128):
+            new[offset] = (new[offset] + 4) & 0xFF
+        new = bytes(new)
+        patch = md.make_patch(self.old, new)
+
+        for chunk in (1, 9, 80, 1023, 4096, len(patch)):
+            with self.subTest(chunk=chunk):
+                ok, message, image = self.apply(patch, chunk)
+                self.assertTrue(ok, message)
+                self.assertEqual(image, new)
+
+    def test_identical_image(self):
+        ok, message, image = self.apply(md.make_patch(self.old, self.old))
+        self.assertTrue(ok, message)
+        self.assertEqual(image, self.old)
+
+    def test_truncated_patches(self):
+        new = self.old[:1000] + b"changed" + self.old[1000:]
+        patch = md.make_patch(self.old, new)
+        cuts = {
+            "header": md.HEADER.size - 5,
+            "op record": md.HEADER.size + 4,
+            "END record": len(patch) - 3,
+        }
+        for name, length in cuts.items():
+            with self.subTest(cut=name):
+                self.assertRejected(patch[:length], "Patch is incomplete", chunk=7)
+
+    def test_truncated_payload(self):
+        new = self.old[:2000]
+        patch = build_patch(self.old, new, [(md.OP_INSERT, 0, len(new), new[:100])])
+        self.assertRejected(patch, "Patch is incomplete")
+
+    def test_copy_past_running_image(self):
+        for offset, length in ((len(self.old) - 10, 20), (len(self.old) + 1, 0), (0xFFFFFFF0, 0x20)):
+            with self.subTest(offset=offset, length=length):
+                patch = build_patch(self.old, self.old[:64], [(md.OP_COPY, offset, length, b"")])
+                self.assertRejected(patch, "Patch reads past the end of the running image")
+
+    def test_add_past_running_image(self):
+        patch = build_patch(self.old, self.old[:64],
+                            [(md.OP_ADD, len(self.old) - 32, 64, bytes(64))])
+        self.assertRejected(patch, "Patch reads past the end of the running image")
+
+    def test_op_past_new_image(self):
+        new = self.old[:64]
+        for op_type in (md.OP_COPY, md.OP_ADD, md.OP_INSERT):
+            with self.subTest(op=op_type):
+                patch = build_patch(self.old, new, [(op_type, 0, 65, bytes(65))])
+                self.assertRejected(patch, "Patch writes past the end of the new image")
+
+        # Each op fits on its own, but together they overrun
+        patch = build_patch(self.old, new, [(md.OP_COPY, 0, 40, b""), (md.OP_INSERT, 0, 40, bytes(40))])
+        self.assertRejected(patch, "Patch writes past the end of the new image")
+
+    def test_unknown_op(self):
+        patch = build_patch(self.old, self.old[:64], [(0x7F, 0, 1, b"")])
+        self.assertRejected(patch, "Unknown delta operation")
+
+    def test_data_after_end(self):
+        patch = md.make_patch(self.old, self.old[:5000]) + b"\0"
+        self.assertRejected(patch, "Unexpected data after end of patch")
+
+    def test_wrong_running_image(self):
+        patch = md.make_patch(self.old, self.old[::-1])
+        ok, error, _ = self.apply(patch, old=self.old[:-1] + b"\0")
+        self.assertFalse(ok)
+        self.assertEqual(error, "Patch does not match the running firmware")
+
+    def test_rebuilt_image_checked(self):
+        new = self.old[:64]
+        end = (md.OP_END, 0, 0, b"")
+        short = build_patch(self.old, new, [(md.OP_COPY, 0, 32, b""), end])
+        self.assertRejected(short, "Rebuilt image size mismatch")
+
+        wrong = build_patch(self.old, new, [(md.OP_COPY, 0, 64, b""), end], new_hash=bytes(32))
+        self.assertRejected(wrong, "Rebuilt image hash mismatch")
+
+
+if __name__ == "__main__":
+    unittest.main()
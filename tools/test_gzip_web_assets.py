@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Tests for gzip_web_assets.py
+
+The .gz variants must decompress to the originals and be byte-identical
+across runs, since the device derives the ETag from their contents.
+
+Run with:
+    python3 -m unittest discover -s tools
+"""
+
+import gzip
+import os
+import tempfile
+import unittest
+
+import gzip_web_assets as gw
+
+
+class GzipWebAssetsTest(unittest.TestCase):
+
+    def setUp(self):
+        self.tmp = tempfile.TemporaryDirectory()
+        self.root = self.tmp.name
+        for name, text in (("index.html", "<html>" + "x" * 4000 + "</html>"),
+                           ("script.js", "console.log('byte90');\n" * 200)):
+            with open(os.path.join(self.root, name), "w") as handle:
+                handle.write(text)
+        with open(os.path.join(self.root, "boot.gif"), "wb") as handle:
+            handle.write(b"GIF89a")
+
+    def tearDown(self):
+        self.tmp.cleanup()
+
+    def read(self, name):
+        with open(os.path.join(self.root, name), "rb") as handle:
+            return handle.read()
+
+    def test_compresses_web_assets_only(self):
+        written = gw.compress_assets(self.root)
+        self.assertEqual(sorted(os.path.basename(path) for path in written),
+                         ["index.html.gz", "script.js.gz"])
+        self.assertEqual(gzip.decompress(self.read("index.html.gz")), self.read("index.html"))
+        self.assertFalse(os.path.exists(os.path.join(self.root, "boot.gif.gz")))
+        self.assertLess(len(self.read("index.html.gz")), len(self.read("index.html")))
+
+    def test_output_is_deterministic(self):
+        gw.compress_assets(self.root)
+        first = self.read("script.js.gz")
+        os.remove(os.path.join(self.root, "script.js.gz"))
+        gw.compress_assets(self.root)
+        self.assertEqual(self.read("script.js.gz"), first)
+
+    def test_rewrites_only_stale_variants(self):
+        gw.compress_assets(self.root)
+        self.assertEqual(gw.compress_assets(self.root), [])
+
+        with open(os.path.join(self.root, "script.js"), "a") as handle:
+            handle.write("// changed\n")
+        written = gw.compress_assets(self.root)
+        self.assertEqual([os.path.basename(path) for path in written], ["script.js.gz"])
+        self.assertEqual(gzip.decompress(self.read("script.js.gz")), self.read("script.js"))
+
+
+if __name__ == "__main__":
+    unittest.main()
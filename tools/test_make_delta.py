@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Round-trip tests for make_delta.py
+
+Synthetic "firmware" images are edited the way point releases change a
+binary (inserted code, shifted sections, relocated addresses) and every
+patch must rebuild the new image exactly through the reference applier.
+
+Run with:
+    python3 -m unittest discover -s tools
+"""
+
+import random
+import struct
+import unittest
+
+import make_delta as md
+
+
+def relocate(image, start, end, delta, stride=64):
+    """Bump a 32-bit little-endian word every `stride` bytes, like shifted pointers."""
+    out = bytearray(image)
+    for offset in range(start, min(end, len(out) - 4), stride):
+        word = struct.unpack_from("<I", out, offset)[0]
+        struct.pack_into("<I", out, offset, (word + delta) & 0xFFFFFFFF)
+    return bytes(out)
+
+
+class MakeDeltaTest(unittest.TestCase):
+
+    def setUp(self):
+        rng = random.Random(90)
+        self.old = bytes(rng.getrandbits(8) for _ in range(256 * 1024))
+        self.rng = rng
+
+    def round_trip(self, new):
+        patch = md.make_patch(self.old, new)
+        self.assertEqual(md.apply_patch(self.old, patch), new)
+        return patch
+
+    def test_identical_image(self):
+        patch = self.round_trip(self.old)
+        self.assertLess(len(patch), 256)
+
+    def test_point_release(self):
+        inserted = bytes(self.rng.getrandbits(8) for _ in range(700))
+        new = self.old[:40000] + inserted + self.old[40000:150000] + self.old[151000:]
+        new = relocate(new, 40700, 200000, 0x2BC, stride=256)
+        new += b"BYTE-90 2.0.1\0"
+
+        patch = self.round_trip(new)
+        self.assertLess(len(patch), len(new) // 10)
+
+    def test_unrelated_image(self):
+        new = bytes(self.rng.getrandbits(8) for _ in range(64 * 1024))
+        patch = self.round_trip(new)
+        self.assertLess(len(patch), len(new) + 1024)
+
+    def test_rejects_wrong_running_image(self):
+        patch = md.make_patch(self.old, self.old[::-1])
+        with self.assertRaises(md.PatchError):
+            md.apply_patch(self.old[:-1] + b"\0", patch)
+
+    def test_rejects_truncated_patch(self):
+        new = self.old[:1000] + b"changed" + self.old[1000:]
+        patch = md.make_patch(self.old, new)
+        with self.assertRaises((md.PatchError, struct.error)):
+            md.apply_patch(self.old, patch[:-md.OP.size - 3])
+
+    def test_header_layout(self):
+        patch = md.make_patch(self.old, self.old)
+        self.assertEqual(md.HEADER.size, 80)
+        self.assertEqual(md.OP.size, 9)
+        self.assertEqual(patch[:4], b"B90P")
+        self.assertEqual(struct.unpack_from("<II", patch, 8), (len(self.old), len(self.old)))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""
+Loopback test for serial_update.py over a pseudo-terminal
+
+A small device emulator sits on the master side of a pty and speaks the
+firmware's side of the binary framed protocol, including the single-NAK
+go-back behaviour. Faults are injected on the wire to exercise CRC
+rejection and frame loss.
+
+Run with:
+    python3 -m unittest discover -s tools
+"""
+
+import gzip
+import os
+import struct
+import threading
+import tty
+import unittest
+import zlib
+
+import serial_update as su
+
+
+class DeviceEmulator(threading.Thread):
+    """Receive side of the protocol, mirroring serial_module.cpp."""
+
+    def __init__(self, fd, corrupt=(), drop=(), max_payload=256, window=4, assets=None):
+        super().__init__(daemon=True)
+        self.fd = fd
+        self.corrupt = set(corrupt)
+        self.drop = set(drop)
+        self.max_payload = max_payload
+        self.window = window
+        self.image = bytearray()
+        self.expected_size = 0
+        self.options = []
+        self.assets = dict(assets or {})  # path -> (size, sha256 hex), for ASSET_CHECK
+        self.transfers = []  # (START command, its data, received bytes)
+        self.naks = 0
+        self.crc_errors = 0
+        self.finished = threading.Event()
+
+    def reply(self, text):
+        os.write(self.fd, (text + "\n").encode())
+
+    def read_exact(self, count):
+        data = b""
+        while len(data) < count:
+            chunk = os.read(self.fd, count - len(data))
+            if not chunk:
+                raise EOFError
+            data += chunk
+        return data
+
+    def run(self):
+        try:
+            self.serve()
+        except (EOFError, OSError):
+            pass
+
+    def serve(self):
+        while True:
+            line = b""
+            while not line.endswith(b"\n"):
+                line += self.read_exact(1)
+            command, _, data = line.decode().strip().partition(":")
+
+            if command == "ASSET_CHECK":
+                size, digest, path = data.split(",", 2)
+                changed = self.assets.get(path) != (int(size), digest)
+                self.reply('OK:{"success":true,"path":"%s","changed":%s}' % (path, "true" if changed else "false"))
+                continue
+
+            assert command in ("START_BINARY_UPDATE", "START_ASSET")
+            self.expected_size = int(data.split(",")[0])
+            self.options = data.split(",")[2:]
+            self.image = bytearray()
+            self.reply('OK:{"success":true,"max_payload":%d,"window":%d}' % (self.max_payload, self.window))
+            self.receive()
+            self.transfers.append((command, data, bytes(self.image)))
+            self.finished.set()
+
+    def receive(self):
+        expected_seq = 0
+        nak_sent = False
+        while True:
+            if self.read_exact(1)[0] != su.FRAME_MAGIC:
+                continue
+            header = self.read_exact(5)
+            frame_type, seq, length = struct.unpack("<BHH", header)
+            if length > self.max_payload:
+                continue
+            payload = self.read_exact(length)
+            crc = struct.unpack("<I", self.read_exact(4))[0]
+
+            # Fault injection applies to the first copy of a frame only
+            if seq in self.drop:
+                self.drop.discard(seq)
+                continue
+            if seq in self.corrupt:
+                self.corrupt.discard(seq)
+                payload = bytes([payload[0] ^ 0xFF]) + payload[1:]
+
+            if zlib.crc32(header + payload) & 0xFFFFFFFF != crc:
+                self.crc_errors += 1
+                if not nak_sent:
+                    self.reply("NAK:%d" % expected_seq)
+                    self.naks += 1
+                    nak_sent = True
+                continue
+
+            distance = (seq - expected_seq) & 0xFFFF
+            if distance != 0:
+                if distance >= 0x8000:
+                    self.reply("ACK:%d" % ((expected_seq - 1) & 0xFFFF))
+                elif not nak_sent:
+                    self.reply("NAK:%d" % expected_seq)
+                    self.naks += 1
+                    nak_sent = True
+                continue
+
+            nak_sent = False
+            expected_seq = (expected_seq + 1) & 0xFFFF
+            self.reply("ACK:%d" % seq)
+
+            if frame_type == su.FRAME_DATA:
+                self.image += payload
+                self.reply('PROGRESS:{"success":true,"received":%d}' % len(self.image))
+            elif frame_type == su.FRAME_END:
+                ok = len(self.image) == self.expected_size
+                self.reply('%s{"success":%s,"message":"done","completed":true}' %
+                           ("OK:" if ok else "ERROR:", "true" if ok else "false"))
+                return
+
+
+class SerialUpdateLoopbackTest(unittest.TestCase):
+
+    def setUp(self):
+        # Hold the slave open for the whole test so the master never sees a
+        # hangup (EIO) before the uploader has opened the port
+        self.master, self.slave = os.openpty()
+        tty.setraw(self.slave)
+        self.slave_path = os.ttyname(self.slave)
+        self.image = os.urandom(10 * 256 + 77)
+
+    def tearDown(self):
+        os.close(self.slave)
+        os.close(self.master)
+
+    def run_upload(self, device, image=None):
+        device.start()
+        fd = su.open_port(self.slave_path)
+        try:
+            result = su.upload(fd, self.image if image is None else image)
+        finally:
+            os.close(fd)
+        self.assertTrue(device.finished.wait(5))
+        return result
+
+    def test_frame_encoding(self):
+        frame = su.build_frame(su.FRAME_DATA, 0x1234, b"abc")
+        self.assertEqual(frame[:6], bytes([0xB9, 0x01, 0x34, 0x12, 0x03, 0x00]))
+        self.assertEqual(struct.unpack("<I", frame[-4:])[0], zlib.crc32(frame[1:-4]))
+
+    def test_clean_link(self):
+        device = DeviceEmulator(self.master)
+        self.assertTrue(self.run_upload(device)["success"])
+        self.assertEqual(bytes(device.image), self.image)
+        self.assertEqual(device.naks, 0)
+
+    def test_recovers_from_corrupt_frame(self):
+        device = DeviceEmulator(self.master, corrupt={3})
+        self.assertTrue(self.run_upload(device)["success"])
+        self.assertEqual(bytes(device.image), self.image)
+        self.assertEqual(device.crc_errors, 1)
+
+    def test_recovers_from_lost_frames(self):
+        device = DeviceEmulator(self.master, drop={0, 7, 10})
+        self.assertTrue(self.run_upload(device)["success"])
+        self.assertEqual(bytes(device.image), self.image)
+        self.assertGreaterEqual(device.naks, 2)
+
+    def test_announces_gzip_image(self):
+        device = DeviceEmulator(self.master)
+        compressed = gzip.compress(self.image, 9, mtime=0)
+        self.assertTrue(self.run_upload(device, compressed)["success"])
+        self.assertEqual(device.options, ["gzip"])
+        self.assertEqual(gzip.decompress(bytes(device.image)), self.image)
+
+
+if __name__ == "__main__":
+    unittest.main()